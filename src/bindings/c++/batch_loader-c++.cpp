@@ -0,0 +1,197 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <exception>
+#include <stdexcept>
+
+#include "sail-c++.h"
+#include "sail.h"
+
+namespace sail
+{
+
+class SAIL_HIDDEN batch_loader::pimpl
+{
+public:
+    pimpl()
+        : sail_batch_options(nullptr)
+    {
+        SAIL_TRY_OR_EXECUTE(sail_alloc_batch_options(&sail_batch_options),
+                            /* on error */ throw std::bad_alloc());
+    }
+
+    ~pimpl()
+    {
+        sail_destroy_batch_options(sail_batch_options);
+    }
+
+    /* Context of a single load() call passed to the C callback. */
+    struct batch_context
+    {
+        const callback_t *callback;
+        std::exception_ptr exception;
+    };
+
+    static void sail_batch_callback(std::size_t index, sail_status_t status, sail_image *sail_image, void *user_data)
+    {
+        batch_context *context = static_cast<batch_context *>(user_data);
+
+        sail::image image(sail_image);
+
+        if (sail_image != nullptr) {
+            sail_image->pixels = nullptr;
+            sail_destroy_image(sail_image);
+        }
+
+        /* Skip the remaining images after the callback has thrown. */
+        if (context->exception) {
+            return;
+        }
+
+        try {
+            (*context->callback)(index, status, std::move(image));
+        } catch (...) {
+            context->exception = std::current_exception();
+        }
+    }
+
+    sail_status_t load(const std::function<sail_status_t(const sail_batch_options *, void *)> &start, const callback_t &callback)
+    {
+        sail_load_options *sail_load_options = nullptr;
+
+        if (load_options) {
+            SAIL_TRY(load_options->to_sail_load_options(&sail_load_options));
+        }
+
+        sail_batch_options->load_options = sail_load_options;
+
+        batch_context context{ &callback, nullptr };
+
+        SAIL_TRY_OR_CLEANUP(start(sail_batch_options, &context),
+                            /* cleanup */ sail_destroy_load_options(sail_load_options));
+
+        sail_batch_options->load_options = nullptr;
+        sail_destroy_load_options(sail_load_options);
+
+        if (context.exception) {
+            std::rethrow_exception(context.exception);
+        }
+
+        return SAIL_OK;
+    }
+
+    struct sail_batch_options *sail_batch_options;
+    std::unique_ptr<sail::load_options> load_options;
+};
+
+batch_loader::batch_loader()
+    : d(new pimpl)
+{
+}
+
+batch_loader::~batch_loader()
+{
+}
+
+unsigned batch_loader::threads() const
+{
+    return d->sail_batch_options->threads;
+}
+
+SailBatchOrder batch_loader::order() const
+{
+    return d->sail_batch_options->order;
+}
+
+std::size_t batch_loader::pixel_pool_size() const
+{
+    return d->sail_batch_options->pixel_pool_size;
+}
+
+void batch_loader::set_threads(unsigned threads)
+{
+    d->sail_batch_options->threads = threads;
+}
+
+void batch_loader::set_order(SailBatchOrder order)
+{
+    d->sail_batch_options->order = order;
+}
+
+void batch_loader::set_pixel_pool_size(std::size_t pixel_pool_size)
+{
+    d->sail_batch_options->pixel_pool_size = pixel_pool_size;
+}
+
+void batch_loader::set_load_options(const sail::load_options &load_options)
+{
+    d->load_options.reset(new sail::load_options(load_options));
+}
+
+sail_status_t batch_loader::load(const std::vector<std::string> &paths, const callback_t &callback)
+{
+    if (paths.empty()) {
+        return SAIL_OK;
+    }
+
+    std::vector<const char *> sail_paths;
+    sail_paths.reserve(paths.size());
+
+    for (const std::string &path : paths) {
+        sail_paths.push_back(path.c_str());
+    }
+
+    SAIL_TRY(d->load([&](const sail_batch_options *batch_options, void *user_data) {
+        return sail_load_batch_from_files(sail_paths.data(), sail_paths.size(), batch_options, pimpl::sail_batch_callback, user_data);
+    }, callback));
+
+    return SAIL_OK;
+}
+
+sail_status_t batch_loader::load(const std::vector<sail::arbitrary_data> &buffers, const callback_t &callback)
+{
+    if (buffers.empty()) {
+        return SAIL_OK;
+    }
+
+    std::vector<const void *> sail_buffers;
+    std::vector<std::size_t> sail_buffer_lengths;
+    sail_buffers.reserve(buffers.size());
+    sail_buffer_lengths.reserve(buffers.size());
+
+    for (const sail::arbitrary_data &buffer : buffers) {
+        sail_buffers.push_back(buffer.data());
+        sail_buffer_lengths.push_back(buffer.size());
+    }
+
+    SAIL_TRY(d->load([&](const sail_batch_options *batch_options, void *user_data) {
+        return sail_load_batch_from_memory(sail_buffers.data(), sail_buffer_lengths.data(), sail_buffers.size(),
+                                           batch_options, pimpl::sail_batch_callback, user_data);
+    }, callback));
+
+    return SAIL_OK;
+}
+
+}
@@ -0,0 +1,141 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SAIL_BATCH_LOADER_CPP_H
+#define SAIL_BATCH_LOADER_CPP_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifdef SAIL_BUILD
+    #include "error.h"
+    #include "export.h"
+
+    #include "batch_options.h"
+
+    #include "arbitrary_data-c++.h"
+#else
+    #include <sail-common/error.h>
+    #include <sail-common/export.h>
+
+    #include <sail/batch_options.h>
+
+    #include <sail-c++/arbitrary_data-c++.h>
+#endif
+
+namespace sail
+{
+
+class image;
+class load_options;
+
+/*
+ * Loads batches of images in parallel. See sail_load_batch_from_files().
+ */
+class SAIL_EXPORT batch_loader
+{
+public:
+    /*
+     * Batch callback. Called for every source with its index in the source list, the loading status,
+     * and the loaded image. The image is invalid if the status is not SAIL_OK.
+     *
+     * Calls are serialized, but may come from any thread of the batch. If the callback throws,
+     * the remaining images are discarded and the exception is rethrown from load().
+     */
+    using callback_t = std::function<void(std::size_t index, sail_status_t status, sail::image &&image)>;
+
+    /*
+     * Constructs a new batch loader with the default options. See sail_alloc_batch_options().
+     */
+    batch_loader();
+
+    /*
+     * Destroys the batch loader.
+     */
+    ~batch_loader();
+
+    /*
+     * Returns the maximum number of threads including the calling thread. Zero means the number of CPUs.
+     */
+    unsigned threads() const;
+
+    /*
+     * Returns the order of delivering loaded images to the callback.
+     */
+    SailBatchOrder order() const;
+
+    /*
+     * Returns the maximum size in bytes of pixel buffers cached by the pixel pool of every thread.
+     */
+    std::size_t pixel_pool_size() const;
+
+    /*
+     * Sets the maximum number of threads including the calling thread. Zero means the number of CPUs.
+     */
+    void set_threads(unsigned threads);
+
+    /*
+     * Sets the order of delivering loaded images to the callback.
+     */
+    void set_order(SailBatchOrder order);
+
+    /*
+     * Sets the maximum size in bytes of pixel buffers cached by the pixel pool of every thread.
+     * Zero disables the pools.
+     */
+    void set_pixel_pool_size(std::size_t pixel_pool_size);
+
+    /*
+     * Sets the load options to load every image with. By default, codec-specific defaults are used.
+     */
+    void set_load_options(const sail::load_options &load_options);
+
+    /*
+     * Loads the first frames of the specified image files in parallel and passes them to the callback.
+     * Returns when all the images are delivered.
+     *
+     * Returns SAIL_OK on success even if some images failed to load. Their errors are passed to the callback.
+     */
+    sail_status_t load(const std::vector<std::string> &paths, const callback_t &callback);
+
+    /*
+     * Loads the first frames of the specified memory buffers in parallel and passes them to the callback.
+     * Returns when all the images are delivered.
+     *
+     * Returns SAIL_OK on success even if some images failed to load. Their errors are passed to the callback.
+     */
+    sail_status_t load(const std::vector<sail::arbitrary_data> &buffers, const callback_t &callback);
+
+private:
+    class pimpl;
+    std::unique_ptr<pimpl> d;
+};
+
+}
+
+#endif
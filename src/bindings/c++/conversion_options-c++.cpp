@@ -79,6 +79,7 @@ conversion_options& conversion_options::operator=(const conversion_options &co)
     set_options(co.options());
     set_background(co.background48());
     set_background(co.background24());
+    set_threads(co.threads());
 
     return *this;
 }
@@ -114,6 +115,11 @@ sail_rgb24_t conversion_options::background24() const
     return d->conversion_options->background24;
 }
 
+unsigned conversion_options::threads() const
+{
+    return d->conversion_options->threads;
+}
+
 void conversion_options::set_options(int options)
 {
     d->conversion_options->options = options;
@@ -141,6 +147,11 @@ void conversion_options::set_background(const sail_rgb24_t &rgb24)
     };
 }
 
+void conversion_options::set_threads(unsigned threads)
+{
+    d->conversion_options->threads = threads;
+}
+
 sail_status_t conversion_options::to_sail_conversion_options(sail_conversion_options **conversion_options) const
 {
     SAIL_CHECK_PTR(conversion_options);
@@ -112,6 +112,12 @@ public:
      */
     sail_rgb24_t background24() const;
 
+    /*
+     * Returns the maximum number of threads to convert images with when the options have
+     * SAIL_CONVERSION_OPTION_PARALLEL. Zero means the number of CPUs.
+     */
+    unsigned threads() const;
+
     /*
      * Sets new or-ed SailConversionOption-s. If zero, SAIL_CONVERSION_OPTION_DROP_ALPHA is assumed.
      */
@@ -129,6 +135,12 @@ public:
      */
     void set_background(const sail_rgb24_t &rgb24);
 
+    /*
+     * Sets the maximum number of threads to convert images with when the options have
+     * SAIL_CONVERSION_OPTION_PARALLEL. Zero means the number of CPUs.
+     */
+    void set_threads(unsigned threads);
+
 private:
     sail_status_t to_sail_conversion_options(sail_conversion_options **conversion_options) const;
 
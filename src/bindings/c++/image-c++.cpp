@@ -59,12 +59,13 @@ public:
     void reset_pixels()
     {
         if (!shallow_pixels) {
-            sail_free(sail_image->pixels);
+            sail_free_pixels(sail_image->pixel_allocator, sail_image->pixels);
         }
 
-        sail_image->pixels = nullptr;
-        pixels_size        = 0;
-        shallow_pixels     = false;
+        sail_image->pixels          = nullptr;
+        sail_image->pixel_allocator = nullptr;
+        pixels_size                 = 0;
+        shallow_pixels              = false;
     }
 
     struct sail_image *sail_image;
@@ -532,6 +533,111 @@ image image::convert_to(const sail::save_features &save_features, const conversi
     return img;
 }
 
+bool image::can_scale() const
+{
+    if (!is_valid()) {
+        return false;
+    }
+
+    return sail_can_scale(d->sail_image->pixel_format);
+}
+
+sail_status_t image::scale(unsigned width, unsigned height, SailScaling algorithm)
+{
+    SAIL_TRY(scale(width, height, algorithm, conversion_options{}));
+
+    return SAIL_OK;
+}
+
+sail_status_t image::scale(unsigned width, unsigned height, SailScaling algorithm, const conversion_options &options)
+{
+    if (!is_valid()) {
+        SAIL_LOG_ERROR("Scaling failed as the input image is invalid");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_BROKEN_IMAGE);
+    }
+
+    sail_conversion_options *sail_conversion_options = nullptr;
+    sail_image *sail_img = nullptr;
+
+    SAIL_AT_SCOPE_EXIT(
+        if (sail_img != nullptr) {
+            sail_img->pixels = nullptr;
+            sail_destroy_image(sail_img);
+        }
+
+        sail_destroy_conversion_options(sail_conversion_options);
+    );
+
+    SAIL_TRY(options.to_sail_conversion_options(&sail_conversion_options));
+
+    SAIL_TRY(sail_alloc_image(&sail_img));
+
+    sail_img->width          = d->sail_image->width;
+    sail_img->height         = d->sail_image->height;
+    sail_img->bytes_per_line = d->sail_image->bytes_per_line;
+    sail_img->pixel_format   = d->sail_image->pixel_format;
+    sail_img->pixels         = d->sail_image->pixels;
+
+    sail_image *sail_image_output = nullptr;
+    SAIL_TRY(sail_scale_image_with_options(sail_img, width, height, algorithm, sail_conversion_options, &sail_image_output));
+
+    d->reset_pixels();
+
+    d->sail_image->width          = sail_image_output->width;
+    d->sail_image->height         = sail_image_output->height;
+    d->sail_image->bytes_per_line = sail_image_output->bytes_per_line;
+    d->sail_image->pixels         = sail_image_output->pixels;
+    d->pixels_size                = sail_image_output->height * sail_image_output->bytes_per_line;
+    d->shallow_pixels             = false;
+
+    sail_image_output->pixels = nullptr;
+    sail_destroy_image(sail_image_output);
+
+    return SAIL_OK;
+}
+
+image image::scale_to(unsigned width, unsigned height, SailScaling algorithm) const
+{
+    return scale_to(width, height, algorithm, conversion_options{});
+}
+
+image image::scale_to(unsigned width, unsigned height, SailScaling algorithm, const conversion_options &options) const
+{
+    image img;
+
+    if (!is_valid()) {
+        SAIL_LOG_ERROR("Scaling failed as the input image is invalid");
+        return img;
+    }
+
+    sail_conversion_options *sail_conversion_options = nullptr;
+
+    sail_image *sail_img;
+    SAIL_TRY_OR_EXECUTE(to_sail_image(&sail_img),
+                        /* on error */ return img);
+
+    SAIL_AT_SCOPE_EXIT(
+        sail_img->pixels = nullptr;
+        sail_destroy_image(sail_img);
+
+        sail_destroy_conversion_options(sail_conversion_options);
+    );
+
+    SAIL_TRY_OR_EXECUTE(options.to_sail_conversion_options(&sail_conversion_options),
+                        /* on error */ return img);
+
+    sail_image *sail_image_output = nullptr;
+    SAIL_TRY_OR_EXECUTE(sail_scale_image_with_options(sail_img, width, height, algorithm, sail_conversion_options, &sail_image_output),
+                        /* on error */ return img);
+
+    img = sail::image(sail_image_output);
+
+    sail_image_output->pixels = nullptr;
+    sail_destroy_image(sail_image_output);
+
+    return img;
+}
+
 SailPixelFormat image::closest_pixel_format(const std::vector<SailPixelFormat> &pixel_formats) const
 {
     return sail_closest_pixel_format(d->sail_image->pixel_format, pixel_formats.data(), pixel_formats.size());
@@ -663,18 +769,15 @@ sail_status_t image::transfer_pixels_pointer(const sail_image *sail_image)
 {
     SAIL_CHECK_PTR(sail_image);
 
-    sail_free(d->sail_image->pixels);
-
-    d->sail_image->pixels = nullptr;
-    d->pixels_size        = 0;
-    d->shallow_pixels     = false;
+    d->reset_pixels();
 
     if (sail_image->pixels == nullptr) {
         return SAIL_OK;
     }
 
-    d->sail_image->pixels = sail_image->pixels;
-    d->pixels_size        = sail_image->height * sail_image->bytes_per_line;
+    d->sail_image->pixels          = sail_image->pixels;
+    d->sail_image->pixel_allocator = sail_image->pixel_allocator;
+    d->pixels_size                 = sail_image->height * sail_image->bytes_per_line;
 
     return SAIL_OK;
 }
@@ -34,6 +34,8 @@
     #include "error.h"
     #include "export.h"
 
+    #include "manip_common.h"
+
     #include "iccp-c++.h"
     #include "palette-c++.h"
     #include "source_image-c++.h"
@@ -42,6 +44,8 @@
     #include <sail-common/error.h>
     #include <sail-common/export.h>
 
+    #include <sail-manip/manip_common.h>
+
     #include <sail-c++/iccp-c++.h>
     #include <sail-c++/palette-c++.h>
     #include <sail-c++/source_image-c++.h>
@@ -62,6 +66,7 @@ class save_features;
  */
 class SAIL_EXPORT image
 {
+    friend class batch_loader;
     friend class image_input;
     friend class image_output;
 
@@ -550,6 +555,48 @@ public:
      */
     image convert_to(const sail::save_features &save_features, const conversion_options &options) const;
 
+    /*
+     * Returns true if the image can be scaled.
+     */
+    bool can_scale() const;
+
+    /*
+     * Scales the image to the specified dimensions with the specified resampling filter.
+     * Use can_scale() to quickly check if the image can actually be scaled.
+     *
+     * Updates the image dimensions and bytes per line. The pixel format is preserved.
+     *
+     * Returns SAIL_OK on success.
+     */
+    sail_status_t scale(unsigned width, unsigned height, SailScaling algorithm);
+
+    /*
+     * Scales the image to the specified dimensions with the specified resampling filter
+     * using the specified conversion options. Only SAIL_CONVERSION_OPTION_PARALLEL and
+     * the number of threads are taken into account.
+     *
+     * Updates the image dimensions and bytes per line. The pixel format is preserved.
+     *
+     * Returns SAIL_OK on success.
+     */
+    sail_status_t scale(unsigned width, unsigned height, SailScaling algorithm, const conversion_options &options);
+
+    /*
+     * Scales the image to the specified dimensions with the specified resampling filter
+     * and returns the resulting image.
+     *
+     * Returns an invalid image on error.
+     */
+    image scale_to(unsigned width, unsigned height, SailScaling algorithm) const;
+
+    /*
+     * Scales the image to the specified dimensions with the specified resampling filter
+     * using the specified conversion options and returns the resulting image.
+     *
+     * Returns an invalid image on error.
+     */
+    image scale_to(unsigned width, unsigned height, SailScaling algorithm, const conversion_options &options) const;
+
     /*
      * Returns the closest pixel format from the list.
      *
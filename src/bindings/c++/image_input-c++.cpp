@@ -268,6 +268,34 @@ image image_input::next_frame()
     return image;
 }
 
+sail_status_t image_input::next_frame(sail::image *image, void *pixels, std::size_t pixels_size)
+{
+    SAIL_TRY(next_frame(image, pixels, pixels_size, /* bytes per line */ 0));
+
+    return SAIL_OK;
+}
+
+sail_status_t image_input::next_frame(sail::image *image, void *pixels, std::size_t pixels_size, unsigned bytes_per_line)
+{
+    SAIL_CHECK_PTR(image);
+
+    sail_image *sail_image = nullptr;
+
+    SAIL_AT_SCOPE_EXIT(
+        sail_destroy_image(sail_image);
+    );
+
+    SAIL_TRY(sail_load_next_frame_into(d->state, pixels, pixels_size, bytes_per_line, &sail_image));
+
+    // The pixels are not owned by the image
+    *image = sail::image(sail_image);
+    sail_image->pixels = nullptr;
+
+    image->set_shallow_pixels(pixels, sail_image->height * sail_image->bytes_per_line);
+
+    return SAIL_OK;
+}
+
 sail_status_t image_input::stop()
 {
     sail_status_t saved_status = SAIL_OK;
@@ -332,6 +360,61 @@ std::tuple<image, codec_info> image_input::probe(sail::abstract_io &abstract_io)
     return std::tuple<image, codec_info>{ image(sail_image), codec_info(sail_codec_info) };
 }
 
+std::tuple<image, codec_info, std::size_t> image_input::probe_header(const std::string &path)
+{
+    const sail_codec_info *sail_codec_info;
+    sail_image *sail_image = nullptr;
+    std::size_t bytes_consumed;
+
+    SAIL_AT_SCOPE_EXIT(
+        sail_destroy_image(sail_image);
+    );
+
+    SAIL_TRY_OR_EXECUTE(sail_probe_header_file(path.c_str(), &sail_image, &sail_codec_info, &bytes_consumed),
+                        /* on error */ return {});
+
+    return std::tuple<image, codec_info, std::size_t>{ image(sail_image), codec_info(sail_codec_info), bytes_consumed };
+}
+
+std::tuple<image, codec_info, std::size_t> image_input::probe_header(const void *buffer, std::size_t buffer_length)
+{
+    const sail_codec_info *sail_codec_info;
+    sail_image *sail_image = nullptr;
+    std::size_t bytes_consumed;
+
+    SAIL_AT_SCOPE_EXIT(
+        sail_destroy_image(sail_image);
+    );
+
+    SAIL_TRY_OR_EXECUTE(sail_probe_header_memory(buffer, buffer_length, &sail_image, &sail_codec_info, &bytes_consumed),
+                        /* on error */ return {});
+
+    return std::tuple<image, codec_info, std::size_t>{ image(sail_image), codec_info(sail_codec_info), bytes_consumed };
+}
+
+std::tuple<image, codec_info, std::size_t> image_input::probe_header(const sail::arbitrary_data &arbitrary_data)
+{
+    return probe_header(arbitrary_data.data(), arbitrary_data.size());
+}
+
+std::tuple<image, codec_info, std::size_t> image_input::probe_header(sail::abstract_io &abstract_io)
+{
+    sail::abstract_io_adapter abstract_io_adapter(abstract_io);
+
+    const sail_codec_info *sail_codec_info;
+    sail_image *sail_image = nullptr;
+    std::size_t bytes_consumed;
+
+    SAIL_AT_SCOPE_EXIT(
+        sail_destroy_image(sail_image);
+    );
+
+    SAIL_TRY_OR_EXECUTE(sail_probe_header_io(&abstract_io_adapter.sail_io_c(), &sail_image, &sail_codec_info, &bytes_consumed),
+                        /* on error */ return {});
+
+    return std::tuple<image, codec_info, std::size_t>{ image(sail_image), codec_info(sail_codec_info), bytes_consumed };
+}
+
 image image_input::load(const std::string &path)
 {
     sail_image *sail_image = nullptr;
@@ -267,6 +267,28 @@ public:
      */
     image next_frame();
 
+    /*
+     * Continues loading the source started by the previous call to start(). Decodes the frame
+     * directly into the specified caller-provided pixel buffer with tightly packed rows.
+     * The loaded image uses the buffer as shallow pixels, so the buffer must outlive it.
+     * See sail_load_next_frame_into().
+     *
+     * Returns SAIL_OK on success.
+     * Returns SAIL_ERROR_NO_MORE_FRAMES when no more frames are available.
+     */
+    sail_status_t next_frame(sail::image *image, void *pixels, std::size_t pixels_size);
+
+    /*
+     * Continues loading the source started by the previous call to start(). Decodes the frame
+     * directly into the specified caller-provided pixel buffer with the specified bytes per line.
+     * The loaded image uses the buffer as shallow pixels, so the buffer must outlive it.
+     * See sail_load_next_frame_into().
+     *
+     * Returns SAIL_OK on success.
+     * Returns SAIL_ERROR_NO_MORE_FRAMES when no more frames are available.
+     */
+    sail_status_t next_frame(sail::image *image, void *pixels, std::size_t pixels_size, unsigned bytes_per_line);
+
     /*
      * Stops loading the source started by the previous call to start(). Does nothing
      * if no loading was started.
@@ -318,6 +340,42 @@ public:
      */
     static std::tuple<image, codec_info> probe(sail::abstract_io &abstract_io);
 
+    /*
+     * Loads only the minimal header of the first frame from the specified image file and returns
+     * its properties without pixels, the corresponding codec info, and the number of bytes consumed.
+     * See sail_probe_header_io().
+     *
+     * Returns an invalid image on error.
+     */
+    static std::tuple<image, codec_info, std::size_t> probe_header(const std::string &path);
+
+    /*
+     * Loads only the minimal header of the first frame from the specified memory buffer and returns
+     * its properties without pixels, the corresponding codec info, and the number of bytes consumed.
+     * See sail_probe_header_io().
+     *
+     * Returns an invalid image on error.
+     */
+    static std::tuple<image, codec_info, std::size_t> probe_header(const void *buffer, std::size_t buffer_length);
+
+    /*
+     * Loads only the minimal header of the first frame from the specified memory buffer and returns
+     * its properties without pixels, the corresponding codec info, and the number of bytes consumed.
+     * See sail_probe_header_io().
+     *
+     * Returns an invalid image on error.
+     */
+    static std::tuple<image, codec_info, std::size_t> probe_header(const sail::arbitrary_data &arbitrary_data);
+
+    /*
+     * Loads only the minimal header of the first frame from the specified I/O source and returns
+     * its properties without pixels, the corresponding codec info, and the number of bytes consumed.
+     * See sail_probe_header_io().
+     *
+     * Returns an invalid image on error.
+     */
+    static std::tuple<image, codec_info, std::size_t> probe_header(sail::abstract_io &abstract_io);
+
     /*
      * Loads the specified image file.
      *
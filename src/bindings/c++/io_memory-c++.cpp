@@ -56,6 +56,46 @@ sail_io *construct_sail_io<const void *>(const void *buffer, std::size_t buffer_
     return sail_io;
 }
 
+/* Buffer written by sail_alloc_io_write_growing_memory(). Must outlive the I/O stream. */
+class SAIL_HIDDEN io_memory::growing_buffer
+{
+public:
+    growing_buffer()
+        : buffer(nullptr)
+        , buffer_length(0)
+    {
+    }
+
+    ~growing_buffer()
+    {
+        sail_free(buffer);
+    }
+
+    void *buffer;
+    std::size_t buffer_length;
+};
+
+static sail_io *construct_growing_sail_io(void **buffer, std::size_t *buffer_length)
+{
+    struct sail_io *sail_io;
+
+    SAIL_TRY_OR_EXECUTE(sail_alloc_io_write_growing_memory(buffer, buffer_length, &sail_io),
+                        /* on error */ throw std::bad_alloc());
+
+    return sail_io;
+}
+
+io_memory::io_memory()
+    : io_memory(new growing_buffer)
+{
+}
+
+io_memory::io_memory(growing_buffer *growing_buffer)
+    : io_base(construct_growing_sail_io(&growing_buffer->buffer, &growing_buffer->buffer_length))
+    , m_growing_buffer(growing_buffer)
+{
+}
+
 io_memory::io_memory(void *buffer, std::size_t buffer_length)
     : io_base(construct_sail_io(buffer, buffer_length))
 {
@@ -68,6 +108,8 @@ io_memory::io_memory(const void *buffer, std::size_t buffer_length)
 
 io_memory::~io_memory()
 {
+    /* Close the I/O stream while the growing buffer is still alive. */
+    d->sail_io.reset();
 }
 
 codec_info io_memory::codec_info()
@@ -75,4 +117,14 @@ codec_info io_memory::codec_info()
     return sail::codec_info::from_magic_number(*this);
 }
 
+const void* io_memory::buffer() const
+{
+    return m_growing_buffer ? m_growing_buffer->buffer : nullptr;
+}
+
+std::size_t io_memory::buffer_length() const
+{
+    return m_growing_buffer ? m_growing_buffer->buffer_length : 0;
+}
+
 }
@@ -27,6 +27,7 @@
 #define SAIL_IO_MEMORY_CPP_H
 
 #include <cstddef>
+#include <memory>
 
 #ifdef SAIL_BUILD
     #include "io_base-c++.h"
@@ -43,6 +44,12 @@ namespace sail
 class SAIL_EXPORT io_memory : public io_base
 {
 public:
+    /*
+     * Opens a memory buffer growing automatically for reading and writing. Use buffer()
+     * and buffer_length() to access the written data. The buffer is freed in the destructor.
+     */
+    io_memory();
+
     /*
      * Opens the specified memory buffer for reading and writing.
      */
@@ -69,6 +76,24 @@ public:
      * Returns an invalid codec info object on error.
      */
     sail::codec_info codec_info() override;
+
+    /*
+     * Returns the growing memory buffer or nullptr when the memory I/O stream
+     * is opened with an external buffer or nothing has been written yet.
+     */
+    const void* buffer() const;
+
+    /*
+     * Returns the number of bytes written into the growing memory buffer
+     * or 0 when the memory I/O stream is opened with an external buffer.
+     */
+    std::size_t buffer_length() const;
+
+private:
+    class growing_buffer;
+    explicit io_memory(growing_buffer *growing_buffer);
+
+    const std::unique_ptr<growing_buffer> m_growing_buffer;
 };
 
 }
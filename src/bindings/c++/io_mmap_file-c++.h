@@ -0,0 +1,72 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SAIL_IO_MMAP_FILE_CPP_H
+#define SAIL_IO_MMAP_FILE_CPP_H
+
+#include <memory>
+#include <string>
+
+#ifdef SAIL_BUILD
+    #include "io_base-c++.h"
+#else
+    #include <sail-c++/io_base-c++.h>
+#endif
+
+namespace sail
+{
+
+/*
+ * Memory-mapped file I/O stream. Read-only. Codecs that need the whole file
+ * borrow the mapped pages instead of copying them. See sail_alloc_io_read_mmap_file().
+ */
+class SAIL_EXPORT io_mmap_file : public io_base
+{
+public:
+    /*
+     * Maps the specified file into memory for reading.
+     */
+    explicit io_mmap_file(const std::string &path);
+
+    /*
+     * Unmaps the file.
+     */
+    ~io_mmap_file() override;
+
+    /*
+     * Finds and returns a first codec info object that supports the file extension of the path.
+     * The comparison algorithm is case insensitive.
+     *
+     * Returns an invalid codec info object on error.
+     */
+    sail::codec_info codec_info() override;
+
+private:
+    const sail::codec_info m_codec_info;
+};
+
+}
+
+#endif
@@ -65,6 +65,9 @@ load_options& load_options::operator=(const sail::load_options &load_options)
 {
     set_options(load_options.options());
     set_tuning(load_options.tuning());
+    set_pixel_allocator(load_options.pixel_allocator());
+    set_pixel_format(load_options.pixel_format());
+    set_max_size(load_options.max_width(), load_options.max_height());
 
     return *this;
 }
@@ -100,6 +103,26 @@ const sail::tuning& load_options::tuning() const
     return d->tuning;
 }
 
+const sail_pixel_allocator* load_options::pixel_allocator() const
+{
+    return d->sail_load_options->pixel_allocator;
+}
+
+SailPixelFormat load_options::pixel_format() const
+{
+    return d->sail_load_options->pixel_format;
+}
+
+unsigned load_options::max_width() const
+{
+    return d->sail_load_options->max_width;
+}
+
+unsigned load_options::max_height() const
+{
+    return d->sail_load_options->max_height;
+}
+
 void load_options::set_options(int options)
 {
     d->sail_load_options->options = options;
@@ -110,6 +133,22 @@ void load_options::set_tuning(const sail::tuning &tuning)
     d->tuning = tuning;
 }
 
+void load_options::set_pixel_allocator(const sail_pixel_allocator *pixel_allocator)
+{
+    d->sail_load_options->pixel_allocator = pixel_allocator;
+}
+
+void load_options::set_pixel_format(SailPixelFormat pixel_format)
+{
+    d->sail_load_options->pixel_format = pixel_format;
+}
+
+void load_options::set_max_size(unsigned max_width, unsigned max_height)
+{
+    d->sail_load_options->max_width  = max_width;
+    d->sail_load_options->max_height = max_height;
+}
+
 load_options::load_options(const sail_load_options *ro)
     : load_options()
 {
@@ -120,6 +159,9 @@ load_options::load_options(const sail_load_options *ro)
 
     set_options(ro->options);
     set_tuning(utils_private::c_tuning_to_cpp_tuning(ro->tuning));
+    set_pixel_allocator(ro->pixel_allocator);
+    set_pixel_format(ro->pixel_format);
+    set_max_size(ro->max_width, ro->max_height);
 }
 
 sail_status_t load_options::to_sail_load_options(sail_load_options **load_options) const
@@ -130,7 +172,11 @@ sail_status_t load_options::to_sail_load_options(sail_load_options **load_option
 
     SAIL_TRY(sail_alloc_load_options(&load_options_local));
 
-    load_options_local->options = d->sail_load_options->options;
+    load_options_local->options         = d->sail_load_options->options;
+    load_options_local->pixel_allocator = d->sail_load_options->pixel_allocator;
+    load_options_local->pixel_format    = d->sail_load_options->pixel_format;
+    load_options_local->max_width       = d->sail_load_options->max_width;
+    load_options_local->max_height      = d->sail_load_options->max_height;
 
     SAIL_TRY_OR_CLEANUP(sail_alloc_hash_map(&load_options_local->tuning),
                         /* cleanup */ sail_destroy_load_options(load_options_local));
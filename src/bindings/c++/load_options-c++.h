@@ -30,11 +30,13 @@
 #include <vector>
 
 #ifdef SAIL_BUILD
+    #include "common.h"
     #include "error.h"
     #include "export.h"
 
     #include "tuning-c++.h"
 #else
+    #include <sail-common/common.h>
     #include <sail-common/error.h>
     #include <sail-common/export.h>
 
@@ -42,6 +44,7 @@
 #endif
 
 struct sail_load_options;
+struct sail_pixel_allocator;
 
 namespace sail
 {
@@ -51,6 +54,7 @@ namespace sail
  */
 class SAIL_EXPORT load_options
 {
+    friend class batch_loader;
     friend class image_input;
     friend class load_features;
 
@@ -118,6 +122,28 @@ public:
      */
     const sail::tuning& tuning() const;
 
+    /*
+     * Returns the pixel allocator to allocate pixels of loaded images with or nullptr
+     * if pixels are allocated with sail_malloc().
+     */
+    const sail_pixel_allocator* pixel_allocator() const;
+
+    /*
+     * Returns the pixel format to load images in or SAIL_PIXEL_FORMAT_UNKNOWN
+     * if images are loaded in the codec pixel format.
+     */
+    SailPixelFormat pixel_format() const;
+
+    /*
+     * Returns the maximum output width hint or 0 if the width is not limited.
+     */
+    unsigned max_width() const;
+
+    /*
+     * Returns the maximum output height hint or 0 if the height is not limited.
+     */
+    unsigned max_height() const;
+
     /*
      * Sets new or-ed manipulation options for loading operations. See SailOption.
      */
@@ -128,6 +154,27 @@ public:
      */
     void set_tuning(const sail::tuning &tuning);
 
+    /*
+     * Sets a new pixel allocator. For example, use sail_pixel_pool_allocator() to reuse
+     * pixel buffers across frames and images. The allocator is not owned by the load options
+     * and must outlive the loaded images.
+     */
+    void set_pixel_allocator(const sail_pixel_allocator *pixel_allocator);
+
+    /*
+     * Sets a new pixel format to load images in. Codecs able to output it natively decode
+     * straight into it. Otherwise, loaded pixels are converted in the same pixel buffer.
+     * SAIL_PIXEL_FORMAT_UNKNOWN means the codec pixel format.
+     */
+    void set_pixel_format(SailPixelFormat pixel_format);
+
+    /*
+     * Sets new maximum output dimensions hint. Codecs able to decode reduced resolutions natively
+     * decode no more than needed to fit the image into the box with the aspect ratio kept.
+     * Other codecs ignore the hint. 0 means no limit.
+     */
+    void set_max_size(unsigned max_width, unsigned max_height);
+
 private:
     /*
      * Makes a deep copy of the specified load options and stores the pointer for further use.
@@ -47,6 +47,7 @@
     #include "abstract_io_adapter-c++.h"
     #include "arbitrary_data-c++.h"
     #include "at_scope_exit-c++.h"
+    #include "batch_loader-c++.h"
     #include "codec_info-c++.h"
     #include "compression_level-c++.h"
     #include "context-c++.h"
@@ -59,6 +60,7 @@
     #include "io_base_p-c++.h"
     #include "io_file-c++.h"
     #include "io_memory-c++.h"
+    #include "io_mmap_file-c++.h"
     #include "load_features-c++.h"
     #include "load_options-c++.h"
     #include "log-c++.h"
@@ -85,6 +87,7 @@
 
     #include <sail-c++/arbitrary_data-c++.h>
     #include <sail-c++/at_scope_exit-c++.h>
+    #include <sail-c++/batch_loader-c++.h>
     #include <sail-c++/codec_info-c++.h>
     #include <sail-c++/compression_level-c++.h>
     #include <sail-c++/context-c++.h>
@@ -96,6 +99,7 @@
     #include <sail-c++/io_base-c++.h>
     #include <sail-c++/io_file-c++.h>
     #include <sail-c++/io_memory-c++.h>
+    #include <sail-c++/io_mmap_file-c++.h>
     #include <sail-c++/load_features-c++.h>
     #include <sail-c++/load_options-c++.h>
     #include <sail-c++/log-c++.h>
@@ -315,19 +315,40 @@ enum SailCodecFeature {
 
     /* Can load or save embedded ICC profiles. */
     SAIL_CODEC_FEATURE_ICCP        = 1 << 6,
+
+    /*
+     * Can load into pixel buffers with more bytes per line than needed to hold a row.
+     * See sail_load_next_frame_into().
+     */
+    SAIL_CODEC_FEATURE_CUSTOM_BYTES_PER_LINE = 1 << 7,
+
+    /*
+     * Can load or save frames row by row without holding whole frames in memory.
+     * See sail_load_next_rows() and sail_write_next_rows().
+     */
+    SAIL_CODEC_FEATURE_ROWS = 1 << 8,
 };
 
 /* Read or save options. */
 enum SailOption {
 
     /* Instruction to load or save image meta data like JPEG comments or EXIF. */
-    SAIL_OPTION_META_DATA  = 1 << 0,
+    SAIL_OPTION_META_DATA   = 1 << 0,
 
     /* Instruction to save interlaced images. Specifying this option for loading operations has no effect. */
-    SAIL_OPTION_INTERLACED = 1 << 1,
+    SAIL_OPTION_INTERLACED  = 1 << 1,
 
     /* Instruction to load or save embedded ICC profile. */
-    SAIL_OPTION_ICCP       = 1 << 2,
+    SAIL_OPTION_ICCP        = 1 << 2,
+
+    /*
+     * Instruction to load only the minimal image header like dimensions and pixel format.
+     * Codecs skip meta data, ICC profiles, palettes, and other data following the header
+     * when possible. Frames cannot be loaded with this option: sail_start_loading_*_with_options()
+     * return SAIL_ERROR_INVALID_ARGUMENT when it's set. Used by sail_probe_header_*().
+     * Specifying this option for saving operations has no effect.
+     */
+    SAIL_OPTION_HEADER_ONLY = 1 << 3,
 };
 
 #endif
@@ -498,6 +498,9 @@ const char* sail_codec_feature_to_string(enum SailCodecFeature codec_feature) {
         case SAIL_CODEC_FEATURE_META_DATA:   return "META-DATA";
         case SAIL_CODEC_FEATURE_INTERLACED:  return "INTERLACED";
         case SAIL_CODEC_FEATURE_ICCP:        return "ICCP";
+
+        case SAIL_CODEC_FEATURE_CUSTOM_BYTES_PER_LINE: return "CUSTOM-BYTES-PER-LINE";
+        case SAIL_CODEC_FEATURE_ROWS:                  return "ROWS";
     }
 
     return NULL;
@@ -513,6 +516,9 @@ enum SailCodecFeature sail_codec_feature_from_string(const char *str) {
         case UINT64_C(249851542786072787):   return SAIL_CODEC_FEATURE_META_DATA;
         case UINT64_C(8244927930303708800):  return SAIL_CODEC_FEATURE_INTERLACED;
         case UINT64_C(6384139556):           return SAIL_CODEC_FEATURE_ICCP;
+
+        case UINT64_C(1550756179932684477):  return SAIL_CODEC_FEATURE_CUSTOM_BYTES_PER_LINE;
+        case UINT64_C(6384476720):           return SAIL_CODEC_FEATURE_ROWS;
     }
 
     return SAIL_CODEC_FEATURE_UNKNOWN;
@@ -23,16 +23,202 @@
     SOFTWARE.
 */
 
+#include <stdint.h>
 #include <string.h>
 
 #include "sail-common.h"
 
+/* Alignment of keys and values in the arena data. Enough for any variant type. */
+static const size_t HASH_MAP_DATA_ALIGNMENT = 8;
+
+static const unsigned HASH_MAP_MIN_SLOTS_CAPACITY = 16;
+static const size_t HASH_MAP_MIN_DATA_CAPACITY    = 256;
+
 /*
  * Private functions.
  */
-static inline uint64_t calculate_hash(const char *key) {
+static inline size_t align_data_size(size_t size) {
+
+    return (size + HASH_MAP_DATA_ALIGNMENT - 1) & ~(HASH_MAP_DATA_ALIGNMENT - 1);
+}
+
+static inline uint32_t ideal_slot(const struct sail_hash_map *hash_map, uint64_t hash) {
+
+    /* djb2 has weak low bits, so spread them with Fibonacci hashing. */
+    return (uint32_t)((hash * UINT64_C(11400714819323198485)) >> 32) & (hash_map->slots_capacity - 1);
+}
+
+static inline const char* entry_key(const struct sail_hash_map *hash_map, const struct sail_hash_map_entry *entry) {
+
+    return (const char *)hash_map->data + entry->key_offset;
+}
+
+static size_t arena_size(unsigned slots_capacity, unsigned entries_capacity, size_t data_capacity,
+                         size_t *entries_offset, size_t *data_offset) {
+
+    /* Slots capacity is a power of two >= 16, so entries are 8-byte aligned. */
+    *entries_offset = (size_t)slots_capacity * sizeof(uint32_t);
+    *data_offset    = *entries_offset + (size_t)entries_capacity * sizeof(struct sail_hash_map_entry);
+
+    return *data_offset + data_capacity;
+}
+
+/* Assigns the arena parts and points the values to the arena data. */
+static void bind_arena(struct sail_hash_map *hash_map) {
+
+    size_t entries_offset;
+    size_t data_offset;
+    arena_size(hash_map->slots_capacity, hash_map->entries_capacity, hash_map->data_capacity, &entries_offset, &data_offset);
+
+    unsigned char *arena = hash_map->arena;
+
+    hash_map->slots   = (uint32_t *)arena;
+    hash_map->entries = (struct sail_hash_map_entry *)(arena + entries_offset);
+    hash_map->data    = arena + data_offset;
+
+    for (unsigned i = 0; i < hash_map->size; i++) {
+        hash_map->entries[i].value.value = hash_map->data + hash_map->entries[i].value_offset;
+    }
+}
+
+/*
+ * Returns the slot holding the key, or the empty slot where the key should be put.
+ * The hash map must have an arena.
+ */
+static uint32_t find_slot(const struct sail_hash_map *hash_map, const char *key, uint64_t hash) {
+
+    const uint32_t mask = hash_map->slots_capacity - 1;
+
+    for (uint32_t slot = ideal_slot(hash_map, hash);; slot = (slot + 1) & mask) {
+        const uint32_t entry_index = hash_map->slots[slot];
+
+        if (entry_index == 0) {
+            return slot;
+        }
+
+        const struct sail_hash_map_entry *entry = &hash_map->entries[entry_index - 1];
+
+        if (entry->hash == hash && strcmp(entry_key(hash_map, entry), key) == 0) {
+            return slot;
+        }
+    }
+}
+
+static void insert_slot(struct sail_hash_map *hash_map, uint64_t hash, uint32_t entry_index) {
+
+    const uint32_t mask = hash_map->slots_capacity - 1;
+
+    uint32_t slot = ideal_slot(hash_map, hash);
+
+    while (hash_map->slots[slot] != 0) {
+        slot = (slot + 1) & mask;
+    }
+
+    hash_map->slots[slot] = entry_index + 1;
+}
+
+/*
+ * Makes sure the hash map can hold the specified number of entries and data bytes.
+ * Reallocates and compacts the arena otherwise.
+ *
+ * Keys and values to put may point into the hash map itself, so the old arena is not freed.
+ * It's assigned to old_arena instead, and the caller must free it after putting. old_arena
+ * is NULL when the arena is not reallocated.
+ */
+static sail_status_t reserve(struct sail_hash_map *hash_map, unsigned entries_count, size_t data_size, void **old_arena) {
+
+    *old_arena = NULL;
+
+    if (hash_map->arena != NULL && entries_count <= hash_map->entries_capacity && data_size <= hash_map->data_capacity) {
+        return SAIL_OK;
+    }
+
+    /* Bytes of live keys and values. Erased and overwritten values are dropped. */
+    size_t live_data_size = 0;
+
+    for (unsigned i = 0; i < hash_map->size; i++) {
+        const struct sail_hash_map_entry *entry = &hash_map->entries[i];
+
+        live_data_size += align_data_size(strlen(entry_key(hash_map, entry)) + 1) + align_data_size(entry->value.size);
+    }
+
+    unsigned slots_capacity = hash_map->slots_capacity == 0 ? HASH_MAP_MIN_SLOTS_CAPACITY : hash_map->slots_capacity;
+
+    while (slots_capacity / 2 < entries_count) {
+        slots_capacity *= 2;
+    }
+
+    size_t data_capacity = hash_map->data_capacity == 0 ? HASH_MAP_MIN_DATA_CAPACITY : hash_map->data_capacity;
+    const size_t required_data_capacity = live_data_size + (data_size - hash_map->data_size);
+
+    while (data_capacity < required_data_capacity * 2) {
+        data_capacity *= 2;
+    }
+
+    size_t entries_offset;
+    size_t data_offset;
+    const size_t arena_size_local = arena_size(slots_capacity, slots_capacity / 2, data_capacity, &entries_offset, &data_offset);
+
+    void *ptr;
+    SAIL_TRY(sail_malloc(arena_size_local, &ptr));
+
+    struct sail_hash_map hash_map_local = *hash_map;
+
+    hash_map_local.arena            = ptr;
+    hash_map_local.slots_capacity   = slots_capacity;
+    hash_map_local.entries_capacity = slots_capacity / 2;
+    hash_map_local.data_capacity    = data_capacity;
+    hash_map_local.data_size        = 0;
+
+    bind_arena(&hash_map_local);
 
-    return sail_string_hash(key) % SAIL_HASH_MAP_SIZE;
+    memset(hash_map_local.slots, 0, (size_t)slots_capacity * sizeof(uint32_t));
+
+    /* Move the entries and compact the data. */
+    for (unsigned i = 0; i < hash_map->size; i++) {
+        const struct sail_hash_map_entry *entry = &hash_map->entries[i];
+        struct sail_hash_map_entry *entry_local = &hash_map_local.entries[i];
+
+        *entry_local = *entry;
+
+        const char *key = entry_key(hash_map, entry);
+        const size_t key_size = strlen(key) + 1;
+
+        entry_local->key_offset = hash_map_local.data_size;
+        memcpy(hash_map_local.data + entry_local->key_offset, key, key_size);
+        hash_map_local.data_size += align_data_size(key_size);
+
+        entry_local->value_offset   = hash_map_local.data_size;
+        entry_local->value_capacity = align_data_size(entry->value.size);
+        entry_local->value.value    = hash_map_local.data + entry_local->value_offset;
+        memcpy(entry_local->value.value, entry->value.value, entry->value.size);
+        hash_map_local.data_size += entry_local->value_capacity;
+
+        insert_slot(&hash_map_local, entry_local->hash, i);
+    }
+
+    *old_arena = hash_map->arena;
+    *hash_map  = hash_map_local;
+
+    return SAIL_OK;
+}
+
+/* Copies the value into the arena data. The data must have enough space. */
+static void store_value(struct sail_hash_map *hash_map, struct sail_hash_map_entry *entry, const struct sail_variant *value) {
+
+    if (value->size > entry->value_capacity) {
+        entry->value_offset   = hash_map->data_size;
+        entry->value_capacity = align_data_size(value->size);
+        hash_map->data_size  += entry->value_capacity;
+    }
+
+    entry->value.type  = value->type;
+    entry->value.value = hash_map->data + entry->value_offset;
+    entry->value.size  = value->size;
+
+    if (value->size > 0) {
+        memcpy(entry->value.value, value->value, value->size);
+    }
 }
 
 /*
@@ -46,9 +232,15 @@ sail_status_t sail_alloc_hash_map(struct sail_hash_map **hash_map) {
     SAIL_TRY(sail_malloc(sizeof(struct sail_hash_map), &ptr));
     *hash_map = ptr;
 
-    for (size_t i = 0; i < SAIL_HASH_MAP_SIZE; i++) {
-        (*hash_map)->buckets[i] = NULL;
-    }
+    (*hash_map)->arena            = NULL;
+    (*hash_map)->slots            = NULL;
+    (*hash_map)->entries          = NULL;
+    (*hash_map)->data             = NULL;
+    (*hash_map)->slots_capacity   = 0;
+    (*hash_map)->entries_capacity = 0;
+    (*hash_map)->size             = 0;
+    (*hash_map)->data_capacity    = 0;
+    (*hash_map)->data_size        = 0;
 
     return SAIL_OK;
 }
@@ -59,8 +251,7 @@ void sail_destroy_hash_map(struct sail_hash_map *hash_map) {
         return;
     }
 
-    sail_clear_hash_map(hash_map);
-
+    sail_free(hash_map->arena);
     sail_free(hash_map);
 }
 
@@ -70,93 +261,88 @@ sail_status_t sail_put_hash_map(struct sail_hash_map *hash_map, const char *key,
     SAIL_CHECK_PTR(key);
     SAIL_CHECK_PTR(value);
 
-    struct sail_variant_node **key_variant_node;
+    const uint64_t hash = sail_string_hash(key);
+
+    if (hash_map->arena != NULL) {
+        const uint32_t entry_index = hash_map->slots[find_slot(hash_map, key, hash)];
 
-    for (key_variant_node = &hash_map->buckets[calculate_hash(key)]; *key_variant_node != NULL; key_variant_node = &(*key_variant_node)->next->next) {
-        struct sail_variant_node *value_variant_node = (*key_variant_node)->next;
+        if (entry_index != 0) {
+            struct sail_hash_map_entry *entry = &hash_map->entries[entry_index - 1];
 
-        if (strcmp(sail_variant_to_string((*key_variant_node)->variant), key) == 0) {
-            if (!sail_equal_variants(value_variant_node->variant, value)) {
-                /* Overwrite value. */
-                sail_destroy_variant(value_variant_node->variant);
-                SAIL_TRY(sail_copy_variant(value, &value_variant_node->variant));
+            if (sail_equal_variants(&entry->value, value)) {
+                return SAIL_OK;
             }
 
+            /* Overwrite the value in place if it fits. */
+            void *old_arena = NULL;
+
+            if (value->size > entry->value_capacity) {
+                SAIL_TRY(reserve(hash_map, hash_map->size, hash_map->data_size + align_data_size(value->size), &old_arena));
+                entry = &hash_map->entries[entry_index - 1];
+            }
+
+            store_value(hash_map, entry, value);
+
+            sail_free(old_arena);
+
             return SAIL_OK;
         }
     }
 
-    struct sail_variant_node *local_variant_node;
+    /* Intern the key and the value. */
+    const size_t key_size = strlen(key) + 1;
+
+    void *old_arena;
+    SAIL_TRY(reserve(hash_map, hash_map->size + 1, hash_map->data_size + align_data_size(key_size) + align_data_size(value->size), &old_arena));
+
+    const uint32_t slot = find_slot(hash_map, key, hash);
+    struct sail_hash_map_entry *entry = &hash_map->entries[hash_map->size];
+
+    entry->hash           = hash;
+    entry->key_offset     = hash_map->data_size;
+    entry->value_offset   = hash_map->data_size + align_data_size(key_size);
+    entry->value_capacity = 0;
 
-    SAIL_TRY(sail_alloc_variant_node_and_value(&local_variant_node));
-    SAIL_TRY_OR_CLEANUP(sail_set_variant_string(local_variant_node->variant, key),
-                        /* cleanup */ sail_destroy_variant_node_chain(local_variant_node));
+    memcpy(hash_map->data + entry->key_offset, key, key_size);
+    hash_map->data_size = entry->value_offset;
 
-    SAIL_TRY_OR_CLEANUP(sail_alloc_variant_node(&local_variant_node->next),
-                        /* cleanup */ sail_destroy_variant_node_chain(local_variant_node));
-    SAIL_TRY_OR_CLEANUP(sail_copy_variant(value, &local_variant_node->next->variant),
-                        /* cleanup */ sail_destroy_variant_node_chain(local_variant_node));
+    store_value(hash_map, entry, value);
 
-    *key_variant_node = local_variant_node;
+    hash_map->slots[slot] = ++hash_map->size;
+
+    sail_free(old_arena);
 
     return SAIL_OK;
 }
 
 bool sail_hash_map_has_key(const struct sail_hash_map *hash_map, const char *key) {
 
-    if (key == NULL) {
-        return false;
-    }
-
-    for (const struct sail_variant_node *key_variant_node = hash_map->buckets[calculate_hash(key)];
-            key_variant_node != NULL;
-            key_variant_node = key_variant_node->next->next) {
-        if (strcmp(sail_variant_to_string(key_variant_node->variant), key) == 0) {
-            return true;
-        }
-    }
-
-    return false;
+    return sail_hash_map_value(hash_map, key) != NULL;
 }
 
-struct sail_variant* sail_hash_map_value(const struct sail_hash_map *hash_map, const char *key) {
+const struct sail_variant* sail_hash_map_value(const struct sail_hash_map *hash_map, const char *key) {
 
-    if (key == NULL) {
+    if (key == NULL || hash_map->size == 0) {
         return NULL;
     }
 
-    for (struct sail_variant_node *key_variant_node = hash_map->buckets[calculate_hash(key)];
-            key_variant_node != NULL;
-            key_variant_node = key_variant_node->next->next) {
-        if (strcmp(sail_variant_to_string(key_variant_node->variant), key) == 0) {
-            return key_variant_node->next->variant;
-        }
-    }
+    const uint32_t entry_index = hash_map->slots[find_slot(hash_map, key, sail_string_hash(key))];
 
-    return NULL;
+    return entry_index == 0 ? NULL : &hash_map->entries[entry_index - 1].value;
 }
 
 unsigned sail_hash_map_size(const struct sail_hash_map *hash_map) {
 
-    unsigned size = 0;
-
-    for (size_t i = 0; i < SAIL_HASH_MAP_SIZE; i++) {
-        for (struct sail_variant_node *key_variant_node = hash_map->buckets[i];
-                key_variant_node != NULL;
-                key_variant_node = key_variant_node->next->next) {
-            size++;
-        }
-    }
-
-    return size;
+    return hash_map->size;
 }
 
 void sail_traverse_hash_map(const struct sail_hash_map *hash_map, bool (*callback)(const char *key, const struct sail_variant *value)){
 
-    for (size_t i = 0; i < SAIL_HASH_MAP_SIZE; i++) {
-        for (const struct sail_variant_node *key_variant_node = hash_map->buckets[i];
-                key_variant_node != NULL && callback(sail_variant_to_string(key_variant_node->variant), key_variant_node->next->variant);
-                key_variant_node = key_variant_node->next->next) {
+    for (unsigned i = 0; i < hash_map->size; i++) {
+        const struct sail_hash_map_entry *entry = &hash_map->entries[i];
+
+        if (!callback(entry_key(hash_map, entry), &entry->value)) {
+            break;
         }
     }
 }
@@ -165,51 +351,75 @@ void sail_traverse_hash_map_with_user_data(const struct sail_hash_map *hash_map,
                                            bool (*callback)(const char *key, const struct sail_variant *value, void *user_data),
                                            void *user_data) {
 
-    for (size_t i = 0; i < SAIL_HASH_MAP_SIZE; i++) {
-        for (const struct sail_variant_node *key_variant_node = hash_map->buckets[i];
-                key_variant_node != NULL && callback(sail_variant_to_string(key_variant_node->variant), key_variant_node->next->variant, user_data);
-                key_variant_node = key_variant_node->next->next) {
+    for (unsigned i = 0; i < hash_map->size; i++) {
+        const struct sail_hash_map_entry *entry = &hash_map->entries[i];
+
+        if (!callback(entry_key(hash_map, entry), &entry->value, user_data)) {
+            break;
         }
     }
 }
 
 void sail_erase_hash_map_key(struct sail_hash_map *hash_map, const char *key) {
 
-    if (key == NULL) {
+    if (key == NULL || hash_map->size == 0) {
         return;
     }
 
-    for (struct sail_variant_node **head_variant_node = &hash_map->buckets[calculate_hash(key)],
-                *key_variant_node = *head_variant_node,
-                *prev_key_variant_node = NULL;
-            key_variant_node != NULL;
-            prev_key_variant_node = key_variant_node, key_variant_node = key_variant_node->next->next) {
-        if (strcmp(sail_variant_to_string(key_variant_node->variant), key) == 0) {
+    const uint32_t mask = hash_map->slots_capacity - 1;
+
+    uint32_t slot = find_slot(hash_map, key, sail_string_hash(key));
+    const uint32_t entry_index = hash_map->slots[slot];
 
-            struct sail_variant_node *next_key_variant_node = key_variant_node->next->next;
+    if (entry_index == 0) {
+        return;
+    }
 
-            sail_destroy_variant_node(key_variant_node->next);
-            sail_destroy_variant_node(key_variant_node);
+    /* Backward shift deletion keeps probe sequences intact without tombstones. */
+    for (uint32_t next_slot = (slot + 1) & mask; hash_map->slots[next_slot] != 0; next_slot = (next_slot + 1) & mask) {
+        const uint32_t ideal = ideal_slot(hash_map, hash_map->entries[hash_map->slots[next_slot] - 1].hash);
 
-            /* Erase from the head. */
-            if (key_variant_node == *head_variant_node) {
-                *head_variant_node = next_key_variant_node;
-            } else if (key_variant_node->next->next == NULL) {
-                /* Erase from the middle/end. */
-                prev_key_variant_node->next = next_key_variant_node;
-            }
+        /* The entry stays if its ideal slot is cyclically in (slot, next_slot]. */
+        const bool stays = (slot <= next_slot) ? (slot < ideal && ideal <= next_slot)
+                                               : (slot < ideal || ideal <= next_slot);
 
-            return;
+        if (!stays) {
+            hash_map->slots[slot] = hash_map->slots[next_slot];
+            slot = next_slot;
         }
     }
+
+    hash_map->slots[slot] = 0;
+
+    /* Keep the entries dense by moving the last entry into the hole. Its data stays in place. */
+    const uint32_t last_entry_index = hash_map->size;
+
+    if (entry_index != last_entry_index) {
+        const struct sail_hash_map_entry *last_entry = &hash_map->entries[last_entry_index - 1];
+
+        for (uint32_t last_slot = ideal_slot(hash_map, last_entry->hash);; last_slot = (last_slot + 1) & mask) {
+            if (hash_map->slots[last_slot] == last_entry_index) {
+                hash_map->slots[last_slot] = entry_index;
+                break;
+            }
+        }
+
+        hash_map->entries[entry_index - 1] = *last_entry;
+    }
+
+    hash_map->size--;
 }
 
 void sail_clear_hash_map(struct sail_hash_map *hash_map) {
 
-    for (size_t i = 0; i < SAIL_HASH_MAP_SIZE; i++) {
-        sail_destroy_variant_node_chain(hash_map->buckets[i]);
-        hash_map->buckets[i] = NULL;
+    if (hash_map->arena == NULL) {
+        return;
     }
+
+    memset(hash_map->slots, 0, (size_t)hash_map->slots_capacity * sizeof(uint32_t));
+
+    hash_map->size      = 0;
+    hash_map->data_size = 0;
 }
 
 sail_status_t sail_copy_hash_map(const struct sail_hash_map *source_hash_map, struct sail_hash_map **target_hash_map) {
@@ -220,9 +430,23 @@ sail_status_t sail_copy_hash_map(const struct sail_hash_map *source_hash_map, st
     struct sail_hash_map *hash_map_local;
     SAIL_TRY(sail_alloc_hash_map(&hash_map_local));
 
-    for (size_t i = 0; i < SAIL_HASH_MAP_SIZE; i++) {
-        SAIL_TRY_OR_CLEANUP(sail_copy_variant_node_chain(source_hash_map->buckets[i], &hash_map_local->buckets[i]),
+    if (source_hash_map->arena != NULL) {
+        size_t entries_offset;
+        size_t data_offset;
+        const size_t arena_size_local = arena_size(source_hash_map->slots_capacity, source_hash_map->entries_capacity,
+                                                   source_hash_map->data_capacity, &entries_offset, &data_offset);
+
+        void *ptr;
+        SAIL_TRY_OR_CLEANUP(sail_malloc(arena_size_local, &ptr),
                             /* cleanup */ sail_destroy_hash_map(hash_map_local));
+
+        /* Skip the unused data tail. */
+        memcpy(ptr, source_hash_map->arena, data_offset + source_hash_map->data_size);
+
+        *hash_map_local = *source_hash_map;
+        hash_map_local->arena = ptr;
+
+        bind_arena(hash_map_local);
     }
 
     *target_hash_map = hash_map_local;
@@ -68,9 +68,12 @@ SAIL_EXPORT sail_status_t sail_put_hash_map(struct sail_hash_map *hash_map, cons
 SAIL_EXPORT bool sail_hash_map_has_key(const struct sail_hash_map *hash_map, const char *key);
 
 /*
- * Returns the key associated value or NULL.
+ * Returns the key associated value or NULL. The value belongs to the hash map and lives in its
+ * internal storage, so it's read-only. To change it, put a new value with sail_put_hash_map().
+ * It stays valid until the hash map is modified. Erasing a key moves other values, so pointers
+ * to them become invalid too.
  */
-SAIL_EXPORT struct sail_variant* sail_hash_map_value(const struct sail_hash_map *hash_map, const char *key);
+SAIL_EXPORT const struct sail_variant* sail_hash_map_value(const struct sail_hash_map *hash_map, const char *key);
 
 /*
  * Returns the number of keys stored in the hash map.
@@ -79,7 +82,8 @@ SAIL_EXPORT unsigned sail_hash_map_size(const struct sail_hash_map *hash_map);
 
 /*
  * Traverses the hash map in random order and calls the callback function on every key-value pair.
- * If the callback returns false, the loop stops at the current element.
+ * If the callback returns false, the loop stops at the current element. The callback MUST NOT
+ * modify the hash map.
  */
 SAIL_EXPORT void sail_traverse_hash_map(const struct sail_hash_map *hash_map, bool (*callback)(const char *key, const struct sail_variant *value));
 
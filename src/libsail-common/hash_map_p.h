@@ -26,21 +26,60 @@
 #ifndef SAIL_HASH_MAP_PRIVATE_H
 #define SAIL_HASH_MAP_PRIVATE_H
 
-struct sail_variant_node;
+#include <stddef.h>
+#include <stdint.h>
 
-/*
- * A pretty limited hash map implementation.
- */
-enum {
-    SAIL_HASH_MAP_SIZE = 32
+#include "variant.h"
+
+struct sail_hash_map_entry {
+
+    /* Full key hash. */
+    uint64_t hash;
+
+    /* Offset of the interned NUL-terminated key in the arena data. */
+    size_t key_offset;
+
+    /* Offset of the value data in the arena data. value.value points to it. */
+    size_t value_offset;
+
+    /* The number of bytes reserved for the value data. Overwriting reuses them when possible. */
+    size_t value_capacity;
+
+    struct sail_variant value;
 };
 
+/*
+ * Open-addressing hash map with linear probing. Slots, entries, interned keys and values
+ * live in a single memory block (arena):
+ *
+ *     [ slots | entries | keys and values data ]
+ *
+ * A slot holds an entry index + 1, or 0 if it's empty. Entries are dense, so traversing doesn't
+ * scan empty slots. Copying a hash map is a single memcpy() of the arena followed by rebasing
+ * the value pointers. The arena grows geometrically and is compacted on growth.
+ */
 struct sail_hash_map {
 
-    /*
-     * Values follow keys in the chain, e.g. key1 -> value1 -> key2 -> value2 -> NULL.
-     */
-    struct sail_variant_node *buckets[SAIL_HASH_MAP_SIZE];
+    /* NULL until the first key is put. */
+    void *arena;
+
+    uint32_t *slots;
+    struct sail_hash_map_entry *entries;
+    unsigned char *data;
+
+    /* Power of two. */
+    unsigned slots_capacity;
+
+    /* Half of the slots to keep probe sequences short. */
+    unsigned entries_capacity;
+
+    /* The number of entries. */
+    unsigned size;
+
+    size_t data_capacity;
+
+    /* Used data bytes including bytes of erased and overwritten values. */
+    size_t data_size;
 };
 
 #endif
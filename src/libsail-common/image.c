@@ -37,18 +37,19 @@ sail_status_t sail_alloc_image(struct sail_image **image) {
     SAIL_TRY(sail_malloc(sizeof(struct sail_image), &ptr));
     *image = ptr;
 
-    (*image)->pixels         = NULL;
-    (*image)->width          = 0;
-    (*image)->height         = 0;
-    (*image)->bytes_per_line = 0;
-    (*image)->resolution     = NULL;
-    (*image)->pixel_format   = SAIL_PIXEL_FORMAT_UNKNOWN;
-    (*image)->gamma          = 1;
-    (*image)->delay          = -1;
-    (*image)->palette        = NULL;
-    (*image)->meta_data_node = NULL;
-    (*image)->iccp           = NULL;
-    (*image)->source_image   = NULL;
+    (*image)->pixels          = NULL;
+    (*image)->width           = 0;
+    (*image)->height          = 0;
+    (*image)->bytes_per_line  = 0;
+    (*image)->resolution      = NULL;
+    (*image)->pixel_format    = SAIL_PIXEL_FORMAT_UNKNOWN;
+    (*image)->gamma           = 1;
+    (*image)->delay           = -1;
+    (*image)->palette         = NULL;
+    (*image)->meta_data_node  = NULL;
+    (*image)->iccp            = NULL;
+    (*image)->source_image    = NULL;
+    (*image)->pixel_allocator = NULL;
 
     return SAIL_OK;
 }
@@ -59,7 +60,7 @@ void sail_destroy_image(struct sail_image *image) {
         return;
     }
 
-    sail_free(image->pixels);
+    sail_free_pixels(image->pixel_allocator, image->pixels);
 
     sail_destroy_resolution(image->resolution);
     sail_destroy_palette(image->palette);
@@ -43,6 +43,7 @@ extern "C" {
 struct sail_iccp;
 struct sail_meta_data_node;
 struct sail_palette;
+struct sail_pixel_allocator;
 struct sail_resolution;
 struct sail_source_image;
 
@@ -163,6 +164,15 @@ struct sail_image {
      * SAVE: Ignored.
      */
     struct sail_source_image *source_image;
+
+    /*
+     * Pixel allocator the pixels were allocated with. NULL means sail_malloc().
+     * sail_destroy_image() frees the pixels with it. The allocator must outlive the image.
+     *
+     * LOAD: Set by SAIL to the pixel allocator from the load options.
+     * SAVE: Ignored.
+     */
+    const struct sail_pixel_allocator *pixel_allocator;
 };
 
 typedef struct sail_image sail_image_t;
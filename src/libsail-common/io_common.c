@@ -50,6 +50,7 @@ sail_status_t sail_alloc_io(struct sail_io **io) {
     (*io)->flush          = NULL;
     (*io)->close          = NULL;
     (*io)->eof            = NULL;
+    (*io)->direct_buffer  = NULL;
 
     return SAIL_OK;
 }
@@ -81,7 +82,8 @@ sail_status_t sail_check_io_valid(const struct sail_io *io)
             io->tell           == NULL ||
             io->flush          == NULL ||
             io->close          == NULL ||
-            io->eof            == NULL) {
+            io->eof            == NULL ||
+            ((io->features & SAIL_IO_FEATURE_DIRECT_BUFFER) && io->direct_buffer == NULL)) {
         SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_IO);
     }
 
@@ -167,6 +169,40 @@ sail_status_t sail_alloc_data_from_io_contents(struct sail_io *io, void **data,
     return SAIL_OK;
 }
 
+sail_status_t sail_borrow_data_from_io_contents(struct sail_io *io, const void **data, size_t *data_size,
+                                                void **data_to_free) {
+
+    SAIL_CHECK_PTR(io);
+    SAIL_CHECK_PTR(data);
+    SAIL_CHECK_PTR(data_size);
+    SAIL_CHECK_PTR(data_to_free);
+
+    if (io->features & SAIL_IO_FEATURE_DIRECT_BUFFER) {
+        const void *buffer;
+        size_t buffer_length;
+        SAIL_TRY(io->direct_buffer(io->stream, &buffer, &buffer_length));
+
+        size_t position;
+        SAIL_TRY(io->tell(io->stream, &position));
+
+        if (position > buffer_length) {
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_READ_IO);
+        }
+
+        *data         = (const unsigned char *)buffer + position;
+        *data_size    = buffer_length - position;
+        *data_to_free = NULL;
+    } else {
+        void *data_local;
+        SAIL_TRY(sail_alloc_data_from_io_contents(io, &data_local, data_size));
+
+        *data         = data_local;
+        *data_to_free = data_local;
+    }
+
+    return SAIL_OK;
+}
+
 sail_status_t sail_read_string_from_io(struct sail_io *io, char *str, size_t str_size) {
 
     SAIL_CHECK_PTR(io);
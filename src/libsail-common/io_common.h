@@ -115,17 +115,28 @@ typedef sail_status_t (*sail_io_close_t)(void *stream);
  */
 typedef sail_status_t (*sail_io_eof_t)(void *stream, bool *result);
 
+/*
+ * Assigns a pointer to the whole underlying data and its length without copying it. The data
+ * is read-only and stays valid until the underlying I/O object is closed. Available only
+ * when the I/O object has the SAIL_IO_FEATURE_DIRECT_BUFFER feature.
+ *
+ * Returns SAIL_OK on success.
+ */
+typedef sail_status_t (*sail_io_direct_buffer_t)(void *stream, const void **buffer, size_t *buffer_length);
+
 /*
  * Well-known I/O ids used in libsail for file and memory I/O classes.
  *
  * You MUST use your own unique id for custom I/O classes. For example, you can use sail_string_hash()
  * to generate a unique id and store it in the source code.
  *
- * SAIL_FILE_IO_ID   = sail_string_hash("sail-file-io-id")
- * SAIL_MEMORY_IO_ID = sail_string_hash("sail-memory-io-id")
+ * SAIL_FILE_IO_ID      = sail_string_hash("sail-file-io-id")
+ * SAIL_MMAP_FILE_IO_ID = sail_string_hash("sail-mmap-file-io-id")
+ * SAIL_MEMORY_IO_ID    = sail_string_hash("sail-memory-io-id")
  */
-static const uint64_t SAIL_FILE_IO_ID   = UINT64_C(5820790535323209114);
-static const uint64_t SAIL_MEMORY_IO_ID = UINT64_C(11955407548648566675);
+static const uint64_t SAIL_FILE_IO_ID      = UINT64_C(5820790535323209114);
+static const uint64_t SAIL_MMAP_FILE_IO_ID = UINT64_C(12788708998701020146);
+static const uint64_t SAIL_MEMORY_IO_ID    = UINT64_C(11955407548648566675);
 
 /* I/O features. */
 enum SailIoFeature {
@@ -135,6 +146,12 @@ enum SailIoFeature {
      * must return SAIL_ERROR_NOT_IMPLEMENTED.
      */
     SAIL_IO_FEATURE_SEEKABLE = 1 << 0,
+
+    /*
+     * The I/O object provides direct read-only access to its whole underlying data
+     * through the direct_buffer callback. For example, memory and memory-mapped file I/O objects.
+     */
+    SAIL_IO_FEATURE_DIRECT_BUFFER = 1 << 1,
 };
 
 /*
@@ -207,6 +224,12 @@ struct sail_io {
      * EOF callback.
      */
     sail_io_eof_t eof;
+
+    /*
+     * Optional direct buffer callback. Must be set when the SAIL_IO_FEATURE_DIRECT_BUFFER feature
+     * is on. Can be NULL otherwise.
+     */
+    sail_io_direct_buffer_t direct_buffer;
 };
 
 typedef struct sail_io sail_io_t;
@@ -263,6 +286,21 @@ SAIL_EXPORT sail_status_t sail_io_contents_into_data(struct sail_io *io, void *d
  */
 SAIL_EXPORT sail_status_t sail_alloc_data_from_io_contents(struct sail_io *io, void **data, size_t *data_size);
 
+/*
+ * Provides the specified I/O stream contents from the current position until EOF.
+ * If the I/O object has the SAIL_IO_FEATURE_DIRECT_BUFFER feature, borrows the data without
+ * copying it and assigns NULL to 'data_to_free'. The borrowed data stays valid until the I/O object
+ * is closed. Otherwise, works just like sail_alloc_data_from_io_contents() and assigns the allocated
+ * buffer to both 'data' and 'data_to_free'. Free 'data_to_free' with sail_free() when the data
+ * is not needed anymore.
+ *
+ * The I/O position is not changed.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_borrow_data_from_io_contents(struct sail_io *io, const void **data, size_t *data_size,
+                                                            void **data_to_free);
+
 /*
  * Reads a string ended with '\n' from the I/O stream. Trailing new line characters
  * are not stripped. The string buffer size must be >= 2 to hold at least "\n".
@@ -37,7 +37,11 @@ sail_status_t sail_alloc_load_options(struct sail_load_options **load_options) {
     *load_options = ptr;
 
     (*load_options)->options = 0;
-    (*load_options)->tuning  = NULL;
+    (*load_options)->tuning          = NULL;
+    (*load_options)->pixel_allocator = NULL;
+    (*load_options)->pixel_format    = SAIL_PIXEL_FORMAT_UNKNOWN;
+    (*load_options)->max_width       = 0;
+    (*load_options)->max_height      = 0;
 
     return SAIL_OK;
 }
@@ -82,7 +86,11 @@ sail_status_t sail_copy_load_options(const struct sail_load_options *source, str
     struct sail_load_options *target_local;
     SAIL_TRY(sail_alloc_load_options(&target_local));
 
-    target_local->options = source->options;
+    target_local->options         = source->options;
+    target_local->pixel_allocator = source->pixel_allocator;
+    target_local->pixel_format    = source->pixel_format;
+    target_local->max_width       = source->max_width;
+    target_local->max_height      = source->max_height;
 
     if (source->tuning != NULL) {
         SAIL_TRY_OR_CLEANUP(sail_copy_hash_map(source->tuning, &target_local->tuning),
@@ -93,3 +101,34 @@ sail_status_t sail_copy_load_options(const struct sail_load_options *source, str
 
     return SAIL_OK;
 }
+
+unsigned sail_scale_denominator_from_load_options(const struct sail_load_options *load_options,
+                                                  unsigned width, unsigned height,
+                                                  unsigned max_scale_denominator) {
+
+    if (load_options == NULL) {
+        return 1;
+    }
+
+    const unsigned max_width  = load_options->max_width;
+    const unsigned max_height = load_options->max_height;
+
+    unsigned scale_denominator = 1;
+
+    /*
+     * The fitted image is limited by the most constraining dimension, so the next denominator
+     * is still acceptable while it keeps that dimension not smaller than its limit.
+     */
+    while (scale_denominator * 2 <= max_scale_denominator) {
+        const unsigned next = scale_denominator * 2;
+
+        if ((max_width  != 0 && (unsigned long long)next * max_width  <= width) ||
+            (max_height != 0 && (unsigned long long)next * max_height <= height)) {
+            scale_denominator = next;
+        } else {
+            break;
+        }
+    }
+
+    return scale_denominator;
+}
@@ -27,9 +27,11 @@
 #define SAIL_LOAD_OPTIONS_H
 
 #ifdef SAIL_BUILD
+    #include "common.h"
     #include "error.h"
     #include "export.h"
 #else
+    #include <sail-common/common.h>
     #include <sail-common/error.h>
     #include <sail-common/export.h>
 #endif
@@ -40,6 +42,7 @@ extern "C" {
 
 struct sail_hash_map;
 struct sail_load_features;
+struct sail_pixel_allocator;
 
 /*
  * Options to modify loading operations.
@@ -64,6 +67,37 @@ struct sail_load_options {
      * or forward compatible.
      */
     struct sail_hash_map *tuning;
+
+    /*
+     * Pixel allocator to allocate pixels of loaded images with. For example, use
+     * sail_pixel_pool_allocator() to reuse pixel buffers across frames and images.
+     * Not owned by the load options. Must outlive the loaded images.
+     *
+     * NULL means sail_malloc().
+     */
+    const struct sail_pixel_allocator *pixel_allocator;
+
+    /*
+     * Pixel format to load images in. Codecs able to output it natively decode straight
+     * into it. Otherwise, loaded pixels are converted row by row in the same pixel buffer,
+     * so no second full-size buffer is allocated. Loading fails with SAIL_ERROR_UNSUPPORTED_PIXEL_FORMAT
+     * if the codec pixel format cannot be converted into it. See sail_can_convert().
+     *
+     * SAIL_PIXEL_FORMAT_UNKNOWN means the codec pixel format. This is the default.
+     */
+    enum SailPixelFormat pixel_format;
+
+    /*
+     * Maximum output dimensions hint. Codecs able to decode reduced resolutions natively,
+     * e.g. with DCT scaling or mipmaps, decode the smallest resolution not smaller than the image
+     * fitted into max_width x max_height with the aspect ratio kept. Vector codecs render images
+     * fitted into the box. Other codecs ignore the hint, so loaded images can still be larger.
+     * Images are never upscaled.
+     *
+     * 0 means no limit. This is the default.
+     */
+    unsigned max_width;
+    unsigned max_height;
 };
 
 typedef struct sail_load_options sail_load_options_t;
@@ -95,6 +129,18 @@ SAIL_EXPORT sail_status_t sail_alloc_load_options_from_features(const struct sai
  */
 SAIL_EXPORT sail_status_t sail_copy_load_options(const struct sail_load_options *source, struct sail_load_options **target);
 
+/*
+ * Returns the largest power-of-two scale denominator not exceeding max_scale_denominator
+ * with which the image of the specified dimensions still covers the image fitted into
+ * the maximum output dimensions of the load options. Codecs supporting reduced resolution
+ * decoding use it to honor sail_load_options.max_width and sail_load_options.max_height.
+ *
+ * Returns 1 if the load options have no maximum output dimensions or the image already fits them.
+ */
+SAIL_EXPORT unsigned sail_scale_denominator_from_load_options(const struct sail_load_options *load_options,
+                                                              unsigned width, unsigned height,
+                                                              unsigned max_scale_denominator);
+
 /* extern "C" */
 #ifdef __cplusplus
 }
@@ -70,6 +70,47 @@ static enum SailLogLevel sail_max_log_level = SAIL_LOG_LEVEL_DEBUG;
 
 static sail_logger sail_external_logger = NULL;
 
+#ifdef SAIL_THREAD_SAFE
+struct async_log_message {
+
+    enum SailLogLevel level;
+    const char *file;
+    int line;
+    char text[SAIL_ASYNC_LOG_MESSAGE_SIZE];
+};
+
+/* Ring buffer of formatted messages written by a background thread. */
+struct async_log {
+
+    sail_mutex_t mutex;
+    sail_condition_t message_available;
+    sail_thread_t thread;
+
+    struct async_log_message *messages;
+    unsigned capacity;
+    unsigned head;
+    unsigned count;
+    unsigned long dropped;
+    bool stop;
+};
+
+static struct async_log sail_async_log;
+
+/*
+ * Non-zero while the background thread accepts messages. Accessed atomically as logging
+ * threads read it without the lock. Cleared before stopping, so the messages logged
+ * after that are written synchronously.
+ */
+static long sail_async_log_running = 0;
+
+/*
+ * Set in the background thread and while queueing a message. Messages logged
+ * in this state (by the external logger, or by failed threading functions) are written
+ * synchronously to avoid recursion.
+ */
+static SAIL_THREAD_LOCAL bool sail_inside_async_log = false;
+#endif
+
 static bool check_ansi_colors_supported(void) {
 
     static SAIL_THREAD_LOCAL bool ansi_colors_supported_called = false;
@@ -117,20 +158,10 @@ static bool check_ansi_colors_supported(void) {
     return ansi_colors_supported;
 }
 
-void sail_log(enum SailLogLevel level, const char *file, int line, const char *format, ...) {
-
-    /* Filter out. */
-    if (level > sail_max_log_level) {
-        return;
-    }
+static void write_log(enum SailLogLevel level, const char *file, int line, const char *format, va_list args) {
 
     if (sail_external_logger != NULL) {
-        va_list args;
-        va_start(args, format);
-
         sail_external_logger(level, file, line, format, args);
-
-        va_end(args);
         return;
     }
 
@@ -165,9 +196,6 @@ void sail_log(enum SailLogLevel level, const char *file, int line, const char *f
     }
 
     /* Print log level. */
-    va_list args;
-    va_start(args, format);
-
     fprintf(SAIL_LOG_FPTR, "SAIL: [%s] ", level_string);
 
     /* Print file and line. */
@@ -187,6 +215,123 @@ void sail_log(enum SailLogLevel level, const char *file, int line, const char *f
     }
 
     fprintf(SAIL_LOG_FPTR, "\n");
+}
+
+#ifdef SAIL_THREAD_SAFE
+static void write_formatted_log(enum SailLogLevel level, const char *file, int line, const char *format, ...) {
+
+    va_list args;
+    va_start(args, format);
+
+    write_log(level, file, line, format, args);
+
+    va_end(args);
+}
+
+static void async_log_routine(void *arg) {
+
+    (void)arg;
+
+    sail_inside_async_log = true;
+
+    SAIL_TRY_OR_EXECUTE(sail_lock_mutex(&sail_async_log.mutex),
+                        /* on error */ return);
+
+    while (true) {
+        while (sail_async_log.count == 0 && !sail_async_log.stop) {
+            SAIL_TRY_OR_EXECUTE(sail_wait_condition(&sail_async_log.message_available, &sail_async_log.mutex),
+                                /* on error */ sail_unlock_mutex(&sail_async_log.mutex); return);
+        }
+
+        /* Stop only when all the queued messages are written. */
+        if (sail_async_log.count == 0) {
+            break;
+        }
+
+        /*
+         * Write without holding the lock so logging threads never wait for the output.
+         * The message slot stays occupied until it's written, so it cannot be overwritten.
+         */
+        const struct async_log_message *message = &sail_async_log.messages[sail_async_log.head];
+
+        sail_unlock_mutex(&sail_async_log.mutex);
+
+        write_formatted_log(message->level, message->file, message->line, "%s", message->text);
+
+        SAIL_TRY_OR_EXECUTE(sail_lock_mutex(&sail_async_log.mutex),
+                            /* on error */ return);
+
+        sail_async_log.head = (sail_async_log.head + 1) % sail_async_log.capacity;
+        sail_async_log.count--;
+    }
+
+    sail_unlock_mutex(&sail_async_log.mutex);
+}
+
+static void queue_async_log(enum SailLogLevel level, const char *file, int line, const char *format, va_list args) {
+
+    /* Format outside of the lock. */
+    char text[SAIL_ASYNC_LOG_MESSAGE_SIZE];
+    vsnprintf(text, sizeof(text), format, args);
+
+    sail_inside_async_log = true;
+
+    SAIL_TRY_OR_EXECUTE(sail_lock_mutex(&sail_async_log.mutex),
+                        /* on error */ sail_inside_async_log = false; return);
+
+    /*
+     * The thread has been requested to stop after we checked the running flag, and it may
+     * have already exited. Write the message synchronously, so it's not lost.
+     */
+    const bool stopping = sail_async_log.stop;
+
+    if (!stopping) {
+        if (sail_async_log.count == sail_async_log.capacity) {
+            sail_async_log.dropped++;
+        } else {
+            struct async_log_message *message =
+                &sail_async_log.messages[(sail_async_log.head + sail_async_log.count) % sail_async_log.capacity];
+
+            message->level = level;
+            message->file  = file;
+            message->line  = line;
+            memcpy(message->text, text, sizeof(text));
+
+            sail_async_log.count++;
+
+            sail_signal_condition(&sail_async_log.message_available);
+        }
+    }
+
+    sail_unlock_mutex(&sail_async_log.mutex);
+
+    if (stopping) {
+        write_formatted_log(level, file, line, "%s", text);
+    }
+
+    sail_inside_async_log = false;
+}
+#endif
+
+void sail_log(enum SailLogLevel level, const char *file, int line, const char *format, ...) {
+
+    /* Filter out. */
+    if (level > SAIL_MIN_LOG_LEVEL || level > sail_max_log_level) {
+        return;
+    }
+
+    va_list args;
+    va_start(args, format);
+
+#ifdef SAIL_THREAD_SAFE
+    if (!sail_inside_async_log && sail_atomic_load_long(&sail_async_log_running)) {
+        queue_async_log(level, file, line, format, args);
+    } else {
+        write_log(level, file, line, format, args);
+    }
+#else
+    write_log(level, file, line, format, args);
+#endif
 
     va_end(args);
 }
@@ -196,7 +341,90 @@ void sail_set_log_barrier(enum SailLogLevel max_level) {
     sail_max_log_level = max_level;
 }
 
+bool sail_log_level_enabled(enum SailLogLevel level) {
+
+    return level <= sail_max_log_level;
+}
+
 void sail_set_logger(sail_logger logger) {
 
     sail_external_logger = logger;
 }
+
+sail_status_t sail_start_async_logging(unsigned capacity) {
+
+#ifdef SAIL_THREAD_SAFE
+    if (sail_atomic_load_long(&sail_async_log_running)) {
+        SAIL_LOG_ERROR("Asynchronous logging is already started");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_CONFLICTING_OPERATION);
+    }
+
+    if (capacity == 0) {
+        SAIL_LOG_ERROR("Asynchronous log capacity must be greater than zero");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+
+    void *ptr;
+    SAIL_TRY(sail_malloc((size_t)capacity * sizeof(struct async_log_message), &ptr));
+
+    sail_async_log.messages = ptr;
+    sail_async_log.capacity = capacity;
+    sail_async_log.head     = 0;
+    sail_async_log.count    = 0;
+    sail_async_log.dropped  = 0;
+    sail_async_log.stop     = false;
+
+    SAIL_TRY_OR_CLEANUP(sail_init_mutex(&sail_async_log.mutex),
+                        /* cleanup */ sail_free(sail_async_log.messages));
+    SAIL_TRY_OR_CLEANUP(sail_init_condition(&sail_async_log.message_available),
+                        /* cleanup */ sail_destroy_mutex(&sail_async_log.mutex),
+                                      sail_free(sail_async_log.messages));
+    SAIL_TRY_OR_CLEANUP(sail_create_thread(&sail_async_log.thread, async_log_routine, NULL),
+                        /* cleanup */ sail_destroy_condition(&sail_async_log.message_available),
+                                      sail_destroy_mutex(&sail_async_log.mutex),
+                                      sail_free(sail_async_log.messages));
+
+    sail_atomic_store_long(&sail_async_log_running, 1);
+
+    return SAIL_OK;
+#else
+    (void)capacity;
+
+    SAIL_LOG_ERROR("Asynchronous logging requires SAIL compiled with SAIL_THREAD_SAFE");
+    SAIL_LOG_AND_RETURN(SAIL_ERROR_NOT_IMPLEMENTED);
+#endif
+}
+
+sail_status_t sail_stop_async_logging(void) {
+
+#ifdef SAIL_THREAD_SAFE
+    if (!sail_atomic_load_long(&sail_async_log_running)) {
+        return SAIL_OK;
+    }
+
+    /*
+     * New messages are written synchronously from now on. Messages queued by threads
+     * that have already seen the running flag are either written by the background thread
+     * before it exits, or written synchronously when they see the stop flag.
+     */
+    SAIL_TRY(sail_lock_mutex(&sail_async_log.mutex));
+    sail_atomic_store_long(&sail_async_log_running, 0);
+    sail_async_log.stop = true;
+    sail_signal_condition(&sail_async_log.message_available);
+    sail_unlock_mutex(&sail_async_log.mutex);
+
+    SAIL_TRY(sail_join_thread(&sail_async_log.thread));
+
+    sail_destroy_condition(&sail_async_log.message_available);
+    sail_destroy_mutex(&sail_async_log.mutex);
+    sail_free(sail_async_log.messages);
+
+    if (sail_async_log.dropped > 0) {
+        SAIL_LOG_WARNING("Asynchronous log dropped %lu message(s) because its buffer was full", sail_async_log.dropped);
+    }
+
+    return SAIL_OK;
+#else
+    return SAIL_OK;
+#endif
+}
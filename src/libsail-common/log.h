@@ -27,10 +27,15 @@
 #define SAIL_LOG_H
 
 #include <stdarg.h>
+#include <stdbool.h>
 
 #ifdef SAIL_BUILD
+    #include "config.h"
+    #include "error.h"
     #include "export.h"
 #else
+    #include <sail-common/config.h>
+    #include <sail-common/error.h>
     #include <sail-common/export.h>
 #endif
 
@@ -64,6 +69,12 @@ SAIL_EXPORT void sail_log(enum SailLogLevel level, const char *file, int line, c
  */
 SAIL_EXPORT void sail_set_log_barrier(enum SailLogLevel max_level);
 
+/*
+ * Returns true if messages of the specified log level pass the current log barrier.
+ * Use it to skip building expensive log arguments that would be filtered out anyway.
+ */
+SAIL_EXPORT bool sail_log_level_enabled(enum SailLogLevel level);
+
 /*
  * Sets an external logger to pass all filtered log messages into.
  *
@@ -72,35 +83,82 @@ SAIL_EXPORT void sail_set_log_barrier(enum SailLogLevel max_level);
  */
 SAIL_EXPORT void sail_set_logger(sail_logger logger);
 
+/*
+ * Starts an asynchronous log sink. Log messages are formatted in the calling thread and put
+ * into a ring buffer of the specified capacity. A background thread takes them from the ring
+ * buffer and writes them to stderr or passes them into the external logger. This way,
+ * threads that log never wait for the console or for a slow external logger.
+ *
+ * When the ring buffer is full, new messages are dropped and counted. The number of dropped
+ * messages is reported when the sink is stopped. Messages longer than SAIL_ASYNC_LOG_MESSAGE_SIZE
+ * bytes are truncated. With the async sink, the external logger is called from the background
+ * thread with already formatted messages.
+ *
+ * Returns SAIL_ERROR_NOT_IMPLEMENTED if SAIL is compiled without SAIL_THREAD_SAFE.
+ *
+ * This function is not thread-safe. It's recommended to call it in the main thread
+ * before initializing SAIL. Other threads must not log while it runs.
+ */
+SAIL_EXPORT sail_status_t sail_start_async_logging(unsigned capacity);
+
+/*
+ * Writes all the queued messages, and stops the asynchronous log sink started with
+ * sail_start_async_logging(). Does nothing if the sink is not running. Messages logged
+ * after the sink starts stopping are written synchronously, so none of them is lost.
+ *
+ * This function is not thread-safe. It's recommended to call it in the main thread
+ * after finishing working with SAIL. Other threads must not log while it runs as it destroys
+ * the lock a logging thread could still be about to take.
+ */
+SAIL_EXPORT sail_status_t sail_stop_async_logging(void);
+
+/* Maximum length of a message in the asynchronous log sink, including the terminating zero. */
+#define SAIL_ASYNC_LOG_MESSAGE_SIZE 512
+
+/* Messages less important than SAIL_MIN_LOG_LEVEL are compiled out. */
+#ifndef SAIL_MIN_LOG_LEVEL
+    #define SAIL_MIN_LOG_LEVEL SAIL_LOG_LEVEL_TRACE
+#endif
+
+/*
+ * Logs a message of the specified level. The log level is checked before evaluating the arguments,
+ * so the arguments are not evaluated for filtered out messages. Messages less important than
+ * SAIL_MIN_LOG_LEVEL are eliminated by the compiler.
+ */
+#define SAIL_LOG_WITH_LEVEL(level, ...)                               \
+    (((level) <= SAIL_MIN_LOG_LEVEL && sail_log_level_enabled(level)) \
+        ? sail_log(level, __FILE__, __LINE__, __VA_ARGS__)            \
+        : (void)0)
+
 /*
  * Log an error message.
  */
-#define SAIL_LOG_ERROR(...) sail_log(SAIL_LOG_LEVEL_ERROR, __FILE__, __LINE__, __VA_ARGS__)
+#define SAIL_LOG_ERROR(...) SAIL_LOG_WITH_LEVEL(SAIL_LOG_LEVEL_ERROR, __VA_ARGS__)
 
 /*
  * Log a warning message.
  */
-#define SAIL_LOG_WARNING(...) sail_log(SAIL_LOG_LEVEL_WARNING, __FILE__, __LINE__, __VA_ARGS__)
+#define SAIL_LOG_WARNING(...) SAIL_LOG_WITH_LEVEL(SAIL_LOG_LEVEL_WARNING, __VA_ARGS__)
 
 /*
  * Log an important information message.
  */
-#define SAIL_LOG_INFO(...) sail_log(SAIL_LOG_LEVEL_INFO, __FILE__, __LINE__, __VA_ARGS__)
+#define SAIL_LOG_INFO(...) SAIL_LOG_WITH_LEVEL(SAIL_LOG_LEVEL_INFO, __VA_ARGS__)
 
 /*
  * Log a regular message.
  */
-#define SAIL_LOG_MESSAGE(...) sail_log(SAIL_LOG_LEVEL_MESSAGE, __FILE__, __LINE__, __VA_ARGS__)
+#define SAIL_LOG_MESSAGE(...) SAIL_LOG_WITH_LEVEL(SAIL_LOG_LEVEL_MESSAGE, __VA_ARGS__)
 
 /*
  * Log a debug message.
  */
-#define SAIL_LOG_DEBUG(...) sail_log(SAIL_LOG_LEVEL_DEBUG, __FILE__, __LINE__, __VA_ARGS__)
+#define SAIL_LOG_DEBUG(...) SAIL_LOG_WITH_LEVEL(SAIL_LOG_LEVEL_DEBUG, __VA_ARGS__)
 
 /*
  * Log a verbose trace message which is usually interesting only for developers.
  */
-#define SAIL_LOG_TRACE(...) sail_log(SAIL_LOG_LEVEL_TRACE, __FILE__, __LINE__, __VA_ARGS__)
+#define SAIL_LOG_TRACE(...) SAIL_LOG_WITH_LEVEL(SAIL_LOG_LEVEL_TRACE, __VA_ARGS__)
 
 /* extern "C" */
 #ifdef __cplusplus
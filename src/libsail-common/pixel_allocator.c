@@ -0,0 +1,326 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "sail-common.h"
+
+/*
+ * Private functions.
+ */
+
+/* The smallest size class is 4 KiB. */
+#define MIN_SIZE_CLASS_SHIFT 12
+#define SIZE_CLASSES_PER_POWER_OF_TWO 4
+#define SIZE_CLASSES_COUNT 160
+#define UNPOOLED_SIZE_CLASS ((unsigned)-1)
+
+struct pixel_pool_buffer_header {
+
+    /* Pointer returned by sail_malloc(). */
+    void *raw;
+
+    /* Next cached buffer of the same size class. */
+    struct pixel_pool_buffer_header *next;
+
+    /* Usable size. */
+    size_t size;
+
+    unsigned size_class;
+};
+
+struct sail_pixel_pool {
+
+    /* Allocator with user_data pointing to this pool. */
+    struct sail_pixel_allocator allocator;
+
+    struct pixel_pool_buffer_header *free_lists[SIZE_CLASSES_COUNT];
+
+    size_t cached_bytes;
+    size_t max_cached_bytes;
+
+    /* Buffers allocated and not yet freed. The destroyed pool is released when it reaches 0. */
+    size_t buffers_in_use;
+    bool destroyed;
+
+#ifdef SAIL_THREAD_SAFE
+    sail_mutex_t mutex;
+#endif
+};
+
+static void lock_pixel_pool(struct sail_pixel_pool *pixel_pool) {
+
+#ifdef SAIL_THREAD_SAFE
+    sail_lock_mutex(&pixel_pool->mutex);
+#else
+    (void)pixel_pool;
+#endif
+}
+
+static void unlock_pixel_pool(struct sail_pixel_pool *pixel_pool) {
+
+#ifdef SAIL_THREAD_SAFE
+    sail_unlock_mutex(&pixel_pool->mutex);
+#else
+    (void)pixel_pool;
+#endif
+}
+
+static void release_pixel_pool(struct sail_pixel_pool *pixel_pool) {
+
+#ifdef SAIL_THREAD_SAFE
+    sail_destroy_mutex(&pixel_pool->mutex);
+#endif
+
+    sail_free(pixel_pool);
+}
+
+/*
+ * Sizes in (2^N, 2^(N+1)] are split into four size classes 2^(N-2) bytes apart.
+ * Returns UNPOOLED_SIZE_CLASS for sizes too large to cache.
+ */
+static unsigned size_class_of(size_t size, size_t *class_size) {
+
+    if (size <= ((size_t)1 << MIN_SIZE_CLASS_SHIFT)) {
+        *class_size = (size_t)1 << MIN_SIZE_CLASS_SHIFT;
+        return 0;
+    }
+
+    if (size > SIZE_MAX / 4) {
+        *class_size = size;
+        return UNPOOLED_SIZE_CLASS;
+    }
+
+    unsigned shift = MIN_SIZE_CLASS_SHIFT;
+
+    while (((size_t)1 << (shift + 1)) < size) {
+        shift++;
+    }
+
+    const size_t base = (size_t)1 << shift;
+    const size_t step = base / SIZE_CLASSES_PER_POWER_OF_TWO;
+    const size_t steps = (size - base + step - 1) / step;
+
+    const unsigned size_class = 1 + (shift - MIN_SIZE_CLASS_SHIFT) * SIZE_CLASSES_PER_POWER_OF_TWO + (unsigned)(steps - 1);
+
+    if (size_class >= SIZE_CLASSES_COUNT) {
+        *class_size = size;
+        return UNPOOLED_SIZE_CLASS;
+    }
+
+    *class_size = base + steps * step;
+
+    return size_class;
+}
+
+static sail_status_t alloc_aligned_buffer(size_t size, unsigned size_class, void **pixels) {
+
+    if (size > SIZE_MAX - sizeof(struct pixel_pool_buffer_header) - SAIL_PIXEL_POOL_ALIGNMENT) {
+        SAIL_LOG_ERROR("Failed to allocate %lu bytes of pixels", (unsigned long)size);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_MEMORY_ALLOCATION);
+    }
+
+    void *raw;
+    SAIL_TRY(sail_malloc(size + sizeof(struct pixel_pool_buffer_header) + SAIL_PIXEL_POOL_ALIGNMENT - 1, &raw));
+
+    const uintptr_t aligned = ((uintptr_t)raw + sizeof(struct pixel_pool_buffer_header) + SAIL_PIXEL_POOL_ALIGNMENT - 1)
+                                & ~(uintptr_t)(SAIL_PIXEL_POOL_ALIGNMENT - 1);
+
+    struct pixel_pool_buffer_header *header = (struct pixel_pool_buffer_header *)aligned - 1;
+
+    header->raw        = raw;
+    header->next       = NULL;
+    header->size       = size;
+    header->size_class = size_class;
+
+    *pixels = (void *)aligned;
+
+    return SAIL_OK;
+}
+
+static sail_status_t pixel_pool_alloc(void *user_data, size_t size, void **pixels) {
+
+    struct sail_pixel_pool *pixel_pool = user_data;
+
+    size_t class_size;
+    const unsigned size_class = size_class_of(size, &class_size);
+
+    lock_pixel_pool(pixel_pool);
+
+    if (size_class != UNPOOLED_SIZE_CLASS && pixel_pool->free_lists[size_class] != NULL) {
+        struct pixel_pool_buffer_header *header = pixel_pool->free_lists[size_class];
+
+        pixel_pool->free_lists[size_class] = header->next;
+        pixel_pool->cached_bytes -= header->size;
+        pixel_pool->buffers_in_use++;
+
+        unlock_pixel_pool(pixel_pool);
+
+        *pixels = header + 1;
+        return SAIL_OK;
+    }
+
+    pixel_pool->buffers_in_use++;
+
+    unlock_pixel_pool(pixel_pool);
+
+    SAIL_TRY_OR_CLEANUP(alloc_aligned_buffer(class_size, size_class, pixels),
+                        /* cleanup */ lock_pixel_pool(pixel_pool),
+                                      pixel_pool->buffers_in_use--,
+                                      unlock_pixel_pool(pixel_pool));
+
+    return SAIL_OK;
+}
+
+static void pixel_pool_free(void *user_data, void *pixels) {
+
+    struct sail_pixel_pool *pixel_pool = user_data;
+    struct pixel_pool_buffer_header *header = (struct pixel_pool_buffer_header *)pixels - 1;
+
+    lock_pixel_pool(pixel_pool);
+
+    pixel_pool->buffers_in_use--;
+
+    if (!pixel_pool->destroyed &&
+            header->size_class != UNPOOLED_SIZE_CLASS &&
+            pixel_pool->cached_bytes + header->size <= pixel_pool->max_cached_bytes) {
+        header->next = pixel_pool->free_lists[header->size_class];
+        pixel_pool->free_lists[header->size_class] = header;
+        pixel_pool->cached_bytes += header->size;
+
+        unlock_pixel_pool(pixel_pool);
+        return;
+    }
+
+    const bool release = pixel_pool->destroyed && pixel_pool->buffers_in_use == 0;
+
+    unlock_pixel_pool(pixel_pool);
+
+    sail_free(header->raw);
+
+    if (release) {
+        release_pixel_pool(pixel_pool);
+    }
+}
+
+/*
+ * Public functions.
+ */
+
+sail_status_t sail_alloc_pixels(const struct sail_pixel_allocator *pixel_allocator, size_t size, void **pixels) {
+
+    SAIL_CHECK_PTR(pixels);
+
+    if (pixel_allocator == NULL) {
+        SAIL_TRY(sail_malloc(size, pixels));
+    } else {
+        SAIL_TRY(pixel_allocator->alloc(pixel_allocator->user_data, size, pixels));
+    }
+
+    return SAIL_OK;
+}
+
+void sail_free_pixels(const struct sail_pixel_allocator *pixel_allocator, void *pixels) {
+
+    if (pixels == NULL) {
+        return;
+    }
+
+    if (pixel_allocator == NULL) {
+        sail_free(pixels);
+    } else {
+        pixel_allocator->free(pixel_allocator->user_data, pixels);
+    }
+}
+
+sail_status_t sail_alloc_pixel_pool(size_t max_cached_bytes, struct sail_pixel_pool **pixel_pool) {
+
+    SAIL_CHECK_PTR(pixel_pool);
+
+    void *ptr;
+    SAIL_TRY(sail_malloc(sizeof(struct sail_pixel_pool), &ptr));
+    struct sail_pixel_pool *pixel_pool_local = ptr;
+
+#ifdef SAIL_THREAD_SAFE
+    SAIL_TRY_OR_CLEANUP(sail_init_mutex(&pixel_pool_local->mutex),
+                        /* cleanup */ sail_free(pixel_pool_local));
+#endif
+
+    pixel_pool_local->allocator.alloc     = pixel_pool_alloc;
+    pixel_pool_local->allocator.free      = pixel_pool_free;
+    pixel_pool_local->allocator.user_data = pixel_pool_local;
+
+    for (unsigned i = 0; i < SIZE_CLASSES_COUNT; i++) {
+        pixel_pool_local->free_lists[i] = NULL;
+    }
+
+    pixel_pool_local->cached_bytes     = 0;
+    pixel_pool_local->max_cached_bytes = max_cached_bytes;
+    pixel_pool_local->buffers_in_use   = 0;
+    pixel_pool_local->destroyed        = false;
+
+    *pixel_pool = pixel_pool_local;
+
+    return SAIL_OK;
+}
+
+void sail_destroy_pixel_pool(struct sail_pixel_pool *pixel_pool) {
+
+    if (pixel_pool == NULL) {
+        return;
+    }
+
+    lock_pixel_pool(pixel_pool);
+
+    pixel_pool->destroyed = true;
+
+    for (unsigned i = 0; i < SIZE_CLASSES_COUNT; i++) {
+        for (struct pixel_pool_buffer_header *header = pixel_pool->free_lists[i]; header != NULL;) {
+            struct pixel_pool_buffer_header *next = header->next;
+            sail_free(header->raw);
+            header = next;
+        }
+
+        pixel_pool->free_lists[i] = NULL;
+    }
+
+    pixel_pool->cached_bytes = 0;
+
+    const bool release = pixel_pool->buffers_in_use == 0;
+
+    unlock_pixel_pool(pixel_pool);
+
+    if (release) {
+        release_pixel_pool(pixel_pool);
+    }
+}
+
+const struct sail_pixel_allocator* sail_pixel_pool_allocator(const struct sail_pixel_pool *pixel_pool) {
+
+    return pixel_pool == NULL ? NULL : &pixel_pool->allocator;
+}
@@ -0,0 +1,119 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SAIL_PIXEL_ALLOCATOR_H
+#define SAIL_PIXEL_ALLOCATOR_H
+
+#include <stddef.h>
+
+#ifdef SAIL_BUILD
+    #include "error.h"
+    #include "export.h"
+#else
+    #include <sail-common/error.h>
+    #include <sail-common/export.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Pixel allocator used to allocate and free image pixels. It must outlive all the images
+ * with pixels allocated by it.
+ */
+struct sail_pixel_allocator {
+
+    /*
+     * Allocates a buffer of the specified size for image pixels.
+     *
+     * Returns SAIL_OK on success.
+     */
+    sail_status_t (*alloc)(void *user_data, size_t size, void **pixels);
+
+    /*
+     * Frees the pixels previously allocated with alloc().
+     */
+    void (*free)(void *user_data, void *pixels);
+
+    /* User data passed to the functions above. */
+    void *user_data;
+};
+
+typedef struct sail_pixel_allocator sail_pixel_allocator_t;
+
+/*
+ * Allocates image pixels with the specified pixel allocator or with sail_malloc()
+ * if the pixel allocator is NULL.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_alloc_pixels(const struct sail_pixel_allocator *pixel_allocator, size_t size, void **pixels);
+
+/*
+ * Frees image pixels with the specified pixel allocator or with sail_free()
+ * if the pixel allocator is NULL. Does nothing if the pixels are NULL.
+ */
+SAIL_EXPORT void sail_free_pixels(const struct sail_pixel_allocator *pixel_allocator, void *pixels);
+
+/*
+ * Pixel pool is a built-in pixel allocator. It reuses freed buffers of similar sizes
+ * across frames and images instead of returning them to the system. Buffers are grouped
+ * into size classes four per power of two, so a reused buffer is at most 25% larger than
+ * requested. All the buffers are aligned to SAIL_PIXEL_POOL_ALIGNMENT bytes.
+ *
+ * The pool is thread-safe when SAIL is built with SAIL_THREAD_SAFE.
+ */
+struct sail_pixel_pool;
+
+#define SAIL_PIXEL_POOL_ALIGNMENT 64
+
+/*
+ * Allocates a new pixel pool. The pool keeps at most max_cached_bytes of freed buffers
+ * for reuse. Buffers freed above the limit are returned to the system.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_alloc_pixel_pool(size_t max_cached_bytes, struct sail_pixel_pool **pixel_pool);
+
+/*
+ * Destroys the specified pixel pool and frees the cached buffers. Buffers still used by images
+ * stay valid. The pool memory is released when the last of them is freed. Does nothing
+ * if the pixel pool is NULL.
+ */
+SAIL_EXPORT void sail_destroy_pixel_pool(struct sail_pixel_pool *pixel_pool);
+
+/*
+ * Returns the pixel allocator backed by the specified pixel pool. Set it in load options
+ * to load images into pooled buffers.
+ */
+SAIL_EXPORT const struct sail_pixel_allocator* sail_pixel_pool_allocator(const struct sail_pixel_pool *pixel_pool);
+
+/* extern "C" */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
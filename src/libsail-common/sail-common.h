@@ -51,6 +51,7 @@
     #include "meta_data_node.h"
     #include "palette.h"
     #include "pixel.h"
+    #include "pixel_allocator.h"
     #include "resolution.h"
     #include "save_features.h"
     #include "save_options.h"
@@ -59,6 +60,9 @@
     #include "utils.h"
     #include "variant.h"
     #include "variant_node.h"
+    #ifdef SAIL_THREAD_SAFE
+    #include "threading.h"
+    #endif
 #else
     #include <sail-common/config.h>
 
@@ -80,6 +84,7 @@
     #include <sail-common/meta_data_node.h>
     #include <sail-common/palette.h>
     #include <sail-common/pixel.h>
+    #include <sail-common/pixel_allocator.h>
     #include <sail-common/resolution.h>
     #include <sail-common/save_features.h>
     #include <sail-common/save_options.h>
@@ -0,0 +1,341 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2021 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <errno.h>
+
+#ifndef SAIL_WIN32
+    #include <unistd.h>
+#endif
+
+#include "sail-common.h"
+
+#ifdef SAIL_WIN32
+struct callback_holder
+{
+    void (*callback)(void);
+};
+
+static BOOL CALLBACK OnceHandler(PINIT_ONCE InitOnce, PVOID Parameter, PVOID *lpContext)
+{
+    (void)InitOnce;
+    (void)lpContext;
+
+    const struct callback_holder *callback_holder = (struct callback_holder *)Parameter;
+
+    callback_holder->callback();
+
+    return TRUE;
+}
+#endif
+
+struct thread_holder
+{
+    void (*function)(void *);
+    void *arg;
+};
+
+#ifdef SAIL_WIN32
+static DWORD WINAPI thread_routine(LPVOID parameter)
+#else
+static void* thread_routine(void *parameter)
+#endif
+{
+    struct thread_holder thread_holder = *(struct thread_holder *)parameter;
+    sail_free(parameter);
+
+    thread_holder.function(thread_holder.arg);
+
+#ifdef SAIL_WIN32
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+sail_status_t sail_call_once(sail_once_flag_t *once_flag, void (*callback)(void))
+{
+    SAIL_CHECK_PTR(once_flag);
+
+#ifdef SAIL_WIN32
+    struct callback_holder callback_holder = { callback };
+
+    if (SAIL_LIKELY(InitOnceExecuteOnce(once_flag, OnceHandler, &callback_holder, NULL))) {
+        return SAIL_OK;
+    } else {
+        SAIL_LOG_ERROR("Failed to execute call_once. Error: 0x%X", GetLastError());
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+#else
+    if (SAIL_LIKELY((errno = pthread_once(once_flag, callback)) == 0)) {
+        return SAIL_OK;
+    } else {
+        SAIL_TRY(sail_print_errno("Failed to execute call_once: %s"));
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+#endif
+}
+
+sail_status_t sail_init_mutex(sail_mutex_t *mutex)
+{
+    SAIL_CHECK_PTR(mutex);
+
+#ifdef SAIL_WIN32
+    InitializeCriticalSection(mutex);
+    return SAIL_OK;
+#else
+    pthread_mutexattr_t attr;
+
+    if (SAIL_LIKELY((errno = pthread_mutexattr_init(&attr)) == 0)) {
+        if (SAIL_LIKELY((errno = pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE)) == 0)) {
+            errno = pthread_mutex_init(mutex, &attr);
+            pthread_mutexattr_destroy(&attr);
+
+            if (SAIL_LIKELY(errno == 0)) {
+                return SAIL_OK;
+            } else {
+                SAIL_TRY(sail_print_errno("Failed to initialize mutex: %s"));
+                SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+            }
+        } else {
+            pthread_mutexattr_destroy(&attr);
+            SAIL_TRY(sail_print_errno("Failed to set mutex attributes: %s"));
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+        }
+    } else {
+        SAIL_TRY(sail_print_errno("Failed to initialize mutex attributes: %s"));
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+#endif
+}
+
+sail_status_t sail_lock_mutex(sail_mutex_t *mutex)
+{
+    SAIL_CHECK_PTR(mutex);
+
+#ifdef SAIL_WIN32
+    EnterCriticalSection(mutex);
+    return SAIL_OK;
+#else
+    if (SAIL_LIKELY((errno = pthread_mutex_lock(mutex)) == 0)) {
+        return SAIL_OK;
+    } else {
+        SAIL_TRY(sail_print_errno("Failed to lock mutex: %s"));
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+#endif
+}
+
+sail_status_t sail_unlock_mutex(sail_mutex_t *mutex)
+{
+    SAIL_CHECK_PTR(mutex);
+
+#ifdef SAIL_WIN32
+    LeaveCriticalSection(mutex);
+    return SAIL_OK;
+#else
+    if (SAIL_LIKELY((errno = pthread_mutex_unlock(mutex)) == 0)) {
+        return SAIL_OK;
+    } else {
+        SAIL_TRY(sail_print_errno("Failed to unlock mutex: %s"));
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+#endif
+}
+
+sail_status_t sail_destroy_mutex(sail_mutex_t *mutex)
+{
+    SAIL_CHECK_PTR(mutex);
+
+#ifdef SAIL_WIN32
+    DeleteCriticalSection(mutex);
+    return SAIL_OK;
+#else
+    if (SAIL_LIKELY((errno = pthread_mutex_destroy(mutex)) == 0)) {
+        return SAIL_OK;
+    } else {
+        SAIL_TRY(sail_print_errno("Failed to destroy mutex: %s"));
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+#endif
+}
+
+sail_status_t sail_init_condition(sail_condition_t *condition)
+{
+    SAIL_CHECK_PTR(condition);
+
+#ifdef SAIL_WIN32
+    InitializeConditionVariable(condition);
+    return SAIL_OK;
+#else
+    if (SAIL_LIKELY((errno = pthread_cond_init(condition, NULL)) == 0)) {
+        return SAIL_OK;
+    } else {
+        SAIL_TRY(sail_print_errno("Failed to initialize condition variable: %s"));
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+#endif
+}
+
+sail_status_t sail_wait_condition(sail_condition_t *condition, sail_mutex_t *mutex)
+{
+    SAIL_CHECK_PTR(condition);
+    SAIL_CHECK_PTR(mutex);
+
+#ifdef SAIL_WIN32
+    if (SAIL_LIKELY(SleepConditionVariableCS(condition, mutex, INFINITE))) {
+        return SAIL_OK;
+    } else {
+        SAIL_LOG_ERROR("Failed to wait for condition variable. Error: 0x%X", GetLastError());
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+#else
+    if (SAIL_LIKELY((errno = pthread_cond_wait(condition, mutex)) == 0)) {
+        return SAIL_OK;
+    } else {
+        SAIL_TRY(sail_print_errno("Failed to wait for condition variable: %s"));
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+#endif
+}
+
+sail_status_t sail_signal_condition(sail_condition_t *condition)
+{
+    SAIL_CHECK_PTR(condition);
+
+#ifdef SAIL_WIN32
+    WakeConditionVariable(condition);
+    return SAIL_OK;
+#else
+    if (SAIL_LIKELY((errno = pthread_cond_signal(condition)) == 0)) {
+        return SAIL_OK;
+    } else {
+        SAIL_TRY(sail_print_errno("Failed to signal condition variable: %s"));
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+#endif
+}
+
+sail_status_t sail_broadcast_condition(sail_condition_t *condition)
+{
+    SAIL_CHECK_PTR(condition);
+
+#ifdef SAIL_WIN32
+    WakeAllConditionVariable(condition);
+    return SAIL_OK;
+#else
+    if (SAIL_LIKELY((errno = pthread_cond_broadcast(condition)) == 0)) {
+        return SAIL_OK;
+    } else {
+        SAIL_TRY(sail_print_errno("Failed to broadcast condition variable: %s"));
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+#endif
+}
+
+sail_status_t sail_destroy_condition(sail_condition_t *condition)
+{
+    SAIL_CHECK_PTR(condition);
+
+#ifdef SAIL_WIN32
+    /* Windows condition variables don't need to be destroyed. */
+    return SAIL_OK;
+#else
+    if (SAIL_LIKELY((errno = pthread_cond_destroy(condition)) == 0)) {
+        return SAIL_OK;
+    } else {
+        SAIL_TRY(sail_print_errno("Failed to destroy condition variable: %s"));
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+#endif
+}
+
+sail_status_t sail_create_thread(sail_thread_t *thread, void (*function)(void *), void *arg)
+{
+    SAIL_CHECK_PTR(thread);
+    SAIL_CHECK_PTR(function);
+
+    void *ptr;
+    SAIL_TRY(sail_malloc(sizeof(struct thread_holder), &ptr));
+    struct thread_holder *thread_holder = ptr;
+
+    thread_holder->function = function;
+    thread_holder->arg      = arg;
+
+#ifdef SAIL_WIN32
+    *thread = CreateThread(NULL, 0, thread_routine, thread_holder, 0, NULL);
+
+    if (SAIL_LIKELY(*thread != NULL)) {
+        return SAIL_OK;
+    } else {
+        sail_free(thread_holder);
+        SAIL_LOG_ERROR("Failed to create thread. Error: 0x%X", GetLastError());
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+#else
+    if (SAIL_LIKELY((errno = pthread_create(thread, NULL, thread_routine, thread_holder)) == 0)) {
+        return SAIL_OK;
+    } else {
+        sail_free(thread_holder);
+        SAIL_TRY(sail_print_errno("Failed to create thread: %s"));
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+#endif
+}
+
+sail_status_t sail_join_thread(sail_thread_t *thread)
+{
+    SAIL_CHECK_PTR(thread);
+
+#ifdef SAIL_WIN32
+    if (SAIL_LIKELY(WaitForSingleObject(*thread, INFINITE) == WAIT_OBJECT_0)) {
+        CloseHandle(*thread);
+        return SAIL_OK;
+    } else {
+        SAIL_LOG_ERROR("Failed to join thread. Error: 0x%X", GetLastError());
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+#else
+    if (SAIL_LIKELY((errno = pthread_join(*thread, NULL)) == 0)) {
+        return SAIL_OK;
+    } else {
+        SAIL_TRY(sail_print_errno("Failed to join thread: %s"));
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+#endif
+}
+
+unsigned sail_cpu_count(void)
+{
+#ifdef SAIL_WIN32
+    SYSTEM_INFO system_info;
+    GetSystemInfo(&system_info);
+
+    return system_info.dwNumberOfProcessors > 0 ? (unsigned)system_info.dwNumberOfProcessors : 1;
+#else
+    const long cpu_count = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return cpu_count > 0 ? (unsigned)cpu_count : 1;
+#endif
+}
@@ -0,0 +1,191 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2021 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SAIL_THREADING_H
+#define SAIL_THREADING_H
+
+#include "config.h"
+
+#ifdef SAIL_BUILD
+    #include "error.h"
+    #include "export.h"
+#else
+    #include <sail-common/error.h>
+    #include <sail-common/export.h>
+#endif
+
+#include <stdbool.h>
+
+#ifdef SAIL_WIN32
+    #include <Windows.h>
+#else
+    #include <pthread.h>
+#endif
+
+/*
+ * Threading support.
+ *
+ * Why this file is needed: C11 introduces threading support with mutexes, atomics, threads etc.
+ * However, the most popular C compiler for Windows, MSVC, still supports nothing from it. We need
+ * to implement our own threading support based on OS-specific APIs.
+ *
+ * The functions are exported only to be shared between SAIL libraries and codecs. They are not
+ * a part of the public API: this header is not installed, and no installed header includes it.
+ */
+
+/* Call once. */
+
+#ifdef SAIL_WIN32
+    typedef INIT_ONCE sail_once_flag_t;
+    #define SAIL_ONCE_DEFAULT_VALUE INIT_ONCE_STATIC_INIT
+#else
+    typedef pthread_once_t sail_once_flag_t;
+    #define SAIL_ONCE_DEFAULT_VALUE PTHREAD_ONCE_INIT
+#endif
+
+SAIL_EXPORT sail_status_t sail_call_once(sail_once_flag_t *once_flag, void (*callback)(void));
+
+/* Mutexes. */
+
+#ifdef SAIL_WIN32
+    typedef CRITICAL_SECTION sail_mutex_t;
+#else
+    typedef pthread_mutex_t sail_mutex_t;
+#endif
+
+SAIL_EXPORT sail_status_t sail_init_mutex(sail_mutex_t *mutex);
+
+SAIL_EXPORT sail_status_t sail_lock_mutex(sail_mutex_t *mutex);
+
+SAIL_EXPORT sail_status_t sail_unlock_mutex(sail_mutex_t *mutex);
+
+SAIL_EXPORT sail_status_t sail_destroy_mutex(sail_mutex_t *mutex);
+
+/* Condition variables. */
+
+#ifdef SAIL_WIN32
+    typedef CONDITION_VARIABLE sail_condition_t;
+#else
+    typedef pthread_cond_t sail_condition_t;
+#endif
+
+SAIL_EXPORT sail_status_t sail_init_condition(sail_condition_t *condition);
+
+/*
+ * Atomically unlocks the mutex and waits for the condition. The mutex MUST be locked exactly once
+ * by the calling thread. The mutex is locked again when the function returns. Spurious wakeups
+ * are possible, so always check the guarded predicate in a loop.
+ */
+SAIL_EXPORT sail_status_t sail_wait_condition(sail_condition_t *condition, sail_mutex_t *mutex);
+
+SAIL_EXPORT sail_status_t sail_signal_condition(sail_condition_t *condition);
+
+SAIL_EXPORT sail_status_t sail_broadcast_condition(sail_condition_t *condition);
+
+SAIL_EXPORT sail_status_t sail_destroy_condition(sail_condition_t *condition);
+
+/* Threads. */
+
+#ifdef SAIL_WIN32
+    typedef HANDLE sail_thread_t;
+#else
+    typedef pthread_t sail_thread_t;
+#endif
+
+/*
+ * Starts a new thread executing the specified function with the specified argument.
+ */
+SAIL_EXPORT sail_status_t sail_create_thread(sail_thread_t *thread, void (*function)(void *), void *arg);
+
+/*
+ * Waits for the thread to finish and releases its resources.
+ */
+SAIL_EXPORT sail_status_t sail_join_thread(sail_thread_t *thread);
+
+/*
+ * Returns the number of logical CPUs available to the process. Never returns zero.
+ */
+SAIL_EXPORT unsigned sail_cpu_count(void);
+
+/*
+ * Atomic pointers. Loads have acquire semantics, stores have release semantics,
+ * and compare-and-swap is a full barrier.
+ */
+
+static inline void* sail_atomic_load_pointer(void **ptr) {
+
+#ifdef SAIL_WIN32
+    return InterlockedCompareExchangePointer(ptr, NULL, NULL);
+#else
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static inline void sail_atomic_store_pointer(void **ptr, void *value) {
+
+#ifdef SAIL_WIN32
+    InterlockedExchangePointer(ptr, value);
+#else
+    __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+#endif
+}
+
+/*
+ * Stores the desired value if *ptr equals the expected value. Returns the value
+ * of *ptr before the operation, so the swap succeeded if it equals the expected value.
+ */
+static inline void* sail_atomic_compare_exchange_pointer(void **ptr, void *expected, void *desired) {
+
+#ifdef SAIL_WIN32
+    return InterlockedCompareExchangePointer(ptr, desired, expected);
+#else
+    __atomic_compare_exchange_n(ptr, &expected, desired, /* weak */ false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+    return expected;
+#endif
+}
+
+/*
+ * Atomic integers with the same memory ordering as the atomic pointers above.
+ */
+
+static inline long sail_atomic_load_long(long *ptr) {
+
+#ifdef SAIL_WIN32
+    return InterlockedCompareExchange(ptr, 0, 0);
+#else
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static inline void sail_atomic_store_long(long *ptr, long value) {
+
+#ifdef SAIL_WIN32
+    InterlockedExchange(ptr, value);
+#else
+    __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+#endif
+}
+
+#endif
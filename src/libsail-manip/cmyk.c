@@ -25,6 +25,24 @@
 
 #include "sail-manip.h"
 
+#include "color_simd.h"
+
+/*
+ * Private functions.
+ */
+
+/* Returns a * b / 255 rounded to the nearest integer. Exact for all 8-bit values. */
+static inline uint8_t multiply_div255(unsigned a, unsigned b) {
+
+    const unsigned product = a * b + 128;
+
+    return (uint8_t)((product + (product >> 8)) >> 8);
+}
+
+/*
+ * Public functions.
+ */
+
 void convert_cmyk32_to_rgba32(uint8_t c, uint8_t m, uint8_t y, uint8_t k, sail_rgba32_t *rgba32) {
 
 #if 0
@@ -37,9 +55,27 @@ void convert_cmyk32_to_rgba32(uint8_t c, uint8_t m, uint8_t y, uint8_t k, sail_r
     *g = (uint8_t)((1-M) * (1-K) * 255);
     *b = (uint8_t)((1-Y) * (1-K) * 255);
 #else
-    rgba32->component1 = (uint8_t)((double)c * k / 255.0 + 0.5);
-    rgba32->component2 = (uint8_t)((double)m * k / 255.0 + 0.5);
-    rgba32->component3 = (uint8_t)((double)y * k / 255.0 + 0.5);
+    /* Same as (uint8_t)(c * k / 255.0 + 0.5) in integers. */
+    rgba32->component1 = multiply_div255(c, k);
+    rgba32->component2 = multiply_div255(m, k);
+    rgba32->component3 = multiply_div255(y, k);
     rgba32->component4 = 255;
 #endif
 }
+
+void convert_cmyk32_to_rgba32_row(const uint8_t *scan_input, sail_rgba32_t *rgba32, unsigned width) {
+
+    unsigned column = 0;
+
+#if defined SAIL_HAVE_X86_SIMD
+    if (cpu_supports_ssse3()) {
+        column = convert_cmyk32_to_rgba32_row_ssse3(scan_input, rgba32, width);
+    }
+#elif defined SAIL_HAVE_NEON
+    column = convert_cmyk32_to_rgba32_row_neon(scan_input, rgba32, width);
+#endif
+
+    for (scan_input += column * 4; column < width; column++, scan_input += 4) {
+        convert_cmyk32_to_rgba32(*(scan_input+0), *(scan_input+1), *(scan_input+2), *(scan_input+3), rgba32 + column);
+    }
+}
@@ -41,4 +41,10 @@
  */
 SAIL_HIDDEN void convert_cmyk32_to_rgba32(uint8_t c, uint8_t m, uint8_t y, uint8_t k, sail_rgba32_t *rgba32);
 
+/*
+ * Converts a whole scan line. Uses SIMD instructions when available. The results are identical
+ * to convert_cmyk32_to_rgba32().
+ */
+SAIL_HIDDEN void convert_cmyk32_to_rgba32_row(const uint8_t *scan_input, sail_rgba32_t *rgba32, unsigned width);
+
 #endif
@@ -0,0 +1,375 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stdint.h>
+
+#include "sail-common.h"
+
+#include "color_simd.h"
+#include "ycbcr.h"
+
+#if defined SAIL_HAVE_X86_SIMD
+    #include <immintrin.h>
+#elif defined SAIL_HAVE_NEON
+    #include <arm_neon.h>
+#endif
+
+#ifdef SAIL_HAVE_X86_SIMD
+
+/* Zeroes the destination byte in _mm_shuffle_epi8(). */
+#define Z -1
+
+/* Returns a vector of 16-bit pairs (a, b) to multiply interleaved 16-bit values with _mm_madd_epi16(). */
+__attribute__((target("ssse3")))
+static inline __m128i set_pairs_epi16(int16_t a, int16_t b) {
+
+    return _mm_set1_epi32((int32_t)(((uint32_t)(uint16_t)b << 16) | (uint16_t)a));
+}
+
+/* Returns (value + 128 + ((value + 128) >> 8)) >> 8 that is value / 255 rounded for products of 8-bit values. */
+__attribute__((target("ssse3")))
+static inline __m128i div255_epu16(__m128i value) {
+
+    value = _mm_add_epi16(value, _mm_set1_epi16(128));
+
+    return _mm_srli_epi16(_mm_add_epi16(value, _mm_srli_epi16(value, 8)), 8);
+}
+
+/* Rounds Q14 fixed-point values and packs them into 16-bit signed values with saturation. */
+__attribute__((target("ssse3")))
+static inline __m128i descale_epi32(__m128i lo, __m128i hi) {
+
+    const __m128i half = _mm_set1_epi32(YCBCR_FIXED_HALF);
+
+    lo = _mm_srai_epi32(_mm_add_epi32(lo, half), YCBCR_FIXED_BITS);
+    hi = _mm_srai_epi32(_mm_add_epi32(hi, half), YCBCR_FIXED_BITS);
+
+    return _mm_packs_epi32(lo, hi);
+}
+
+__attribute__((target("ssse3")))
+unsigned convert_ycbcr24_to_rgba32_row_ssse3(const uint8_t *scan_input, sail_rgba32_t *rgba32, unsigned width) {
+
+    /* Gather 8 pixels from 16 + 8 bytes into 16-bit lanes. */
+    const __m128i y_mask0  = _mm_setr_epi8(0, Z, 3, Z, 6, Z, 9, Z, 12, Z, 15, Z, Z, Z, Z, Z);
+    const __m128i y_mask1  = _mm_setr_epi8(Z, Z, Z, Z, Z, Z, Z, Z, Z,  Z, Z,  Z, 2, Z, 5, Z);
+    const __m128i cb_mask0 = _mm_setr_epi8(1, Z, 4, Z, 7, Z, 10, Z, 13, Z, Z, Z, Z, Z, Z, Z);
+    const __m128i cb_mask1 = _mm_setr_epi8(Z, Z, Z, Z, Z, Z, Z,  Z, Z,  Z, 0, Z, 3, Z, 6, Z);
+    const __m128i cr_mask0 = _mm_setr_epi8(2, Z, 5, Z, 8, Z, 11, Z, 14, Z, Z, Z, Z, Z, Z, Z);
+    const __m128i cr_mask1 = _mm_setr_epi8(Z, Z, Z, Z, Z, Z, Z,  Z, Z,  Z, 1, Z, 4, Z, 7, Z);
+
+    const __m128i zero   = _mm_setzero_si128();
+    const __m128i center = _mm_set1_epi16(128);
+    const __m128i alpha  = _mm_set1_epi16(255);
+
+    const __m128i cr_r = set_pairs_epi16(0, YCBCR_CR_R);
+    const __m128i cb_g = set_pairs_epi16(YCBCR_CB_G, YCBCR_CR_G);
+    const __m128i cb_b = set_pairs_epi16(YCBCR_CB_B, 0);
+
+    uint8_t *output = (uint8_t *)rgba32;
+    unsigned column = 0;
+
+    for (; width - column >= 8; column += 8, scan_input += 24, output += 32) {
+        const __m128i input0 = _mm_loadu_si128((const __m128i *)scan_input);
+        const __m128i input1 = _mm_loadl_epi64((const __m128i *)(scan_input + 16));
+
+        const __m128i y  = _mm_or_si128(_mm_shuffle_epi8(input0, y_mask0), _mm_shuffle_epi8(input1, y_mask1));
+        const __m128i cb = _mm_sub_epi16(_mm_or_si128(_mm_shuffle_epi8(input0, cb_mask0), _mm_shuffle_epi8(input1, cb_mask1)), center);
+        const __m128i cr = _mm_sub_epi16(_mm_or_si128(_mm_shuffle_epi8(input0, cr_mask0), _mm_shuffle_epi8(input1, cr_mask1)), center);
+
+        const __m128i y_lo = _mm_slli_epi32(_mm_unpacklo_epi16(y, zero), YCBCR_FIXED_BITS);
+        const __m128i y_hi = _mm_slli_epi32(_mm_unpackhi_epi16(y, zero), YCBCR_FIXED_BITS);
+
+        const __m128i cbcr_lo = _mm_unpacklo_epi16(cb, cr);
+        const __m128i cbcr_hi = _mm_unpackhi_epi16(cb, cr);
+
+        const __m128i r = descale_epi32(_mm_add_epi32(y_lo, _mm_madd_epi16(cbcr_lo, cr_r)), _mm_add_epi32(y_hi, _mm_madd_epi16(cbcr_hi, cr_r)));
+        const __m128i g = descale_epi32(_mm_add_epi32(y_lo, _mm_madd_epi16(cbcr_lo, cb_g)), _mm_add_epi32(y_hi, _mm_madd_epi16(cbcr_hi, cb_g)));
+        const __m128i b = descale_epi32(_mm_add_epi32(y_lo, _mm_madd_epi16(cbcr_lo, cb_b)), _mm_add_epi32(y_hi, _mm_madd_epi16(cbcr_hi, cb_b)));
+
+        /* R0..R7 G0..G7 and B0..B7 A0..A7 clamped to [0, 255]. */
+        const __m128i rg = _mm_packus_epi16(r, g);
+        const __m128i ba = _mm_packus_epi16(b, alpha);
+
+        const __m128i rg_interleaved = _mm_unpacklo_epi8(rg, _mm_srli_si128(rg, 8));
+        const __m128i ba_interleaved = _mm_unpacklo_epi8(ba, _mm_srli_si128(ba, 8));
+
+        _mm_storeu_si128((__m128i *)output,        _mm_unpacklo_epi16(rg_interleaved, ba_interleaved));
+        _mm_storeu_si128((__m128i *)(output + 16), _mm_unpackhi_epi16(rg_interleaved, ba_interleaved));
+    }
+
+    return column;
+}
+
+__attribute__((target("ssse3")))
+unsigned convert_rgba32_to_ycbcr24_row_ssse3(const sail_rgba32_t *rgba32, uint8_t *scan_output, unsigned width) {
+
+    /* Interleaved 16-bit (R, G) and (B, 128) pairs of 4 pixels. */
+    const __m128i rg_mask = _mm_setr_epi8(0, Z, 1, Z, 4, Z, 5, Z, 8, Z, 9, Z, 12, Z, 13, Z);
+    const __m128i b_mask  = _mm_setr_epi8(2, Z, Z, Z, 6, Z, Z, Z, 10, Z, Z, Z, 14, Z, Z, Z);
+    const __m128i center  = _mm_set1_epi32(128 << 16);
+
+    const __m128i rg_y  = set_pairs_epi16(YCBCR_R_Y,  YCBCR_G_Y);
+    const __m128i b_y   = set_pairs_epi16(YCBCR_B_Y,  0);
+    const __m128i rg_cb = set_pairs_epi16(YCBCR_R_CB, YCBCR_G_CB);
+    const __m128i b_cb  = set_pairs_epi16(YCBCR_B_CB, 1 << YCBCR_FIXED_BITS);
+    const __m128i rg_cr = set_pairs_epi16(YCBCR_R_CR, YCBCR_G_CR);
+    const __m128i b_cr  = set_pairs_epi16(YCBCR_B_CR, 1 << YCBCR_FIXED_BITS);
+
+    /* Interleave Y0..Y7 Cb0..Cb7 and Cr0..Cr7 into 24 bytes. */
+    const __m128i ycb_mask0 = _mm_setr_epi8(0, 8, Z, 1, 9, Z, 2, 10, Z, 3, 11, Z, 4, 12, Z, 5);
+    const __m128i cr_mask0  = _mm_setr_epi8(Z, Z, 0, Z, Z, 1, Z, Z,  2, Z, Z,  3, Z, Z,  4, Z);
+    const __m128i ycb_mask1 = _mm_setr_epi8(13, Z, 6, 14, Z, 7, 15, Z, Z, Z, Z, Z, Z, Z, Z, Z);
+    const __m128i cr_mask1  = _mm_setr_epi8(Z,  5, Z, Z,  6, Z, Z,  7, Z, Z, Z, Z, Z, Z, Z, Z);
+
+    const uint8_t *input = (const uint8_t *)rgba32;
+    unsigned column = 0;
+
+    for (; width - column >= 8; column += 8, input += 32, scan_output += 24) {
+        const __m128i input0 = _mm_loadu_si128((const __m128i *)input);
+        const __m128i input1 = _mm_loadu_si128((const __m128i *)(input + 16));
+
+        const __m128i rg0 = _mm_shuffle_epi8(input0, rg_mask);
+        const __m128i rg1 = _mm_shuffle_epi8(input1, rg_mask);
+        const __m128i b0  = _mm_or_si128(_mm_shuffle_epi8(input0, b_mask), center);
+        const __m128i b1  = _mm_or_si128(_mm_shuffle_epi8(input1, b_mask), center);
+
+        const __m128i y  = descale_epi32(_mm_add_epi32(_mm_madd_epi16(rg0, rg_y),  _mm_madd_epi16(b0, b_y)),
+                                         _mm_add_epi32(_mm_madd_epi16(rg1, rg_y),  _mm_madd_epi16(b1, b_y)));
+        const __m128i cb = descale_epi32(_mm_add_epi32(_mm_madd_epi16(rg0, rg_cb), _mm_madd_epi16(b0, b_cb)),
+                                         _mm_add_epi32(_mm_madd_epi16(rg1, rg_cb), _mm_madd_epi16(b1, b_cb)));
+        const __m128i cr = descale_epi32(_mm_add_epi32(_mm_madd_epi16(rg0, rg_cr), _mm_madd_epi16(b0, b_cr)),
+                                         _mm_add_epi32(_mm_madd_epi16(rg1, rg_cr), _mm_madd_epi16(b1, b_cr)));
+
+        /* Y0..Y7 Cb0..Cb7 and Cr0..Cr7 clamped to [0, 255]. */
+        const __m128i ycb = _mm_packus_epi16(y, cb);
+        const __m128i crr = _mm_packus_epi16(cr, cr);
+
+        _mm_storeu_si128((__m128i *)scan_output,        _mm_or_si128(_mm_shuffle_epi8(ycb, ycb_mask0), _mm_shuffle_epi8(crr, cr_mask0)));
+        _mm_storel_epi64((__m128i *)(scan_output + 16), _mm_or_si128(_mm_shuffle_epi8(ycb, ycb_mask1), _mm_shuffle_epi8(crr, cr_mask1)));
+    }
+
+    return column;
+}
+
+__attribute__((target("ssse3")))
+unsigned convert_cmyk32_to_rgba32_row_ssse3(const uint8_t *scan_input, sail_rgba32_t *rgba32, unsigned width) {
+
+    /* K of 2 pixels broadcasted to 16-bit lanes. */
+    const __m128i k_mask_lo = _mm_setr_epi8(3,  Z, 3,  Z, 3,  Z, 3,  Z, 7,  Z, 7,  Z, 7,  Z, 7,  Z);
+    const __m128i k_mask_hi = _mm_setr_epi8(11, Z, 11, Z, 11, Z, 11, Z, 15, Z, 15, Z, 15, Z, 15, Z);
+
+    const __m128i zero  = _mm_setzero_si128();
+    const __m128i alpha = _mm_set1_epi32((int32_t)0xFF000000);
+
+    uint8_t *output = (uint8_t *)rgba32;
+    unsigned column = 0;
+
+    for (; width - column >= 4; column += 4, scan_input += 16, output += 16) {
+        const __m128i input = _mm_loadu_si128((const __m128i *)scan_input);
+
+        const __m128i lo = div255_epu16(_mm_mullo_epi16(_mm_unpacklo_epi8(input, zero), _mm_shuffle_epi8(input, k_mask_lo)));
+        const __m128i hi = div255_epu16(_mm_mullo_epi16(_mm_unpackhi_epi8(input, zero), _mm_shuffle_epi8(input, k_mask_hi)));
+
+        _mm_storeu_si128((__m128i *)output, _mm_or_si128(_mm_packus_epi16(lo, hi), alpha));
+    }
+
+    return column;
+}
+
+__attribute__((target("ssse3")))
+unsigned convert_ycck32_to_rgba32_row_ssse3(const uint8_t *scan_input, sail_rgba32_t *rgba32, unsigned width) {
+
+    const __m128i cbcr_mask = _mm_setr_epi8(1, Z, 2, Z, 5, Z, 6, Z, 9, Z, 10, Z, 13, Z, 14, Z);
+    const __m128i y_mask    = _mm_setr_epi8(0, Z, Z, Z, 4, Z, Z, Z, 8, Z, Z,  Z, 12, Z, Z,  Z);
+    const __m128i k_mask    = _mm_setr_epi8(3, Z, 7, Z, 11, Z, 15, Z, 3, Z, 7, Z, 11, Z, 15, Z);
+    const __m128i rgba_mask = _mm_setr_epi8(0, 4, 8, Z, 1, 5, 9, Z, 2, 6, 10, Z, 3, 7, 11, Z);
+
+    const __m128i zero   = _mm_setzero_si128();
+    const __m128i max    = _mm_set1_epi16(255);
+    const __m128i center = _mm_set1_epi16(128);
+    const __m128i alpha  = _mm_set1_epi32((int32_t)0xFF000000);
+
+    const __m128i cr_r = set_pairs_epi16(0, YCBCR_CR_R);
+    const __m128i cb_g = set_pairs_epi16(YCBCR_CB_G, YCBCR_CR_G);
+    const __m128i cb_b = set_pairs_epi16(YCBCR_CB_B, 0);
+
+    uint8_t *output = (uint8_t *)rgba32;
+    unsigned column = 0;
+
+    for (; width - column >= 4; column += 4, scan_input += 16, output += 16) {
+        const __m128i input = _mm_loadu_si128((const __m128i *)scan_input);
+
+        const __m128i cbcr = _mm_sub_epi16(_mm_shuffle_epi8(input, cbcr_mask), center);
+        const __m128i y    = _mm_slli_epi32(_mm_shuffle_epi8(input, y_mask), YCBCR_FIXED_BITS);
+        const __m128i k    = _mm_shuffle_epi8(input, k_mask);
+
+        /* R0..R3 G0..G3 and B0..B3 B0..B3. */
+        __m128i rg = descale_epi32(_mm_add_epi32(y, _mm_madd_epi16(cbcr, cr_r)), _mm_add_epi32(y, _mm_madd_epi16(cbcr, cb_g)));
+        __m128i bb = descale_epi32(_mm_add_epi32(y, _mm_madd_epi16(cbcr, cb_b)), _mm_add_epi32(y, _mm_madd_epi16(cbcr, cb_b)));
+
+        /* Clamp, invert, and apply K like convert_cmyk32_to_rgba32(). */
+        rg = _mm_sub_epi16(max, _mm_min_epi16(_mm_max_epi16(rg, zero), max));
+        bb = _mm_sub_epi16(max, _mm_min_epi16(_mm_max_epi16(bb, zero), max));
+
+        rg = div255_epu16(_mm_mullo_epi16(rg, k));
+        bb = div255_epu16(_mm_mullo_epi16(bb, k));
+
+        _mm_storeu_si128((__m128i *)output, _mm_or_si128(_mm_shuffle_epi8(_mm_packus_epi16(rg, bb), rgba_mask), alpha));
+    }
+
+    return column;
+}
+
+#undef Z
+
+#endif
+
+#ifdef SAIL_HAVE_NEON
+
+/* Rounds Q14 fixed-point values and narrows them to 8-bit unsigned values with saturation. */
+static inline uint8x8_t descale_neon(int32x4_t lo, int32x4_t hi) {
+
+    return vqmovun_s16(vcombine_s16(vrshrn_n_s32(lo, YCBCR_FIXED_BITS), vrshrn_n_s32(hi, YCBCR_FIXED_BITS)));
+}
+
+/* Returns value / 255 rounded for products of 8-bit values. */
+static inline uint8x8_t div255_neon(uint16x8_t value) {
+
+    value = vaddq_u16(value, vdupq_n_u16(128));
+
+    return vshrn_n_u16(vsraq_n_u16(value, value, 8), 8);
+}
+
+static inline void ycbcr_to_rgb_neon(uint8x8_t y8, uint8x8_t cb8, uint8x8_t cr8, uint8x8_t *r, uint8x8_t *g, uint8x8_t *b) {
+
+    const int16x8_t y  = vreinterpretq_s16_u16(vmovl_u8(y8));
+    const int16x8_t cb = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(cb8)), vdupq_n_s16(128));
+    const int16x8_t cr = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(cr8)), vdupq_n_s16(128));
+
+    const int32x4_t y_lo = vshll_n_s16(vget_low_s16(y),  YCBCR_FIXED_BITS);
+    const int32x4_t y_hi = vshll_n_s16(vget_high_s16(y), YCBCR_FIXED_BITS);
+
+    *r = descale_neon(vmlal_n_s16(y_lo, vget_low_s16(cr), YCBCR_CR_R),
+                      vmlal_n_s16(y_hi, vget_high_s16(cr), YCBCR_CR_R));
+    *g = descale_neon(vmlal_n_s16(vmlal_n_s16(y_lo, vget_low_s16(cb), YCBCR_CB_G), vget_low_s16(cr), YCBCR_CR_G),
+                      vmlal_n_s16(vmlal_n_s16(y_hi, vget_high_s16(cb), YCBCR_CB_G), vget_high_s16(cr), YCBCR_CR_G));
+    *b = descale_neon(vmlal_n_s16(y_lo, vget_low_s16(cb), YCBCR_CB_B),
+                      vmlal_n_s16(y_hi, vget_high_s16(cb), YCBCR_CB_B));
+}
+
+unsigned convert_ycbcr24_to_rgba32_row_neon(const uint8_t *scan_input, sail_rgba32_t *rgba32, unsigned width) {
+
+    uint8_t *output = (uint8_t *)rgba32;
+    unsigned column = 0;
+
+    for (; width - column >= 8; column += 8, scan_input += 24, output += 32) {
+        const uint8x8x3_t ycbcr = vld3_u8(scan_input);
+        uint8x8x4_t rgba;
+
+        ycbcr_to_rgb_neon(ycbcr.val[0], ycbcr.val[1], ycbcr.val[2], &rgba.val[0], &rgba.val[1], &rgba.val[2]);
+        rgba.val[3] = vdup_n_u8(255);
+
+        vst4_u8(output, rgba);
+    }
+
+    return column;
+}
+
+unsigned convert_rgba32_to_ycbcr24_row_neon(const sail_rgba32_t *rgba32, uint8_t *scan_output, unsigned width) {
+
+    const uint8_t *input = (const uint8_t *)rgba32;
+    const int32x4_t center = vdupq_n_s32(128 << YCBCR_FIXED_BITS);
+    unsigned column = 0;
+
+    for (; width - column >= 8; column += 8, input += 32, scan_output += 24) {
+        const uint8x8x4_t rgba = vld4_u8(input);
+
+        const int16x8_t r = vreinterpretq_s16_u16(vmovl_u8(rgba.val[0]));
+        const int16x8_t g = vreinterpretq_s16_u16(vmovl_u8(rgba.val[1]));
+        const int16x8_t b = vreinterpretq_s16_u16(vmovl_u8(rgba.val[2]));
+
+        uint8x8x3_t ycbcr;
+
+        ycbcr.val[0] = descale_neon(
+            vmlal_n_s16(vmlal_n_s16(vmull_n_s16(vget_low_s16(r), YCBCR_R_Y), vget_low_s16(g), YCBCR_G_Y), vget_low_s16(b), YCBCR_B_Y),
+            vmlal_n_s16(vmlal_n_s16(vmull_n_s16(vget_high_s16(r), YCBCR_R_Y), vget_high_s16(g), YCBCR_G_Y), vget_high_s16(b), YCBCR_B_Y));
+        ycbcr.val[1] = descale_neon(
+            vmlal_n_s16(vmlal_n_s16(vmlal_n_s16(center, vget_low_s16(r), YCBCR_R_CB), vget_low_s16(g), YCBCR_G_CB), vget_low_s16(b), YCBCR_B_CB),
+            vmlal_n_s16(vmlal_n_s16(vmlal_n_s16(center, vget_high_s16(r), YCBCR_R_CB), vget_high_s16(g), YCBCR_G_CB), vget_high_s16(b), YCBCR_B_CB));
+        ycbcr.val[2] = descale_neon(
+            vmlal_n_s16(vmlal_n_s16(vmlal_n_s16(center, vget_low_s16(r), YCBCR_R_CR), vget_low_s16(g), YCBCR_G_CR), vget_low_s16(b), YCBCR_B_CR),
+            vmlal_n_s16(vmlal_n_s16(vmlal_n_s16(center, vget_high_s16(r), YCBCR_R_CR), vget_high_s16(g), YCBCR_G_CR), vget_high_s16(b), YCBCR_B_CR));
+
+        vst3_u8(scan_output, ycbcr);
+    }
+
+    return column;
+}
+
+unsigned convert_cmyk32_to_rgba32_row_neon(const uint8_t *scan_input, sail_rgba32_t *rgba32, unsigned width) {
+
+    uint8_t *output = (uint8_t *)rgba32;
+    unsigned column = 0;
+
+    for (; width - column >= 8; column += 8, scan_input += 32, output += 32) {
+        const uint8x8x4_t cmyk = vld4_u8(scan_input);
+        uint8x8x4_t rgba;
+
+        rgba.val[0] = div255_neon(vmull_u8(cmyk.val[0], cmyk.val[3]));
+        rgba.val[1] = div255_neon(vmull_u8(cmyk.val[1], cmyk.val[3]));
+        rgba.val[2] = div255_neon(vmull_u8(cmyk.val[2], cmyk.val[3]));
+        rgba.val[3] = vdup_n_u8(255);
+
+        vst4_u8(output, rgba);
+    }
+
+    return column;
+}
+
+unsigned convert_ycck32_to_rgba32_row_neon(const uint8_t *scan_input, sail_rgba32_t *rgba32, unsigned width) {
+
+    uint8_t *output = (uint8_t *)rgba32;
+    unsigned column = 0;
+
+    for (; width - column >= 8; column += 8, scan_input += 32, output += 32) {
+        const uint8x8x4_t ycck = vld4_u8(scan_input);
+        uint8x8x4_t rgba;
+
+        ycbcr_to_rgb_neon(ycck.val[0], ycck.val[1], ycck.val[2], &rgba.val[0], &rgba.val[1], &rgba.val[2]);
+
+        /* Invert and apply K like convert_cmyk32_to_rgba32(). */
+        rgba.val[0] = div255_neon(vmull_u8(vmvn_u8(rgba.val[0]), ycck.val[3]));
+        rgba.val[1] = div255_neon(vmull_u8(vmvn_u8(rgba.val[1]), ycck.val[3]));
+        rgba.val[2] = div255_neon(vmull_u8(vmvn_u8(rgba.val[2]), ycck.val[3]));
+        rgba.val[3] = vdup_n_u8(255);
+
+        vst4_u8(output, rgba);
+    }
+
+    return column;
+}
+
+#endif
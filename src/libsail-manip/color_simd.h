@@ -0,0 +1,66 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SAIL_COLOR_SIMD_H
+#define SAIL_COLOR_SIMD_H
+
+#include <stdint.h>
+
+#ifdef SAIL_BUILD
+    #include "export.h"
+    #include "pixel.h"
+#else
+    #include <sail-common/export.h>
+    #include <sail-common/pixel.h>
+#endif
+
+#include "row_kernels_simd.h"
+
+/*
+ * SIMD YCbCr, CMYK, and YCCK converters. They convert as many leading pixels of the scan line
+ * as possible and return their number. The caller converts the remaining pixels with the scalar
+ * per-pixel functions that use the same fixed-point arithmetic.
+ */
+#ifdef SAIL_HAVE_X86_SIMD
+SAIL_HIDDEN unsigned convert_ycbcr24_to_rgba32_row_ssse3(const uint8_t *scan_input, sail_rgba32_t *rgba32, unsigned width);
+
+SAIL_HIDDEN unsigned convert_rgba32_to_ycbcr24_row_ssse3(const sail_rgba32_t *rgba32, uint8_t *scan_output, unsigned width);
+
+SAIL_HIDDEN unsigned convert_cmyk32_to_rgba32_row_ssse3(const uint8_t *scan_input, sail_rgba32_t *rgba32, unsigned width);
+
+SAIL_HIDDEN unsigned convert_ycck32_to_rgba32_row_ssse3(const uint8_t *scan_input, sail_rgba32_t *rgba32, unsigned width);
+#endif
+
+#ifdef SAIL_HAVE_NEON
+SAIL_HIDDEN unsigned convert_ycbcr24_to_rgba32_row_neon(const uint8_t *scan_input, sail_rgba32_t *rgba32, unsigned width);
+
+SAIL_HIDDEN unsigned convert_rgba32_to_ycbcr24_row_neon(const sail_rgba32_t *rgba32, uint8_t *scan_output, unsigned width);
+
+SAIL_HIDDEN unsigned convert_cmyk32_to_rgba32_row_neon(const uint8_t *scan_input, sail_rgba32_t *rgba32, unsigned width);
+
+SAIL_HIDDEN unsigned convert_ycck32_to_rgba32_row_neon(const uint8_t *scan_input, sail_rgba32_t *rgba32, unsigned width);
+#endif
+
+#endif
@@ -65,6 +65,12 @@ struct sail_conversion_options {
      * when options has SAIL_CONVERSION_OPTION_BLEND_ALPHA.
      */
     sail_rgb24_t background24;
+
+    /*
+     * Maximum number of threads including the calling thread to convert the image with
+     * when options has SAIL_CONVERSION_OPTION_PARALLEL. If zero, the number of CPUs is assumed.
+     */
+    unsigned threads;
 };
 
 typedef struct sail_conversion_options sail_conversion_options_t;
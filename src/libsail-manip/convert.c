@@ -28,6 +28,7 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "sail-common.h"
 
@@ -39,6 +40,8 @@
 
 struct output_context {
     struct sail_image *image;
+    /* The output image pixel format. Updated images get it only after the conversion. */
+    enum SailPixelFormat pixel_format;
     int r;
     int g;
     int b;
@@ -482,63 +485,130 @@ static sail_status_t convert_from_bpp64_rgba_kind(const struct sail_image *image
     return SAIL_OK;
 }
 
-static sail_status_t convert_from_bpp32_cmyk(const struct sail_image *image, pixel_consumer_t pixel_consumer, const struct output_context *output_context) {
+typedef void (*rgba32_row_converter_t)(const uint8_t *scan_input, sail_rgba32_t *rgba32, unsigned width);
 
-    sail_rgba32_t rgba32;
+/*
+ * Converts every scan line into RGBA32 with the specified row converter, and then into the output
+ * pixel format with a row kernel if any or with the pixel consumer.
+ */
+static sail_status_t convert_via_rgba32_rows(const struct sail_image *image, rgba32_row_converter_t row_converter,
+                                                pixel_consumer_t pixel_consumer, const struct output_context *output_context) {
+
+    struct sail_image *image_output = output_context->image;
+
+    /*
+     * Convert directly into the output image. When updating an image in place, this works only if
+     * the input pixel is not smaller than the RGBA32 output pixel, like CMYK32 and YCCK32 are: row
+     * converters read every pixel before writing it. YCbCr24 pixels would be overwritten before
+     * being read, so they go through the temporary row below. sail_update_image() rejects
+     * YCbCr24 to RGBA32 anyway, but don't rely on that.
+     */
+    bool input_fits_output = true;
+
+    if (image->pixels == image_output->pixels) {
+        SAIL_TRY(sail_greater_equal_bits_per_pixel(image->pixel_format, SAIL_PIXEL_FORMAT_BPP32_RGBA, &input_fits_output));
+    }
+
+    if (output_context->pixel_format == SAIL_PIXEL_FORMAT_BPP32_RGBA && input_fits_output) {
+        for (unsigned row = 0; row < image->height; row++) {
+            const uint8_t *scan_input = (uint8_t *)image->pixels + image->bytes_per_line * row;
+            sail_rgba32_t *scan_output = (sail_rgba32_t *)((uint8_t *)image_output->pixels + image_output->bytes_per_line * row);
+
+            row_converter(scan_input, scan_output, image->width);
+        }
+
+        return SAIL_OK;
+    }
+
+    struct row_kernel row_kernel;
+    const bool has_row_kernel = find_row_kernel(SAIL_PIXEL_FORMAT_BPP32_RGBA, output_context->pixel_format, &row_kernel);
+
+    void *ptr;
+    SAIL_TRY(sail_malloc((size_t)image->width * sizeof(sail_rgba32_t), &ptr));
+    sail_rgba32_t *rgba32_row = ptr;
 
     for (unsigned row = 0; row < image->height; row++) {
         const uint8_t *scan_input = (uint8_t *)image->pixels + image->bytes_per_line * row;
 
-        for (unsigned column = 0; column < image->width; column++) {
-            convert_cmyk32_to_rgba32(*(scan_input+0), *(scan_input+1), *(scan_input+2), *(scan_input+3), &rgba32);
+        row_converter(scan_input, rgba32_row, image->width);
 
-            pixel_consumer(output_context, row, column, &rgba32, NULL);
-            scan_input += 4;
+        if (has_row_kernel) {
+            convert_row(&row_kernel, rgba32_row, (uint8_t *)image_output->pixels + image_output->bytes_per_line * row, image->width);
+        } else {
+            for (unsigned column = 0; column < image->width; column++) {
+                pixel_consumer(output_context, row, column, rgba32_row + column, NULL);
+            }
         }
     }
 
+    sail_free(rgba32_row);
+
     return SAIL_OK;
 }
 
-static sail_status_t convert_from_bpp24_ycbcr(const struct sail_image *image, pixel_consumer_t pixel_consumer, const struct output_context *output_context) {
+static sail_status_t convert_from_bpp32_cmyk(const struct sail_image *image, pixel_consumer_t pixel_consumer, const struct output_context *output_context) {
 
-    sail_rgba32_t rgba32;
+    SAIL_TRY(convert_via_rgba32_rows(image, convert_cmyk32_to_rgba32_row, pixel_consumer, output_context));
 
-    for (unsigned row = 0; row < image->height; row++) {
-        const uint8_t *scan_input = (uint8_t *)image->pixels + image->bytes_per_line * row;
+    return SAIL_OK;
+}
 
-        for (unsigned column = 0; column < image->width; column++) {
-            convert_ycbcr24_to_rgba32(*(scan_input+0), *(scan_input+1), *(scan_input+2), &rgba32);
+static sail_status_t convert_from_bpp24_ycbcr(const struct sail_image *image, pixel_consumer_t pixel_consumer, const struct output_context *output_context) {
 
-            pixel_consumer(output_context, row, column, &rgba32, NULL);
-            scan_input += 3;
-        }
-    }
+    SAIL_TRY(convert_via_rgba32_rows(image, convert_ycbcr24_to_rgba32_row, pixel_consumer, output_context));
 
     return SAIL_OK;
 }
 
 static sail_status_t convert_from_bpp32_ycck(const struct sail_image *image, pixel_consumer_t pixel_consumer, const struct output_context *output_context) {
 
-    sail_rgba32_t rgba32;
+    SAIL_TRY(convert_via_rgba32_rows(image, convert_ycck32_to_rgba32_row, pixel_consumer, output_context));
+
+    return SAIL_OK;
+}
+
+static void convert_rows(const struct sail_image *image, struct sail_image *image_output, const struct row_kernel *row_kernel) {
 
     for (unsigned row = 0; row < image->height; row++) {
         const uint8_t *scan_input = (uint8_t *)image->pixels + image->bytes_per_line * row;
+        uint8_t *scan_output = (uint8_t *)image_output->pixels + image_output->bytes_per_line * row;
 
-        for (unsigned column = 0; column < image->width; column++) {
-            convert_ycck32_to_rgba32(*(scan_input+0), *(scan_input+1), *(scan_input+2), *(scan_input+3), &rgba32);
+        convert_row(row_kernel, scan_input, scan_output, image->width);
+    }
+}
 
-            pixel_consumer(output_context, row, column, &rgba32, NULL);
-            scan_input += 4;
+/*
+ * Converts every scan line into RGBA32 with the specified row kernel or copies it as is when the kernel
+ * is NULL, and then into YCbCr.
+ */
+static sail_status_t convert_rows_to_ycbcr(const struct sail_image *image, struct sail_image *image_output, const struct row_kernel *row_kernel) {
+
+    void *ptr;
+    SAIL_TRY(sail_malloc((size_t)image->width * sizeof(sail_rgba32_t), &ptr));
+    sail_rgba32_t *rgba32_row = ptr;
+
+    for (unsigned row = 0; row < image->height; row++) {
+        const uint8_t *scan_input = (uint8_t *)image->pixels + image->bytes_per_line * row;
+        uint8_t *scan_output = (uint8_t *)image_output->pixels + image_output->bytes_per_line * row;
+
+        if (row_kernel != NULL) {
+            convert_row(row_kernel, scan_input, rgba32_row, image->width);
+        } else {
+            memcpy(rgba32_row, scan_input, (size_t)image->width * sizeof(sail_rgba32_t));
         }
+
+        convert_rgba32_to_ycbcr24_row(rgba32_row, scan_output, image->width);
     }
 
+    sail_free(rgba32_row);
+
     return SAIL_OK;
 }
 
 static sail_status_t conversion_impl(
     const struct sail_image *image,
     struct sail_image *image_output,
+    enum SailPixelFormat output_pixel_format,
     pixel_consumer_t pixel_consumer,
     int r, /* Index of RED component. */
     int g, /* Index of GREEN component. */
@@ -546,7 +616,31 @@ static sail_status_t conversion_impl(
     int a, /* Index of ALPHA component. */
     const struct sail_conversion_options *options) {
 
-    const struct output_context output_context = { image_output, r, g, b, a, options };
+    /*
+     * Try a row kernel specialized for this pair of pixel formats first. Row kernels never blend alpha,
+     * so fall back to the generic per-pixel path when the alpha channel needs to be blended.
+     */
+    const bool blend_alpha = a < 0 && options != NULL && (options->options & SAIL_CONVERSION_OPTION_BLEND_ALPHA);
+
+    struct row_kernel row_kernel;
+
+    if (!blend_alpha && find_row_kernel(image->pixel_format, output_pixel_format, &row_kernel)) {
+        convert_rows(image, image_output, &row_kernel);
+        return SAIL_OK;
+    }
+
+    /* Convert into YCbCr through RGBA32 scan lines when possible. */
+    if (!blend_alpha && output_pixel_format == SAIL_PIXEL_FORMAT_BPP24_YCBCR) {
+        if (image->pixel_format == SAIL_PIXEL_FORMAT_BPP32_RGBA) {
+            SAIL_TRY(convert_rows_to_ycbcr(image, image_output, NULL));
+            return SAIL_OK;
+        } else if (find_row_kernel(image->pixel_format, SAIL_PIXEL_FORMAT_BPP32_RGBA, &row_kernel)) {
+            SAIL_TRY(convert_rows_to_ycbcr(image, image_output, &row_kernel));
+            return SAIL_OK;
+        }
+    }
+
+    const struct output_context output_context = { image_output, output_pixel_format, r, g, b, a, options };
 
     /* After adding a new input pixel format, also update the switch in sail_can_convert(). */
     switch (image->pixel_format) {
@@ -699,6 +793,116 @@ static sail_status_t conversion_impl(
     return SAIL_OK;
 }
 
+/* Images with fewer pixels are always converted on the calling thread. */
+#define PARALLEL_CONVERSION_MIN_PIXELS (512 * 512)
+
+/* Minimum number of rows in a band converted by a single thread. */
+#define PARALLEL_CONVERSION_MIN_BAND_ROWS 16
+
+struct band_conversion_context {
+    const struct sail_image *image;
+    struct sail_image *image_output;
+    enum SailPixelFormat output_pixel_format;
+    pixel_consumer_t pixel_consumer;
+    int r;
+    int g;
+    int b;
+    int a;
+    const struct sail_conversion_options *options;
+};
+
+static sail_status_t convert_band(void *context, unsigned first_row, unsigned rows) {
+
+    const struct band_conversion_context *band_conversion_context = context;
+
+    /* Shallow copies of the images pointing to the band. */
+    struct sail_image band_image = *band_conversion_context->image;
+    band_image.pixels = (uint8_t *)band_image.pixels + (size_t)band_image.bytes_per_line * first_row;
+    band_image.height = rows;
+
+    struct sail_image band_image_output = *band_conversion_context->image_output;
+    band_image_output.pixels = (uint8_t *)band_image_output.pixels + (size_t)band_image_output.bytes_per_line * first_row;
+    band_image_output.height = rows;
+
+    SAIL_TRY(conversion_impl(&band_image,
+                             &band_image_output,
+                             band_conversion_context->output_pixel_format,
+                             band_conversion_context->pixel_consumer,
+                             band_conversion_context->r,
+                             band_conversion_context->g,
+                             band_conversion_context->b,
+                             band_conversion_context->a,
+                             band_conversion_context->options));
+
+    return SAIL_OK;
+}
+
+static unsigned conversion_bands(const struct sail_image *image, const struct sail_conversion_options *options) {
+
+    if (options == NULL || !(options->options & SAIL_CONVERSION_OPTION_PARALLEL)) {
+        return 1;
+    }
+
+    if ((size_t)image->width * image->height < PARALLEL_CONVERSION_MIN_PIXELS) {
+        return 1;
+    }
+
+    unsigned bands = thread_pool_concurrency();
+
+    if (options->threads > 0 && options->threads < bands) {
+        bands = options->threads;
+    }
+
+    const unsigned max_bands = image->height / PARALLEL_CONVERSION_MIN_BAND_ROWS;
+
+    if (bands > max_bands) {
+        bands = max_bands;
+    }
+
+    return bands == 0 ? 1 : bands;
+}
+
+/*
+ * Converts the image on the calling thread or splits it into horizontal bands converted in parallel
+ * when requested by the options. Every band writes its own rows only, so the output doesn't depend
+ * on the order the bands are converted in. In-place conversion is safe too as the input and output
+ * images share bytes per line.
+ */
+static sail_status_t parallel_conversion_impl(
+    const struct sail_image *image,
+    struct sail_image *image_output,
+    enum SailPixelFormat output_pixel_format,
+    pixel_consumer_t pixel_consumer,
+    int r,
+    int g,
+    int b,
+    int a,
+    const struct sail_conversion_options *options) {
+
+    const unsigned bands = conversion_bands(image, options);
+
+    if (bands == 1) {
+        SAIL_TRY(conversion_impl(image, image_output, output_pixel_format, pixel_consumer, r, g, b, a, options));
+        return SAIL_OK;
+    }
+
+    const struct band_conversion_context band_conversion_context = {
+        image,
+        image_output,
+        output_pixel_format,
+        pixel_consumer,
+        r,
+        g,
+        b,
+        a,
+        options
+    };
+
+    SAIL_TRY(thread_pool_run_bands(image->height, bands, convert_band, (void *)&band_conversion_context));
+
+    return SAIL_OK;
+}
+
 /*
  * Public functions.
  */
@@ -736,7 +940,7 @@ sail_status_t sail_convert_image_with_options(const struct sail_image *image,
     SAIL_TRY_OR_CLEANUP(sail_malloc(pixels_size, &image_local->pixels),
                         /* cleanup */ sail_destroy_image(image_local));
 
-    SAIL_TRY_OR_CLEANUP(conversion_impl(image, image_local, pixel_consumer, r, g, b, a, options),
+    SAIL_TRY_OR_CLEANUP(parallel_conversion_impl(image, image_local, output_pixel_format, pixel_consumer, r, g, b, a, options),
                         /* cleanup */ sail_destroy_image(image_local));
 
     *image_output = image_local;
@@ -744,6 +948,38 @@ sail_status_t sail_convert_image_with_options(const struct sail_image *image,
     return SAIL_OK;
 }
 
+sail_status_t sail_convert_image_to_pixels(const struct sail_image *image,
+                                           enum SailPixelFormat output_pixel_format,
+                                           const struct sail_conversion_options *options,
+                                           void *pixels,
+                                           unsigned bytes_per_line) {
+
+    SAIL_TRY(sail_check_image_valid(image));
+    SAIL_CHECK_PTR(pixels);
+
+    int r, g, b, a;
+    pixel_consumer_t pixel_consumer;
+    SAIL_TRY(verify_and_construct_rgba_indexes_verbose(output_pixel_format, &pixel_consumer, &r, &g, &b, &a));
+
+    unsigned natural_bytes_per_line;
+    SAIL_TRY(sail_bytes_per_line(image->width, output_pixel_format, &natural_bytes_per_line));
+
+    if (bytes_per_line < natural_bytes_per_line) {
+        SAIL_LOG_ERROR("Bytes per line %u is less than the %u bytes required to hold a row", bytes_per_line, natural_bytes_per_line);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INCORRECT_BYTES_PER_LINE);
+    }
+
+    /* Shallow copy of the image pointing to the caller pixels. */
+    struct sail_image image_output = *image;
+    image_output.pixel_format   = output_pixel_format;
+    image_output.bytes_per_line = bytes_per_line;
+    image_output.pixels         = pixels;
+
+    SAIL_TRY(parallel_conversion_impl(image, &image_output, output_pixel_format, pixel_consumer, r, g, b, a, options));
+
+    return SAIL_OK;
+}
+
 sail_status_t sail_update_image(struct sail_image *image, enum SailPixelFormat output_pixel_format) {
 
     SAIL_TRY(sail_update_image_with_options(image, output_pixel_format, NULL /* options */));
@@ -774,7 +1010,7 @@ sail_status_t sail_update_image_with_options(struct sail_image *image,
         SAIL_LOG_AND_RETURN(SAIL_ERROR_UNSUPPORTED_PIXEL_FORMAT);
     }
 
-    SAIL_TRY(conversion_impl(image, image, pixel_consumer, r, g, b, a, options));
+    SAIL_TRY(parallel_conversion_impl(image, image, output_pixel_format, pixel_consumer, r, g, b, a, options));
 
     image->pixel_format = output_pixel_format;
 
@@ -982,3 +1218,8 @@ sail_status_t sail_convert_image_for_saving_with_options(const struct sail_image
 
     return SAIL_OK;
 }
+
+void sail_stop_conversion_threads(void) {
+
+    thread_pool_finish();
+}
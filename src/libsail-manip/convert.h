@@ -155,6 +155,23 @@ SAIL_EXPORT sail_status_t sail_convert_image_with_options(const struct sail_imag
                                                           const struct sail_conversion_options *options,
                                                           struct sail_image **image_output);
 
+/*
+ * Converts the input image to the pixel format and writes the result into the pixels
+ * allocated by the caller. Rows are written bytes_per_line bytes apart. The pixels must hold
+ * at least image->height * bytes_per_line bytes and must not overlap the input pixels.
+ *
+ * Options (which may be NULL) control the conversion behavior.
+ *
+ * Allowed input and output pixel formats are the same as in sail_convert_image().
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_convert_image_to_pixels(const struct sail_image *image,
+                                                       enum SailPixelFormat output_pixel_format,
+                                                       const struct sail_conversion_options *options,
+                                                       void *pixels,
+                                                       unsigned bytes_per_line);
+
 /*
  * Updates the image to the pixel format. If the function fails, the image pixels
  * may be left partially converted.
@@ -317,6 +334,15 @@ SAIL_EXPORT sail_status_t sail_convert_image_for_saving_with_options(const struc
                                                                      const struct sail_conversion_options *options,
                                                                      struct sail_image **image_output);
 
+/*
+ * Stops the worker threads started by conversions and scaling with SAIL_CONVERSION_OPTION_PARALLEL,
+ * and waits for them to exit. Does nothing if they are not started. They are started again
+ * by the next parallel conversion. sail_finish() calls this function.
+ *
+ * Warning: Make sure no conversions or scaling are in progress before calling it.
+ */
+SAIL_EXPORT void sail_stop_conversion_threads(void);
+
 /* extern "C" */
 #ifdef __cplusplus
 }
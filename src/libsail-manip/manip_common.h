@@ -49,6 +49,31 @@ enum SailConversionOption {
      *   output_pixel = opacity * input_pixel + (1 - opacity) * background
      */
     SAIL_CONVERSION_OPTION_BLEND_ALPHA = 1 << 1,
+
+    /*
+     * Convert the image in horizontal bands on a pool of worker threads. The output is identical
+     * to the output of the single-threaded conversion. Small images are always converted
+     * on the calling thread. Has no effect when SAIL is built without SAIL_THREAD_SAFE.
+     */
+    SAIL_CONVERSION_OPTION_PARALLEL    = 1 << 2,
+};
+
+/*
+ * Resampling filters to scale images with.
+ */
+enum SailScaling {
+
+    /* Averages the covered input pixels. Fast, blocky when upscaling. */
+    SAIL_SCALING_BOX,
+
+    /* Triangle filter. Fast, slightly blurry. */
+    SAIL_SCALING_BILINEAR,
+
+    /* Mitchell-Netravali cubic filter with B = C = 1/3. Balances sharpness and ringing. */
+    SAIL_SCALING_MITCHELL,
+
+    /* 3-lobed Lanczos windowed sinc filter. The sharpest one with slight ringing on edges. */
+    SAIL_SCALING_LANCZOS3,
 };
 
 #endif
@@ -0,0 +1,436 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sail-common.h"
+
+#include "row_kernels.h"
+#include "row_kernels_simd.h"
+
+/*
+ * Component layouts used to specialize row kernels. See struct component_layout.
+ * Grayscale layouts point all the color indexes to the same component to spread it.
+ */
+#define LAYOUT_GRAY       1, 0, 0, 0, -1
+#define LAYOUT_GRAY_ALPHA 2, 0, 0, 0,  1
+#define LAYOUT_RGB        3, 0, 1, 2, -1
+#define LAYOUT_BGR        3, 2, 1, 0, -1
+#define LAYOUT_RGBX       4, 0, 1, 2, -1
+#define LAYOUT_BGRX       4, 2, 1, 0, -1
+#define LAYOUT_XRGB       4, 1, 2, 3, -1
+#define LAYOUT_XBGR       4, 3, 2, 1, -1
+#define LAYOUT_RGBA       4, 0, 1, 2,  3
+#define LAYOUT_BGRA       4, 2, 1, 0,  3
+#define LAYOUT_ARGB       4, 1, 2, 3,  0
+#define LAYOUT_ABGR       4, 3, 2, 1,  0
+
+/*
+ * Generic row templates. Specialized kernels below call them with constant layouts, so the compiler
+ * unrolls the component shuffling. Other channel permutations call them with runtime layouts.
+ *
+ * All the components of a pixel are read before writing the output pixel, so the templates
+ * are safe for in-place conversions where the output pixel is not larger than the input pixel.
+ */
+static inline void convert_row_uint8_to_uint8(const uint8_t *scan_input, uint8_t *scan_output, unsigned width,
+                                              unsigned input_step, int ri, int gi, int bi, int ai,
+                                              unsigned output_step, int ro, int go, int bo, int ao) {
+
+    for (unsigned column = 0; column < width; column++) {
+        const uint8_t r = scan_input[ri];
+        const uint8_t g = scan_input[gi];
+        const uint8_t b = scan_input[bi];
+        const uint8_t a = ai >= 0 ? scan_input[ai] : 255;
+
+        scan_output[ro] = r;
+        scan_output[go] = g;
+        scan_output[bo] = b;
+
+        if (ao >= 0) {
+            scan_output[ao] = a;
+        }
+
+        scan_input += input_step;
+        scan_output += output_step;
+    }
+}
+
+static inline void convert_row_uint16_to_uint8(const uint16_t *scan_input, uint8_t *scan_output, unsigned width,
+                                               unsigned input_step, int ri, int gi, int bi, int ai,
+                                               unsigned output_step, int ro, int go, int bo, int ao) {
+
+    /* Integer division truncates exactly like (uint8_t)(value / 257.0) in the generic path. */
+    for (unsigned column = 0; column < width; column++) {
+        const uint8_t r = (uint8_t)(scan_input[ri] / 257);
+        const uint8_t g = (uint8_t)(scan_input[gi] / 257);
+        const uint8_t b = (uint8_t)(scan_input[bi] / 257);
+        const uint8_t a = ai >= 0 ? (uint8_t)(scan_input[ai] / 257) : 255;
+
+        scan_output[ro] = r;
+        scan_output[go] = g;
+        scan_output[bo] = b;
+
+        if (ao >= 0) {
+            scan_output[ao] = a;
+        }
+
+        scan_input += input_step;
+        scan_output += output_step;
+    }
+}
+
+static inline void convert_row_uint8_to_uint16(const uint8_t *scan_input, uint16_t *scan_output, unsigned width,
+                                               unsigned input_step, int ri, int gi, int bi, int ai,
+                                               unsigned output_step, int ro, int go, int bo, int ao) {
+
+    for (unsigned column = 0; column < width; column++) {
+        const uint16_t r = (uint16_t)(scan_input[ri] * 257);
+        const uint16_t g = (uint16_t)(scan_input[gi] * 257);
+        const uint16_t b = (uint16_t)(scan_input[bi] * 257);
+        const uint16_t a = ai >= 0 ? (uint16_t)(scan_input[ai] * 257) : 65535;
+
+        scan_output[ro] = r;
+        scan_output[go] = g;
+        scan_output[bo] = b;
+
+        if (ao >= 0) {
+            scan_output[ao] = a;
+        }
+
+        scan_input += input_step;
+        scan_output += output_step;
+    }
+}
+
+static inline void convert_row_uint16_to_uint16(const uint16_t *scan_input, uint16_t *scan_output, unsigned width,
+                                                unsigned input_step, int ri, int gi, int bi, int ai,
+                                                unsigned output_step, int ro, int go, int bo, int ao) {
+
+    for (unsigned column = 0; column < width; column++) {
+        const uint16_t r = scan_input[ri];
+        const uint16_t g = scan_input[gi];
+        const uint16_t b = scan_input[bi];
+        const uint16_t a = ai >= 0 ? scan_input[ai] : 65535;
+
+        scan_output[ro] = r;
+        scan_output[go] = g;
+        scan_output[bo] = b;
+
+        if (ao >= 0) {
+            scan_output[ao] = a;
+        }
+
+        scan_input += input_step;
+        scan_output += output_step;
+    }
+}
+
+/*
+ * Defines a row kernel specialized for the input and output layouts.
+ */
+#define SAIL_ROW_KERNEL(name, template, input_type, output_type, input_layout, output_layout) \
+    static void name(const void *scan_input, void *scan_output, unsigned width) {              \
+        template((const input_type *)scan_input, (output_type *)scan_output, width,            \
+                    input_layout, output_layout);                                             \
+    }
+
+/* 8-bit -> 8-bit. */
+SAIL_ROW_KERNEL(gray8_to_rgb24,         convert_row_uint8_to_uint8,   uint8_t,  uint8_t,  LAYOUT_GRAY,       LAYOUT_RGB)
+SAIL_ROW_KERNEL(gray8_to_bgr24,         convert_row_uint8_to_uint8,   uint8_t,  uint8_t,  LAYOUT_GRAY,       LAYOUT_BGR)
+SAIL_ROW_KERNEL(gray8_to_rgba32,        convert_row_uint8_to_uint8,   uint8_t,  uint8_t,  LAYOUT_GRAY,       LAYOUT_RGBA)
+SAIL_ROW_KERNEL(gray8_to_bgra32,        convert_row_uint8_to_uint8,   uint8_t,  uint8_t,  LAYOUT_GRAY,       LAYOUT_BGRA)
+SAIL_ROW_KERNEL(gray_alpha16_to_rgba32, convert_row_uint8_to_uint8,   uint8_t,  uint8_t,  LAYOUT_GRAY_ALPHA, LAYOUT_RGBA)
+SAIL_ROW_KERNEL(gray_alpha16_to_bgra32, convert_row_uint8_to_uint8,   uint8_t,  uint8_t,  LAYOUT_GRAY_ALPHA, LAYOUT_BGRA)
+
+SAIL_ROW_KERNEL(rgb24_to_bgr24,         convert_row_uint8_to_uint8,   uint8_t,  uint8_t,  LAYOUT_RGB,        LAYOUT_BGR)
+SAIL_ROW_KERNEL(bgr24_to_rgb24,         convert_row_uint8_to_uint8,   uint8_t,  uint8_t,  LAYOUT_BGR,        LAYOUT_RGB)
+SAIL_ROW_KERNEL(rgb24_to_rgba32,        convert_row_uint8_to_uint8,   uint8_t,  uint8_t,  LAYOUT_RGB,        LAYOUT_RGBA)
+SAIL_ROW_KERNEL(rgb24_to_bgra32,        convert_row_uint8_to_uint8,   uint8_t,  uint8_t,  LAYOUT_RGB,        LAYOUT_BGRA)
+SAIL_ROW_KERNEL(bgr24_to_rgba32,        convert_row_uint8_to_uint8,   uint8_t,  uint8_t,  LAYOUT_BGR,        LAYOUT_RGBA)
+SAIL_ROW_KERNEL(bgr24_to_bgra32,        convert_row_uint8_to_uint8,   uint8_t,  uint8_t,  LAYOUT_BGR,        LAYOUT_BGRA)
+
+SAIL_ROW_KERNEL(rgbx32_to_rgb24,        convert_row_uint8_to_uint8,   uint8_t,  uint8_t,  LAYOUT_RGBX,       LAYOUT_RGB)
+SAIL_ROW_KERNEL(bgrx32_to_rgb24,        convert_row_uint8_to_uint8,   uint8_t,  uint8_t,  LAYOUT_BGRX,       LAYOUT_RGB)
+SAIL_ROW_KERNEL(bgrx32_to_bgr24,        convert_row_uint8_to_uint8,   uint8_t,  uint8_t,  LAYOUT_BGRX,       LAYOUT_BGR)
+SAIL_ROW_KERNEL(rgbx32_to_rgba32,       convert_row_uint8_to_uint8,   uint8_t,  uint8_t,  LAYOUT_RGBX,       LAYOUT_RGBA)
+SAIL_ROW_KERNEL(bgrx32_to_rgba32,       convert_row_uint8_to_uint8,   uint8_t,  uint8_t,  LAYOUT_BGRX,       LAYOUT_RGBA)
+SAIL_ROW_KERNEL(bgrx32_to_bgra32,       convert_row_uint8_to_uint8,   uint8_t,  uint8_t,  LAYOUT_BGRX,       LAYOUT_BGRA)
+
+SAIL_ROW_KERNEL(rgba32_to_rgb24,        convert_row_uint8_to_uint8,   uint8_t,  uint8_t,  LAYOUT_RGBA,       LAYOUT_RGB)
+SAIL_ROW_KERNEL(rgba32_to_bgr24,        convert_row_uint8_to_uint8,   uint8_t,  uint8_t,  LAYOUT_RGBA,       LAYOUT_BGR)
+SAIL_ROW_KERNEL(bgra32_to_rgb24,        convert_row_uint8_to_uint8,   uint8_t,  uint8_t,  LAYOUT_BGRA,       LAYOUT_RGB)
+SAIL_ROW_KERNEL(bgra32_to_bgr24,        convert_row_uint8_to_uint8,   uint8_t,  uint8_t,  LAYOUT_BGRA,       LAYOUT_BGR)
+SAIL_ROW_KERNEL(rgba32_to_bgra32,       convert_row_uint8_to_uint8,   uint8_t,  uint8_t,  LAYOUT_RGBA,       LAYOUT_BGRA)
+SAIL_ROW_KERNEL(rgba32_to_argb32,       convert_row_uint8_to_uint8,   uint8_t,  uint8_t,  LAYOUT_RGBA,       LAYOUT_ARGB)
+SAIL_ROW_KERNEL(rgba32_to_abgr32,       convert_row_uint8_to_uint8,   uint8_t,  uint8_t,  LAYOUT_RGBA,       LAYOUT_ABGR)
+SAIL_ROW_KERNEL(bgra32_to_rgba32,       convert_row_uint8_to_uint8,   uint8_t,  uint8_t,  LAYOUT_BGRA,       LAYOUT_RGBA)
+SAIL_ROW_KERNEL(argb32_to_rgba32,       convert_row_uint8_to_uint8,   uint8_t,  uint8_t,  LAYOUT_ARGB,       LAYOUT_RGBA)
+SAIL_ROW_KERNEL(abgr32_to_rgba32,       convert_row_uint8_to_uint8,   uint8_t,  uint8_t,  LAYOUT_ABGR,       LAYOUT_RGBA)
+
+/* 16-bit -> 8-bit. */
+SAIL_ROW_KERNEL(gray16_to_rgb24,        convert_row_uint16_to_uint8,  uint16_t, uint8_t,  LAYOUT_GRAY,       LAYOUT_RGB)
+SAIL_ROW_KERNEL(gray16_to_rgba32,       convert_row_uint16_to_uint8,  uint16_t, uint8_t,  LAYOUT_GRAY,       LAYOUT_RGBA)
+SAIL_ROW_KERNEL(gray_alpha32_to_rgba32, convert_row_uint16_to_uint8,  uint16_t, uint8_t,  LAYOUT_GRAY_ALPHA, LAYOUT_RGBA)
+SAIL_ROW_KERNEL(rgb48_to_rgb24,         convert_row_uint16_to_uint8,  uint16_t, uint8_t,  LAYOUT_RGB,        LAYOUT_RGB)
+SAIL_ROW_KERNEL(bgr48_to_rgb24,         convert_row_uint16_to_uint8,  uint16_t, uint8_t,  LAYOUT_BGR,        LAYOUT_RGB)
+SAIL_ROW_KERNEL(rgb48_to_rgba32,        convert_row_uint16_to_uint8,  uint16_t, uint8_t,  LAYOUT_RGB,        LAYOUT_RGBA)
+SAIL_ROW_KERNEL(rgba64_to_rgb24,        convert_row_uint16_to_uint8,  uint16_t, uint8_t,  LAYOUT_RGBA,       LAYOUT_RGB)
+SAIL_ROW_KERNEL(rgba64_to_rgba32,       convert_row_uint16_to_uint8,  uint16_t, uint8_t,  LAYOUT_RGBA,       LAYOUT_RGBA)
+SAIL_ROW_KERNEL(rgba64_to_bgra32,       convert_row_uint16_to_uint8,  uint16_t, uint8_t,  LAYOUT_RGBA,       LAYOUT_BGRA)
+SAIL_ROW_KERNEL(bgra64_to_rgba32,       convert_row_uint16_to_uint8,  uint16_t, uint8_t,  LAYOUT_BGRA,       LAYOUT_RGBA)
+
+/* 8-bit -> 16-bit. */
+SAIL_ROW_KERNEL(rgb24_to_rgb48,         convert_row_uint8_to_uint16,  uint8_t,  uint16_t, LAYOUT_RGB,        LAYOUT_RGB)
+SAIL_ROW_KERNEL(rgba32_to_rgba64,       convert_row_uint8_to_uint16,  uint8_t,  uint16_t, LAYOUT_RGBA,       LAYOUT_RGBA)
+
+/* 16-bit -> 16-bit. */
+SAIL_ROW_KERNEL(gray16_to_rgb48,        convert_row_uint16_to_uint16, uint16_t, uint16_t, LAYOUT_GRAY,       LAYOUT_RGB)
+SAIL_ROW_KERNEL(gray16_to_rgba64,       convert_row_uint16_to_uint16, uint16_t, uint16_t, LAYOUT_GRAY,       LAYOUT_RGBA)
+SAIL_ROW_KERNEL(rgb48_to_rgba64,        convert_row_uint16_to_uint16, uint16_t, uint16_t, LAYOUT_RGB,        LAYOUT_RGBA)
+SAIL_ROW_KERNEL(rgba64_to_rgb48,        convert_row_uint16_to_uint16, uint16_t, uint16_t, LAYOUT_RGBA,       LAYOUT_RGB)
+SAIL_ROW_KERNEL(bgra64_to_rgba64,       convert_row_uint16_to_uint16, uint16_t, uint16_t, LAYOUT_BGRA,       LAYOUT_RGBA)
+
+struct row_kernel_entry {
+    enum SailPixelFormat input_pixel_format;
+    enum SailPixelFormat output_pixel_format;
+    row_kernel_t row_kernel;
+};
+
+static const struct row_kernel_entry ROW_KERNELS[] = {
+
+    /* 8-bit -> 8-bit. */
+    { SAIL_PIXEL_FORMAT_BPP8_GRAYSCALE,        SAIL_PIXEL_FORMAT_BPP24_RGB,  gray8_to_rgb24 },
+    { SAIL_PIXEL_FORMAT_BPP8_GRAYSCALE,        SAIL_PIXEL_FORMAT_BPP24_BGR,  gray8_to_bgr24 },
+    { SAIL_PIXEL_FORMAT_BPP8_GRAYSCALE,        SAIL_PIXEL_FORMAT_BPP32_RGBA, gray8_to_rgba32 },
+    { SAIL_PIXEL_FORMAT_BPP8_GRAYSCALE,        SAIL_PIXEL_FORMAT_BPP32_BGRA, gray8_to_bgra32 },
+    { SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE_ALPHA, SAIL_PIXEL_FORMAT_BPP32_RGBA, gray_alpha16_to_rgba32 },
+    { SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE_ALPHA, SAIL_PIXEL_FORMAT_BPP32_BGRA, gray_alpha16_to_bgra32 },
+
+    { SAIL_PIXEL_FORMAT_BPP24_RGB,  SAIL_PIXEL_FORMAT_BPP24_BGR,  rgb24_to_bgr24 },
+    { SAIL_PIXEL_FORMAT_BPP24_BGR,  SAIL_PIXEL_FORMAT_BPP24_RGB,  bgr24_to_rgb24 },
+    { SAIL_PIXEL_FORMAT_BPP24_RGB,  SAIL_PIXEL_FORMAT_BPP32_RGBA, rgb24_to_rgba32 },
+    { SAIL_PIXEL_FORMAT_BPP24_RGB,  SAIL_PIXEL_FORMAT_BPP32_BGRA, rgb24_to_bgra32 },
+    { SAIL_PIXEL_FORMAT_BPP24_BGR,  SAIL_PIXEL_FORMAT_BPP32_RGBA, bgr24_to_rgba32 },
+    { SAIL_PIXEL_FORMAT_BPP24_BGR,  SAIL_PIXEL_FORMAT_BPP32_BGRA, bgr24_to_bgra32 },
+
+    { SAIL_PIXEL_FORMAT_BPP32_RGBX, SAIL_PIXEL_FORMAT_BPP24_RGB,  rgbx32_to_rgb24 },
+    { SAIL_PIXEL_FORMAT_BPP32_BGRX, SAIL_PIXEL_FORMAT_BPP24_RGB,  bgrx32_to_rgb24 },
+    { SAIL_PIXEL_FORMAT_BPP32_BGRX, SAIL_PIXEL_FORMAT_BPP24_BGR,  bgrx32_to_bgr24 },
+    { SAIL_PIXEL_FORMAT_BPP32_RGBX, SAIL_PIXEL_FORMAT_BPP32_RGBA, rgbx32_to_rgba32 },
+    { SAIL_PIXEL_FORMAT_BPP32_BGRX, SAIL_PIXEL_FORMAT_BPP32_RGBA, bgrx32_to_rgba32 },
+    { SAIL_PIXEL_FORMAT_BPP32_BGRX, SAIL_PIXEL_FORMAT_BPP32_BGRA, bgrx32_to_bgra32 },
+
+    { SAIL_PIXEL_FORMAT_BPP32_RGBA, SAIL_PIXEL_FORMAT_BPP24_RGB,  rgba32_to_rgb24 },
+    { SAIL_PIXEL_FORMAT_BPP32_RGBA, SAIL_PIXEL_FORMAT_BPP24_BGR,  rgba32_to_bgr24 },
+    { SAIL_PIXEL_FORMAT_BPP32_BGRA, SAIL_PIXEL_FORMAT_BPP24_RGB,  bgra32_to_rgb24 },
+    { SAIL_PIXEL_FORMAT_BPP32_BGRA, SAIL_PIXEL_FORMAT_BPP24_BGR,  bgra32_to_bgr24 },
+    { SAIL_PIXEL_FORMAT_BPP32_RGBA, SAIL_PIXEL_FORMAT_BPP32_BGRA, rgba32_to_bgra32 },
+    { SAIL_PIXEL_FORMAT_BPP32_RGBA, SAIL_PIXEL_FORMAT_BPP32_ARGB, rgba32_to_argb32 },
+    { SAIL_PIXEL_FORMAT_BPP32_RGBA, SAIL_PIXEL_FORMAT_BPP32_ABGR, rgba32_to_abgr32 },
+    { SAIL_PIXEL_FORMAT_BPP32_BGRA, SAIL_PIXEL_FORMAT_BPP32_RGBA, bgra32_to_rgba32 },
+    { SAIL_PIXEL_FORMAT_BPP32_ARGB, SAIL_PIXEL_FORMAT_BPP32_RGBA, argb32_to_rgba32 },
+    { SAIL_PIXEL_FORMAT_BPP32_ABGR, SAIL_PIXEL_FORMAT_BPP32_RGBA, abgr32_to_rgba32 },
+
+    /* 16-bit -> 8-bit. */
+    { SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE,       SAIL_PIXEL_FORMAT_BPP24_RGB,  gray16_to_rgb24 },
+    { SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE,       SAIL_PIXEL_FORMAT_BPP32_RGBA, gray16_to_rgba32 },
+    { SAIL_PIXEL_FORMAT_BPP32_GRAYSCALE_ALPHA, SAIL_PIXEL_FORMAT_BPP32_RGBA, gray_alpha32_to_rgba32 },
+
+    { SAIL_PIXEL_FORMAT_BPP48_RGB,  SAIL_PIXEL_FORMAT_BPP24_RGB,  rgb48_to_rgb24 },
+    { SAIL_PIXEL_FORMAT_BPP48_BGR,  SAIL_PIXEL_FORMAT_BPP24_RGB,  bgr48_to_rgb24 },
+    { SAIL_PIXEL_FORMAT_BPP48_RGB,  SAIL_PIXEL_FORMAT_BPP32_RGBA, rgb48_to_rgba32 },
+    { SAIL_PIXEL_FORMAT_BPP64_RGBA, SAIL_PIXEL_FORMAT_BPP24_RGB,  rgba64_to_rgb24 },
+    { SAIL_PIXEL_FORMAT_BPP64_RGBA, SAIL_PIXEL_FORMAT_BPP32_RGBA, rgba64_to_rgba32 },
+    { SAIL_PIXEL_FORMAT_BPP64_RGBA, SAIL_PIXEL_FORMAT_BPP32_BGRA, rgba64_to_bgra32 },
+    { SAIL_PIXEL_FORMAT_BPP64_BGRA, SAIL_PIXEL_FORMAT_BPP32_RGBA, bgra64_to_rgba32 },
+
+    /* 8-bit -> 16-bit. */
+    { SAIL_PIXEL_FORMAT_BPP24_RGB,  SAIL_PIXEL_FORMAT_BPP48_RGB,  rgb24_to_rgb48 },
+    { SAIL_PIXEL_FORMAT_BPP32_RGBA, SAIL_PIXEL_FORMAT_BPP64_RGBA, rgba32_to_rgba64 },
+
+    /* 16-bit -> 16-bit. */
+    { SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE, SAIL_PIXEL_FORMAT_BPP48_RGB,  gray16_to_rgb48 },
+    { SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE, SAIL_PIXEL_FORMAT_BPP64_RGBA, gray16_to_rgba64 },
+    { SAIL_PIXEL_FORMAT_BPP48_RGB,       SAIL_PIXEL_FORMAT_BPP64_RGBA, rgb48_to_rgba64 },
+    { SAIL_PIXEL_FORMAT_BPP64_RGBA,      SAIL_PIXEL_FORMAT_BPP48_RGB,  rgba64_to_rgb48 },
+    { SAIL_PIXEL_FORMAT_BPP64_BGRA,      SAIL_PIXEL_FORMAT_BPP64_RGBA, bgra64_to_rgba64 },
+};
+
+static const size_t ROW_KERNELS_LENGTH = sizeof(ROW_KERNELS) / sizeof(ROW_KERNELS[0]);
+
+static row_kernel_t find_specialized_row_kernel(enum SailPixelFormat input_pixel_format, enum SailPixelFormat output_pixel_format) {
+
+    for (size_t i = 0; i < ROW_KERNELS_LENGTH; i++) {
+        if (ROW_KERNELS[i].input_pixel_format == input_pixel_format && ROW_KERNELS[i].output_pixel_format == output_pixel_format) {
+            return ROW_KERNELS[i].row_kernel;
+        }
+    }
+
+    return NULL;
+}
+
+static bool shuffle_layout_of(enum SailPixelFormat pixel_format, unsigned *component_size, struct component_layout *layout) {
+
+    switch (pixel_format) {
+        case SAIL_PIXEL_FORMAT_BPP8_GRAYSCALE:        { *component_size = 1; *layout = (struct component_layout) { LAYOUT_GRAY };       return true; }
+        case SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE:       { *component_size = 2; *layout = (struct component_layout) { LAYOUT_GRAY };       return true; }
+        case SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE_ALPHA: { *component_size = 1; *layout = (struct component_layout) { LAYOUT_GRAY_ALPHA }; return true; }
+        case SAIL_PIXEL_FORMAT_BPP32_GRAYSCALE_ALPHA: { *component_size = 2; *layout = (struct component_layout) { LAYOUT_GRAY_ALPHA }; return true; }
+
+        case SAIL_PIXEL_FORMAT_BPP32_RGBX: { *component_size = 1; *layout = (struct component_layout) { LAYOUT_RGBX }; return true; }
+        case SAIL_PIXEL_FORMAT_BPP32_BGRX: { *component_size = 1; *layout = (struct component_layout) { LAYOUT_BGRX }; return true; }
+        case SAIL_PIXEL_FORMAT_BPP32_XRGB: { *component_size = 1; *layout = (struct component_layout) { LAYOUT_XRGB }; return true; }
+        case SAIL_PIXEL_FORMAT_BPP32_XBGR: { *component_size = 1; *layout = (struct component_layout) { LAYOUT_XBGR }; return true; }
+        case SAIL_PIXEL_FORMAT_BPP64_RGBX: { *component_size = 2; *layout = (struct component_layout) { LAYOUT_RGBX }; return true; }
+        case SAIL_PIXEL_FORMAT_BPP64_BGRX: { *component_size = 2; *layout = (struct component_layout) { LAYOUT_BGRX }; return true; }
+        case SAIL_PIXEL_FORMAT_BPP64_XRGB: { *component_size = 2; *layout = (struct component_layout) { LAYOUT_XRGB }; return true; }
+        case SAIL_PIXEL_FORMAT_BPP64_XBGR: { *component_size = 2; *layout = (struct component_layout) { LAYOUT_XBGR }; return true; }
+
+        case SAIL_PIXEL_FORMAT_BPP24_RGB:  { *component_size = 1; *layout = (struct component_layout) { LAYOUT_RGB };  return true; }
+        case SAIL_PIXEL_FORMAT_BPP24_BGR:  { *component_size = 1; *layout = (struct component_layout) { LAYOUT_BGR };  return true; }
+        case SAIL_PIXEL_FORMAT_BPP48_RGB:  { *component_size = 2; *layout = (struct component_layout) { LAYOUT_RGB };  return true; }
+        case SAIL_PIXEL_FORMAT_BPP48_BGR:  { *component_size = 2; *layout = (struct component_layout) { LAYOUT_BGR };  return true; }
+        case SAIL_PIXEL_FORMAT_BPP32_RGBA: { *component_size = 1; *layout = (struct component_layout) { LAYOUT_RGBA }; return true; }
+        case SAIL_PIXEL_FORMAT_BPP32_BGRA: { *component_size = 1; *layout = (struct component_layout) { LAYOUT_BGRA }; return true; }
+        case SAIL_PIXEL_FORMAT_BPP32_ARGB: { *component_size = 1; *layout = (struct component_layout) { LAYOUT_ARGB }; return true; }
+        case SAIL_PIXEL_FORMAT_BPP32_ABGR: { *component_size = 1; *layout = (struct component_layout) { LAYOUT_ABGR }; return true; }
+        case SAIL_PIXEL_FORMAT_BPP64_RGBA: { *component_size = 2; *layout = (struct component_layout) { LAYOUT_RGBA }; return true; }
+        case SAIL_PIXEL_FORMAT_BPP64_BGRA: { *component_size = 2; *layout = (struct component_layout) { LAYOUT_BGRA }; return true; }
+        case SAIL_PIXEL_FORMAT_BPP64_ARGB: { *component_size = 2; *layout = (struct component_layout) { LAYOUT_ARGB }; return true; }
+        case SAIL_PIXEL_FORMAT_BPP64_ABGR: { *component_size = 2; *layout = (struct component_layout) { LAYOUT_ABGR }; return true; }
+
+        default: {
+            return false;
+        }
+    }
+}
+
+/*
+ * Output layouts are limited to RGB and RGBA kinds. Grayscale outputs need weighted sums,
+ * and the generic conversion leaves X components of RGBX-like outputs untouched.
+ */
+static bool output_shuffle_layout(enum SailPixelFormat pixel_format, unsigned *component_size, struct component_layout *layout) {
+
+    switch (pixel_format) {
+        case SAIL_PIXEL_FORMAT_BPP24_RGB:
+        case SAIL_PIXEL_FORMAT_BPP24_BGR:
+        case SAIL_PIXEL_FORMAT_BPP48_RGB:
+        case SAIL_PIXEL_FORMAT_BPP48_BGR:
+        case SAIL_PIXEL_FORMAT_BPP32_RGBA:
+        case SAIL_PIXEL_FORMAT_BPP32_BGRA:
+        case SAIL_PIXEL_FORMAT_BPP32_ARGB:
+        case SAIL_PIXEL_FORMAT_BPP32_ABGR:
+        case SAIL_PIXEL_FORMAT_BPP64_RGBA:
+        case SAIL_PIXEL_FORMAT_BPP64_BGRA:
+        case SAIL_PIXEL_FORMAT_BPP64_ARGB:
+        case SAIL_PIXEL_FORMAT_BPP64_ABGR: {
+            return shuffle_layout_of(pixel_format, component_size, layout);
+        }
+        default: {
+            return false;
+        }
+    }
+}
+
+static shuffle_row_t select_shuffle_row(void) {
+
+#if defined SAIL_HAVE_X86_SIMD
+    if (cpu_supports_avx2()) {
+        return shuffle_row_avx2;
+    }
+    if (cpu_supports_ssse3()) {
+        return shuffle_row_ssse3;
+    }
+
+    return NULL;
+#elif defined SAIL_HAVE_NEON
+    return shuffle_row_neon;
+#else
+    return NULL;
+#endif
+}
+
+static void shuffle_row_scalar(const void *scan_input, void *scan_output, unsigned width, const struct shuffle_layout *layout) {
+
+    const struct component_layout *input = &layout->input;
+    const struct component_layout *output = &layout->output;
+
+    if (layout->component_size == 1) {
+        convert_row_uint8_to_uint8(scan_input, scan_output, width,
+                                    input->components, input->r, input->g, input->b, input->a,
+                                    output->components, output->r, output->g, output->b, output->a);
+    } else {
+        convert_row_uint16_to_uint16(scan_input, scan_output, width,
+                                        input->components, input->r, input->g, input->b, input->a,
+                                        output->components, output->r, output->g, output->b, output->a);
+    }
+}
+
+/*
+ * Public functions.
+ */
+
+bool find_row_kernel(enum SailPixelFormat input_pixel_format, enum SailPixelFormat output_pixel_format, struct row_kernel *row_kernel) {
+
+    row_kernel->kernel = find_specialized_row_kernel(input_pixel_format, output_pixel_format);
+    row_kernel->is_shuffle = false;
+    row_kernel->shuffle_row = NULL;
+
+    unsigned input_component_size;
+    unsigned output_component_size;
+
+    if (shuffle_layout_of(input_pixel_format, &input_component_size, &row_kernel->shuffle_layout.input) &&
+            output_shuffle_layout(output_pixel_format, &output_component_size, &row_kernel->shuffle_layout.output) &&
+            input_component_size == output_component_size) {
+        row_kernel->is_shuffle = true;
+        row_kernel->shuffle_layout.component_size = input_component_size;
+        row_kernel->shuffle_row = select_shuffle_row();
+    }
+
+    return row_kernel->kernel != NULL || row_kernel->is_shuffle;
+}
+
+void convert_row(const struct row_kernel *row_kernel, const void *scan_input, void *scan_output, unsigned width) {
+
+    if (!row_kernel->is_shuffle) {
+        row_kernel->kernel(scan_input, scan_output, width);
+        return;
+    }
+
+    const struct shuffle_layout *layout = &row_kernel->shuffle_layout;
+
+    /* Convert the leading pixels with SIMD and the rest with the scalar kernel. */
+    const unsigned converted = row_kernel->shuffle_row != NULL ? row_kernel->shuffle_row(scan_input, scan_output, width, layout) : 0;
+
+    const uint8_t *scan_input_rest = (const uint8_t *)scan_input + (size_t)converted * layout->input.components * layout->component_size;
+    uint8_t *scan_output_rest = (uint8_t *)scan_output + (size_t)converted * layout->output.components * layout->component_size;
+
+    if (row_kernel->kernel != NULL) {
+        row_kernel->kernel(scan_input_rest, scan_output_rest, width - converted);
+    } else {
+        shuffle_row_scalar(scan_input_rest, scan_output_rest, width - converted, layout);
+    }
+}
@@ -0,0 +1,98 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SAIL_ROW_KERNELS_H
+#define SAIL_ROW_KERNELS_H
+
+#include <stdbool.h>
+
+#ifdef SAIL_BUILD
+    #include "export.h"
+    #include "pixel.h"
+#else
+    #include <sail-common/export.h>
+    #include <sail-common/pixel.h>
+#endif
+
+/*
+ * Component layout of a pixel: number of components followed by indexes of RED, GREEN,
+ * BLUE, and ALPHA components. ALPHA index is -1 when there is no alpha.
+ */
+struct component_layout {
+    unsigned components;
+    int r;
+    int g;
+    int b;
+    int a;
+};
+
+/*
+ * Describes a pure channel permutation between two pixel formats with the same
+ * component size. Missing input alpha is filled with the maximum value.
+ */
+struct shuffle_layout {
+    unsigned component_size;
+    struct component_layout input;
+    struct component_layout output;
+};
+
+/*
+ * Converts a single scan line of the specified width. The input and output scan lines
+ * may point to the same memory when the output pixel is not larger than the input pixel.
+ */
+typedef void (*row_kernel_t)(const void *scan_input, void *scan_output, unsigned width);
+
+/*
+ * Converts as many leading pixels of a scan line as possible with SIMD instructions
+ * and returns their number.
+ */
+typedef unsigned (*shuffle_row_t)(const void *scan_input, void *scan_output, unsigned width, const struct shuffle_layout *layout);
+
+struct row_kernel {
+
+    /* Scalar kernel specialized for the pair of pixel formats or NULL. */
+    row_kernel_t kernel;
+
+    /* Set when the pair of pixel formats is a pure channel permutation. */
+    bool is_shuffle;
+    struct shuffle_layout shuffle_layout;
+
+    /* SIMD shuffle supported by the current CPU or NULL. */
+    shuffle_row_t shuffle_row;
+};
+
+/*
+ * Finds a row kernel for the specified pair of pixel formats. Returns false if the pair
+ * must be converted with the generic per-pixel conversion. Row kernels never blend alpha,
+ * so the caller must also fall back to the generic conversion when alpha blending is requested.
+ */
+SAIL_HIDDEN bool find_row_kernel(enum SailPixelFormat input_pixel_format, enum SailPixelFormat output_pixel_format, struct row_kernel *row_kernel);
+
+/*
+ * Converts a single scan line with the row kernel.
+ */
+SAIL_HIDDEN void convert_row(const struct row_kernel *row_kernel, const void *scan_input, void *scan_output, unsigned width);
+
+#endif
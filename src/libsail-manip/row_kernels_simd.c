@@ -0,0 +1,264 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "sail-common.h"
+
+#include "row_kernels.h"
+#include "row_kernels_simd.h"
+
+#if defined SAIL_HAVE_X86_SIMD
+    #include <immintrin.h>
+#elif defined SAIL_HAVE_NEON
+    #include <arm_neon.h>
+#endif
+
+#if defined SAIL_HAVE_X86_SIMD || defined SAIL_HAVE_NEON
+
+/*
+ * Every SIMD block holds 4 components of 8 bits or 2 components of 16 bits of each pixel slot.
+ * This way input blocks are 4-16 bytes long and output blocks (3 or 4 components) are
+ * always 12 or 16 bytes long.
+ */
+static const unsigned BLOCK_PIXELS_MULTIPLIER = 4;
+
+/*
+ * Builds a byte shuffle mask for a single block and a mask to OR with to fill
+ * missing alpha. Shuffle indexes with the high bit set produce zeros.
+ */
+static void build_shuffle_masks(const struct shuffle_layout *layout, uint8_t shuffle[16], uint8_t alpha[16]) {
+
+    const unsigned component_size = layout->component_size;
+    const unsigned pixels = BLOCK_PIXELS_MULTIPLIER / component_size;
+
+    const int input_indexes[4] = { layout->input.r, layout->input.g, layout->input.b, layout->input.a };
+    const int output_indexes[4] = { layout->output.r, layout->output.g, layout->output.b, layout->output.a };
+
+    /* Output component position -> channel. */
+    int output_channels[4] = { -1, -1, -1, -1 };
+
+    for (int channel = 0; channel < 4; channel++) {
+        if (output_indexes[channel] >= 0) {
+            output_channels[output_indexes[channel]] = channel;
+        }
+    }
+
+    memset(shuffle, 0x80, 16);
+    memset(alpha, 0, 16);
+
+    for (unsigned pixel = 0; pixel < pixels; pixel++) {
+        for (unsigned position = 0; position < layout->output.components; position++) {
+            const int channel = output_channels[position];
+            const int input_index = channel >= 0 ? input_indexes[channel] : -1;
+
+            for (unsigned byte = 0; byte < component_size; byte++) {
+                const unsigned output_byte = (pixel * layout->output.components + position) * component_size + byte;
+
+                if (input_index >= 0) {
+                    shuffle[output_byte] = (uint8_t)((pixel * layout->input.components + (unsigned)input_index) * component_size + byte);
+                } else if (channel == 3) {
+                    alpha[output_byte] = 0xff;
+                }
+            }
+        }
+    }
+}
+
+#endif
+
+#ifdef SAIL_HAVE_X86_SIMD
+
+bool cpu_supports_ssse3(void) {
+
+    return __builtin_cpu_supports("ssse3");
+}
+
+bool cpu_supports_avx2(void) {
+
+    return __builtin_cpu_supports("avx2");
+}
+
+__attribute__((target("ssse3")))
+static inline void store_block_sse(uint8_t *scan_output, __m128i value, unsigned output_block) {
+
+    if (output_block == 16) {
+        _mm_storeu_si128((__m128i *)scan_output, value);
+    } else {
+        const int tail = _mm_cvtsi128_si32(_mm_srli_si128(value, 8));
+
+        _mm_storel_epi64((__m128i *)scan_output, value);
+        memcpy(scan_output + 8, &tail, sizeof(tail));
+    }
+}
+
+/*
+ * Processes 128-bit blocks while at least 16 input bytes are left. Returns the number of
+ * converted pixels and advances the offsets.
+ */
+__attribute__((target("ssse3")))
+static inline unsigned shuffle_blocks_sse(const uint8_t *scan_input, uint8_t *scan_output, size_t input_size,
+                                          const uint8_t shuffle[16], const uint8_t alpha[16],
+                                          const struct shuffle_layout *layout, size_t *i, size_t *o) {
+
+    const unsigned input_block = BLOCK_PIXELS_MULTIPLIER * layout->input.components;
+    const unsigned output_block = BLOCK_PIXELS_MULTIPLIER * layout->output.components;
+    const unsigned block_pixels = BLOCK_PIXELS_MULTIPLIER / layout->component_size;
+
+    const __m128i shuffle_mask = _mm_loadu_si128((const __m128i *)shuffle);
+    const __m128i alpha_mask = _mm_loadu_si128((const __m128i *)alpha);
+
+    unsigned pixels = 0;
+
+    while (input_size - *i >= 16) {
+        __m128i value = _mm_loadu_si128((const __m128i *)(scan_input + *i));
+        value = _mm_or_si128(_mm_shuffle_epi8(value, shuffle_mask), alpha_mask);
+
+        store_block_sse(scan_output + *o, value, output_block);
+
+        *i += input_block;
+        *o += output_block;
+        pixels += block_pixels;
+    }
+
+    return pixels;
+}
+
+__attribute__((target("ssse3")))
+unsigned shuffle_row_ssse3(const void *scan_input, void *scan_output, unsigned width, const struct shuffle_layout *layout) {
+
+    uint8_t shuffle[16];
+    uint8_t alpha[16];
+    build_shuffle_masks(layout, shuffle, alpha);
+
+    const size_t input_size = (size_t)width * layout->input.components * layout->component_size;
+    size_t i = 0;
+    size_t o = 0;
+
+    return shuffle_blocks_sse(scan_input, scan_output, input_size, shuffle, alpha, layout, &i, &o);
+}
+
+__attribute__((target("avx2")))
+unsigned shuffle_row_avx2(const void *scan_input, void *scan_output, unsigned width, const struct shuffle_layout *layout) {
+
+    uint8_t shuffle[16];
+    uint8_t alpha[16];
+    build_shuffle_masks(layout, shuffle, alpha);
+
+    const uint8_t *input = scan_input;
+    uint8_t *output = scan_output;
+
+    const unsigned input_block = BLOCK_PIXELS_MULTIPLIER * layout->input.components;
+    const unsigned output_block = BLOCK_PIXELS_MULTIPLIER * layout->output.components;
+    const unsigned block_pixels = BLOCK_PIXELS_MULTIPLIER / layout->component_size;
+
+    /* vpshufb shuffles within 128-bit lanes, so move the second input block into the high lane. */
+    const int q = (int)layout->input.components;
+    const __m256i input_permutation = _mm256_setr_epi32(0, 1, 2, 3, q, q + 1, q + 2, q + 3);
+    /* And pack 12-byte output blocks back together. */
+    const __m256i output_permutation = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7);
+
+    const __m256i shuffle_mask = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)shuffle));
+    const __m256i alpha_mask = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)alpha));
+
+    const size_t input_size = (size_t)width * layout->input.components * layout->component_size;
+    size_t i = 0;
+    size_t o = 0;
+    unsigned pixels = 0;
+
+    while (input_size - i >= 32) {
+        __m256i value = _mm256_loadu_si256((const __m256i *)(input + i));
+        value = _mm256_permutevar8x32_epi32(value, input_permutation);
+        value = _mm256_or_si256(_mm256_shuffle_epi8(value, shuffle_mask), alpha_mask);
+
+        if (output_block == 16) {
+            _mm256_storeu_si256((__m256i *)(output + o), value);
+        } else {
+            value = _mm256_permutevar8x32_epi32(value, output_permutation);
+
+            _mm_storeu_si128((__m128i *)(output + o), _mm256_castsi256_si128(value));
+            _mm_storel_epi64((__m128i *)(output + o + 16), _mm256_extracti128_si256(value, 1));
+        }
+
+        i += 2 * input_block;
+        o += 2 * output_block;
+        pixels += 2 * block_pixels;
+    }
+
+    pixels += shuffle_blocks_sse(input, output, input_size, shuffle, alpha, layout, &i, &o);
+
+    return pixels;
+}
+
+#endif
+
+#ifdef SAIL_HAVE_NEON
+
+unsigned shuffle_row_neon(const void *scan_input, void *scan_output, unsigned width, const struct shuffle_layout *layout) {
+
+    uint8_t shuffle[16];
+    uint8_t alpha[16];
+    build_shuffle_masks(layout, shuffle, alpha);
+
+    const uint8_t *input = scan_input;
+    uint8_t *output = scan_output;
+
+    const unsigned input_block = BLOCK_PIXELS_MULTIPLIER * layout->input.components;
+    const unsigned output_block = BLOCK_PIXELS_MULTIPLIER * layout->output.components;
+    const unsigned block_pixels = BLOCK_PIXELS_MULTIPLIER / layout->component_size;
+
+    const uint8x16_t shuffle_mask = vld1q_u8(shuffle);
+    const uint8x16_t alpha_mask = vld1q_u8(alpha);
+
+    const size_t input_size = (size_t)width * layout->input.components * layout->component_size;
+    size_t i = 0;
+    size_t o = 0;
+    unsigned pixels = 0;
+
+    while (input_size - i >= 16) {
+        /* Out of range indexes produce zeros like with pshufb. */
+        uint8x16_t value = vld1q_u8(input + i);
+        value = vorrq_u8(vqtbl1q_u8(value, shuffle_mask), alpha_mask);
+
+        if (output_block == 16) {
+            vst1q_u8(output + o, value);
+        } else {
+            const uint32_t tail = vgetq_lane_u32(vreinterpretq_u32_u8(value), 2);
+
+            vst1_u8(output + o, vget_low_u8(value));
+            memcpy(output + o + 8, &tail, sizeof(tail));
+        }
+
+        i += input_block;
+        o += output_block;
+        pixels += block_pixels;
+    }
+
+    return pixels;
+}
+
+#endif
@@ -0,0 +1,71 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SAIL_ROW_KERNELS_SIMD_H
+#define SAIL_ROW_KERNELS_SIMD_H
+
+#include <stdbool.h>
+
+#ifdef SAIL_BUILD
+    #include "export.h"
+#else
+    #include <sail-common/export.h>
+#endif
+
+#include "row_kernels.h"
+
+/*
+ * x86 SIMD kernels are compiled with function-level target attributes and selected
+ * at runtime. NEON is always available on AArch64, so it's selected at compile time.
+ */
+#if defined __GNUC__ && (defined __x86_64__ || defined __i386__)
+    #define SAIL_HAVE_X86_SIMD
+#endif
+
+#if defined __aarch64__ && defined __ARM_NEON
+    #define SAIL_HAVE_NEON
+#endif
+
+/*
+ * SIMD shuffle kernels. They convert as many leading pixels of the scan line as possible
+ * and return their number. The caller converts the remaining pixels with a scalar kernel.
+ * Like scalar kernels, they are safe for in-place conversions where the output pixel
+ * is not larger than the input pixel.
+ */
+#ifdef SAIL_HAVE_X86_SIMD
+SAIL_HIDDEN bool cpu_supports_ssse3(void);
+
+SAIL_HIDDEN bool cpu_supports_avx2(void);
+
+SAIL_HIDDEN unsigned shuffle_row_ssse3(const void *scan_input, void *scan_output, unsigned width, const struct shuffle_layout *layout);
+
+SAIL_HIDDEN unsigned shuffle_row_avx2(const void *scan_input, void *scan_output, unsigned width, const struct shuffle_layout *layout);
+#endif
+
+#ifdef SAIL_HAVE_NEON
+SAIL_HIDDEN unsigned shuffle_row_neon(const void *scan_input, void *scan_output, unsigned width, const struct shuffle_layout *layout);
+#endif
+
+#endif
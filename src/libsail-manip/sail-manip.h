@@ -32,10 +32,16 @@
     #include "sail-common.h"
 
     #include "cmyk.h"
+    #include "color_simd.h"
     #include "conversion_options.h"
     #include "convert.h"
     #include "manip_common.h"
     #include "manip_utils.h"
+    #include "row_kernels.h"
+    #include "row_kernels_simd.h"
+    #include "scale.h"
+    #include "scale_kernels_simd.h"
+    #include "thread_pool.h"
     #include "ycbcr.h"
     #include "ycck.h"
 #else
@@ -44,6 +50,7 @@
     #include <sail-manip/conversion_options.h>
     #include <sail-manip/convert.h>
     #include <sail-manip/manip_common.h>
+    #include <sail-manip/scale.h>
 #endif
 
 #endif
@@ -0,0 +1,624 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sail-common.h"
+
+#include "sail-manip.h"
+
+/*
+ * Private functions.
+ */
+
+struct scale_layout {
+    unsigned component_size;
+    unsigned components;
+    /* Floats per pixel in working rows. RGB pixels are padded to 4 floats to use 4-component kernels. */
+    unsigned working_components;
+    int alpha;
+};
+
+static bool scale_layout_of(enum SailPixelFormat pixel_format, struct scale_layout *layout) {
+
+    switch (pixel_format) {
+        case SAIL_PIXEL_FORMAT_BPP8_GRAYSCALE:         *layout = (struct scale_layout) { 1, 1, 1, -1 }; return true;
+        case SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE:        *layout = (struct scale_layout) { 2, 1, 1, -1 }; return true;
+        case SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE_ALPHA:  *layout = (struct scale_layout) { 1, 2, 2,  1 }; return true;
+        case SAIL_PIXEL_FORMAT_BPP32_GRAYSCALE_ALPHA:  *layout = (struct scale_layout) { 2, 2, 2,  1 }; return true;
+
+        case SAIL_PIXEL_FORMAT_BPP24_RGB:
+        case SAIL_PIXEL_FORMAT_BPP24_BGR:              *layout = (struct scale_layout) { 1, 3, 4, -1 }; return true;
+
+        case SAIL_PIXEL_FORMAT_BPP48_RGB:
+        case SAIL_PIXEL_FORMAT_BPP48_BGR:              *layout = (struct scale_layout) { 2, 3, 4, -1 }; return true;
+
+        case SAIL_PIXEL_FORMAT_BPP32_RGBX:
+        case SAIL_PIXEL_FORMAT_BPP32_BGRX:
+        case SAIL_PIXEL_FORMAT_BPP32_XRGB:
+        case SAIL_PIXEL_FORMAT_BPP32_XBGR:             *layout = (struct scale_layout) { 1, 4, 4, -1 }; return true;
+        case SAIL_PIXEL_FORMAT_BPP32_RGBA:
+        case SAIL_PIXEL_FORMAT_BPP32_BGRA:             *layout = (struct scale_layout) { 1, 4, 4,  3 }; return true;
+        case SAIL_PIXEL_FORMAT_BPP32_ARGB:
+        case SAIL_PIXEL_FORMAT_BPP32_ABGR:             *layout = (struct scale_layout) { 1, 4, 4,  0 }; return true;
+
+        case SAIL_PIXEL_FORMAT_BPP64_RGBX:
+        case SAIL_PIXEL_FORMAT_BPP64_BGRX:
+        case SAIL_PIXEL_FORMAT_BPP64_XRGB:
+        case SAIL_PIXEL_FORMAT_BPP64_XBGR:             *layout = (struct scale_layout) { 2, 4, 4, -1 }; return true;
+        case SAIL_PIXEL_FORMAT_BPP64_RGBA:
+        case SAIL_PIXEL_FORMAT_BPP64_BGRA:             *layout = (struct scale_layout) { 2, 4, 4,  3 }; return true;
+        case SAIL_PIXEL_FORMAT_BPP64_ARGB:
+        case SAIL_PIXEL_FORMAT_BPP64_ABGR:             *layout = (struct scale_layout) { 2, 4, 4,  0 }; return true;
+
+        default: {
+            return false;
+        }
+    }
+}
+
+/*
+ * Resampling filters.
+ */
+
+static double box_filter(double x) {
+
+    return (x > -0.5 && x <= 0.5) ? 1 : 0;
+}
+
+static double bilinear_filter(double x) {
+
+    x = fabs(x);
+
+    return x < 1 ? 1 - x : 0;
+}
+
+static double mitchell_filter(double x) {
+
+    const double b = 1.0 / 3;
+    const double c = 1.0 / 3;
+
+    x = fabs(x);
+
+    if (x < 1) {
+        return ((12 - 9 * b - 6 * c) * x * x * x + (-18 + 12 * b + 6 * c) * x * x + (6 - 2 * b)) / 6;
+    } else if (x < 2) {
+        return ((-b - 6 * c) * x * x * x + (6 * b + 30 * c) * x * x + (-12 * b - 48 * c) * x + (8 * b + 24 * c)) / 6;
+    } else {
+        return 0;
+    }
+}
+
+static double sinc(double x) {
+
+    static const double PI = 3.14159265358979323846;
+
+    if (x == 0) {
+        return 1;
+    }
+
+    x *= PI;
+
+    return sin(x) / x;
+}
+
+static double lanczos3_filter(double x) {
+
+    return (x > -3 && x < 3) ? sinc(x) * sinc(x / 3) : 0;
+}
+
+struct scale_filter {
+    /* Filter radius in input pixels when upscaling. */
+    double support;
+    double (*function)(double x);
+};
+
+static sail_status_t scale_filter_of(enum SailScaling algorithm, struct scale_filter *filter) {
+
+    switch (algorithm) {
+        case SAIL_SCALING_BOX:      *filter = (struct scale_filter) { 0.5, box_filter };      return SAIL_OK;
+        case SAIL_SCALING_BILINEAR: *filter = (struct scale_filter) { 1,   bilinear_filter }; return SAIL_OK;
+        case SAIL_SCALING_MITCHELL: *filter = (struct scale_filter) { 2,   mitchell_filter }; return SAIL_OK;
+        case SAIL_SCALING_LANCZOS3: *filter = (struct scale_filter) { 3,   lanczos3_filter }; return SAIL_OK;
+    }
+
+    SAIL_LOG_ERROR("Unknown scaling algorithm %d", algorithm);
+    SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+}
+
+static void destroy_contributions(struct scale_contributions *contributions) {
+
+    sail_free(contributions->first);
+    sail_free(contributions->count);
+    sail_free(contributions->weights);
+}
+
+/*
+ * Calculates the filter weights of every output pixel along a single axis. The filter is stretched
+ * when downscaling, so every input pixel contributes to the output.
+ */
+static sail_status_t build_contributions(unsigned input_size, unsigned output_size, const struct scale_filter *filter, struct scale_contributions *contributions) {
+
+    const double scale        = (double)input_size / output_size;
+    const double filter_scale = scale > 1 ? scale : 1;
+    const double support      = filter->support * filter_scale;
+
+    contributions->first     = NULL;
+    contributions->count     = NULL;
+    contributions->weights   = NULL;
+    contributions->max_count = (unsigned)ceil(support) * 2 + 1;
+
+    if (contributions->max_count > input_size) {
+        contributions->max_count = input_size;
+    }
+
+    void *ptr;
+    SAIL_TRY(sail_malloc(sizeof(unsigned) * output_size, &ptr));
+    contributions->first = ptr;
+    SAIL_TRY_OR_CLEANUP(sail_malloc(sizeof(unsigned) * output_size, &ptr),
+                        /* cleanup */ destroy_contributions(contributions));
+    contributions->count = ptr;
+    SAIL_TRY_OR_CLEANUP(sail_malloc(sizeof(float) * output_size * contributions->max_count, &ptr),
+                        /* cleanup */ destroy_contributions(contributions));
+    contributions->weights = ptr;
+
+    for (unsigned output = 0; output < output_size; output++) {
+        const double center = (output + 0.5) * scale;
+
+        const double first = floor(center - support + 0.5);
+        const double last  = floor(center + support + 0.5);
+
+        const unsigned first_input = first < 0 ? 0 : (unsigned)first;
+        const unsigned last_input  = last > input_size ? input_size : (unsigned)last;
+        const unsigned count       = last_input - first_input;
+
+        float *weights = contributions->weights + (size_t)output * contributions->max_count;
+        double weights_sum = 0;
+
+        for (unsigned k = 0; k < count; k++) {
+            const double weight = filter->function((first_input + k + 0.5 - center) / filter_scale);
+
+            weights[k] = (float)weight;
+            weights_sum += weight;
+        }
+
+        if (weights_sum != 0) {
+            for (unsigned k = 0; k < count; k++) {
+                weights[k] = (float)(weights[k] / weights_sum);
+            }
+        } else {
+            /* Take the nearest input pixel. */
+            for (unsigned k = 0; k < count; k++) {
+                weights[k] = (first_input + k == (unsigned)center) ? 1.0f : 0.0f;
+            }
+        }
+
+        contributions->first[output] = first_input;
+        contributions->count[output] = count;
+    }
+
+    return SAIL_OK;
+}
+
+/*
+ * Converts the input row into floats premultiplied by alpha.
+ */
+static void load_row(const struct scale_layout *layout, const void *scan, float *row, unsigned width) {
+
+    const unsigned components         = layout->components;
+    const unsigned working_components = layout->working_components;
+
+    if (layout->component_size == 1) {
+        const uint8_t *input = scan;
+
+        for (unsigned column = 0; column < width; column++, input += components, row += working_components) {
+            for (unsigned component = 0; component < components; component++) {
+                row[component] = input[component];
+            }
+            for (unsigned component = components; component < working_components; component++) {
+                row[component] = 0;
+            }
+        }
+    } else {
+        const uint16_t *input = scan;
+
+        for (unsigned column = 0; column < width; column++, input += components, row += working_components) {
+            for (unsigned component = 0; component < components; component++) {
+                row[component] = input[component];
+            }
+            for (unsigned component = components; component < working_components; component++) {
+                row[component] = 0;
+            }
+        }
+    }
+
+    if (layout->alpha >= 0) {
+        const float max_value = layout->component_size == 1 ? 255.0f : 65535.0f;
+
+        row -= (size_t)width * working_components;
+
+        for (unsigned column = 0; column < width; column++, row += working_components) {
+            const float opacity = row[layout->alpha] / max_value;
+
+            for (unsigned component = 0; component < components; component++) {
+                if ((int)component != layout->alpha) {
+                    row[component] *= opacity;
+                }
+            }
+        }
+    }
+}
+
+static inline float clamp_component(float value, float max_value) {
+
+    if (value < 0) {
+        return 0;
+    } else if (value > max_value) {
+        return max_value;
+    } else {
+        return value;
+    }
+}
+
+/*
+ * Un-premultiplies, rounds, and clamps the float row into the output row.
+ */
+static void store_row(const struct scale_layout *layout, const float *row, void *scan, unsigned width) {
+
+    const unsigned components         = layout->components;
+    const unsigned working_components = layout->working_components;
+    const float max_value             = layout->component_size == 1 ? 255.0f : 65535.0f;
+
+    uint8_t *output8   = scan;
+    uint16_t *output16 = scan;
+
+    for (unsigned column = 0; column < width; column++, row += working_components) {
+        float factor = 1;
+
+        if (layout->alpha >= 0) {
+            const float alpha = clamp_component(row[layout->alpha], max_value);
+            factor = alpha > 0 ? max_value / alpha : 0;
+        }
+
+        for (unsigned component = 0; component < components; component++) {
+            const float value = ((int)component == layout->alpha) ? row[component] : row[component] * factor;
+            const float clamped = clamp_component(value, max_value) + 0.5f;
+
+            if (layout->component_size == 1) {
+                *output8++ = (uint8_t)clamped;
+            } else {
+                *output16++ = (uint16_t)clamped;
+            }
+        }
+    }
+}
+
+static inline void scale_horizontal_row_scalar(const float *input, float *output, unsigned output_width,
+                                                const struct scale_contributions *contributions, unsigned components) {
+
+    for (unsigned column = 0; column < output_width; column++, output += components) {
+        const float *weights = contributions->weights + (size_t)column * contributions->max_count;
+        const float *pixels = input + (size_t)contributions->first[column] * components;
+        const unsigned count = contributions->count[column];
+
+        for (unsigned component = 0; component < components; component++) {
+            output[component] = 0;
+        }
+
+        for (unsigned k = 0; k < count; k++, pixels += components) {
+            for (unsigned component = 0; component < components; component++) {
+                output[component] += weights[k] * pixels[component];
+            }
+        }
+    }
+}
+
+static void scale_horizontal_row1_scalar(const float *input, float *output, unsigned output_width, const struct scale_contributions *contributions) {
+
+    scale_horizontal_row_scalar(input, output, output_width, contributions, 1);
+}
+
+static void scale_horizontal_row2_scalar(const float *input, float *output, unsigned output_width, const struct scale_contributions *contributions) {
+
+    scale_horizontal_row_scalar(input, output, output_width, contributions, 2);
+}
+
+static void scale_horizontal_row4_scalar(const float *input, float *output, unsigned output_width, const struct scale_contributions *contributions) {
+
+    scale_horizontal_row_scalar(input, output, output_width, contributions, 4);
+}
+
+static void scale_vertical_row_scalar(const float *const *rows, const float *weights, unsigned count, float *output, unsigned first_column, unsigned length) {
+
+    for (unsigned column = first_column; column < length; column++) {
+        float sum = 0;
+
+        for (unsigned k = 0; k < count; k++) {
+            sum += weights[k] * rows[k][column];
+        }
+
+        output[column] = sum;
+    }
+}
+
+static scale_horizontal_row_t select_horizontal_row(unsigned working_components) {
+
+#if defined SAIL_HAVE_X86_SIMD
+    if (cpu_supports_ssse3()) {
+        if (working_components == 4) {
+            return scale_horizontal_row4_ssse3;
+        }
+        if (working_components == 1) {
+            return scale_horizontal_row1_ssse3;
+        }
+    }
+#elif defined SAIL_HAVE_NEON
+    if (working_components == 4) {
+        return scale_horizontal_row4_neon;
+    }
+    if (working_components == 1) {
+        return scale_horizontal_row1_neon;
+    }
+#endif
+
+    switch (working_components) {
+        case 1:  return scale_horizontal_row1_scalar;
+        case 2:  return scale_horizontal_row2_scalar;
+        default: return scale_horizontal_row4_scalar;
+    }
+}
+
+static scale_vertical_row_t select_vertical_row(void) {
+
+#if defined SAIL_HAVE_X86_SIMD
+    if (cpu_supports_avx2()) {
+        return scale_vertical_row_avx2;
+    }
+    if (cpu_supports_ssse3()) {
+        return scale_vertical_row_ssse3;
+    }
+
+    return NULL;
+#elif defined SAIL_HAVE_NEON
+    return scale_vertical_row_neon;
+#else
+    return NULL;
+#endif
+}
+
+struct band_scaling_context {
+    const struct sail_image *image;
+    struct sail_image *image_output;
+    struct scale_layout layout;
+    const struct scale_contributions *horizontal;
+    const struct scale_contributions *vertical;
+    scale_horizontal_row_t horizontal_row;
+    scale_vertical_row_t vertical_row;
+};
+
+/*
+ * Scales the output rows of the band. Input rows are filtered horizontally into a ring of rows
+ * just large enough to hold the rows of a single vertical filter window. The window slides down
+ * monotonically, so every input row is filtered once per band, and the working set stays small
+ * instead of holding a whole horizontally scaled image.
+ */
+static sail_status_t scale_band(void *context, unsigned first_row, unsigned rows) {
+
+    const struct band_scaling_context *band_scaling_context = context;
+
+    const struct sail_image *image               = band_scaling_context->image;
+    struct sail_image *image_output              = band_scaling_context->image_output;
+    const struct scale_layout *layout            = &band_scaling_context->layout;
+    const struct scale_contributions *horizontal = band_scaling_context->horizontal;
+    const struct scale_contributions *vertical   = band_scaling_context->vertical;
+
+    const size_t input_length  = (size_t)image->width * layout->working_components;
+    const size_t output_length = (size_t)image_output->width * layout->working_components;
+    const unsigned ring_rows   = vertical->max_count;
+
+    /* Row pointers go first to keep them aligned. */
+    void *ptr;
+    SAIL_TRY(sail_malloc(sizeof(float *) * ring_rows + sizeof(float) * (input_length + output_length * (ring_rows + 1)), &ptr));
+
+    const float **window = ptr;
+    float *input_row     = (float *)(window + ring_rows);
+    float *output_row    = input_row + input_length;
+    float *ring          = output_row + output_length;
+
+    unsigned next_input_row = vertical->first[first_row];
+
+    for (unsigned row = first_row; row < first_row + rows; row++) {
+        const unsigned first = vertical->first[row];
+        const unsigned count = vertical->count[row];
+
+        if (next_input_row < first) {
+            next_input_row = first;
+        }
+
+        for (; next_input_row < first + count; next_input_row++) {
+            load_row(layout, (const uint8_t *)image->pixels + (size_t)image->bytes_per_line * next_input_row, input_row, image->width);
+            band_scaling_context->horizontal_row(input_row, ring + (next_input_row % ring_rows) * output_length, image_output->width, horizontal);
+        }
+
+        for (unsigned k = 0; k < count; k++) {
+            window[k] = ring + ((first + k) % ring_rows) * output_length;
+        }
+
+        const float *weights = vertical->weights + (size_t)row * vertical->max_count;
+
+        const unsigned column = band_scaling_context->vertical_row == NULL
+                                    ? 0
+                                    : band_scaling_context->vertical_row(window, weights, count, output_row, (unsigned)output_length);
+        scale_vertical_row_scalar(window, weights, count, output_row, column, (unsigned)output_length);
+
+        store_row(layout, output_row, (uint8_t *)image_output->pixels + (size_t)image_output->bytes_per_line * row, image_output->width);
+    }
+
+    sail_free(ptr);
+
+    return SAIL_OK;
+}
+
+/* Images with fewer pixels are always scaled on the calling thread. */
+#define PARALLEL_SCALING_MIN_PIXELS (512 * 512)
+
+/* Minimum number of output rows in a band scaled by a single thread. */
+#define PARALLEL_SCALING_MIN_BAND_ROWS 16
+
+static unsigned scaling_bands(const struct sail_image *image, const struct sail_image *image_output, const struct sail_conversion_options *options) {
+
+    if (options == NULL || !(options->options & SAIL_CONVERSION_OPTION_PARALLEL)) {
+        return 1;
+    }
+
+    if ((size_t)image->width * image->height < PARALLEL_SCALING_MIN_PIXELS &&
+            (size_t)image_output->width * image_output->height < PARALLEL_SCALING_MIN_PIXELS) {
+        return 1;
+    }
+
+    unsigned bands = thread_pool_concurrency();
+
+    if (options->threads > 0 && options->threads < bands) {
+        bands = options->threads;
+    }
+
+    const unsigned max_bands = image_output->height / PARALLEL_SCALING_MIN_BAND_ROWS;
+
+    if (bands > max_bands) {
+        bands = max_bands;
+    }
+
+    return bands == 0 ? 1 : bands;
+}
+
+/*
+ * Scales the image into the allocated output image on the calling thread or in horizontal bands
+ * of output rows scaled in parallel when requested by the options. Bands filter the input rows
+ * they share independently, so the output doesn't depend on the number of bands.
+ */
+static sail_status_t scale_impl(const struct sail_image *image,
+                                struct sail_image *image_output,
+                                const struct scale_layout *layout,
+                                const struct scale_filter *filter,
+                                const struct sail_conversion_options *options) {
+
+    struct scale_contributions horizontal;
+    SAIL_TRY(build_contributions(image->width, image_output->width, filter, &horizontal));
+
+    struct scale_contributions vertical;
+    SAIL_TRY_OR_CLEANUP(build_contributions(image->height, image_output->height, filter, &vertical),
+                        /* cleanup */ destroy_contributions(&horizontal));
+
+    const struct band_scaling_context band_scaling_context = {
+        image,
+        image_output,
+        *layout,
+        &horizontal,
+        &vertical,
+        select_horizontal_row(layout->working_components),
+        select_vertical_row()
+    };
+
+    const sail_status_t status = thread_pool_run_bands(image_output->height,
+                                                       scaling_bands(image, image_output, options),
+                                                       scale_band,
+                                                       (void *)&band_scaling_context);
+
+    destroy_contributions(&vertical);
+    destroy_contributions(&horizontal);
+
+    return status;
+}
+
+/*
+ * Public functions.
+ */
+
+sail_status_t sail_scale_image(const struct sail_image *image,
+                               unsigned width,
+                               unsigned height,
+                               enum SailScaling algorithm,
+                               struct sail_image **image_output) {
+
+    SAIL_TRY(sail_scale_image_with_options(image, width, height, algorithm, NULL /* options */, image_output));
+
+    return SAIL_OK;
+}
+
+sail_status_t sail_scale_image_with_options(const struct sail_image *image,
+                                            unsigned width,
+                                            unsigned height,
+                                            enum SailScaling algorithm,
+                                            const struct sail_conversion_options *options,
+                                            struct sail_image **image_output) {
+
+    SAIL_TRY(sail_check_image_valid(image));
+    SAIL_CHECK_PTR(image_output);
+
+    if (width == 0 || height == 0) {
+        SAIL_LOG_ERROR("Cannot scale images to %ux%u", width, height);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+
+    struct scale_layout layout;
+
+    if (!scale_layout_of(image->pixel_format, &layout)) {
+        SAIL_LOG_ERROR("Scaling %s images is not supported", sail_pixel_format_to_string(image->pixel_format));
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNSUPPORTED_PIXEL_FORMAT);
+    }
+
+    struct scale_filter filter;
+    SAIL_TRY(scale_filter_of(algorithm, &filter));
+
+    struct sail_image *image_local;
+    SAIL_TRY(sail_copy_image_skeleton(image, &image_local));
+
+    image_local->width  = width;
+    image_local->height = height;
+
+    SAIL_TRY_OR_CLEANUP(sail_bytes_per_line(image_local->width, image_local->pixel_format, &image_local->bytes_per_line),
+                        /* cleanup */ sail_destroy_image(image_local));
+
+    const size_t pixels_size = (size_t)image_local->height * image_local->bytes_per_line;
+    SAIL_TRY_OR_CLEANUP(sail_malloc(pixels_size, &image_local->pixels),
+                        /* cleanup */ sail_destroy_image(image_local));
+
+    SAIL_TRY_OR_CLEANUP(scale_impl(image, image_local, &layout, &filter, options),
+                        /* cleanup */ sail_destroy_image(image_local));
+
+    *image_output = image_local;
+
+    return SAIL_OK;
+}
+
+bool sail_can_scale(enum SailPixelFormat pixel_format) {
+
+    struct scale_layout layout;
+
+    return scale_layout_of(pixel_format, &layout);
+}
@@ -0,0 +1,190 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include "sail-common.h"
+
+#include "scale_kernels_simd.h"
+
+#if defined SAIL_HAVE_X86_SIMD
+    #include <immintrin.h>
+#elif defined SAIL_HAVE_NEON
+    #include <arm_neon.h>
+#endif
+
+#ifdef SAIL_HAVE_X86_SIMD
+
+__attribute__((target("ssse3")))
+static inline float horizontal_sum_sse(__m128 value) {
+
+    const __m128 high = _mm_movehl_ps(value, value);
+    const __m128 pair = _mm_add_ps(value, high);
+
+    return _mm_cvtss_f32(_mm_add_ss(pair, _mm_shuffle_ps(pair, pair, 1)));
+}
+
+__attribute__((target("ssse3")))
+void scale_horizontal_row1_ssse3(const float *input, float *output, unsigned output_width, const struct scale_contributions *contributions) {
+
+    for (unsigned column = 0; column < output_width; column++) {
+        const float *weights = contributions->weights + (size_t)column * contributions->max_count;
+        const float *pixels = input + contributions->first[column];
+        const unsigned count = contributions->count[column];
+
+        /* Neighbor taps are adjacent in gray rows, so multiply 4 of them at once. */
+        __m128 sum = _mm_setzero_ps();
+        unsigned k = 0;
+
+        for (; count - k >= 4; k += 4) {
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(weights + k), _mm_loadu_ps(pixels + k)));
+        }
+
+        float value = horizontal_sum_sse(sum);
+
+        for (; k < count; k++) {
+            value += weights[k] * pixels[k];
+        }
+
+        output[column] = value;
+    }
+}
+
+__attribute__((target("ssse3")))
+void scale_horizontal_row4_ssse3(const float *input, float *output, unsigned output_width, const struct scale_contributions *contributions) {
+
+    for (unsigned column = 0; column < output_width; column++, output += 4) {
+        const float *weights = contributions->weights + (size_t)column * contributions->max_count;
+        const float *pixels = input + (size_t)contributions->first[column] * 4;
+        const unsigned count = contributions->count[column];
+
+        /* Every pixel fills a vector. */
+        __m128 sum = _mm_setzero_ps();
+
+        for (unsigned k = 0; k < count; k++, pixels += 4) {
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[k]), _mm_loadu_ps(pixels)));
+        }
+
+        _mm_storeu_ps(output, sum);
+    }
+}
+
+__attribute__((target("ssse3")))
+unsigned scale_vertical_row_ssse3(const float *const *rows, const float *weights, unsigned count, float *output, unsigned length) {
+
+    unsigned column = 0;
+
+    for (; length - column >= 4; column += 4) {
+        __m128 sum = _mm_setzero_ps();
+
+        for (unsigned k = 0; k < count; k++) {
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[k]), _mm_loadu_ps(rows[k] + column)));
+        }
+
+        _mm_storeu_ps(output + column, sum);
+    }
+
+    return column;
+}
+
+__attribute__((target("avx2")))
+unsigned scale_vertical_row_avx2(const float *const *rows, const float *weights, unsigned count, float *output, unsigned length) {
+
+    unsigned column = 0;
+
+    for (; length - column >= 8; column += 8) {
+        __m256 sum = _mm256_setzero_ps();
+
+        for (unsigned k = 0; k < count; k++) {
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_set1_ps(weights[k]), _mm256_loadu_ps(rows[k] + column)));
+        }
+
+        _mm256_storeu_ps(output + column, sum);
+    }
+
+    return column;
+}
+
+#endif
+
+#ifdef SAIL_HAVE_NEON
+
+void scale_horizontal_row1_neon(const float *input, float *output, unsigned output_width, const struct scale_contributions *contributions) {
+
+    for (unsigned column = 0; column < output_width; column++) {
+        const float *weights = contributions->weights + (size_t)column * contributions->max_count;
+        const float *pixels = input + contributions->first[column];
+        const unsigned count = contributions->count[column];
+
+        float32x4_t sum = vdupq_n_f32(0);
+        unsigned k = 0;
+
+        for (; count - k >= 4; k += 4) {
+            sum = vmlaq_f32(sum, vld1q_f32(weights + k), vld1q_f32(pixels + k));
+        }
+
+        float value = vaddvq_f32(sum);
+
+        for (; k < count; k++) {
+            value += weights[k] * pixels[k];
+        }
+
+        output[column] = value;
+    }
+}
+
+void scale_horizontal_row4_neon(const float *input, float *output, unsigned output_width, const struct scale_contributions *contributions) {
+
+    for (unsigned column = 0; column < output_width; column++, output += 4) {
+        const float *weights = contributions->weights + (size_t)column * contributions->max_count;
+        const float *pixels = input + (size_t)contributions->first[column] * 4;
+        const unsigned count = contributions->count[column];
+
+        float32x4_t sum = vdupq_n_f32(0);
+
+        for (unsigned k = 0; k < count; k++, pixels += 4) {
+            sum = vmlaq_n_f32(sum, vld1q_f32(pixels), weights[k]);
+        }
+
+        vst1q_f32(output, sum);
+    }
+}
+
+unsigned scale_vertical_row_neon(const float *const *rows, const float *weights, unsigned count, float *output, unsigned length) {
+
+    unsigned column = 0;
+
+    for (; length - column >= 4; column += 4) {
+        float32x4_t sum = vdupq_n_f32(0);
+
+        for (unsigned k = 0; k < count; k++) {
+            sum = vmlaq_n_f32(sum, vld1q_f32(rows[k] + column), weights[k]);
+        }
+
+        vst1q_f32(output + column, sum);
+    }
+
+    return column;
+}
+
+#endif
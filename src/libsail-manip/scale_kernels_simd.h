@@ -0,0 +1,79 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SAIL_SCALE_KERNELS_H
+#define SAIL_SCALE_KERNELS_H
+
+#ifdef SAIL_BUILD
+    #include "export.h"
+#else
+    #include <sail-common/export.h>
+#endif
+
+#include "row_kernels_simd.h"
+
+/*
+ * Filter weights along a single axis. Output pixel i is the weighted sum of count[i]
+ * input pixels starting with first[i]. Weights of every output pixel are stored max_count
+ * floats apart and sum up to 1.
+ */
+struct scale_contributions {
+    unsigned *first;
+    unsigned *count;
+    float *weights;
+    unsigned max_count;
+};
+
+/*
+ * Horizontal kernels filter a row of float pixels with the specified number of components
+ * into output_width pixels. Vertical kernels sum count rows multiplied by their weights into
+ * the output row of length floats.
+ *
+ * SIMD vertical kernels process as many leading floats as possible and return their number.
+ * The caller processes the remaining floats with the scalar kernel.
+ */
+typedef void (*scale_horizontal_row_t)(const float *input, float *output, unsigned output_width, const struct scale_contributions *contributions);
+
+typedef unsigned (*scale_vertical_row_t)(const float *const *rows, const float *weights, unsigned count, float *output, unsigned length);
+
+#ifdef SAIL_HAVE_X86_SIMD
+SAIL_HIDDEN void scale_horizontal_row1_ssse3(const float *input, float *output, unsigned output_width, const struct scale_contributions *contributions);
+
+SAIL_HIDDEN void scale_horizontal_row4_ssse3(const float *input, float *output, unsigned output_width, const struct scale_contributions *contributions);
+
+SAIL_HIDDEN unsigned scale_vertical_row_ssse3(const float *const *rows, const float *weights, unsigned count, float *output, unsigned length);
+
+SAIL_HIDDEN unsigned scale_vertical_row_avx2(const float *const *rows, const float *weights, unsigned count, float *output, unsigned length);
+#endif
+
+#ifdef SAIL_HAVE_NEON
+SAIL_HIDDEN void scale_horizontal_row1_neon(const float *input, float *output, unsigned output_width, const struct scale_contributions *contributions);
+
+SAIL_HIDDEN void scale_horizontal_row4_neon(const float *input, float *output, unsigned output_width, const struct scale_contributions *contributions);
+
+SAIL_HIDDEN unsigned scale_vertical_row_neon(const float *const *rows, const float *weights, unsigned count, float *output, unsigned length);
+#endif
+
+#endif
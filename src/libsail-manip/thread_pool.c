@@ -0,0 +1,401 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "sail-manip.h"
+
+/*
+ * Private functions.
+ */
+
+static sail_status_t run_band(band_function_t band_function, void *context, unsigned height, unsigned bands, unsigned band) {
+
+    const unsigned first_row = (unsigned)((uint64_t)height * band / bands);
+    const unsigned last_row  = (unsigned)((uint64_t)height * (band + 1) / bands);
+
+    SAIL_TRY(band_function(context, first_row, last_row - first_row));
+
+    return SAIL_OK;
+}
+
+#ifdef SAIL_THREAD_SAFE
+
+/* Upper limit of worker threads in the pool. */
+#define THREAD_POOL_MAX_WORKERS 63
+
+/*
+ * A job submitted to the pool. Lives on the stack of the submitting thread
+ * until all of its bands are finished.
+ */
+struct band_job {
+
+    band_function_t band_function;
+    void *context;
+    unsigned height;
+    unsigned bands;
+
+    /* The next band to hand out. */
+    unsigned next_band;
+    unsigned finished_bands;
+
+    /* The first failed band in the band order and its status. */
+    unsigned failed_band;
+    sail_status_t status;
+
+    struct band_job *next;
+};
+
+struct thread_pool {
+
+    sail_mutex_t mutex;
+
+    /* Signaled when a new job is queued. */
+    sail_condition_t work_available;
+
+    /* Broadcasted when the last band of a job is finished. */
+    sail_condition_t work_finished;
+
+    /* Jobs with bands not handed out yet. */
+    struct band_job *jobs;
+
+    /* Workers exit when there are no more jobs. */
+    bool stop;
+
+    unsigned workers_count;
+    sail_thread_t workers[THREAD_POOL_MAX_WORKERS];
+};
+
+enum ThreadPoolState {
+    THREAD_POOL_NOT_STARTED,
+    THREAD_POOL_RUNNING,
+    THREAD_POOL_UNAVAILABLE,
+};
+
+static struct thread_pool global_thread_pool;
+
+/* One of ThreadPoolState. Accessed atomically, and changed only with the guard mutex locked. */
+static long global_thread_pool_state = THREAD_POOL_NOT_STARTED;
+
+/* Serializes starting and stopping the pool. */
+static sail_mutex_t global_thread_pool_guard;
+
+static bool global_thread_pool_guard_initialized = false;
+
+/*
+ * Locks the pool mutex while a job is published. The job lives on the stack of the submitting thread
+ * and other threads may still work on it, so neither the submitting thread nor a worker can back out.
+ */
+static void lock_thread_pool_or_abort(void) {
+
+    if (sail_lock_mutex(&global_thread_pool.mutex) != SAIL_OK) {
+        SAIL_LOG_ERROR("Failed to lock the thread pool with a job in progress. Aborting");
+        abort();
+    }
+}
+
+/* Must be called with the pool mutex locked. */
+static void remove_job(struct band_job *job) {
+
+    for (struct band_job **it = &global_thread_pool.jobs; *it != NULL; it = &(*it)->next) {
+        if (*it == job) {
+            *it = job->next;
+            return;
+        }
+    }
+}
+
+/* Must be called with the pool mutex locked. */
+static unsigned take_band(struct band_job *job) {
+
+    const unsigned band = job->next_band++;
+
+    if (job->next_band == job->bands) {
+        remove_job(job);
+    }
+
+    return band;
+}
+
+/* Must be called with the pool mutex locked. */
+static void finish_band(struct band_job *job, unsigned band, sail_status_t status) {
+
+    if (status != SAIL_OK && band < job->failed_band) {
+        job->failed_band = band;
+        job->status = status;
+    }
+
+    if (++job->finished_bands == job->bands) {
+        sail_broadcast_condition(&global_thread_pool.work_finished);
+    }
+}
+
+static void worker_routine(void *arg) {
+
+    (void)arg;
+
+    SAIL_TRY_OR_EXECUTE(sail_lock_mutex(&global_thread_pool.mutex),
+                        /* on error */ return);
+
+    for (;;) {
+        while (global_thread_pool.jobs == NULL && !global_thread_pool.stop) {
+            SAIL_TRY_OR_EXECUTE(sail_wait_condition(&global_thread_pool.work_available, &global_thread_pool.mutex),
+                                /* on error */ sail_unlock_mutex(&global_thread_pool.mutex); return);
+        }
+
+        /* Stop only when all the queued jobs are handed out. */
+        if (global_thread_pool.jobs == NULL) {
+            break;
+        }
+
+        struct band_job *job = global_thread_pool.jobs;
+        const unsigned band = take_band(job);
+
+        sail_unlock_mutex(&global_thread_pool.mutex);
+
+        const sail_status_t status = run_band(job->band_function, job->context, job->height, job->bands, band);
+
+        lock_thread_pool_or_abort();
+
+        finish_band(job, band, status);
+    }
+
+    sail_unlock_mutex(&global_thread_pool.mutex);
+}
+
+/* Must be called with the guard mutex locked. Returns true if at least one worker is started. */
+static bool start_global_thread_pool(void) {
+
+    const unsigned cpu_count = sail_cpu_count();
+    const unsigned workers_count = cpu_count - 1 > THREAD_POOL_MAX_WORKERS ? THREAD_POOL_MAX_WORKERS : cpu_count - 1;
+
+    if (workers_count == 0) {
+        return false;
+    }
+
+    global_thread_pool.jobs = NULL;
+    global_thread_pool.stop = false;
+
+    SAIL_TRY_OR_EXECUTE(sail_init_mutex(&global_thread_pool.mutex),
+                        /* on error */ return false);
+    SAIL_TRY_OR_EXECUTE(sail_init_condition(&global_thread_pool.work_available),
+                        /* on error */ sail_destroy_mutex(&global_thread_pool.mutex); return false);
+    SAIL_TRY_OR_EXECUTE(sail_init_condition(&global_thread_pool.work_finished),
+                        /* on error */ sail_destroy_condition(&global_thread_pool.work_available);
+                                       sail_destroy_mutex(&global_thread_pool.mutex);
+                                       return false);
+
+    /* The workers sleep on the condition variable when there is no work. */
+    for (global_thread_pool.workers_count = 0; global_thread_pool.workers_count < workers_count; global_thread_pool.workers_count++) {
+        SAIL_TRY_OR_EXECUTE(sail_create_thread(&global_thread_pool.workers[global_thread_pool.workers_count], worker_routine, NULL),
+                            /* on error */ break);
+    }
+
+    if (global_thread_pool.workers_count == 0) {
+        sail_destroy_condition(&global_thread_pool.work_finished);
+        sail_destroy_condition(&global_thread_pool.work_available);
+        sail_destroy_mutex(&global_thread_pool.mutex);
+        return false;
+    }
+
+    SAIL_LOG_DEBUG("Started %u conversion worker threads", global_thread_pool.workers_count);
+
+    return true;
+}
+
+/* Must be called with the guard mutex locked. */
+static void stop_global_thread_pool(void) {
+
+    SAIL_TRY_OR_EXECUTE(sail_lock_mutex(&global_thread_pool.mutex),
+                        /* on error */ SAIL_LOG_ERROR("Failed to stop the conversion worker threads"); return);
+    global_thread_pool.stop = true;
+    sail_broadcast_condition(&global_thread_pool.work_available);
+    sail_unlock_mutex(&global_thread_pool.mutex);
+
+    for (unsigned i = 0; i < global_thread_pool.workers_count; i++) {
+        sail_join_thread(&global_thread_pool.workers[i]);
+    }
+
+    sail_destroy_condition(&global_thread_pool.work_finished);
+    sail_destroy_condition(&global_thread_pool.work_available);
+    sail_destroy_mutex(&global_thread_pool.mutex);
+
+    SAIL_LOG_DEBUG("Stopped %u conversion worker threads", global_thread_pool.workers_count);
+
+    global_thread_pool.workers_count = 0;
+
+    sail_atomic_store_long(&global_thread_pool_state, THREAD_POOL_NOT_STARTED);
+}
+
+/* Must be called by sail_call_once() to guarantee atomic operation. */
+static void initialize_global_thread_pool_guard_callback(void) {
+
+    global_thread_pool_guard_initialized = sail_init_mutex(&global_thread_pool_guard) == SAIL_OK;
+}
+
+static bool initialize_global_thread_pool(void) {
+
+    /* Fast path. */
+    const long state = sail_atomic_load_long(&global_thread_pool_state);
+
+    if (state != THREAD_POOL_NOT_STARTED) {
+        return state == THREAD_POOL_RUNNING;
+    }
+
+    static sail_once_flag_t once_flag = SAIL_ONCE_DEFAULT_VALUE;
+    SAIL_TRY_OR_EXECUTE(sail_call_once(&once_flag, initialize_global_thread_pool_guard_callback),
+                        /* on error */ return false);
+
+    if (!global_thread_pool_guard_initialized) {
+        return false;
+    }
+
+    SAIL_TRY_OR_EXECUTE(sail_lock_mutex(&global_thread_pool_guard),
+                        /* on error */ return false);
+
+    if (sail_atomic_load_long(&global_thread_pool_state) == THREAD_POOL_NOT_STARTED) {
+        sail_atomic_store_long(&global_thread_pool_state,
+                               start_global_thread_pool() ? THREAD_POOL_RUNNING : THREAD_POOL_UNAVAILABLE);
+    }
+
+    const bool running = sail_atomic_load_long(&global_thread_pool_state) == THREAD_POOL_RUNNING;
+
+    sail_unlock_mutex(&global_thread_pool_guard);
+
+    return running;
+}
+
+static sail_status_t run_job(struct band_job *job) {
+
+    /* The job is not published yet, so it's safe to return. */
+    SAIL_TRY(sail_lock_mutex(&global_thread_pool.mutex));
+
+    job->next = global_thread_pool.jobs;
+    global_thread_pool.jobs = job;
+
+    sail_broadcast_condition(&global_thread_pool.work_available);
+
+    /* The calling thread processes the bands of its own job too. */
+    while (job->next_band < job->bands) {
+        const unsigned band = take_band(job);
+
+        sail_unlock_mutex(&global_thread_pool.mutex);
+
+        const sail_status_t status = run_band(job->band_function, job->context, job->height, job->bands, band);
+
+        lock_thread_pool_or_abort();
+
+        finish_band(job, band, status);
+    }
+
+    /* Workers may still run the bands of the job. Wait for them whatever happens. */
+    while (job->finished_bands < job->bands) {
+        if (sail_wait_condition(&global_thread_pool.work_finished, &global_thread_pool.mutex) != SAIL_OK) {
+            SAIL_LOG_ERROR("Failed to wait for the conversion worker threads. Aborting");
+            abort();
+        }
+    }
+
+    sail_unlock_mutex(&global_thread_pool.mutex);
+
+    return SAIL_OK;
+}
+
+#endif
+
+/*
+ * Public functions.
+ */
+
+void thread_pool_finish(void) {
+
+#ifdef SAIL_THREAD_SAFE
+    if (sail_atomic_load_long(&global_thread_pool_state) == THREAD_POOL_NOT_STARTED) {
+        return;
+    }
+
+    SAIL_TRY_OR_EXECUTE(sail_lock_mutex(&global_thread_pool_guard),
+                        /* on error */ return);
+
+    const long state = sail_atomic_load_long(&global_thread_pool_state);
+
+    if (state == THREAD_POOL_RUNNING) {
+        stop_global_thread_pool();
+    } else if (state == THREAD_POOL_UNAVAILABLE) {
+        /* Try again on the next conversion. */
+        sail_atomic_store_long(&global_thread_pool_state, THREAD_POOL_NOT_STARTED);
+    }
+
+    sail_unlock_mutex(&global_thread_pool_guard);
+#endif
+}
+
+unsigned thread_pool_concurrency(void) {
+
+#ifdef SAIL_THREAD_SAFE
+    if (initialize_global_thread_pool()) {
+        return global_thread_pool.workers_count + 1;
+    }
+#endif
+
+    return 1;
+}
+
+sail_status_t thread_pool_run_bands(unsigned height, unsigned bands, band_function_t band_function, void *context) {
+
+    SAIL_CHECK_PTR(band_function);
+
+    if (bands == 0) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+
+#ifdef SAIL_THREAD_SAFE
+    if (bands > 1 && initialize_global_thread_pool()) {
+        struct band_job job = {
+            band_function,
+            context,
+            height,
+            bands,
+            0,          /* next_band */
+            0,          /* finished_bands */
+            bands,      /* failed_band */
+            SAIL_OK,    /* status */
+            NULL        /* next */
+        };
+
+        SAIL_TRY(run_job(&job));
+
+        return job.status;
+    }
+#endif
+
+    for (unsigned band = 0; band < bands; band++) {
+        SAIL_TRY(run_band(band_function, context, height, bands, band));
+    }
+
+    return SAIL_OK;
+}
@@ -0,0 +1,65 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SAIL_THREAD_POOL_H
+#define SAIL_THREAD_POOL_H
+
+#ifdef SAIL_BUILD
+    #include "error.h"
+    #include "export.h"
+#else
+    #include <sail-common/error.h>
+    #include <sail-common/export.h>
+#endif
+
+/*
+ * Processes the specified number of rows starting with first_row.
+ */
+typedef sail_status_t (*band_function_t)(void *context, unsigned first_row, unsigned rows);
+
+/*
+ * Returns the maximum number of bands that can be processed simultaneously, including
+ * the calling thread. Returns 1 when SAIL is built without SAIL_THREAD_SAFE or when
+ * the pool of worker threads is not available.
+ */
+SAIL_HIDDEN unsigned thread_pool_concurrency(void);
+
+/*
+ * Splits the rows [0, height) into the specified number of contiguous bands of almost equal size
+ * and runs the band function on them using the pool of worker threads and the calling thread.
+ * Blocks until all the bands are processed. The band function MUST NOT touch rows outside
+ * of its band.
+ *
+ * Returns the status of the first failed band in the band order or SAIL_OK.
+ */
+SAIL_HIDDEN sail_status_t thread_pool_run_bands(unsigned height, unsigned bands, band_function_t band_function, void *context);
+
+/*
+ * Stops the worker threads and waits for them to exit. The pool is started again on demand.
+ * No bands must be in progress.
+ */
+SAIL_HIDDEN void thread_pool_finish(void);
+
+#endif
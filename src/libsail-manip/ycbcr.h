@@ -36,8 +36,40 @@
     #include <sail-common/pixel.h>
 #endif
 
+/*
+ * Q14 fixed-point coefficients of the full range YCbCr <-> RGB conversion used by JPEG.
+ * Scalar and SIMD conversions share them to produce identical results.
+ *
+ * See also https://en.wikipedia.org/wiki/YCbCr
+ */
+#define YCBCR_FIXED_BITS 14
+#define YCBCR_FIXED_HALF (1 << (YCBCR_FIXED_BITS - 1))
+
+#define YCBCR_CR_R   22970 /*  1.40200   */
+#define YCBCR_CB_G   -5638 /* -0.34414   */
+#define YCBCR_CR_G  -11700 /* -0.71414   */
+#define YCBCR_CB_B   29032 /*  1.77200   */
+
+#define YCBCR_R_Y     4899 /*  0.299000  */
+#define YCBCR_G_Y     9617 /*  0.587000  */
+#define YCBCR_B_Y     1868 /*  0.114000  */
+#define YCBCR_R_CB   -2765 /* -0.168736  */
+#define YCBCR_G_CB   -5427 /* -0.331264  */
+#define YCBCR_B_CB    8192 /*  0.500000  */
+#define YCBCR_R_CR    8192 /*  0.500000  */
+#define YCBCR_G_CR   -6860 /* -0.418688  */
+#define YCBCR_B_CR   -1332 /* -0.081312  */
+
 SAIL_HIDDEN void convert_ycbcr24_to_rgba32(uint8_t y, uint8_t cb, uint8_t cr, sail_rgba32_t *rgba32);
 
 SAIL_HIDDEN void convert_rgba32_to_ycbcr24(const sail_rgba32_t *rgba32, uint8_t *y, uint8_t *cb, uint8_t *cr);
 
+/*
+ * Convert whole scan lines. Use SIMD instructions when available. The results are identical
+ * to the per-pixel functions above.
+ */
+SAIL_HIDDEN void convert_ycbcr24_to_rgba32_row(const uint8_t *scan_input, sail_rgba32_t *rgba32, unsigned width);
+
+SAIL_HIDDEN void convert_rgba32_to_ycbcr24_row(const sail_rgba32_t *rgba32, uint8_t *scan_output, unsigned width);
+
 #endif
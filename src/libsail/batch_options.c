@@ -0,0 +1,55 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include "sail-common.h"
+#include "sail.h"
+
+/* 64 MiB of cached pixel buffers per thread. */
+#define BATCH_DEFAULT_PIXEL_POOL_SIZE ((size_t)64 * 1024 * 1024)
+
+sail_status_t sail_alloc_batch_options(struct sail_batch_options **batch_options) {
+
+    SAIL_CHECK_PTR(batch_options);
+
+    void *ptr;
+    SAIL_TRY(sail_malloc(sizeof(struct sail_batch_options), &ptr));
+    *batch_options = ptr;
+
+    (*batch_options)->threads         = 0;
+    (*batch_options)->order           = SAIL_BATCH_ORDER_COMPLETION;
+    (*batch_options)->load_options    = NULL;
+    (*batch_options)->pixel_pool_size = BATCH_DEFAULT_PIXEL_POOL_SIZE;
+
+    return SAIL_OK;
+}
+
+void sail_destroy_batch_options(struct sail_batch_options *batch_options) {
+
+    if (batch_options == NULL) {
+        return;
+    }
+
+    sail_free(batch_options);
+}
@@ -0,0 +1,107 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SAIL_BATCH_OPTIONS_H
+#define SAIL_BATCH_OPTIONS_H
+
+#include <stddef.h>
+
+#ifdef SAIL_BUILD
+    #include "error.h"
+    #include "export.h"
+#else
+    #include <sail-common/error.h>
+    #include <sail-common/export.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct sail_load_options;
+
+/*
+ * Order of delivering loaded images to the batch callback.
+ */
+enum SailBatchOrder {
+
+    /* Deliver images as soon as they are loaded. */
+    SAIL_BATCH_ORDER_COMPLETION,
+
+    /* Deliver images in the order of the sources. Loaded images wait for the preceding ones. */
+    SAIL_BATCH_ORDER_INPUT,
+};
+
+/*
+ * Options to control batch loading behavior.
+ */
+struct sail_batch_options {
+
+    /*
+     * Maximum number of threads including the calling thread to load the images with.
+     * If zero, the number of CPUs is assumed. SAIL never starts more threads than sources.
+     */
+    unsigned threads;
+
+    /*
+     * Order of delivering loaded images to the callback.
+     */
+    enum SailBatchOrder order;
+
+    /*
+     * Load options to load every image with. If NULL, codec-specific defaults are used.
+     * The load options MUST stay valid until the batch is finished.
+     */
+    const struct sail_load_options *load_options;
+
+    /*
+     * Maximum size in bytes of pixel buffers cached by the pixel pool of every thread.
+     * Buffers of destroyed images return to the pool and get reused for the next images.
+     * Ignored if the load options specify their own pixel allocator. If zero, the pools are disabled.
+     */
+    size_t pixel_pool_size;
+};
+
+typedef struct sail_batch_options sail_batch_options_t;
+
+/*
+ * Allocates new batch options.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_alloc_batch_options(struct sail_batch_options **batch_options);
+
+/*
+ * Destroys the specified batch options. The options MUST NOT be used anymore after calling
+ * this function. Does nothing if the options is NULL.
+ */
+SAIL_EXPORT void sail_destroy_batch_options(struct sail_batch_options *batch_options);
+
+/* extern "C" */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -142,6 +142,18 @@ static sail_status_t load_codec_from_file(const struct sail_codec_info *codec_in
     SAIL_RESOLVE(codec->v7->save_frame,           handle, sail_codec_save_frame_v7,           codec_info->name);
     SAIL_RESOLVE(codec->v7->save_finish,          handle, sail_codec_save_finish_v7,          codec_info->name);
 
+    /* Optional functions. */
+    codec->v7->load_frame_rows = NULL;
+    codec->v7->save_frame_rows = NULL;
+
+    if (codec_info->load_features->features & SAIL_CODEC_FEATURE_ROWS) {
+        SAIL_RESOLVE(codec->v7->load_frame_rows, handle, sail_codec_load_frame_rows_v7, codec_info->name);
+    }
+
+    if (codec_info->save_features->features & SAIL_CODEC_FEATURE_ROWS) {
+        SAIL_RESOLVE(codec->v7->save_frame_rows, handle, sail_codec_save_frame_rows_v7, codec_info->name);
+    }
+
     return SAIL_OK;
 }
 
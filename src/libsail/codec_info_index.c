@@ -0,0 +1,166 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <ctype.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "sail.h"
+
+/*
+ * Private functions.
+ */
+
+struct sail_codec_info_index_entry {
+
+    uint64_t hash;
+
+    /* Lower case key owned by the codec info. NULL for empty slots. */
+    const char *key;
+
+    const struct sail_codec_info *codec_info;
+};
+
+/* djb2 over lower case characters. */
+static uint64_t lower_case_string_hash(const char *str) {
+
+    const unsigned char *ustr = (const unsigned char *)str;
+
+    uint64_t hash = 5381;
+    unsigned c;
+
+    while ((c = *ustr++) != 0) {
+        hash = ((hash << 5) + hash) + (unsigned)tolower(c);
+    }
+
+    return hash;
+}
+
+/* Compares the lower case key against the string in any case. */
+static bool equal_to_lower_case_key(const char *lower_case_key, const char *str) {
+
+    const unsigned char *ukey = (const unsigned char *)lower_case_key;
+    const unsigned char *ustr = (const unsigned char *)str;
+
+    for (; *ukey != '\0'; ukey++, ustr++) {
+        if (*ukey != (unsigned)tolower(*ustr)) {
+            return false;
+        }
+    }
+
+    return *ustr == '\0';
+}
+
+static struct sail_codec_info_index_entry* find_entry(const struct sail_codec_info_index *codec_info_index,
+                                                      const char *key, uint64_t hash) {
+
+    const size_t mask = codec_info_index->capacity - 1;
+
+    for (size_t i = (size_t)hash & mask;; i = (i + 1) & mask) {
+        struct sail_codec_info_index_entry *entry = &codec_info_index->entries[i];
+
+        if (entry->key == NULL || (entry->hash == hash && equal_to_lower_case_key(entry->key, key))) {
+            return entry;
+        }
+    }
+}
+
+/*
+ * Public functions.
+ */
+
+sail_status_t alloc_codec_info_index(const struct sail_codec_bundle_node *codec_bundle_node,
+                                     codec_info_index_keys_t keys,
+                                     struct sail_codec_info_index **codec_info_index) {
+
+    SAIL_CHECK_PTR(keys);
+    SAIL_CHECK_PTR(codec_info_index);
+
+    size_t keys_count = 0;
+
+    for (const struct sail_codec_bundle_node *node = codec_bundle_node; node != NULL; node = node->next) {
+        for (const struct sail_string_node *key_node = keys(node->codec_bundle->codec_info); key_node != NULL; key_node = key_node->next) {
+            keys_count++;
+        }
+    }
+
+    /* Keep the load factor under 50% to guarantee empty slots and short probes. */
+    size_t capacity = 8;
+
+    while (capacity < keys_count * 2) {
+        capacity *= 2;
+    }
+
+    void *ptr;
+    SAIL_TRY(sail_malloc(sizeof(struct sail_codec_info_index), &ptr));
+    struct sail_codec_info_index *index = ptr;
+
+    SAIL_TRY_OR_CLEANUP(sail_malloc(sizeof(struct sail_codec_info_index_entry) * capacity, &ptr),
+                        /* cleanup */ sail_free(index));
+    index->entries  = ptr;
+    index->capacity = capacity;
+
+    memset(index->entries, 0, sizeof(struct sail_codec_info_index_entry) * capacity);
+
+    for (const struct sail_codec_bundle_node *node = codec_bundle_node; node != NULL; node = node->next) {
+        const struct sail_codec_info *codec_info = node->codec_bundle->codec_info;
+
+        for (const struct sail_string_node *key_node = keys(codec_info); key_node != NULL; key_node = key_node->next) {
+            const uint64_t hash = lower_case_string_hash(key_node->string);
+            struct sail_codec_info_index_entry *entry = find_entry(index, key_node->string, hash);
+
+            /* Higher priority codecs are inserted first. */
+            if (entry->key == NULL) {
+                entry->hash       = hash;
+                entry->key        = key_node->string;
+                entry->codec_info = codec_info;
+            }
+        }
+    }
+
+    *codec_info_index = index;
+
+    return SAIL_OK;
+}
+
+void destroy_codec_info_index(struct sail_codec_info_index *codec_info_index) {
+
+    if (codec_info_index == NULL) {
+        return;
+    }
+
+    sail_free(codec_info_index->entries);
+    sail_free(codec_info_index);
+}
+
+const struct sail_codec_info* codec_info_index_find(const struct sail_codec_info_index *codec_info_index,
+                                                    const char *key) {
+
+    const struct sail_codec_info_index_entry *entry = find_entry(codec_info_index, key, lower_case_string_hash(key));
+
+    return entry->codec_info;
+}
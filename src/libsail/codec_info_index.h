@@ -0,0 +1,84 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SAIL_CODEC_INFO_INDEX_H
+#define SAIL_CODEC_INFO_INDEX_H
+
+#include <stddef.h>
+
+#ifdef SAIL_BUILD
+    #include "error.h"
+    #include "export.h"
+#else
+    #include <sail-common/error.h>
+    #include <sail-common/export.h>
+#endif
+
+struct sail_codec_bundle_node;
+struct sail_codec_info;
+struct sail_codec_info_index_entry;
+struct sail_string_node;
+
+/*
+ * Immutable open addressing hash index from lower case strings like file extensions
+ * to codec info objects. Built once after codecs are enumerated. Lookups are
+ * case-insensitive and never allocate.
+ */
+struct sail_codec_info_index {
+
+    /* Power of two number of slots. */
+    struct sail_codec_info_index_entry *entries;
+    size_t capacity;
+};
+
+/*
+ * Returns the list of keys to index for the specified codec info.
+ */
+typedef const struct sail_string_node* (*codec_info_index_keys_t)(const struct sail_codec_info *codec_info);
+
+/*
+ * Builds a new index from the keys of the specified codec bundles. Codec bundles must be sorted by priority.
+ * When several codecs share the same key, the first one wins.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_HIDDEN sail_status_t alloc_codec_info_index(const struct sail_codec_bundle_node *codec_bundle_node,
+                                                 codec_info_index_keys_t keys,
+                                                 struct sail_codec_info_index **codec_info_index);
+
+/*
+ * Destroys the specified index.
+ */
+SAIL_HIDDEN void destroy_codec_info_index(struct sail_codec_info_index *codec_info_index);
+
+/*
+ * Finds the codec info by the specified key in any case.
+ *
+ * Returns the found codec info or NULL.
+ */
+SAIL_HIDDEN const struct sail_codec_info* codec_info_index_find(const struct sail_codec_info_index *codec_info_index,
+                                                                const char *key);
+
+#endif
@@ -43,10 +43,16 @@ struct sail_codec_layout_v7 {
     sail_codec_load_frame_v7_t           load_frame;
     sail_codec_load_finish_v7_t          load_finish;
 
+    /* Optional. NULL if the codec doesn't have the SAIL_CODEC_FEATURE_ROWS load feature. */
+    sail_codec_load_frame_rows_v7_t      load_frame_rows;
+
     sail_codec_save_init_v7_t            save_init;
     sail_codec_save_seek_next_frame_v7_t save_seek_next_frame;
     sail_codec_save_frame_v7_t           save_frame;
     sail_codec_save_finish_v7_t          save_finish;
+
+    /* Optional. NULL if the codec doesn't have the SAIL_CODEC_FEATURE_ROWS save feature. */
+    sail_codec_save_frame_rows_v7_t      save_frame_rows;
 };
 
 #endif
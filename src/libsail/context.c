@@ -31,6 +31,7 @@
 
 #include "sail-common.h"
 #include "sail.h"
+#include "sail-manip.h"
 
 sail_status_t sail_init(void) {
 
@@ -57,4 +58,6 @@ sail_status_t sail_unload_codecs(void) {
 void sail_finish(void) {
 
     destroy_global_context();
+
+    sail_stop_conversion_threads();
 }
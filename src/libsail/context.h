@@ -110,8 +110,10 @@ SAIL_EXPORT sail_status_t sail_init_with_flags(int flags);
  * with sail_finish(). Subsequent attempts to load or save images will reload necessary SAIL codecs
  * from disk.
  *
- * Warning: Make sure no loading or saving operations are in progress before calling sail_unload_codecs().
- *          Failure to do so may lead to a crash.
+ * Warning: Make sure no loading or saving operations are in progress before calling sail_unload_codecs(),
+ *          and no new ones are started until it returns. Loaded codecs are looked up without locking,
+ *          so sail_unload_codecs() cannot wait for other threads that use them. Failure to do so
+ *          may lead to a crash.
  *
  * Typical usage: This is a standalone function that can be called at any time.
  *
@@ -126,6 +128,8 @@ SAIL_EXPORT sail_status_t sail_unload_codecs(void);
  * Unloads all codecs. All pointers to codec info objects, load and save features, and codecs
  * get invalidated. Using them after calling sail_finish() will lead to a crash.
  *
+ * Stops the worker threads started by parallel conversions. See sail_stop_conversion_threads().
+ *
  * It's possible to initialize a new global static context afterwards, implicitly or explicitly.
  *
  * Warning: Make sure no loading or saving operations are in progress before calling sail_finish().
@@ -46,15 +46,39 @@
 
 static struct sail_context *global_context = NULL;
 
+/*
+ * The global context published after successful initialization. Readers access it
+ * without locking. It's reset in destroy_global_context().
+ */
+static struct sail_context *initialized_global_context = NULL;
+
+static struct sail_context* load_initialized_global_context(void) {
+
+#ifdef SAIL_THREAD_SAFE
+    return sail_atomic_load_pointer((void **)&initialized_global_context);
+#else
+    return initialized_global_context;
+#endif
+}
+
+static void store_initialized_global_context(struct sail_context *context) {
+
+#ifdef SAIL_THREAD_SAFE
+    sail_atomic_store_pointer((void **)&initialized_global_context, context);
+#else
+    initialized_global_context = context;
+#endif
+}
+
 #ifdef SAIL_THREAD_SAFE
 static sail_mutex_t global_context_guard_mutex;
 
 static bool global_context_guard_mutex_initialized = false;
 
-/* Must be called by threading_call_once() to guarantee atomic operation. */
+/* Must be called by sail_call_once() to guarantee atomic operation. */
 static void initialize_global_context_guard_mutex_callback(void) {
 
-    SAIL_TRY_OR_EXECUTE(threading_init_mutex(&global_context_guard_mutex),
+    SAIL_TRY_OR_EXECUTE(sail_init_mutex(&global_context_guard_mutex),
                         /* on error */ return);
 
     SAIL_LOG_DEBUG("Allocated new global context mutex");
@@ -65,7 +89,7 @@ static void initialize_global_context_guard_mutex_callback(void) {
 static sail_status_t initialize_global_context_guard_mutex(void) {
 
     static sail_once_flag_t once_flag = SAIL_ONCE_DEFAULT_VALUE;
-    SAIL_TRY(threading_call_once(&once_flag, initialize_global_context_guard_mutex_callback));
+    SAIL_TRY(sail_call_once(&once_flag, initialize_global_context_guard_mutex_callback));
 
     if (!global_context_guard_mutex_initialized) {
         SAIL_LOG_AND_RETURN(SAIL_ERROR_CONTEXT_UNINITIALIZED);
@@ -185,6 +209,16 @@ static sail_status_t client_codecs_paths_to_string_node_chain(struct sail_string
 }
 #endif
 
+static const struct sail_string_node* codec_info_extensions(const struct sail_codec_info *codec_info) {
+
+    return codec_info->extension_node;
+}
+
+static const struct sail_string_node* codec_info_mime_types(const struct sail_codec_info *codec_info) {
+
+    return codec_info->mime_type_node;
+}
+
 static sail_status_t alloc_context(struct sail_context **context) {
 
     SAIL_CHECK_PTR(context);
@@ -193,8 +227,11 @@ static sail_status_t alloc_context(struct sail_context **context) {
     SAIL_TRY(sail_malloc(sizeof(struct sail_context), &ptr));
     *context = ptr;
 
-    (*context)->initialized     = false;
-    (*context)->codec_bundle_node = NULL;
+    (*context)->initialized          = false;
+    (*context)->codec_bundle_node    = NULL;
+    (*context)->magic_number_matcher = NULL;
+    (*context)->extension_index      = NULL;
+    (*context)->mime_type_index      = NULL;
 
     return SAIL_OK;
 }
@@ -213,13 +250,26 @@ static sail_status_t allocate_global_context(struct sail_context **context) {
     return SAIL_OK;
 }
 
+static void destroy_context_members(struct sail_context *context) {
+
+    destroy_codec_info_index(context->mime_type_index);
+    destroy_codec_info_index(context->extension_index);
+    destroy_magic_number_matcher(context->magic_number_matcher);
+    destroy_codec_bundle_node_chain(context->codec_bundle_node);
+
+    context->mime_type_index      = NULL;
+    context->extension_index      = NULL;
+    context->magic_number_matcher = NULL;
+    context->codec_bundle_node    = NULL;
+}
+
 static sail_status_t destroy_context(struct sail_context *context) {
 
     if (context == NULL) {
         return SAIL_OK;
     }
 
-    destroy_codec_bundle_node_chain(context->codec_bundle_node);
+    destroy_context_members(context);
     sail_free(context);
 
     return SAIL_OK;
@@ -741,21 +791,8 @@ static void print_build_statistics(void) {
 #endif
 }
 
-/* Initializes the context and loads all the codec info files if the context is not initialized. */
-static sail_status_t init_context(struct sail_context *context, int flags) {
-
-    SAIL_CHECK_PTR(context);
-
-    if (context->initialized) {
-        return SAIL_OK;
-    }
-
-    context->initialized = true;
-
-    /* Time counter. */
-    uint64_t start_time = sail_now();
-
-    print_build_statistics();
+/* Loads all the codec info files, and builds the lookup tables. */
+static sail_status_t init_context_members(struct sail_context *context) {
 
     /* Always search DLLs in the sail.dll location so custom codecs can hold dependencies there. */
 #ifdef SAIL_WIN32
@@ -775,6 +812,38 @@ static sail_status_t init_context(struct sail_context *context, int flags) {
 
     SAIL_TRY(print_enumerated_codecs(context));
 
+    SAIL_TRY(alloc_magic_number_matcher(context->codec_bundle_node, &context->magic_number_matcher));
+    SAIL_TRY(alloc_codec_info_index(context->codec_bundle_node, codec_info_extensions, &context->extension_index));
+    SAIL_TRY(alloc_codec_info_index(context->codec_bundle_node, codec_info_mime_types, &context->mime_type_index));
+
+    return SAIL_OK;
+}
+
+/* Initializes the context and loads all the codec info files if the context is not initialized. */
+static sail_status_t init_context(struct sail_context *context, int flags) {
+
+    SAIL_CHECK_PTR(context);
+
+    if (context->initialized) {
+        return SAIL_OK;
+    }
+
+    /* Time counter. */
+    uint64_t start_time = sail_now();
+
+    print_build_statistics();
+
+    /* Start from scratch on the next attempt if something fails. */
+    SAIL_TRY_OR_CLEANUP(init_context_members(context),
+                        /* cleanup */ destroy_context_members(context));
+
+    /*
+     * Mark the context initialized only when all its members are ready. It's published to the lock-free
+     * fast path in fetch_global_context_guarded_with_flags() only after that. Preloading codecs below
+     * fetches the context again and must see it initialized.
+     */
+    context->initialized = true;
+
     if (flags & SAIL_FLAG_PRELOAD_CODECS) {
         SAIL_TRY(preload_codecs(context));
     }
@@ -784,15 +853,12 @@ static sail_status_t init_context(struct sail_context *context, int flags) {
     return SAIL_OK;
 }
 
-/*
- * Public functions.
- */
-
 sail_status_t destroy_global_context(void) {
 
     SAIL_TRY(lock_context());
 
     SAIL_LOG_DEBUG("Destroyed context %p", global_context);
+    store_initialized_global_context(NULL);
     destroy_context(global_context);
     global_context = NULL;
 
@@ -819,6 +885,14 @@ sail_status_t fetch_global_context_guarded_with_flags(struct sail_context **cont
 
     SAIL_CHECK_PTR(context);
 
+    /* Fast path. */
+    struct sail_context *initialized_context = load_initialized_global_context();
+
+    if (initialized_context != NULL) {
+        *context = initialized_context;
+        return SAIL_OK;
+    }
+
     SAIL_TRY(lock_context());
 
     SAIL_TRY_OR_CLEANUP(fetch_global_context_unsafe_with_flags(context, flags),
@@ -838,6 +912,8 @@ sail_status_t fetch_global_context_unsafe_with_flags(struct sail_context **conte
     SAIL_TRY(allocate_global_context(&local_context));
     SAIL_TRY(init_context(local_context, flags));
 
+    store_initialized_global_context(local_context);
+
     *context = local_context;
 
     return SAIL_OK;
@@ -862,9 +938,20 @@ sail_status_t sail_unload_codecs_private(void) {
     for (struct sail_codec_bundle_node *codec_bundle_node = context->codec_bundle_node; codec_bundle_node != NULL; codec_bundle_node = codec_bundle_node->next) {
         struct sail_codec_bundle *codec_bundle = codec_bundle_node->codec_bundle;
 
-        if (codec_bundle->codec != NULL) {
-            destroy_codec(codec_bundle->codec);
+        struct sail_codec *codec = codec_bundle->codec;
+
+        if (codec != NULL) {
+            /*
+             * Unpublish the codec before destroying it so lock-free readers in load_codec_by_codec_info()
+             * never pick up a destroyed codec. Readers that have picked it up earlier are not tracked,
+             * see the sail_unload_codecs() contract.
+             */
+#ifdef SAIL_THREAD_SAFE
+            sail_atomic_store_pointer((void **)&codec_bundle->codec, NULL);
+#else
             codec_bundle->codec = NULL;
+#endif
+            destroy_codec(codec);
             counter++;
         }
     }
@@ -881,7 +968,7 @@ sail_status_t lock_context(void) {
 #ifdef SAIL_THREAD_SAFE
     SAIL_TRY(initialize_global_context_guard_mutex());
 
-    SAIL_TRY(threading_lock_mutex(&global_context_guard_mutex));
+    SAIL_TRY(sail_lock_mutex(&global_context_guard_mutex));
 #endif
 
     return SAIL_OK;
@@ -890,7 +977,7 @@ sail_status_t lock_context(void) {
 sail_status_t unlock_context(void) {
 
 #ifdef SAIL_THREAD_SAFE
-    SAIL_TRY(threading_unlock_mutex(&global_context_guard_mutex));
+    SAIL_TRY(sail_unlock_mutex(&global_context_guard_mutex));
 #endif
 
     return SAIL_OK;
@@ -37,6 +37,8 @@
 #endif
 
 struct sail_codec_bundle_node;
+struct sail_codec_info_index;
+struct sail_magic_number_matcher;
 
 /*
  * Context is a main entry point to start working with SAIL. It enumerates codec info objects which could be
@@ -49,12 +51,23 @@ struct sail_context {
 
     /* Linked list of found codec info objects. */
     struct sail_codec_bundle_node *codec_bundle_node;
+
+    /* Magic numbers of the found codecs compiled for fast detection. */
+    struct sail_magic_number_matcher *magic_number_matcher;
+
+    /* File extension and MIME type indexes of the found codecs. */
+    struct sail_codec_info_index *extension_index;
+    struct sail_codec_info_index *mime_type_index;
 };
 
 typedef struct sail_context sail_context_t;
 
 SAIL_HIDDEN sail_status_t destroy_global_context(void);
 
+/*
+ * Returns the global context, initializing it if necessary. Once the context is initialized,
+ * it's returned without locking.
+ */
 SAIL_HIDDEN sail_status_t fetch_global_context_guarded(struct sail_context **context);
 
 SAIL_HIDDEN sail_status_t fetch_global_context_unsafe(struct sail_context **context);
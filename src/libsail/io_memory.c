@@ -26,6 +26,7 @@
 #include "config.h"
 
 #include <errno.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -67,6 +68,18 @@ struct mem_io_write_stream {
     void *buffer;
 };
 
+/* The total buffer size is the capacity here. */
+struct mem_io_growing_stream {
+    struct mem_io_buffer_info mem_io_buffer_info;
+
+    /* Caller variables updated on every write. */
+    void **buffer;
+    size_t *buffer_length;
+};
+
+/* The first allocation size of growing buffers. */
+static const size_t GROWING_MEMORY_INITIAL_LENGTH = 64 * 1024;
+
 /*
  * Private functions.
  */
@@ -238,6 +251,195 @@ static sail_status_t io_memory_eof(void *stream, bool *result) {
     return SAIL_OK;
 }
 
+static sail_status_t io_memory_direct_buffer(void *stream, const void **buffer, size_t *buffer_length) {
+
+    SAIL_CHECK_PTR(stream);
+    SAIL_CHECK_PTR(buffer);
+    SAIL_CHECK_PTR(buffer_length);
+
+    const struct mem_io_read_stream *mem_io_read_stream = (const struct mem_io_read_stream *)stream;
+
+    *buffer        = mem_io_read_stream->buffer;
+    *buffer_length = mem_io_read_stream->mem_io_buffer_info.accessible_length;
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_growing_memory_tolerant_read(void *stream, void *buf, size_t size_to_read, size_t *read_size) {
+
+    SAIL_CHECK_PTR(stream);
+    SAIL_CHECK_PTR(buf);
+    SAIL_CHECK_PTR(read_size);
+
+    struct mem_io_growing_stream *mem_io_growing_stream = (struct mem_io_growing_stream *)stream;
+    struct mem_io_buffer_info *mem_io_buffer_info = &mem_io_growing_stream->mem_io_buffer_info;
+
+    *read_size = 0;
+
+    if (mem_io_buffer_info->pos >= mem_io_buffer_info->accessible_length) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_EOF);
+    }
+
+    size_t actual_size_to_read = (mem_io_buffer_info->pos + size_to_read > mem_io_buffer_info->accessible_length)
+                                 ? mem_io_buffer_info->accessible_length - mem_io_buffer_info->pos
+                                 : size_to_read;
+
+    memcpy(buf, (const char *)*mem_io_growing_stream->buffer + mem_io_buffer_info->pos, actual_size_to_read);
+    mem_io_buffer_info->pos += actual_size_to_read;
+
+    *read_size = actual_size_to_read;
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_growing_memory_strict_read(void *stream, void *buf, size_t size_to_read) {
+
+    size_t read_size;
+
+    SAIL_TRY(io_growing_memory_tolerant_read(stream, buf, size_to_read, &read_size));
+
+    if (read_size != size_to_read) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_READ_IO);
+    }
+
+    return SAIL_OK;
+}
+
+/* Grows the buffer geometrically to hold at least the specified number of bytes. */
+static sail_status_t io_growing_memory_reserve(struct mem_io_growing_stream *mem_io_growing_stream, size_t length) {
+
+    struct mem_io_buffer_info *mem_io_buffer_info = &mem_io_growing_stream->mem_io_buffer_info;
+
+    if (length <= mem_io_buffer_info->length) {
+        return SAIL_OK;
+    }
+
+    size_t new_length = mem_io_buffer_info->length == 0 ? GROWING_MEMORY_INITIAL_LENGTH : mem_io_buffer_info->length;
+
+    while (new_length < length) {
+        if (new_length > SIZE_MAX / 2) {
+            new_length = length;
+            break;
+        }
+
+        new_length *= 2;
+    }
+
+    SAIL_TRY(sail_realloc(new_length, mem_io_growing_stream->buffer));
+
+    mem_io_buffer_info->length = new_length;
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_growing_memory_tolerant_write(void *stream, const void *buf, size_t size_to_write, size_t *written_size) {
+
+    SAIL_CHECK_PTR(stream);
+    SAIL_CHECK_PTR(buf);
+    SAIL_CHECK_PTR(written_size);
+
+    struct mem_io_growing_stream *mem_io_growing_stream = (struct mem_io_growing_stream *)stream;
+    struct mem_io_buffer_info *mem_io_buffer_info = &mem_io_growing_stream->mem_io_buffer_info;
+
+    *written_size = 0;
+
+    if (size_to_write > SIZE_MAX - mem_io_buffer_info->pos) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_WRITE_IO);
+    }
+
+    SAIL_TRY(io_growing_memory_reserve(mem_io_growing_stream, mem_io_buffer_info->pos + size_to_write));
+
+    char *buffer = *mem_io_growing_stream->buffer;
+
+    /* Zero the gap after seeking past the end. */
+    if (mem_io_buffer_info->pos > mem_io_buffer_info->accessible_length) {
+        memset(buffer + mem_io_buffer_info->accessible_length, 0, mem_io_buffer_info->pos - mem_io_buffer_info->accessible_length);
+    }
+
+    memcpy(buffer + mem_io_buffer_info->pos, buf, size_to_write);
+    mem_io_buffer_info->pos += size_to_write;
+
+    *written_size = size_to_write;
+
+    if (mem_io_buffer_info->pos > mem_io_buffer_info->accessible_length) {
+        mem_io_buffer_info->accessible_length = mem_io_buffer_info->pos;
+        *mem_io_growing_stream->buffer_length = mem_io_buffer_info->accessible_length;
+    }
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_growing_memory_strict_write(void *stream, const void *buf, size_t size_to_write) {
+
+    size_t written_size;
+
+    SAIL_TRY(io_growing_memory_tolerant_write(stream, buf, size_to_write, &written_size));
+
+    if (written_size != size_to_write) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_WRITE_IO);
+    }
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_growing_memory_seek(void *stream, long offset, int whence) {
+
+    SAIL_CHECK_PTR(stream);
+
+    struct mem_io_buffer_info *mem_io_buffer_info = (struct mem_io_buffer_info *)stream;
+
+    size_t base;
+
+    switch (whence) {
+        case SEEK_SET: {
+            base = 0;
+            break;
+        }
+
+        case SEEK_CUR: {
+            base = mem_io_buffer_info->pos;
+            break;
+        }
+
+        case SEEK_END: {
+            base = mem_io_buffer_info->accessible_length;
+            break;
+        }
+
+        default: {
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_UNSUPPORTED_SEEK_WHENCE);
+        }
+    }
+
+    if (offset < 0 && (size_t)(-(offset + 1)) >= base) {
+        SAIL_LOG_ERROR("Cannot seek before the beginning of the memory buffer");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+
+    /* The buffer grows on the next write. */
+    mem_io_buffer_info->pos = (offset < 0) ? base - (size_t)(-(offset + 1)) - 1 : base + (size_t)offset;
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_growing_memory_close(void *stream) {
+
+    SAIL_CHECK_PTR(stream);
+
+    struct mem_io_growing_stream *mem_io_growing_stream = (struct mem_io_growing_stream *)stream;
+    struct mem_io_buffer_info *mem_io_buffer_info = &mem_io_growing_stream->mem_io_buffer_info;
+
+    /* Release the unused capacity. The buffer itself belongs to the caller. */
+    if (mem_io_buffer_info->accessible_length > 0 && mem_io_buffer_info->accessible_length < mem_io_buffer_info->length) {
+        SAIL_TRY_OR_EXECUTE(sail_realloc(mem_io_buffer_info->accessible_length, mem_io_growing_stream->buffer),
+                            /* on error */ SAIL_LOG_WARNING("Failed to shrink the memory buffer"));
+    }
+
+    sail_free(stream);
+
+    return SAIL_OK;
+}
+
 /*
  * Public functions.
  */
@@ -263,6 +465,7 @@ sail_status_t sail_alloc_io_read_memory(const void *buffer, size_t length, struc
     mem_io_read_stream->buffer                               = buffer;
 
     io_local->id             = SAIL_MEMORY_IO_ID;
+    io_local->features       = SAIL_IO_FEATURE_DIRECT_BUFFER;
     io_local->stream         = mem_io_read_stream;
     io_local->tolerant_read  = io_memory_tolerant_read;
     io_local->strict_read    = io_memory_strict_read;
@@ -273,6 +476,7 @@ sail_status_t sail_alloc_io_read_memory(const void *buffer, size_t length, struc
     io_local->flush          = sail_io_noop_flush;
     io_local->close          = io_memory_close;
     io_local->eof            = io_memory_eof;
+    io_local->direct_buffer  = io_memory_direct_buffer;
 
     *io = io_local;
 
@@ -316,3 +520,46 @@ sail_status_t sail_alloc_io_read_write_memory(void *buffer, size_t length, struc
 
     return SAIL_OK;
 }
+
+sail_status_t sail_alloc_io_write_growing_memory(void **buffer, size_t *buffer_length, struct sail_io **io) {
+
+    SAIL_CHECK_PTR(buffer);
+    SAIL_CHECK_PTR(buffer_length);
+    SAIL_CHECK_PTR(io);
+
+    SAIL_LOG_DEBUG("Opening growing memory buffer for writing");
+
+    struct sail_io *io_local;
+    SAIL_TRY(sail_alloc_io(&io_local));
+
+    void *ptr;
+    SAIL_TRY_OR_CLEANUP(sail_malloc(sizeof(struct mem_io_growing_stream), &ptr),
+                        /* cleanup */ sail_destroy_io(io_local));
+    struct mem_io_growing_stream *mem_io_growing_stream = ptr;
+
+    *buffer        = NULL;
+    *buffer_length = 0;
+
+    mem_io_growing_stream->mem_io_buffer_info.length            = 0;
+    mem_io_growing_stream->mem_io_buffer_info.accessible_length = 0;
+    mem_io_growing_stream->mem_io_buffer_info.pos               = 0;
+    mem_io_growing_stream->buffer                               = buffer;
+    mem_io_growing_stream->buffer_length                        = buffer_length;
+
+    io_local->id             = SAIL_MEMORY_IO_ID;
+    io_local->features       = SAIL_IO_FEATURE_SEEKABLE;
+    io_local->stream         = mem_io_growing_stream;
+    io_local->tolerant_read  = io_growing_memory_tolerant_read;
+    io_local->strict_read    = io_growing_memory_strict_read;
+    io_local->tolerant_write = io_growing_memory_tolerant_write;
+    io_local->strict_write   = io_growing_memory_strict_write;
+    io_local->seek           = io_growing_memory_seek;
+    io_local->tell           = io_memory_tell;
+    io_local->flush          = io_memory_flush;
+    io_local->close          = io_growing_memory_close;
+    io_local->eof            = io_memory_eof;
+
+    *io = io_local;
+
+    return SAIL_OK;
+}
@@ -45,6 +45,8 @@ struct sail_io;
 /*
  * Opens the specified memory buffer for reading and allocates a new I/O object for it.
  *
+ * The I/O object has the SAIL_IO_FEATURE_DIRECT_BUFFER feature.
+ *
  * Returns SAIL_OK on success.
  */
 SAIL_EXPORT sail_status_t sail_alloc_io_read_memory(const void *buffer, size_t length, struct sail_io **io);
@@ -56,6 +58,19 @@ SAIL_EXPORT sail_status_t sail_alloc_io_read_memory(const void *buffer, size_t l
  */
 SAIL_EXPORT sail_status_t sail_alloc_io_read_write_memory(void *buffer, size_t length, struct sail_io **io);
 
+/*
+ * Allocates a new I/O object that writes into a memory buffer growing automatically.
+ * The buffer grows geometrically, so writes have amortized constant cost.
+ *
+ * Assigns NULL and 0 to the specified buffer and buffer length and updates them on every
+ * write. The buffer can be read and written back as well. Closing the I/O object shrinks
+ * the buffer to the written length but doesn't free it. The buffer belongs to the caller
+ * who must free it with sail_free() after closing the I/O object, even if writing failed.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_alloc_io_write_growing_memory(void **buffer, size_t *buffer_length, struct sail_io **io);
+
 /* extern "C" */
 #ifdef __cplusplus
 }
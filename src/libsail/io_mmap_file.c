@@ -0,0 +1,354 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include "config.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef SAIL_WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include "sail.h"
+
+struct mmap_file_stream {
+
+    /* Mapped file data. NULL for empty files. */
+    const unsigned char *data;
+
+    /* Mapped file size. */
+    size_t length;
+
+    /* Current stream position. Can exceed the length after seeking. */
+    size_t pos;
+
+#ifdef SAIL_WIN32
+    HANDLE file;
+    HANDLE mapping;
+#endif
+};
+
+/*
+ * Private functions.
+ */
+
+static sail_status_t io_mmap_file_tolerant_read(void *stream, void *buf, size_t size_to_read, size_t *read_size) {
+
+    SAIL_CHECK_PTR(stream);
+    SAIL_CHECK_PTR(buf);
+    SAIL_CHECK_PTR(read_size);
+
+    struct mmap_file_stream *mmap_file_stream = (struct mmap_file_stream *)stream;
+
+    *read_size = 0;
+
+    if (mmap_file_stream->pos >= mmap_file_stream->length) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_EOF);
+    }
+
+    const size_t available = mmap_file_stream->length - mmap_file_stream->pos;
+    const size_t actual_size_to_read = size_to_read > available ? available : size_to_read;
+
+    memcpy(buf, mmap_file_stream->data + mmap_file_stream->pos, actual_size_to_read);
+    mmap_file_stream->pos += actual_size_to_read;
+
+    *read_size = actual_size_to_read;
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_mmap_file_strict_read(void *stream, void *buf, size_t size_to_read) {
+
+    size_t read_size;
+
+    SAIL_TRY(io_mmap_file_tolerant_read(stream, buf, size_to_read, &read_size));
+
+    if (read_size != size_to_read) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_READ_IO);
+    }
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_mmap_file_seek(void *stream, long offset, int whence) {
+
+    SAIL_CHECK_PTR(stream);
+
+    struct mmap_file_stream *mmap_file_stream = (struct mmap_file_stream *)stream;
+
+    size_t base;
+
+    switch (whence) {
+        case SEEK_SET: {
+            base = 0;
+            break;
+        }
+
+        case SEEK_CUR: {
+            base = mmap_file_stream->pos;
+            break;
+        }
+
+        case SEEK_END: {
+            base = mmap_file_stream->length;
+            break;
+        }
+
+        default: {
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_UNSUPPORTED_SEEK_WHENCE);
+        }
+    }
+
+    if (offset < 0 && (size_t)(-(offset + 1)) >= base) {
+        SAIL_LOG_ERROR("Cannot seek before the beginning of the mapped file");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+
+    mmap_file_stream->pos = offset < 0 ? base - (size_t)(-(offset + 1)) - 1 : base + (size_t)offset;
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_mmap_file_tell(void *stream, size_t *offset) {
+
+    SAIL_CHECK_PTR(stream);
+    SAIL_CHECK_PTR(offset);
+
+    const struct mmap_file_stream *mmap_file_stream = (const struct mmap_file_stream *)stream;
+
+    *offset = mmap_file_stream->pos;
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_mmap_file_close(void *stream) {
+
+    SAIL_CHECK_PTR(stream);
+
+    struct mmap_file_stream *mmap_file_stream = (struct mmap_file_stream *)stream;
+
+#ifdef SAIL_WIN32
+    if (mmap_file_stream->data != NULL) {
+        UnmapViewOfFile(mmap_file_stream->data);
+        CloseHandle(mmap_file_stream->mapping);
+    }
+
+    CloseHandle(mmap_file_stream->file);
+#else
+    if (mmap_file_stream->data != NULL) {
+        munmap((void *)mmap_file_stream->data, mmap_file_stream->length);
+    }
+#endif
+
+    sail_free(mmap_file_stream);
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_mmap_file_eof(void *stream, bool *result) {
+
+    SAIL_CHECK_PTR(stream);
+    SAIL_CHECK_PTR(result);
+
+    const struct mmap_file_stream *mmap_file_stream = (const struct mmap_file_stream *)stream;
+
+    *result = mmap_file_stream->pos >= mmap_file_stream->length;
+
+    return SAIL_OK;
+}
+
+static sail_status_t io_mmap_file_direct_buffer(void *stream, const void **buffer, size_t *buffer_length) {
+
+    SAIL_CHECK_PTR(stream);
+    SAIL_CHECK_PTR(buffer);
+    SAIL_CHECK_PTR(buffer_length);
+
+    const struct mmap_file_stream *mmap_file_stream = (const struct mmap_file_stream *)stream;
+
+    *buffer        = mmap_file_stream->data;
+    *buffer_length = mmap_file_stream->length;
+
+    return SAIL_OK;
+}
+
+#ifdef SAIL_WIN32
+static sail_status_t map_file(const char *path, struct mmap_file_stream *mmap_file_stream) {
+
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+
+    if (file == INVALID_HANDLE_VALUE) {
+        SAIL_LOG_ERROR("Failed to open the specified file. Error: 0x%X", GetLastError());
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_OPEN_FILE);
+    }
+
+    LARGE_INTEGER file_size;
+
+    if (!GetFileSizeEx(file, &file_size)) {
+        SAIL_LOG_ERROR("Failed to get the file size. Error: 0x%X", GetLastError());
+        CloseHandle(file);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_READ_FILE);
+    }
+
+    if ((unsigned long long)file_size.QuadPart > SIZE_MAX) {
+        SAIL_LOG_ERROR("The file is too large to be mapped");
+        CloseHandle(file);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_READ_FILE);
+    }
+
+    mmap_file_stream->file    = file;
+    mmap_file_stream->mapping = NULL;
+    mmap_file_stream->data    = NULL;
+    mmap_file_stream->length  = (size_t)file_size.QuadPart;
+
+    /* Empty files cannot be mapped. */
+    if (mmap_file_stream->length == 0) {
+        return SAIL_OK;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+
+    if (mapping == NULL) {
+        SAIL_LOG_ERROR("Failed to map the file. Error: 0x%X", GetLastError());
+        CloseHandle(file);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_READ_FILE);
+    }
+
+    const void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+    if (data == NULL) {
+        SAIL_LOG_ERROR("Failed to map the file view. Error: 0x%X", GetLastError());
+        CloseHandle(mapping);
+        CloseHandle(file);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_READ_FILE);
+    }
+
+    mmap_file_stream->mapping = mapping;
+    mmap_file_stream->data    = data;
+
+    return SAIL_OK;
+}
+#else
+static sail_status_t map_file(const char *path, struct mmap_file_stream *mmap_file_stream) {
+
+    const int fd = open(path, O_RDONLY);
+
+    if (fd == -1) {
+        sail_print_errno("Failed to open the specified file: %s");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_OPEN_FILE);
+    }
+
+    struct stat st;
+
+    if (fstat(fd, &st) != 0) {
+        sail_print_errno("Failed to get the file size: %s");
+        close(fd);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_READ_FILE);
+    }
+
+    if (!S_ISREG(st.st_mode)) {
+        SAIL_LOG_ERROR("Only regular files can be mapped");
+        close(fd);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_OPEN_FILE);
+    }
+
+    mmap_file_stream->data   = NULL;
+    mmap_file_stream->length = (size_t)st.st_size;
+
+    /* Empty files cannot be mapped. */
+    if (mmap_file_stream->length == 0) {
+        close(fd);
+        return SAIL_OK;
+    }
+
+    void *data = mmap(NULL, mmap_file_stream->length, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    /* The mapping stays valid after closing the descriptor. */
+    close(fd);
+
+    if (data == MAP_FAILED) {
+        sail_print_errno("Failed to map the file: %s");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_READ_FILE);
+    }
+
+    /* Just a hint. Codecs mostly read images from start to end. */
+    posix_madvise(data, mmap_file_stream->length, POSIX_MADV_SEQUENTIAL);
+
+    mmap_file_stream->data = data;
+
+    return SAIL_OK;
+}
+#endif
+
+/*
+ * Public functions.
+ */
+
+sail_status_t sail_alloc_io_read_mmap_file(const char *path, struct sail_io **io) {
+
+    SAIL_CHECK_PTR(path);
+    SAIL_CHECK_PTR(io);
+
+    SAIL_LOG_DEBUG("Mapping file '%s' for reading", path);
+
+    void *ptr;
+    SAIL_TRY(sail_malloc(sizeof(struct mmap_file_stream), &ptr));
+    struct mmap_file_stream *mmap_file_stream = ptr;
+
+    SAIL_TRY_OR_CLEANUP(map_file(path, mmap_file_stream),
+                        /* cleanup */ sail_free(mmap_file_stream));
+
+    mmap_file_stream->pos = 0;
+
+    struct sail_io *io_local;
+    SAIL_TRY_OR_CLEANUP(sail_alloc_io(&io_local),
+                        /* cleanup */ io_mmap_file_close(mmap_file_stream));
+
+    io_local->id             = SAIL_MMAP_FILE_IO_ID;
+    io_local->features       = SAIL_IO_FEATURE_SEEKABLE | SAIL_IO_FEATURE_DIRECT_BUFFER;
+    io_local->stream         = mmap_file_stream;
+    io_local->tolerant_read  = io_mmap_file_tolerant_read;
+    io_local->strict_read    = io_mmap_file_strict_read;
+    io_local->tolerant_write = sail_io_noop_tolerant_write;
+    io_local->strict_write   = sail_io_noop_strict_write;
+    io_local->seek           = io_mmap_file_seek;
+    io_local->tell           = io_mmap_file_tell;
+    io_local->flush          = sail_io_noop_flush;
+    io_local->close          = io_mmap_file_close;
+    io_local->eof            = io_mmap_file_eof;
+    io_local->direct_buffer  = io_mmap_file_direct_buffer;
+
+    *io = io_local;
+
+    return SAIL_OK;
+}
@@ -1,6 +1,6 @@
 /*  This file is part of SAIL (https://github.com/smoked-herring/sail)
 
-    Copyright (c) 2021 Dmitry Baryshev
+    Copyright (c) 2022 Dmitry Baryshev
 
     The MIT License
 
@@ -23,10 +23,8 @@
     SOFTWARE.
 */
 
-#ifndef SAIL_THREADING_H
-#define SAIL_THREADING_H
-
-#include "config.h"
+#ifndef SAIL_IO_MMAP_FILE_H
+#define SAIL_IO_MMAP_FILE_H
 
 #ifdef SAIL_BUILD
     #include "error.h"
@@ -36,46 +34,27 @@
     #include <sail-common/export.h>
 #endif
 
-#ifdef SAIL_WIN32
-    #include <Windows.h>
-#else
-    #include <pthread.h>
+#ifdef __cplusplus
+extern "C" {
 #endif
 
+struct sail_io;
+
 /*
- * Threading support.
+ * Maps the specified image file into memory for reading and allocates a new I/O object for it.
+ * Reads are served from the mapped pages without system calls. The I/O object has
+ * the SAIL_IO_FEATURE_DIRECT_BUFFER feature, so codecs that need the whole file borrow
+ * the mapped pages instead of copying them. sail_io.id is SAIL_MMAP_FILE_IO_ID.
+ *
+ * The file must not be truncated while it's mapped.
  *
- * Why this file is needed: C11 introduces threading support with mutexes, atomics, threads etc.
- * However, the most popular C compiler for Windows, MSVC, still supports nothing from it. We need
- * to implement our own threading support based on OS-specific APIs.
+ * Returns SAIL_OK on success.
  */
+SAIL_EXPORT sail_status_t sail_alloc_io_read_mmap_file(const char *path, struct sail_io **io);
 
-/* Call once. */
-
-#ifdef SAIL_WIN32
-    typedef INIT_ONCE sail_once_flag_t;
-    #define SAIL_ONCE_DEFAULT_VALUE INIT_ONCE_STATIC_INIT
-#else
-    typedef pthread_once_t sail_once_flag_t;
-    #define SAIL_ONCE_DEFAULT_VALUE PTHREAD_ONCE_INIT
+/* extern "C" */
+#ifdef __cplusplus
+}
 #endif
 
-SAIL_HIDDEN sail_status_t threading_call_once(sail_once_flag_t *once_flag, void (*callback)(void));
-
-/* Mutexes. */
-
-#ifdef SAIL_WIN32
-    typedef CRITICAL_SECTION sail_mutex_t;
-#else
-    typedef pthread_mutex_t sail_mutex_t;
-#endif
-
-SAIL_HIDDEN sail_status_t threading_init_mutex(sail_mutex_t *mutex);
-
-SAIL_HIDDEN sail_status_t threading_lock_mutex(sail_mutex_t *mutex);
-
-SAIL_HIDDEN sail_status_t threading_unlock_mutex(sail_mutex_t *mutex);
-
-SAIL_HIDDEN sail_status_t threading_destroy_mutex(sail_mutex_t *mutex);
-
 #endif
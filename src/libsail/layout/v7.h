@@ -125,6 +125,31 @@ sail_status_t SAIL_CONSTRUCT_CODEC_FUNC(sail_codec_load_seek_next_frame_v7)(void
  */
 sail_status_t SAIL_CONSTRUCT_CODEC_FUNC(sail_codec_load_frame_v7)(void *state, struct sail_io *io, struct sail_image *image);
 
+/*
+ * Optional. Reads the next rows of the current frame. Codecs with the SAIL_CODEC_FEATURE_ROWS load feature
+ * MUST export this function. SAIL calls it instead of sail_codec_load_frame_vx() to load frames row by row
+ * in sail_load_next_rows().
+ *
+ * libsail, a caller of this function, guarantees the following:
+ *   - The state is valid and points to the state allocated by sail_codec_load_init_vx().
+ *   - The IO is valid and open.
+ *   - The image points to the image allocated by sail_codec_load_seek_next_frame_vx().
+ *   - The image pixels point to a buffer of rows_count rows sail_image.bytes_per_line bytes apart.
+ *   - The rows requested for the frame in total never exceed the image height.
+ *
+ * This function MUST:
+ *   - Read the next rows_count rows of the frame into sail_image.pixels.
+ *   - Output rows from top to bottom in the same pixel format as sail_codec_load_frame_vx().
+ *
+ * This function MAY:
+ *   - Return SAIL_ERROR_NOT_IMPLEMENTED from the first call for the frame without reading anything
+ *     if the frame cannot be read row by row, e.g. an interlaced one. SAIL loads such frames
+ *     with sail_codec_load_frame_vx() then.
+ *
+ * Returns SAIL_OK on success.
+ */
+sail_status_t SAIL_CONSTRUCT_CODEC_FUNC(sail_codec_load_frame_rows_v7)(void *state, struct sail_io *io, struct sail_image *image, unsigned rows_count);
+
 /*
  * Finilizes loading operation. No more loadings are possible after calling this function.
  * This function doesn't close the io stream. It just stops decoding. Use io->close() or sail_destroy_io()
@@ -199,6 +224,31 @@ sail_status_t SAIL_CONSTRUCT_CODEC_FUNC(sail_codec_save_seek_next_frame_v7)(void
  */
 sail_status_t SAIL_CONSTRUCT_CODEC_FUNC(sail_codec_save_frame_v7)(void *state, struct sail_io *io, const struct sail_image *image);
 
+/*
+ * Optional. Writes the next rows of the current frame. Codecs with the SAIL_CODEC_FEATURE_ROWS save feature
+ * MUST export this function. SAIL calls it instead of sail_codec_save_frame_vx() to save frames row by row
+ * in sail_write_next_rows().
+ *
+ * libsail, a caller of this function, guarantees the following:
+ *   - The state is valid and points to the state allocated by sail_codec_save_init_vx().
+ *   - The IO is valid and open.
+ *   - The image properties are the same as passed to sail_codec_save_seek_next_frame_vx().
+ *   - The image pixels point to rows_count rows sail_image.bytes_per_line bytes apart.
+ *   - The rows passed for the frame in total never exceed the image height.
+ *
+ * This function MUST:
+ *   - Write the next rows_count rows of the frame from top to bottom into the IO.
+ *   - Finish the frame like sail_codec_save_frame_vx() does when the last row of the frame is written.
+ *
+ * This function MAY:
+ *   - Return SAIL_ERROR_NOT_IMPLEMENTED from the first call for the frame without writing anything
+ *     if the frame cannot be written row by row, e.g. an interlaced one. SAIL saves such frames
+ *     with sail_codec_save_frame_vx() then.
+ *
+ * Returns SAIL_OK on success.
+ */
+sail_status_t SAIL_CONSTRUCT_CODEC_FUNC(sail_codec_save_frame_rows_v7)(void *state, struct sail_io *io, const struct sail_image *image, unsigned rows_count);
+
 /*
  * Finilizes saving operation. No more savings are possible after calling this function.
  * This function doesn't close the io stream. Use io->close() or sail_destroy_io() to actually
@@ -41,6 +41,12 @@ typedef sail_status_t (*sail_codec_load_seek_next_frame_v7_t)(void *state, struc
 typedef sail_status_t (*sail_codec_load_frame_v7_t)(void *state, struct sail_io *io, struct sail_image *image);
 typedef sail_status_t (*sail_codec_load_finish_v7_t)(void **state, struct sail_io *io);
 
+/*
+ * Optional decoding functions. Codecs export them along with the SAIL_CODEC_FEATURE_ROWS load feature.
+ */
+
+typedef sail_status_t (*sail_codec_load_frame_rows_v7_t)(void *state, struct sail_io *io, struct sail_image *image, unsigned rows_count);
+
 /*
  * Encoding functions.
  */
@@ -50,4 +56,10 @@ typedef sail_status_t (*sail_codec_save_seek_next_frame_v7_t)(void *state, struc
 typedef sail_status_t (*sail_codec_save_frame_v7_t)(void *state, struct sail_io *io, const struct sail_image *image);
 typedef sail_status_t (*sail_codec_save_finish_v7_t)(void **state, struct sail_io *io);
 
+/*
+ * Optional encoding functions. Codecs export them along with the SAIL_CODEC_FEATURE_ROWS save feature.
+ */
+
+typedef sail_status_t (*sail_codec_save_frame_rows_v7_t)(void *state, struct sail_io *io, const struct sail_image *image, unsigned rows_count);
+
 #endif
@@ -0,0 +1,261 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include "config.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "sail.h"
+
+/*
+ * Private functions.
+ */
+
+struct sail_magic_number {
+
+    /* Expected bytes. Wildcard positions are zeroed. */
+    unsigned char bytes[SAIL_MAGIC_BUFFER_SIZE];
+
+    /* 0xFF for bytes to compare, 0x00 for "??" wildcards. */
+    unsigned char mask[SAIL_MAGIC_BUFFER_SIZE];
+
+    unsigned length;
+
+    const struct sail_codec_info *codec_info;
+};
+
+static int hex_digit_value(char c) {
+
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    } else if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    } else if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    } else {
+        return -1;
+    }
+}
+
+static bool is_space(char c) {
+
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+/*
+ * Compiles "ab cd ?? ef" into byte/mask arrays. "??" matches any byte. Magic numbers
+ * longer than SAIL_MAGIC_BUFFER_SIZE bytes are truncated.
+ */
+static sail_status_t compile_magic_number(const char *str, struct sail_magic_number *magic_number) {
+
+    const char *magic_number_str = str;
+
+    memset(magic_number->bytes, 0, sizeof(magic_number->bytes));
+    memset(magic_number->mask,  0, sizeof(magic_number->mask));
+    magic_number->length = 0;
+
+    while (true) {
+        while (is_space(*str)) {
+            str++;
+        }
+
+        if (*str == '\0') {
+            break;
+        }
+
+        /* Only that many bytes are read from the I/O source to match against. */
+        if (magic_number->length == SAIL_MAGIC_BUFFER_SIZE) {
+            SAIL_LOG_WARNING("Magic number '%s' is longer than %d bytes. Only the first %d bytes are matched",
+                             magic_number_str, SAIL_MAGIC_BUFFER_SIZE, SAIL_MAGIC_BUFFER_SIZE);
+            break;
+        }
+
+        if (str[0] == '?') {
+            str += (str[1] == '?') ? 2 : 1;
+        } else {
+            const int high = hex_digit_value(str[0]);
+            const int low = (high < 0) ? -1 : hex_digit_value(str[1]);
+
+            if (low < 0) {
+                SAIL_LOG_AND_RETURN(SAIL_ERROR_PARSE_FILE);
+            }
+
+            magic_number->bytes[magic_number->length] = (unsigned char)(high * 16 + low);
+            magic_number->mask[magic_number->length]  = 0xFF;
+            str += 2;
+        }
+
+        if (*str != '\0' && !is_space(*str)) {
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_PARSE_FILE);
+        }
+
+        magic_number->length++;
+    }
+
+    if (magic_number->length == 0) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_PARSE_FILE);
+    }
+
+    return SAIL_OK;
+}
+
+static bool magic_number_candidate_for(const struct sail_magic_number *magic_number, unsigned first_byte) {
+
+    return magic_number->mask[0] == 0 || magic_number->bytes[0] == first_byte;
+}
+
+static bool magic_number_matches(const struct sail_magic_number *magic_number, const unsigned char *buffer) {
+
+    for (unsigned i = 0; i < magic_number->length; i++) {
+        if ((buffer[i] & magic_number->mask[i]) != magic_number->bytes[i]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Public functions.
+ */
+
+sail_status_t alloc_magic_number_matcher(const struct sail_codec_bundle_node *codec_bundle_node,
+                                         struct sail_magic_number_matcher **magic_number_matcher) {
+
+    SAIL_CHECK_PTR(magic_number_matcher);
+
+    void *ptr;
+    SAIL_TRY(sail_malloc(sizeof(struct sail_magic_number_matcher), &ptr));
+    struct sail_magic_number_matcher *matcher = ptr;
+
+    matcher->magic_numbers = NULL;
+    matcher->candidates    = NULL;
+    memset(matcher->first_byte_offsets, 0, sizeof(matcher->first_byte_offsets));
+
+    /* Compile magic numbers. */
+    unsigned magic_numbers_count = 0;
+
+    for (const struct sail_codec_bundle_node *node = codec_bundle_node; node != NULL; node = node->next) {
+        for (const struct sail_string_node *magic_node = node->codec_bundle->codec_info->magic_number_node;
+                magic_node != NULL; magic_node = magic_node->next) {
+            magic_numbers_count++;
+        }
+    }
+
+    if (magic_numbers_count == 0) {
+        *magic_number_matcher = matcher;
+        return SAIL_OK;
+    }
+
+    SAIL_TRY_OR_CLEANUP(sail_malloc(sizeof(struct sail_magic_number) * magic_numbers_count, &ptr),
+                        /* cleanup */ destroy_magic_number_matcher(matcher));
+    matcher->magic_numbers = ptr;
+
+    unsigned compiled_count = 0;
+
+    for (const struct sail_codec_bundle_node *node = codec_bundle_node; node != NULL; node = node->next) {
+        const struct sail_codec_info *codec_info = node->codec_bundle->codec_info;
+
+        for (const struct sail_string_node *magic_node = codec_info->magic_number_node; magic_node != NULL; magic_node = magic_node->next) {
+            struct sail_magic_number *magic_number = &matcher->magic_numbers[compiled_count];
+
+            if (compile_magic_number(magic_node->string, magic_number) != SAIL_OK) {
+                SAIL_LOG_ERROR("Failed to parse magic number '%s' of the '%s' codec. Skipping it",
+                                magic_node->string, codec_info->name);
+                continue;
+            }
+
+            magic_number->codec_info = codec_info;
+            compiled_count++;
+        }
+    }
+
+    /* Build the first-byte dispatch table. Candidates keep the priority order. */
+    unsigned candidates_count = 0;
+
+    for (unsigned first_byte = 0; first_byte < 256; first_byte++) {
+        matcher->first_byte_offsets[first_byte] = candidates_count;
+
+        for (unsigned i = 0; i < compiled_count; i++) {
+            if (magic_number_candidate_for(&matcher->magic_numbers[i], first_byte)) {
+                candidates_count++;
+            }
+        }
+    }
+
+    matcher->first_byte_offsets[256] = candidates_count;
+
+    if (candidates_count > 0) {
+        SAIL_TRY_OR_CLEANUP(sail_malloc(sizeof(unsigned) * candidates_count, &ptr),
+                            /* cleanup */ destroy_magic_number_matcher(matcher));
+        matcher->candidates = ptr;
+
+        unsigned *candidate = matcher->candidates;
+
+        for (unsigned first_byte = 0; first_byte < 256; first_byte++) {
+            for (unsigned i = 0; i < compiled_count; i++) {
+                if (magic_number_candidate_for(&matcher->magic_numbers[i], first_byte)) {
+                    *candidate++ = i;
+                }
+            }
+        }
+    }
+
+    SAIL_LOG_DEBUG("Compiled %u magic numbers", compiled_count);
+
+    *magic_number_matcher = matcher;
+
+    return SAIL_OK;
+}
+
+void destroy_magic_number_matcher(struct sail_magic_number_matcher *magic_number_matcher) {
+
+    if (magic_number_matcher == NULL) {
+        return;
+    }
+
+    sail_free(magic_number_matcher->candidates);
+    sail_free(magic_number_matcher->magic_numbers);
+    sail_free(magic_number_matcher);
+}
+
+const struct sail_codec_info* match_magic_number(const struct sail_magic_number_matcher *magic_number_matcher,
+                                                 const unsigned char *buffer) {
+
+    const unsigned first = magic_number_matcher->first_byte_offsets[buffer[0]];
+    const unsigned last  = magic_number_matcher->first_byte_offsets[buffer[0] + 1];
+
+    for (unsigned i = first; i < last; i++) {
+        const struct sail_magic_number *magic_number = &magic_number_matcher->magic_numbers[magic_number_matcher->candidates[i]];
+
+        if (magic_number_matches(magic_number, buffer)) {
+            return magic_number->codec_info;
+        }
+    }
+
+    return NULL;
+}
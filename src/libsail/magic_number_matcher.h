@@ -0,0 +1,82 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SAIL_MAGIC_NUMBER_MATCHER_H
+#define SAIL_MAGIC_NUMBER_MATCHER_H
+
+#include <stddef.h>
+
+#ifdef SAIL_BUILD
+    #include "error.h"
+    #include "export.h"
+#else
+    #include <sail-common/error.h>
+    #include <sail-common/export.h>
+#endif
+
+struct sail_codec_bundle_node;
+struct sail_codec_info;
+struct sail_magic_number;
+
+/*
+ * Magic numbers of all the enumerated codecs precompiled into byte/mask pairs. Candidates
+ * are dispatched by the first byte of the probed data and keep the codec priority order.
+ */
+struct sail_magic_number_matcher {
+
+    /* Compiled magic numbers in the codec priority order. */
+    struct sail_magic_number *magic_numbers;
+
+    /*
+     * Indices into magic_numbers to check for every possible first byte. Candidates for
+     * the byte B are stored in candidates[first_byte_offsets[B] .. first_byte_offsets[B+1]).
+     */
+    unsigned *candidates;
+    unsigned first_byte_offsets[257];
+};
+
+/*
+ * Compiles the magic numbers of the specified codec bundles. Codec bundles must be sorted by priority.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_HIDDEN sail_status_t alloc_magic_number_matcher(const struct sail_codec_bundle_node *codec_bundle_node,
+                                                      struct sail_magic_number_matcher **magic_number_matcher);
+
+/*
+ * Destroys the specified magic number matcher.
+ */
+SAIL_HIDDEN void destroy_magic_number_matcher(struct sail_magic_number_matcher *magic_number_matcher);
+
+/*
+ * Finds the first codec info whose magic number matches the specified buffer. The buffer
+ * must be SAIL_MAGIC_BUFFER_SIZE bytes long.
+ *
+ * Returns the found codec info or NULL.
+ */
+SAIL_HIDDEN const struct sail_codec_info* match_magic_number(const struct sail_magic_number_matcher *magic_number_matcher,
+                                                             const unsigned char *buffer);
+
+#endif
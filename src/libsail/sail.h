@@ -31,12 +31,14 @@
 #ifdef SAIL_BUILD
     #include "sail-common.h"
 
+    #include "batch_options.h"
     #include "codec.h"
     #include "codec_bundle.h"
     #include "codec_bundle_node.h"
     #include "codec_bundle_node_private.h"
     #include "codec_bundle_private.h"
     #include "codec_info.h"
+    #include "codec_info_index.h"
     #include "codec_info_private.h"
     #include "codec_layout.h"
     #include "codec_priority.h"
@@ -45,19 +47,20 @@
     #include "ini.h"
     #include "io_file.h"
     #include "io_memory.h"
+    #include "io_mmap_file.h"
     #include "io_noop.h"
+    #include "magic_number_matcher.h"
     #include "sail_advanced.h"
+    #include "sail_batch.h"
     #include "sail_deep_diver.h"
     #include "sail_junior.h"
     #include "sail_private.h"
     #include "sail_technical_diver.h"
     #include "sail_technical_diver_private.h"
-    #ifdef SAIL_THREAD_SAFE
-    #include "threading.h"
-    #endif
 #else
     #include <sail-common/sail-common.h>
 
+    #include <sail/batch_options.h>
     #include <sail/codec_bundle.h>
     #include <sail/codec_bundle_node.h>
     #include <sail/codec_info.h>
@@ -65,8 +68,10 @@
     #include <sail/context.h>
     #include <sail/io_file.h>
     #include <sail/io_memory.h>
+    #include <sail/io_mmap_file.h>
     #include <sail/io_noop.h>
     #include <sail/sail_advanced.h>
+    #include <sail/sail_batch.h>
     #include <sail/sail_deep_diver.h>
     #include <sail/sail_junior.h>
     #include <sail/sail_technical_diver.h>
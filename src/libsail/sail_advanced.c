@@ -27,9 +27,256 @@
 
 #include <stddef.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "sail-common.h"
 #include "sail.h"
+#include "sail-manip.h"
+
+/*
+ * Private functions.
+ */
+
+static sail_status_t alloc_caller_pixels(void *user_data, size_t size, void **pixels) {
+
+    (void)user_data;
+    (void)size;
+    (void)pixels;
+
+    SAIL_LOG_AND_RETURN(SAIL_ERROR_NOT_IMPLEMENTED);
+}
+
+static void free_caller_pixels(void *user_data, void *pixels) {
+
+    (void)user_data;
+    (void)pixels;
+}
+
+/* Pixel allocator of caller-provided pixel buffers. It never frees them. */
+static const struct sail_pixel_allocator caller_pixel_allocator = {
+    alloc_caller_pixels,
+    free_caller_pixels,
+    NULL
+};
+
+/*
+ * Copies the specified rows of the image in the codec pixel format into the caller rows
+ * converting them into the output pixel format if necessary.
+ */
+static sail_status_t output_rows(const struct sail_image *image, const void *source_rows, unsigned rows_count,
+                                 void *rows, unsigned bytes_per_line, enum SailPixelFormat output_pixel_format) {
+
+    if (image->pixel_format == output_pixel_format) {
+        for (unsigned row = 0; row < rows_count; row++) {
+            memcpy((unsigned char *)rows + (size_t)row * bytes_per_line,
+                    (const unsigned char *)source_rows + (size_t)row * image->bytes_per_line,
+                    image->bytes_per_line);
+        }
+    } else {
+        /* Shallow copy of the image pointing to the rows. */
+        struct sail_image rows_image = *image;
+        rows_image.pixels = (void *)source_rows;
+        rows_image.height = rows_count;
+
+        SAIL_TRY(sail_convert_image_to_pixels(&rows_image, output_pixel_format, NULL /* options */, rows, bytes_per_line));
+    }
+
+    return SAIL_OK;
+}
+
+static sail_status_t load_frame_into_temporary_buffer(struct hidden_state *state_of_mind, struct sail_image *image,
+                                                      void *pixels, unsigned bytes_per_line,
+                                                      enum SailPixelFormat output_pixel_format) {
+
+    /* The codec expects tightly packed rows in its own pixel format. */
+    void *temp_pixels;
+    SAIL_TRY(sail_malloc((size_t)image->height * image->bytes_per_line, &temp_pixels));
+
+    image->pixels = temp_pixels;
+
+    SAIL_TRY_OR_CLEANUP(state_of_mind->codec->v7->load_frame(state_of_mind->state, state_of_mind->io, image),
+                        /* cleanup */ image->pixels = NULL,
+                                      sail_free(temp_pixels));
+
+    SAIL_TRY_OR_CLEANUP(output_rows(image, temp_pixels, image->height, pixels, bytes_per_line, output_pixel_format),
+                        /* cleanup */ image->pixels = NULL,
+                                      sail_free(temp_pixels));
+
+    image->pixel_format = output_pixel_format;
+    image->pixels       = NULL;
+    sail_free(temp_pixels);
+
+    return SAIL_OK;
+}
+
+/*
+ * Returns the frame left by sail_load_next_frame_into() when it didn't fit into the caller buffer,
+ * or seeks to the next frame.
+ */
+static sail_status_t seek_next_frame_or_pending(struct hidden_state *state_of_mind, struct sail_image **image) {
+
+    if (state_of_mind->pending_image != NULL) {
+        *image = state_of_mind->pending_image;
+        state_of_mind->pending_image = NULL;
+        return SAIL_OK;
+    }
+
+    SAIL_TRY(state_of_mind->codec->v7->load_seek_next_frame(state_of_mind->state, state_of_mind->io, image));
+
+    return SAIL_OK;
+}
+
+static sail_status_t check_no_rows_left(const struct hidden_state *state_of_mind) {
+
+    if (state_of_mind->rows_image != NULL) {
+        SAIL_LOG_ERROR("%u rows of the current frame are not processed yet",
+                        state_of_mind->rows_image->height - state_of_mind->rows_processed);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_CONFLICTING_OPERATION);
+    }
+
+    return SAIL_OK;
+}
+
+/*
+ * Loads the next rows of the current frame with the codec. Returns SAIL_ERROR_NOT_IMPLEMENTED
+ * if the codec cannot load the frame row by row.
+ */
+static sail_status_t load_rows_with_codec(struct hidden_state *state_of_mind, void *rows, unsigned rows_count,
+                                          unsigned bytes_per_line, enum SailPixelFormat output_pixel_format) {
+
+    if (state_of_mind->codec->v7->load_frame_rows == NULL) {
+        return SAIL_ERROR_NOT_IMPLEMENTED;
+    }
+
+    struct sail_image *image = state_of_mind->rows_image;
+    const unsigned natural_bytes_per_line = image->bytes_per_line;
+
+    const bool custom_bytes_per_line_supported =
+        (state_of_mind->codec_info->load_features->features & SAIL_CODEC_FEATURE_CUSTOM_BYTES_PER_LINE) != 0;
+
+    /* Load directly into the caller rows. */
+    if (image->pixel_format == output_pixel_format && (bytes_per_line == natural_bytes_per_line || custom_bytes_per_line_supported)) {
+        image->pixels         = rows;
+        image->bytes_per_line = bytes_per_line;
+
+        const sail_status_t status = state_of_mind->codec->v7->load_frame_rows(state_of_mind->state, state_of_mind->io, image, rows_count);
+
+        image->pixels         = NULL;
+        image->bytes_per_line = natural_bytes_per_line;
+
+        return status;
+    }
+
+    /* Load into the temporary rows in the codec pixel format and convert them. */
+    const size_t rows_buffer_size = (size_t)rows_count * natural_bytes_per_line;
+
+    if (state_of_mind->rows_buffer_size < rows_buffer_size) {
+        SAIL_TRY(sail_realloc(rows_buffer_size, &state_of_mind->rows_buffer));
+        state_of_mind->rows_buffer_size = rows_buffer_size;
+    }
+
+    image->pixels = state_of_mind->rows_buffer;
+
+    const sail_status_t status = state_of_mind->codec->v7->load_frame_rows(state_of_mind->state, state_of_mind->io, image, rows_count);
+
+    image->pixels = NULL;
+
+    if (status != SAIL_OK) {
+        return status;
+    }
+
+    SAIL_TRY(output_rows(image, state_of_mind->rows_buffer, rows_count, rows, bytes_per_line, output_pixel_format));
+
+    return SAIL_OK;
+}
+
+/* Loads the whole current frame when the codec cannot load it row by row. */
+static sail_status_t load_rows_frame(struct hidden_state *state_of_mind) {
+
+    struct sail_image *image = state_of_mind->rows_image;
+
+    void *frame;
+    SAIL_TRY(sail_malloc((size_t)image->height * image->bytes_per_line, &frame));
+
+    image->pixels = frame;
+
+    SAIL_TRY_OR_CLEANUP(state_of_mind->codec->v7->load_frame(state_of_mind->state, state_of_mind->io, image),
+                        /* cleanup */ image->pixels = NULL,
+                                      sail_free(frame));
+
+    image->pixels = NULL;
+    state_of_mind->rows_frame = frame;
+
+    return SAIL_OK;
+}
+
+/*
+ * Writes the next rows of the current frame with the codec. Returns SAIL_ERROR_NOT_IMPLEMENTED
+ * if the codec cannot save the frame row by row.
+ */
+static sail_status_t write_rows_with_codec(struct hidden_state *state_of_mind, const void *rows, unsigned rows_count,
+                                           unsigned bytes_per_line) {
+
+    if (state_of_mind->codec->v7->save_frame_rows == NULL) {
+        return SAIL_ERROR_NOT_IMPLEMENTED;
+    }
+
+    struct sail_image *image = state_of_mind->rows_image;
+    const unsigned natural_bytes_per_line = image->bytes_per_line;
+
+    image->pixels         = (void *)rows;
+    image->bytes_per_line = bytes_per_line;
+
+    sail_status_t status = SAIL_OK;
+
+    if (state_of_mind->rows_processed == 0) {
+        status = state_of_mind->codec->v7->save_seek_next_frame(state_of_mind->state, state_of_mind->io, image);
+    }
+
+    if (status == SAIL_OK) {
+        status = state_of_mind->codec->v7->save_frame_rows(state_of_mind->state, state_of_mind->io, image, rows_count);
+    }
+
+    image->pixels         = NULL;
+    image->bytes_per_line = natural_bytes_per_line;
+
+    return status;
+}
+
+/* Writes the whole current frame accumulated when the codec cannot save the frame row by row. */
+static sail_status_t write_rows_frame(struct hidden_state *state_of_mind) {
+
+    struct sail_image *image = state_of_mind->rows_image;
+
+    image->pixels = state_of_mind->rows_frame;
+
+    /* Codecs with row by row saving have already seeked to the frame before refusing the rows. */
+    if (state_of_mind->codec->v7->save_frame_rows == NULL) {
+        SAIL_TRY_OR_CLEANUP(state_of_mind->codec->v7->save_seek_next_frame(state_of_mind->state, state_of_mind->io, image),
+                            /* cleanup */ image->pixels = NULL);
+    }
+
+    SAIL_TRY_OR_CLEANUP(state_of_mind->codec->v7->save_frame(state_of_mind->state, state_of_mind->io, image),
+                        /* cleanup */ image->pixels = NULL);
+
+    image->pixels = NULL;
+
+    return SAIL_OK;
+}
+
+static void finish_rows_frame(struct hidden_state *state_of_mind) {
+
+    sail_destroy_image(state_of_mind->rows_image);
+    sail_free(state_of_mind->rows_frame);
+
+    state_of_mind->rows_image     = NULL;
+    state_of_mind->rows_processed = 0;
+    state_of_mind->rows_frame     = NULL;
+}
+
+/*
+ * Public functions.
+ */
 
 sail_status_t sail_probe_io(struct sail_io *io, struct sail_image **image, const struct sail_codec_info **codec_info) {
 
@@ -80,6 +327,37 @@ sail_status_t sail_probe_memory(const void *buffer, size_t buffer_length, struct
     return SAIL_OK;
 }
 
+sail_status_t sail_probe_header_io(struct sail_io *io, struct sail_image **image,
+                                  const struct sail_codec_info **codec_info, size_t *bytes_consumed) {
+
+    SAIL_CHECK_PTR(io);
+
+    const struct sail_codec_info *codec_info_noop;
+    const struct sail_codec_info **codec_info_local = codec_info == NULL ? &codec_info_noop : codec_info;
+
+    SAIL_TRY(sail_codec_info_by_magic_number_from_io(io, codec_info_local));
+
+    SAIL_TRY(probe_header(io, *codec_info_local, image, bytes_consumed));
+
+    return SAIL_OK;
+}
+
+sail_status_t sail_probe_header_memory(const void *buffer, size_t buffer_length, struct sail_image **image,
+                                      const struct sail_codec_info **codec_info, size_t *bytes_consumed) {
+
+    SAIL_CHECK_PTR(buffer);
+
+    struct sail_io *io;
+    SAIL_TRY(sail_alloc_io_read_memory(buffer, buffer_length, &io));
+
+    SAIL_TRY_OR_CLEANUP(sail_probe_header_io(io, image, codec_info, bytes_consumed),
+                        /* cleanup */ sail_destroy_io(io));
+
+    sail_destroy_io(io);
+
+    return SAIL_OK;
+}
+
 sail_status_t sail_start_loading_from_file(const char *path, const struct sail_codec_info *codec_info, void **state) {
 
     SAIL_TRY(sail_start_loading_from_file_with_options(path, codec_info, NULL, state));
@@ -104,9 +382,10 @@ sail_status_t sail_load_next_frame(void *state, struct sail_image **image) {
     SAIL_TRY(sail_check_io_valid(state_of_mind->io));
     SAIL_CHECK_PTR(state_of_mind->state);
     SAIL_CHECK_PTR(state_of_mind->codec);
+    SAIL_TRY(check_no_rows_left(state_of_mind));
 
     struct sail_image *image_local;
-    SAIL_TRY(state_of_mind->codec->v7->load_seek_next_frame(state_of_mind->state, state_of_mind->io, &image_local));
+    SAIL_TRY(seek_next_frame_or_pending(state_of_mind, &image_local));
 
     if (image_local->pixels != NULL) {
         SAIL_LOG_ERROR("Internal error in %s codec: codecs must not allocate pixels", state_of_mind->codec_info->name);
@@ -114,19 +393,229 @@ sail_status_t sail_load_next_frame(void *state, struct sail_image **image) {
         SAIL_LOG_AND_RETURN(SAIL_ERROR_CONFLICTING_OPERATION);
     }
 
+    /* The codec cannot output the requested pixel format, so convert the frame after loading. */
+    const bool convert_frame = state_of_mind->pixel_format != SAIL_PIXEL_FORMAT_UNKNOWN &&
+                                state_of_mind->pixel_format != image_local->pixel_format;
+
     /* Allocate pixels. */
-    const size_t pixels_size = (size_t)image_local->height * image_local->bytes_per_line;
-    SAIL_TRY_OR_CLEANUP(sail_malloc(pixels_size, &image_local->pixels),
+    size_t pixels_size = (size_t)image_local->height * image_local->bytes_per_line;
+
+    if (convert_frame) {
+        unsigned output_bytes_per_line;
+        SAIL_TRY_OR_CLEANUP(check_frame_conversion(image_local, state_of_mind->pixel_format, &output_bytes_per_line),
+                            /* cleanup */ sail_destroy_image(image_local));
+
+        /* Hold the frame in both pixel formats to convert it in place. */
+        if (output_bytes_per_line > image_local->bytes_per_line) {
+            pixels_size = (size_t)image_local->height * output_bytes_per_line;
+        }
+    }
+
+    SAIL_TRY_OR_CLEANUP(sail_alloc_pixels(state_of_mind->pixel_allocator, pixels_size, &image_local->pixels),
                         /* cleanup */ sail_destroy_image(image_local));
+    image_local->pixel_allocator = state_of_mind->pixel_allocator;
 
     SAIL_TRY_OR_CLEANUP(state_of_mind->codec->v7->load_frame(state_of_mind->state, state_of_mind->io, image_local),
                         /* cleanup */ sail_destroy_image(image_local));
 
+    if (convert_frame) {
+        SAIL_TRY_OR_CLEANUP(convert_frame_in_place(image_local, state_of_mind->pixel_format),
+                            /* cleanup */ sail_destroy_image(image_local));
+    }
+
     *image = image_local;
 
     return SAIL_OK;
 }
 
+sail_status_t sail_load_next_frame_into(void *state, void *pixels, size_t pixels_size,
+                                       unsigned bytes_per_line, struct sail_image **image) {
+
+    SAIL_CHECK_PTR(state);
+    SAIL_CHECK_PTR(pixels);
+    SAIL_CHECK_PTR(image);
+
+    struct hidden_state *state_of_mind = (struct hidden_state *)state;
+
+    SAIL_TRY(sail_check_io_valid(state_of_mind->io));
+    SAIL_CHECK_PTR(state_of_mind->state);
+    SAIL_CHECK_PTR(state_of_mind->codec);
+    SAIL_TRY(check_no_rows_left(state_of_mind));
+
+    struct sail_image *image_local;
+    SAIL_TRY(seek_next_frame_or_pending(state_of_mind, &image_local));
+
+    if (image_local->pixels != NULL) {
+        SAIL_LOG_ERROR("Internal error in %s codec: codecs must not allocate pixels", state_of_mind->codec_info->name);
+        sail_destroy_image(image_local);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_CONFLICTING_OPERATION);
+    }
+
+    /* The codec cannot output the requested pixel format, so convert the frame while copying it into the caller pixels. */
+    const bool convert_frame = state_of_mind->pixel_format != SAIL_PIXEL_FORMAT_UNKNOWN &&
+                                state_of_mind->pixel_format != image_local->pixel_format;
+    const enum SailPixelFormat output_pixel_format = convert_frame ? state_of_mind->pixel_format : image_local->pixel_format;
+
+    unsigned natural_bytes_per_line = image_local->bytes_per_line;
+
+    if (convert_frame) {
+        SAIL_TRY_OR_CLEANUP(check_frame_conversion(image_local, output_pixel_format, &natural_bytes_per_line),
+                            /* cleanup */ sail_destroy_image(image_local));
+    }
+
+    const unsigned target_bytes_per_line = (bytes_per_line == 0) ? natural_bytes_per_line : bytes_per_line;
+
+    /* Keep the sought frame so the caller can retry with a bigger buffer. */
+    if (target_bytes_per_line < natural_bytes_per_line) {
+        SAIL_LOG_ERROR("Bytes per line %u is less than the %u bytes required to hold a row", target_bytes_per_line, natural_bytes_per_line);
+        state_of_mind->pending_image = image_local;
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INCORRECT_BYTES_PER_LINE);
+    }
+
+    const size_t required_pixels_size = (size_t)image_local->height * target_bytes_per_line;
+
+    if (pixels_size < required_pixels_size) {
+        SAIL_LOG_ERROR("Pixel buffer of %lu bytes is too small to hold %lu bytes of pixels",
+                        (unsigned long)pixels_size, (unsigned long)required_pixels_size);
+        state_of_mind->pending_image = image_local;
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+
+    const bool custom_bytes_per_line_supported =
+        (state_of_mind->codec_info->load_features->features & SAIL_CODEC_FEATURE_CUSTOM_BYTES_PER_LINE) != 0;
+
+    if (!convert_frame && (target_bytes_per_line == natural_bytes_per_line || custom_bytes_per_line_supported)) {
+        image_local->pixels         = pixels;
+        image_local->bytes_per_line = target_bytes_per_line;
+
+        SAIL_TRY_OR_CLEANUP(state_of_mind->codec->v7->load_frame(state_of_mind->state, state_of_mind->io, image_local),
+                            /* cleanup */ image_local->pixels = NULL,
+                                          sail_destroy_image(image_local));
+    } else {
+        SAIL_TRY_OR_CLEANUP(load_frame_into_temporary_buffer(state_of_mind, image_local, pixels, target_bytes_per_line, output_pixel_format),
+                            /* cleanup */ sail_destroy_image(image_local));
+
+        image_local->pixels         = pixels;
+        image_local->bytes_per_line = target_bytes_per_line;
+    }
+
+    image_local->pixel_allocator = &caller_pixel_allocator;
+
+    *image = image_local;
+
+    return SAIL_OK;
+}
+
+sail_status_t sail_seek_next_frame(void *state, struct sail_image **image) {
+
+    SAIL_CHECK_PTR(state);
+    SAIL_CHECK_PTR(image);
+
+    struct hidden_state *state_of_mind = (struct hidden_state *)state;
+
+    SAIL_TRY(sail_check_io_valid(state_of_mind->io));
+    SAIL_CHECK_PTR(state_of_mind->state);
+    SAIL_CHECK_PTR(state_of_mind->codec);
+    SAIL_TRY(check_no_rows_left(state_of_mind));
+
+    struct sail_image *rows_image;
+    SAIL_TRY(seek_next_frame_or_pending(state_of_mind, &rows_image));
+
+    if (rows_image->pixels != NULL) {
+        SAIL_LOG_ERROR("Internal error in %s codec: codecs must not allocate pixels", state_of_mind->codec_info->name);
+        sail_destroy_image(rows_image);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_CONFLICTING_OPERATION);
+    }
+
+    struct sail_image *image_local;
+    SAIL_TRY_OR_CLEANUP(sail_copy_image(rows_image, &image_local),
+                        /* cleanup */ sail_destroy_image(rows_image));
+
+    /* The rows are converted into the requested pixel format while loading. */
+    if (state_of_mind->pixel_format != SAIL_PIXEL_FORMAT_UNKNOWN && state_of_mind->pixel_format != rows_image->pixel_format) {
+        SAIL_TRY_OR_CLEANUP(check_frame_conversion(rows_image, state_of_mind->pixel_format, &image_local->bytes_per_line),
+                            /* cleanup */ sail_destroy_image(image_local),
+                                          sail_destroy_image(rows_image));
+
+        image_local->pixel_format = state_of_mind->pixel_format;
+    }
+
+    state_of_mind->rows_image     = rows_image;
+    state_of_mind->rows_processed = 0;
+
+    *image = image_local;
+
+    return SAIL_OK;
+}
+
+sail_status_t sail_load_next_rows(void *state, void *rows, unsigned rows_count, unsigned bytes_per_line) {
+
+    SAIL_CHECK_PTR(state);
+    SAIL_CHECK_PTR(rows);
+
+    struct hidden_state *state_of_mind = (struct hidden_state *)state;
+
+    SAIL_TRY(sail_check_io_valid(state_of_mind->io));
+    SAIL_CHECK_PTR(state_of_mind->state);
+    SAIL_CHECK_PTR(state_of_mind->codec);
+
+    const struct sail_image *image = state_of_mind->rows_image;
+
+    if (image == NULL) {
+        SAIL_LOG_ERROR("No frame to load rows from. Call sail_seek_next_frame() first");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_CONFLICTING_OPERATION);
+    }
+
+    const unsigned rows_left = image->height - state_of_mind->rows_processed;
+
+    if (rows_count == 0 || rows_count > rows_left) {
+        SAIL_LOG_ERROR("Cannot load %u rows when %u rows are left", rows_count, rows_left);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+
+    const enum SailPixelFormat output_pixel_format = (state_of_mind->pixel_format == SAIL_PIXEL_FORMAT_UNKNOWN)
+                                                        ? image->pixel_format : state_of_mind->pixel_format;
+
+    unsigned output_bytes_per_line;
+    SAIL_TRY(sail_bytes_per_line(image->width, output_pixel_format, &output_bytes_per_line));
+
+    const unsigned target_bytes_per_line = (bytes_per_line == 0) ? output_bytes_per_line : bytes_per_line;
+
+    if (target_bytes_per_line < output_bytes_per_line) {
+        SAIL_LOG_ERROR("Bytes per line %u is less than the %u bytes required to hold a row", target_bytes_per_line, output_bytes_per_line);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INCORRECT_BYTES_PER_LINE);
+    }
+
+    /* Stream the rows with the codec. Fall back to loading the whole frame on the first rows if it cannot. */
+    if (state_of_mind->rows_frame == NULL) {
+        const sail_status_t status = load_rows_with_codec(state_of_mind, rows, rows_count, target_bytes_per_line, output_pixel_format);
+
+        if (status == SAIL_ERROR_NOT_IMPLEMENTED && state_of_mind->rows_processed == 0) {
+            SAIL_LOG_DEBUG("%s codec cannot load the frame row by row, loading the whole frame", state_of_mind->codec_info->name);
+            SAIL_TRY(load_rows_frame(state_of_mind));
+        } else if (status != SAIL_OK) {
+            return status;
+        }
+    }
+
+    if (state_of_mind->rows_frame != NULL) {
+        SAIL_TRY(output_rows(image,
+                             (const unsigned char *)state_of_mind->rows_frame + (size_t)state_of_mind->rows_processed * image->bytes_per_line,
+                             rows_count,
+                             rows,
+                             target_bytes_per_line,
+                             output_pixel_format));
+    }
+
+    state_of_mind->rows_processed += rows_count;
+
+    if (state_of_mind->rows_processed == image->height) {
+        finish_rows_frame(state_of_mind);
+    }
+
+    return SAIL_OK;
+}
+
 sail_status_t sail_stop_loading(void *state) {
 
     /* Not an error. */
@@ -164,6 +653,14 @@ sail_status_t sail_start_saving_into_memory(void *buffer, size_t buffer_length,
     return SAIL_OK;
 }
 
+sail_status_t sail_start_saving_into_growing_memory(void **buffer, size_t *buffer_length,
+                                                    const struct sail_codec_info *codec_info, void **state) {
+
+    SAIL_TRY(sail_start_saving_into_growing_memory_with_options(buffer, buffer_length, codec_info, NULL, state));
+
+    return SAIL_OK;
+}
+
 sail_status_t sail_write_next_frame(void *state, const struct sail_image *image) {
 
     SAIL_CHECK_PTR(state);
@@ -175,6 +672,7 @@ sail_status_t sail_write_next_frame(void *state, const struct sail_image *image)
     SAIL_CHECK_PTR(state_of_mind->state);
     SAIL_CHECK_PTR(state_of_mind->codec_info);
     SAIL_CHECK_PTR(state_of_mind->codec);
+    SAIL_TRY(check_no_rows_left(state_of_mind));
 
     /* Check if we actually able to save the requested pixel format. */
     SAIL_TRY(allowed_write_output_pixel_format(state_of_mind->codec_info->save_features,
@@ -189,6 +687,106 @@ sail_status_t sail_write_next_frame(void *state, const struct sail_image *image)
     return SAIL_OK;
 }
 
+sail_status_t sail_write_next_frame_header(void *state, const struct sail_image *image) {
+
+    SAIL_CHECK_PTR(state);
+    SAIL_TRY(sail_check_image_skeleton_valid(image));
+
+    struct hidden_state *state_of_mind = (struct hidden_state *)state;
+
+    SAIL_TRY(sail_check_io_valid(state_of_mind->io));
+    SAIL_CHECK_PTR(state_of_mind->state);
+    SAIL_CHECK_PTR(state_of_mind->codec_info);
+    SAIL_CHECK_PTR(state_of_mind->codec);
+    SAIL_TRY(check_no_rows_left(state_of_mind));
+
+    /* Check if we actually able to save the requested pixel format. */
+    SAIL_TRY(allowed_write_output_pixel_format(state_of_mind->codec_info->save_features,
+                                                image->pixel_format));
+
+    /* The rows are passed later. Keep the frame properties only. */
+    struct sail_image image_properties = *image;
+    image_properties.pixels = NULL;
+
+    SAIL_TRY(sail_bytes_per_line(image->width, image->pixel_format, &image_properties.bytes_per_line));
+
+    struct sail_image *rows_image;
+    SAIL_TRY(sail_copy_image(&image_properties, &rows_image));
+
+    state_of_mind->rows_image     = rows_image;
+    state_of_mind->rows_processed = 0;
+
+    return SAIL_OK;
+}
+
+sail_status_t sail_write_next_rows(void *state, const void *rows, unsigned rows_count, unsigned bytes_per_line) {
+
+    SAIL_CHECK_PTR(state);
+    SAIL_CHECK_PTR(rows);
+
+    struct hidden_state *state_of_mind = (struct hidden_state *)state;
+
+    SAIL_TRY(sail_check_io_valid(state_of_mind->io));
+    SAIL_CHECK_PTR(state_of_mind->state);
+    SAIL_CHECK_PTR(state_of_mind->codec);
+
+    const struct sail_image *image = state_of_mind->rows_image;
+
+    if (image == NULL) {
+        SAIL_LOG_ERROR("No frame to write rows into. Call sail_write_next_frame_header() first");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_CONFLICTING_OPERATION);
+    }
+
+    const unsigned rows_left = image->height - state_of_mind->rows_processed;
+
+    if (rows_count == 0 || rows_count > rows_left) {
+        SAIL_LOG_ERROR("Cannot write %u rows when %u rows are left", rows_count, rows_left);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+
+    const unsigned source_bytes_per_line = (bytes_per_line == 0) ? image->bytes_per_line : bytes_per_line;
+
+    if (source_bytes_per_line < image->bytes_per_line) {
+        SAIL_LOG_ERROR("Bytes per line %u is less than the %u bytes required to hold a row", source_bytes_per_line, image->bytes_per_line);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INCORRECT_BYTES_PER_LINE);
+    }
+
+    /* Stream the rows with the codec. Fall back to accumulating the whole frame on the first rows if it cannot. */
+    if (state_of_mind->rows_frame == NULL) {
+        const sail_status_t status = write_rows_with_codec(state_of_mind, rows, rows_count, source_bytes_per_line);
+
+        if (status == SAIL_ERROR_NOT_IMPLEMENTED && state_of_mind->rows_processed == 0) {
+            SAIL_LOG_DEBUG("%s codec cannot save the frame row by row, accumulating the whole frame", state_of_mind->codec_info->name);
+            SAIL_TRY(sail_malloc((size_t)image->height * image->bytes_per_line, &state_of_mind->rows_frame));
+        } else if (status != SAIL_OK) {
+            return status;
+        }
+    }
+
+    if (state_of_mind->rows_frame != NULL) {
+        unsigned char *frame_rows = (unsigned char *)state_of_mind->rows_frame + (size_t)state_of_mind->rows_processed * image->bytes_per_line;
+
+        for (unsigned row = 0; row < rows_count; row++) {
+            memcpy(frame_rows + (size_t)row * image->bytes_per_line,
+                   (const unsigned char *)rows + (size_t)row * source_bytes_per_line,
+                   image->bytes_per_line);
+        }
+    }
+
+    state_of_mind->rows_processed += rows_count;
+
+    if (state_of_mind->rows_processed == image->height) {
+        if (state_of_mind->rows_frame != NULL) {
+            SAIL_TRY_OR_CLEANUP(write_rows_frame(state_of_mind),
+                                /* cleanup */ finish_rows_frame(state_of_mind));
+        }
+
+        finish_rows_frame(state_of_mind);
+    }
+
+    return SAIL_OK;
+}
+
 sail_status_t sail_stop_saving(void *state) {
 
     SAIL_TRY(stop_saving(state, NULL));
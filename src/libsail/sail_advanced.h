@@ -67,6 +67,34 @@ SAIL_EXPORT sail_status_t sail_probe_io(struct sail_io *io, struct sail_image **
 SAIL_EXPORT sail_status_t sail_probe_memory(const void *buffer, size_t buffer_length,
                                             struct sail_image **image, const struct sail_codec_info **codec_info);
 
+/*
+ * Loads only the minimal header of the first frame from the specified I/O source and returns
+ * its properties like dimensions and pixel format. Codecs skip meta data, ICC profiles, palettes,
+ * and other data following the header when possible. See SAIL_OPTION_HEADER_ONLY.
+ * The assigned codec info MUST NOT be destroyed because it is a pointer to an internal
+ * data structure. If you don't need it, just pass NULL.
+ *
+ * Assigns the number of bytes consumed from the current I/O position to bytes_consumed.
+ * It's the furthest offset read by the codec, so codecs that need the whole stream, like QOI
+ * or WebP, consume everything until the end. Having that many bytes of the image is enough
+ * to probe it again. If you don't need it, just pass NULL.
+ *
+ * Typical usage: This is a standalone function that could be called at any time.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_probe_header_io(struct sail_io *io, struct sail_image **image,
+                                               const struct sail_codec_info **codec_info, size_t *bytes_consumed);
+
+/*
+ * Loads only the minimal header of the first frame from the specified memory buffer.
+ * See sail_probe_header_io().
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_probe_header_memory(const void *buffer, size_t buffer_length, struct sail_image **image,
+                                                   const struct sail_codec_info **codec_info, size_t *bytes_consumed);
+
 /*
  * Starts loading the specified image file. Pass codec info if you would like to start loading
  * with a specific codec. If not, just pass NULL.
@@ -108,11 +136,80 @@ SAIL_EXPORT sail_status_t sail_start_loading_from_memory(const void *buffer, siz
 /*
  * Continues loading the file started by sail_start_loading_from_file() and brothers.
  *
+ * The loaded frame has the pixel format requested in the load options if any. Otherwise,
+ * it has the codec pixel format.
+ *
  * Returns SAIL_OK on success.
  * Returns SAIL_ERROR_NO_MORE_FRAMES when no more frames are available.
  */
 SAIL_EXPORT sail_status_t sail_load_next_frame(void *state, struct sail_image **image);
 
+/*
+ * Continues loading the file started by sail_start_loading_from_file() and brothers. Decodes
+ * the frame directly into the specified caller-provided pixel buffer instead of allocating a new one.
+ * The loaded image points to the buffer and doesn't own it. sail_destroy_image() leaves the buffer intact.
+ *
+ * bytes_per_line is the distance between rows in the buffer. Pass 0 to use tightly packed rows
+ * as returned by sail_load_next_frame(). It must not be less than that. The buffer must be at least
+ * height * bytes_per_line bytes long. Use sail_probe_*() to get the image dimensions in advance.
+ *
+ * Codecs with the SAIL_CODEC_FEATURE_CUSTOM_BYTES_PER_LINE load feature write into the buffer
+ * directly with any bytes per line. Other codecs write into it directly only with tightly packed rows.
+ * Otherwise, SAIL decodes into a temporary buffer and copies the rows.
+ *
+ * When the load options request a pixel format the codec cannot output natively, bytes_per_line
+ * refers to the requested pixel format, and SAIL converts the rows from a temporary buffer.
+ *
+ * Returns SAIL_OK on success.
+ * Returns SAIL_ERROR_NO_MORE_FRAMES when no more frames are available.
+ * Returns SAIL_ERROR_INCORRECT_BYTES_PER_LINE when bytes_per_line is too small to hold a row.
+ * Returns SAIL_ERROR_INVALID_ARGUMENT when the buffer is too small to hold the frame.
+ *
+ * The frame dimensions are known only after seeking to the frame. When the buffer or bytes_per_line
+ * is too small, the frame is not lost: the next sail_load_next_frame_into(), sail_load_next_frame(),
+ * or sail_seek_next_frame() call continues with the same frame. So the caller can retry with
+ * a bigger buffer.
+ */
+SAIL_EXPORT sail_status_t sail_load_next_frame_into(void *state, void *pixels, size_t pixels_size,
+                                                    unsigned bytes_per_line, struct sail_image **image);
+
+/*
+ * Continues loading the file started by sail_start_loading_from_file() and brothers. Seeks to the next
+ * frame and returns its properties without pixels. Load the frame pixels with sail_load_next_rows() then.
+ * Use it to process frames too large to be held in memory.
+ *
+ * The image has the pixel format requested in the load options if any, and the bytes per line
+ * of tightly packed rows in that pixel format.
+ *
+ * Typical usage: sail_start_loading_from_file() ->
+ *                sail_seek_next_frame()         ->
+ *                sail_load_next_rows() x n      ->
+ *                sail_stop_loading().
+ *
+ * Returns SAIL_OK on success.
+ * Returns SAIL_ERROR_NO_MORE_FRAMES when no more frames are available.
+ * Returns SAIL_ERROR_CONFLICTING_OPERATION when some rows of the previous frame are not loaded yet.
+ */
+SAIL_EXPORT sail_status_t sail_seek_next_frame(void *state, struct sail_image **image);
+
+/*
+ * Loads the next rows of the frame started by sail_seek_next_frame() into the specified caller-provided
+ * buffer from top to bottom. All the frame rows must be loaded before moving to the next frame.
+ *
+ * bytes_per_line is the distance between rows in the buffer. Pass 0 to use tightly packed rows.
+ * The buffer must be at least rows_count * bytes_per_line bytes long.
+ *
+ * Codecs with the SAIL_CODEC_FEATURE_ROWS load feature decode only the requested rows. Other codecs,
+ * and the ones that cannot load specific frames row by row like interlaced ones, load the whole frame
+ * into memory on the first call.
+ *
+ * Returns SAIL_OK on success.
+ * Returns SAIL_ERROR_CONFLICTING_OPERATION when there is no frame started by sail_seek_next_frame() with rows left.
+ * Returns SAIL_ERROR_INVALID_ARGUMENT when rows_count is zero or exceeds the number of rows left.
+ * Returns SAIL_ERROR_INCORRECT_BYTES_PER_LINE when bytes_per_line is too small to hold a row.
+ */
+SAIL_EXPORT sail_status_t sail_load_next_rows(void *state, void *rows, unsigned rows_count, unsigned bytes_per_line);
+
 /*
  * Stops loading the file started by sail_start_loading_from_file() and brothers.
  * Does nothing if the state is NULL.
@@ -162,6 +259,29 @@ SAIL_EXPORT sail_status_t sail_start_saving_into_file(const char *path, const st
 SAIL_EXPORT sail_status_t sail_start_saving_into_memory(void *buffer, size_t buffer_length,
                                                         const struct sail_codec_info *codec_info, void **state);
 
+/*
+ * Starts saving into a memory buffer growing automatically. There is no need to guess
+ * the output size in advance.
+ *
+ * Assigns NULL and 0 to the specified buffer and buffer length. They hold the saved image
+ * after sail_stop_saving(). The buffer belongs to the caller who must free it with sail_free()
+ * even if saving failed.
+ *
+ * Typical usage: sail_codec_info_from_extension()        ->
+ *                sail_start_saving_into_growing_memory() ->
+ *                sail_write_next_frame()                 ->
+ *                sail_stop_saving()                      ->
+ *                sail_free().
+ *
+ * STATE explanation: Passes the address of a local void* pointer. SAIL will store an internal state
+ * in it and destroy it in sail_stop_saving. States must be used per image. DO NOT use the same state
+ * to start saving multiple images at the same time.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_start_saving_into_growing_memory(void **buffer, size_t *buffer_length,
+                                                                const struct sail_codec_info *codec_info, void **state);
+
 /*
  * Continues saving started by sail_start_saving_into_file() and brothers. Writes the specified
  * image into the underlying I/O target.
@@ -174,6 +294,42 @@ SAIL_EXPORT sail_status_t sail_start_saving_into_memory(void *buffer, size_t buf
  */
 SAIL_EXPORT sail_status_t sail_write_next_frame(void *state, const struct sail_image *image);
 
+/*
+ * Continues saving started by sail_start_saving_into_file() and brothers. Starts the next frame
+ * with the properties of the specified image. The image pixels are ignored. Write the frame pixels
+ * with sail_write_next_rows() then. Use it to save frames too large to be held in memory.
+ *
+ * Typical usage: sail_start_saving_into_file()  ->
+ *                sail_write_next_frame_header() ->
+ *                sail_write_next_rows() x n     ->
+ *                sail_stop_saving().
+ *
+ * If the selected image format doesn't support the image pixel format, an error is returned.
+ *
+ * Returns SAIL_OK on success.
+ * Returns SAIL_ERROR_CONFLICTING_OPERATION when some rows of the previous frame are not written yet.
+ */
+SAIL_EXPORT sail_status_t sail_write_next_frame_header(void *state, const struct sail_image *image);
+
+/*
+ * Writes the next rows of the frame started by sail_write_next_frame_header() from the specified
+ * caller-provided buffer from top to bottom. The rows must have the frame pixel format. All the frame
+ * rows must be written before moving to the next frame or stopping saving.
+ *
+ * bytes_per_line is the distance between rows in the buffer. Pass 0 to use tightly packed rows.
+ * The buffer must be at least rows_count * bytes_per_line bytes long.
+ *
+ * Codecs with the SAIL_CODEC_FEATURE_ROWS save feature encode the rows immediately. Other codecs,
+ * and the ones that cannot save specific frames row by row like interlaced ones, accumulate the whole
+ * frame in memory and save it with the last rows.
+ *
+ * Returns SAIL_OK on success.
+ * Returns SAIL_ERROR_CONFLICTING_OPERATION when there is no frame started by sail_write_next_frame_header() with rows left.
+ * Returns SAIL_ERROR_INVALID_ARGUMENT when rows_count is zero or exceeds the number of rows left.
+ * Returns SAIL_ERROR_INCORRECT_BYTES_PER_LINE when bytes_per_line is too small to hold a row.
+ */
+SAIL_EXPORT sail_status_t sail_write_next_rows(void *state, const void *rows, unsigned rows_count, unsigned bytes_per_line);
+
 /*
  * Stops saving started by sail_start_saving_into_file() and brothers. Closes the underlying I/O target.
  * Does nothing if the state is NULL.
@@ -182,6 +338,8 @@ SAIL_EXPORT sail_status_t sail_write_next_frame(void *state, const struct sail_i
  * will lead to memory leaks.
  *
  * Returns SAIL_OK on success.
+ * Returns SAIL_ERROR_CONFLICTING_OPERATION when some rows of the frame started by sail_write_next_frame_header()
+ * are not written. The state is freed anyway.
  */
 SAIL_EXPORT sail_status_t sail_stop_saving(void *state);
 
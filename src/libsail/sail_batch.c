@@ -0,0 +1,546 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "sail-common.h"
+#include "sail.h"
+
+/*
+ * Private functions.
+ */
+
+/* Load options with the worker pixel allocator for a specific codec. */
+struct batch_codec_options {
+
+    const struct sail_codec_info *codec_info;
+    struct sail_load_options *load_options;
+
+    struct batch_codec_options *next;
+};
+
+struct batch;
+
+struct batch_worker {
+
+    struct batch *batch;
+
+    /*
+     * Sources not taken yet. The owner takes sources from the front,
+     * other workers steal sources from the back.
+     */
+    size_t begin;
+    size_t end;
+
+#ifdef SAIL_THREAD_SAFE
+    sail_mutex_t range_mutex;
+
+    sail_thread_t thread;
+    bool thread_started;
+#endif
+
+    struct sail_pixel_pool *pixel_pool;
+
+    /* Copy of the batch load options with the worker pixel allocator. */
+    struct sail_load_options *load_options;
+
+    /* Codec load options with the worker pixel allocator when the batch has no load options. */
+    struct batch_codec_options *codec_options;
+};
+
+/* A loaded image waiting for the preceding ones in SAIL_BATCH_ORDER_INPUT. */
+struct batch_result {
+
+    bool ready;
+    sail_status_t status;
+    struct sail_image *image;
+};
+
+struct batch {
+
+    /* Either paths or buffers are set. */
+    const char * const *paths;
+    const void * const *buffers;
+    const size_t *buffer_lengths;
+    size_t count;
+
+    unsigned threads;
+    enum SailBatchOrder order;
+    const struct sail_load_options *load_options;
+    size_t pixel_pool_size;
+
+    sail_batch_callback_t callback;
+    void *user_data;
+
+    struct batch_worker *workers;
+    unsigned workers_count;
+
+#ifdef SAIL_THREAD_SAFE
+    /* Serializes the callback calls. */
+    sail_mutex_t delivery_mutex;
+#endif
+
+    /* Results not delivered yet and the next one to deliver in SAIL_BATCH_ORDER_INPUT. */
+    struct batch_result *results;
+    size_t next_result;
+};
+
+static void lock_worker_range(struct batch_worker *worker) {
+
+#ifdef SAIL_THREAD_SAFE
+    sail_lock_mutex(&worker->range_mutex);
+#else
+    (void)worker;
+#endif
+}
+
+static void unlock_worker_range(struct batch_worker *worker) {
+
+#ifdef SAIL_THREAD_SAFE
+    sail_unlock_mutex(&worker->range_mutex);
+#else
+    (void)worker;
+#endif
+}
+
+static bool take_own_source(struct batch_worker *worker, size_t *index) {
+
+    bool taken = false;
+
+    lock_worker_range(worker);
+
+    if (worker->begin < worker->end) {
+        *index = worker->begin++;
+        taken = true;
+    }
+
+    unlock_worker_range(worker);
+
+    return taken;
+}
+
+/*
+ * Steals the back half of the sources left in the first non-empty range of the other workers.
+ * Returns false when there is nothing to steal.
+ */
+static bool steal_sources(struct batch_worker *thief) {
+
+    struct batch *batch = thief->batch;
+    const unsigned thief_index = (unsigned)(thief - batch->workers);
+
+    for (unsigned i = 1; i < batch->workers_count; i++) {
+        struct batch_worker *victim = &batch->workers[(thief_index + i) % batch->workers_count];
+
+        size_t begin = 0;
+        size_t end = 0;
+
+        lock_worker_range(victim);
+
+        const size_t left = victim->end - victim->begin;
+
+        if (left > 0) {
+            /* Round up to steal the last source too. */
+            begin = victim->end - (left + 1) / 2;
+            end = victim->end;
+            victim->end = begin;
+        }
+
+        unlock_worker_range(victim);
+
+        if (begin < end) {
+            lock_worker_range(thief);
+            thief->begin = begin;
+            thief->end = end;
+            unlock_worker_range(thief);
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool next_source(struct batch_worker *worker, size_t *index) {
+
+    do {
+        if (take_own_source(worker, index)) {
+            return true;
+        }
+    } while (steal_sources(worker));
+
+    return false;
+}
+
+/* Returns the load options to load an image with the specified codec. NULL means codec defaults. */
+static sail_status_t worker_load_options(struct batch_worker *worker, const struct sail_codec_info *codec_info,
+                                         const struct sail_load_options **load_options) {
+
+    if (worker->load_options != NULL || worker->pixel_pool == NULL) {
+        *load_options = worker->load_options;
+        return SAIL_OK;
+    }
+
+    for (struct batch_codec_options *codec_options = worker->codec_options; codec_options != NULL; codec_options = codec_options->next) {
+        if (codec_options->codec_info == codec_info) {
+            *load_options = codec_options->load_options;
+            return SAIL_OK;
+        }
+    }
+
+    void *ptr;
+    SAIL_TRY(sail_malloc(sizeof(struct batch_codec_options), &ptr));
+    struct batch_codec_options *codec_options = ptr;
+
+    SAIL_TRY_OR_CLEANUP(sail_alloc_load_options_from_features(codec_info->load_features, &codec_options->load_options),
+                        /* cleanup */ sail_free(codec_options));
+
+    codec_options->codec_info                    = codec_info;
+    codec_options->load_options->pixel_allocator = sail_pixel_pool_allocator(worker->pixel_pool);
+    codec_options->next                          = worker->codec_options;
+
+    worker->codec_options = codec_options;
+
+    *load_options = codec_options->load_options;
+
+    return SAIL_OK;
+}
+
+static sail_status_t start_loading_source(struct batch_worker *worker, size_t index, void **state) {
+
+    const struct batch *batch = worker->batch;
+    const struct sail_codec_info *codec_info;
+    const struct sail_load_options *load_options;
+
+    if (batch->paths != NULL) {
+        const char *path = batch->paths[index];
+        SAIL_CHECK_PTR(path);
+
+        /* Detect the codec by the file extension first, and then by the magic number. */
+        if (sail_codec_info_from_path(path, &codec_info) != SAIL_OK) {
+            SAIL_TRY(sail_codec_info_by_magic_number_from_path(path, &codec_info));
+        }
+
+        SAIL_TRY(worker_load_options(worker, codec_info, &load_options));
+        SAIL_TRY(sail_start_loading_from_file_with_options(path, codec_info, load_options, state));
+    } else {
+        const void *buffer = batch->buffers[index];
+        const size_t buffer_length = batch->buffer_lengths[index];
+        SAIL_CHECK_PTR(buffer);
+
+        SAIL_TRY(sail_codec_info_by_magic_number_from_memory(buffer, buffer_length, &codec_info));
+
+        SAIL_TRY(worker_load_options(worker, codec_info, &load_options));
+        SAIL_TRY(sail_start_loading_from_memory_with_options(buffer, buffer_length, codec_info, load_options, state));
+    }
+
+    return SAIL_OK;
+}
+
+static sail_status_t load_source(struct batch_worker *worker, size_t index, struct sail_image **image) {
+
+    void *state = NULL;
+
+    SAIL_TRY_OR_CLEANUP(start_loading_source(worker, index, &state),
+                        /* cleanup */ sail_stop_loading(state));
+
+    struct sail_image *image_local;
+
+    SAIL_TRY_OR_CLEANUP(sail_load_next_frame(state, &image_local),
+                        /* cleanup */ sail_stop_loading(state));
+
+    SAIL_TRY_OR_CLEANUP(sail_stop_loading(state),
+                        /* cleanup */ sail_destroy_image(image_local));
+
+    *image = image_local;
+
+    return SAIL_OK;
+}
+
+static void deliver_result(struct batch *batch, size_t index, sail_status_t status, struct sail_image *image) {
+
+#ifdef SAIL_THREAD_SAFE
+    sail_lock_mutex(&batch->delivery_mutex);
+#endif
+
+    if (batch->order == SAIL_BATCH_ORDER_COMPLETION) {
+        batch->callback(index, status, image, batch->user_data);
+    } else {
+        batch->results[index].ready  = true;
+        batch->results[index].status = status;
+        batch->results[index].image  = image;
+
+        for (; batch->next_result < batch->count && batch->results[batch->next_result].ready; batch->next_result++) {
+            const struct batch_result *result = &batch->results[batch->next_result];
+
+            batch->callback(batch->next_result, result->status, result->image, batch->user_data);
+        }
+    }
+
+#ifdef SAIL_THREAD_SAFE
+    sail_unlock_mutex(&batch->delivery_mutex);
+#endif
+}
+
+static void worker_routine(void *arg) {
+
+    struct batch_worker *worker = arg;
+    size_t index;
+
+    while (next_source(worker, &index)) {
+        struct sail_image *image = NULL;
+        const sail_status_t status = load_source(worker, index, &image);
+
+        deliver_result(worker->batch, index, status, status == SAIL_OK ? image : NULL);
+    }
+}
+
+static void destroy_worker(struct batch_worker *worker) {
+
+    while (worker->codec_options != NULL) {
+        struct batch_codec_options *next = worker->codec_options->next;
+
+        sail_destroy_load_options(worker->codec_options->load_options);
+        sail_free(worker->codec_options);
+
+        worker->codec_options = next;
+    }
+
+    sail_destroy_load_options(worker->load_options);
+
+    /* Images allocated from the pool stay valid. */
+    sail_destroy_pixel_pool(worker->pixel_pool);
+
+#ifdef SAIL_THREAD_SAFE
+    sail_destroy_mutex(&worker->range_mutex);
+#endif
+}
+
+static sail_status_t init_worker(struct batch *batch, unsigned worker_index, struct batch_worker *worker) {
+
+    /* Split the sources evenly between the workers. */
+    worker->batch         = batch;
+    worker->begin         = (size_t)((unsigned long long)batch->count * worker_index / batch->workers_count);
+    worker->end           = (size_t)((unsigned long long)batch->count * (worker_index + 1) / batch->workers_count);
+    worker->pixel_pool    = NULL;
+    worker->load_options  = NULL;
+    worker->codec_options = NULL;
+
+#ifdef SAIL_THREAD_SAFE
+    worker->thread_started = false;
+    SAIL_TRY(sail_init_mutex(&worker->range_mutex));
+#endif
+
+    const bool use_pixel_pool = batch->pixel_pool_size > 0
+                                    && (batch->load_options == NULL || batch->load_options->pixel_allocator == NULL);
+
+    if (use_pixel_pool) {
+        SAIL_TRY_OR_CLEANUP(sail_alloc_pixel_pool(batch->pixel_pool_size, &worker->pixel_pool),
+                            /* cleanup */ destroy_worker(worker));
+    }
+
+    if (batch->load_options != NULL) {
+        SAIL_TRY_OR_CLEANUP(sail_copy_load_options(batch->load_options, &worker->load_options),
+                            /* cleanup */ destroy_worker(worker));
+
+        if (use_pixel_pool) {
+            worker->load_options->pixel_allocator = sail_pixel_pool_allocator(worker->pixel_pool);
+        }
+    }
+
+    return SAIL_OK;
+}
+
+static void destroy_workers(struct batch *batch, unsigned workers_count) {
+
+    for (unsigned i = 0; i < workers_count; i++) {
+        destroy_worker(&batch->workers[i]);
+    }
+
+    sail_free(batch->workers);
+    batch->workers = NULL;
+}
+
+static sail_status_t alloc_workers(struct batch *batch) {
+
+    void *ptr;
+    SAIL_TRY(sail_malloc(sizeof(struct batch_worker) * batch->workers_count, &ptr));
+    batch->workers = ptr;
+
+    for (unsigned i = 0; i < batch->workers_count; i++) {
+        SAIL_TRY_OR_CLEANUP(init_worker(batch, i, &batch->workers[i]),
+                            /* cleanup */ destroy_workers(batch, i));
+    }
+
+    return SAIL_OK;
+}
+
+static void run_workers(struct batch *batch) {
+
+#ifdef SAIL_THREAD_SAFE
+    /*
+     * The calling thread is the first worker. If some threads fail to start,
+     * their sources are stolen by the running workers.
+     */
+    for (unsigned i = 1; i < batch->workers_count; i++) {
+        struct batch_worker *worker = &batch->workers[i];
+
+        worker->thread_started = sail_create_thread(&worker->thread, worker_routine, worker) == SAIL_OK;
+    }
+#endif
+
+    worker_routine(&batch->workers[0]);
+
+#ifdef SAIL_THREAD_SAFE
+    for (unsigned i = 1; i < batch->workers_count; i++) {
+        struct batch_worker *worker = &batch->workers[i];
+
+        if (worker->thread_started) {
+            sail_join_thread(&worker->thread);
+        }
+    }
+#endif
+}
+
+static void destroy_delivery(struct batch *batch) {
+
+#ifdef SAIL_THREAD_SAFE
+    sail_destroy_mutex(&batch->delivery_mutex);
+#endif
+
+    sail_free(batch->results);
+}
+
+static sail_status_t load_batch(struct batch *batch) {
+
+    if (batch->count == 0) {
+        return SAIL_OK;
+    }
+
+#ifdef SAIL_THREAD_SAFE
+    const unsigned threads = batch->threads == 0 ? sail_cpu_count() : batch->threads;
+#else
+    const unsigned threads = 1;
+#endif
+
+    batch->workers_count = (size_t)threads > batch->count ? (unsigned)batch->count : threads;
+    batch->results       = NULL;
+    batch->next_result   = 0;
+
+    if (batch->order == SAIL_BATCH_ORDER_INPUT) {
+        void *ptr;
+        SAIL_TRY(sail_malloc(sizeof(struct batch_result) * batch->count, &ptr));
+        batch->results = ptr;
+
+        for (size_t i = 0; i < batch->count; i++) {
+            batch->results[i].ready = false;
+        }
+    }
+
+#ifdef SAIL_THREAD_SAFE
+    SAIL_TRY_OR_CLEANUP(sail_init_mutex(&batch->delivery_mutex),
+                        /* cleanup */ sail_free(batch->results));
+#endif
+
+    SAIL_TRY_OR_CLEANUP(alloc_workers(batch),
+                        /* cleanup */ destroy_delivery(batch));
+
+    SAIL_LOG_DEBUG("Loading a batch of %lu images with %u threads", (unsigned long)batch->count, batch->workers_count);
+
+    run_workers(batch);
+
+    destroy_workers(batch, batch->workers_count);
+    destroy_delivery(batch);
+
+    return SAIL_OK;
+}
+
+static sail_status_t init_batch(struct batch *batch, size_t count, const struct sail_batch_options *batch_options,
+                                sail_batch_callback_t callback, void *user_data) {
+
+    struct sail_batch_options *batch_options_default = NULL;
+
+    if (batch_options == NULL) {
+        SAIL_TRY(sail_alloc_batch_options(&batch_options_default));
+        batch_options = batch_options_default;
+    }
+
+    batch->paths           = NULL;
+    batch->buffers         = NULL;
+    batch->buffer_lengths  = NULL;
+    batch->count           = count;
+    batch->threads         = batch_options->threads;
+    batch->order           = batch_options->order;
+    batch->load_options    = batch_options->load_options;
+    batch->pixel_pool_size = batch_options->pixel_pool_size;
+    batch->callback        = callback;
+    batch->user_data       = user_data;
+    batch->workers         = NULL;
+    batch->workers_count   = 0;
+
+    sail_destroy_batch_options(batch_options_default);
+
+    return SAIL_OK;
+}
+
+/*
+ * Public functions.
+ */
+
+sail_status_t sail_load_batch_from_files(const char * const *paths, size_t count,
+                                         const struct sail_batch_options *batch_options,
+                                         sail_batch_callback_t callback, void *user_data) {
+
+    SAIL_CHECK_PTR(paths);
+    SAIL_CHECK_PTR(callback);
+
+    struct batch batch;
+    SAIL_TRY(init_batch(&batch, count, batch_options, callback, user_data));
+
+    batch.paths = paths;
+
+    SAIL_TRY(load_batch(&batch));
+
+    return SAIL_OK;
+}
+
+sail_status_t sail_load_batch_from_memory(const void * const *buffers, const size_t *buffer_lengths, size_t count,
+                                          const struct sail_batch_options *batch_options,
+                                          sail_batch_callback_t callback, void *user_data) {
+
+    SAIL_CHECK_PTR(buffers);
+    SAIL_CHECK_PTR(buffer_lengths);
+    SAIL_CHECK_PTR(callback);
+
+    struct batch batch;
+    SAIL_TRY(init_batch(&batch, count, batch_options, callback, user_data));
+
+    batch.buffers        = buffers;
+    batch.buffer_lengths = buffer_lengths;
+
+    SAIL_TRY(load_batch(&batch));
+
+    return SAIL_OK;
+}
@@ -0,0 +1,87 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SAIL_SAIL_BATCH_H
+#define SAIL_SAIL_BATCH_H
+
+#include <stddef.h>
+
+#ifdef SAIL_BUILD
+    #include "error.h"
+    #include "export.h"
+#else
+    #include <sail-common/error.h>
+    #include <sail-common/export.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct sail_batch_options;
+struct sail_image;
+
+/*
+ * Batch callback. Called for every source with its index in the source list, the loading status,
+ * and the loaded image. The image is NULL if the status is not SAIL_OK. Otherwise, the callback
+ * takes the ownership of the image and must destroy it with sail_destroy_image().
+ *
+ * Calls are serialized, so the callback doesn't need to be thread-safe. However, it may be called
+ * from any thread of the batch. Keep it short as it blocks delivering other images.
+ */
+typedef void (*sail_batch_callback_t)(size_t index, sail_status_t status, struct sail_image *image, void *user_data);
+
+/*
+ * Loads the first frames of the specified image files in parallel and passes them to the callback.
+ * Returns when all the images are delivered.
+ *
+ * Every thread takes images from its own part of the source list and steals images from
+ * the other threads when its part is finished. Every thread uses its own load options and pixel pool.
+ * Pass NULL batch options to use the defaults from sail_alloc_batch_options().
+ *
+ * Typical usage: This is a standalone function that could be called at any time.
+ *
+ * Returns SAIL_OK on success even if some images failed to load. Their errors are passed to the callback.
+ */
+SAIL_EXPORT sail_status_t sail_load_batch_from_files(const char * const *paths, size_t count,
+                                                     const struct sail_batch_options *batch_options,
+                                                     sail_batch_callback_t callback, void *user_data);
+
+/*
+ * Loads the first frames of the specified memory buffers in parallel and passes them to the callback.
+ * See sail_load_batch_from_files().
+ *
+ * Returns SAIL_OK on success even if some images failed to load. Their errors are passed to the callback.
+ */
+SAIL_EXPORT sail_status_t sail_load_batch_from_memory(const void * const *buffers, const size_t *buffer_lengths, size_t count,
+                                                      const struct sail_batch_options *batch_options,
+                                                      sail_batch_callback_t callback, void *user_data);
+
+/* extern "C" */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -110,6 +110,22 @@ sail_status_t sail_start_saving_into_memory_with_options(void *buffer, size_t bu
     return SAIL_OK;
 }
 
+sail_status_t sail_start_saving_into_growing_memory_with_options(void **buffer, size_t *buffer_length,
+                                                                 const struct sail_codec_info *codec_info,
+                                                                 const struct sail_save_options *save_options, void **state) {
+    SAIL_CHECK_PTR(buffer);
+    SAIL_CHECK_PTR(buffer_length);
+    SAIL_CHECK_PTR(codec_info);
+
+    struct sail_io *io;
+    SAIL_TRY(sail_alloc_io_write_growing_memory(buffer, buffer_length, &io));
+
+    /* The I/O object will be destroyed in this function. */
+    SAIL_TRY(start_saving_io_with_options(io, true, codec_info, save_options, state));
+
+    return SAIL_OK;
+}
+
 sail_status_t sail_stop_saving_with_written(void *state, size_t *written) {
 
     SAIL_TRY(stop_saving(state, written));
@@ -138,6 +138,28 @@ SAIL_EXPORT sail_status_t sail_start_saving_into_memory_with_options(void *buffe
                                                                      const struct sail_codec_info *codec_info,
                                                                         const struct sail_save_options *save_options, void **state);
 
+/*
+ * Starts saving into a memory buffer growing automatically with the specified save options.
+ * If you do not need specific save options, just pass NULL. Codec-specific defaults will be used in this case.
+ * See sail_start_saving_into_growing_memory() for the buffer ownership.
+ *
+ * The save options are deep copied.
+ *
+ * Typical usage: sail_codec_info_from_extension()                     ->
+ *                sail_start_saving_into_growing_memory_with_options() ->
+ *                sail_write_next_frame()                              ->
+ *                sail_stop_saving().
+ *
+ * STATE explanation: Passes the address of a local void* pointer. SAIL will store an internal state
+ * in it and destroy it in sail_stop_saving. States must be used per image. DO NOT use the same state
+ * to start saving multiple images at the same time.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_start_saving_into_growing_memory_with_options(void **buffer, size_t *buffer_length,
+                                                                             const struct sail_codec_info *codec_info,
+                                                                             const struct sail_save_options *save_options, void **state);
+
 
 /*
  * Stops saving started by sail_start_saving_into_file() and brothers. Closes the underlying I/O target.
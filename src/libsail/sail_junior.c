@@ -96,6 +96,31 @@ sail_status_t sail_probe_file(const char *path, struct sail_image **image, const
     return SAIL_OK;
 }
 
+sail_status_t sail_probe_header_file(const char *path, struct sail_image **image,
+                                    const struct sail_codec_info **codec_info, size_t *bytes_consumed) {
+
+    SAIL_CHECK_PTR(path);
+
+    struct sail_io *io;
+    SAIL_TRY(sail_alloc_io_read_file(path, &io));
+
+    const struct sail_codec_info *codec_info_noop;
+    const struct sail_codec_info **codec_info_local = codec_info == NULL ? &codec_info_noop : codec_info;
+
+    /* Detect the codec by the file extension first, and then by the magic number. */
+    if (sail_codec_info_from_path(path, codec_info_local) == SAIL_OK) {
+        SAIL_TRY_OR_CLEANUP(probe_header(io, *codec_info_local, image, bytes_consumed),
+                            /* cleanup */ sail_destroy_io(io));
+    } else {
+        SAIL_TRY_OR_CLEANUP(sail_probe_header_io(io, image, codec_info, bytes_consumed),
+                            /* cleanup */ sail_destroy_io(io));
+    }
+
+    sail_destroy_io(io);
+
+    return SAIL_OK;
+}
+
 sail_status_t sail_load_from_file(const char *path, struct sail_image **image) {
 
     SAIL_CHECK_PTR(path);
@@ -177,3 +202,32 @@ sail_status_t sail_save_into_memory(void *buffer, size_t buffer_length, const st
 
     return SAIL_OK;
 }
+
+sail_status_t sail_save_into_growing_memory(void **buffer, size_t *buffer_length,
+                                            const struct sail_codec_info *codec_info, const struct sail_image *image) {
+
+    SAIL_CHECK_PTR(buffer);
+    SAIL_CHECK_PTR(buffer_length);
+    SAIL_CHECK_PTR(codec_info);
+    SAIL_TRY(sail_check_image_valid(image));
+
+    void *buffer_local = NULL;
+    size_t buffer_length_local = 0;
+    void *state = NULL;
+
+    SAIL_TRY_OR_CLEANUP(sail_start_saving_into_growing_memory(&buffer_local, &buffer_length_local, codec_info, &state),
+                        /* cleanup */ sail_stop_saving(state),
+                                      sail_free(buffer_local));
+
+    SAIL_TRY_OR_CLEANUP(sail_write_next_frame(state, image),
+                        /* cleanup */ sail_stop_saving(state),
+                                      sail_free(buffer_local));
+
+    SAIL_TRY_OR_CLEANUP(sail_stop_saving(state),
+                        /* cleanup */ sail_free(buffer_local));
+
+    *buffer        = buffer_local;
+    *buffer_length = buffer_length_local;
+
+    return SAIL_OK;
+}
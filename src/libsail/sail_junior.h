@@ -55,6 +55,17 @@ struct sail_codec_info;
  */
 SAIL_EXPORT sail_status_t sail_probe_file(const char *path, struct sail_image **image, const struct sail_codec_info **codec_info);
 
+/*
+ * Loads only the minimal header of the first frame from the specified image file.
+ * See sail_probe_header_io().
+ *
+ * Typical usage: This is a standalone function that could be called at any time.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_probe_header_file(const char *path, struct sail_image **image,
+                                                 const struct sail_codec_info **codec_info, size_t *bytes_consumed);
+
 /*
  * Loads the specified image file and returns its properties and pixels.
  *
@@ -101,6 +112,24 @@ SAIL_EXPORT sail_status_t sail_save_into_file(const char *path, const struct sai
  */
 SAIL_EXPORT sail_status_t sail_save_into_memory(void *buffer, size_t buffer_length, const struct sail_image *image, size_t *written);
 
+/*
+ * Saves the specified image with the specified codec into a memory buffer growing automatically.
+ * There is no need to guess the output size in advance.
+ *
+ * If the selected image format doesn't support the image pixel format, an error is returned.
+ * Consider converting the image into a supported image format beforehand with functions
+ * from sail-manip.
+ *
+ * Assigns the saved image and its size to the buffer and buffer_length arguments.
+ * The buffer belongs to the caller who must free it with sail_free(). On error, the buffer is NULL.
+ *
+ * Typical usage: This is a standalone function that could be called at any time.
+ *
+ * Returns SAIL_OK on success.
+ */
+SAIL_EXPORT sail_status_t sail_save_into_growing_memory(void **buffer, size_t *buffer_length,
+                                                        const struct sail_codec_info *codec_info, const struct sail_image *image);
+
 /* extern "C" */
 #ifdef __cplusplus
 }
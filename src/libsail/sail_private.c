@@ -23,7 +23,11 @@
     SOFTWARE.
 */
 
+#include <stdint.h>
+#include <string.h>
+
 #include "sail.h"
+#include "sail-manip.h"
 
 /*
  * Private functions.
@@ -35,41 +39,114 @@ static void print_unsupported_write_pixel_format(enum SailPixelFormat pixel_form
                     sail_pixel_format_to_string(pixel_format));
 }
 
-static sail_status_t load_codec_by_codec_info_unsafe(const struct sail_codec_info *codec_info, const struct sail_codec **codec) {
+static struct sail_codec* load_codec_pointer(struct sail_codec_bundle *codec_bundle) {
 
-    SAIL_CHECK_PTR(codec_info);
-    SAIL_CHECK_PTR(codec);
+#ifdef SAIL_THREAD_SAFE
+    return sail_atomic_load_pointer((void **)&codec_bundle->codec);
+#else
+    return codec_bundle->codec;
+#endif
+}
 
-    struct sail_context *context;
-    SAIL_TRY(fetch_global_context_unsafe(&context));
+/*
+ * Publishes the loaded codec unless another thread has published its own copy first.
+ * Returns the published codec.
+ */
+static struct sail_codec* publish_codec_pointer(struct sail_codec_bundle *codec_bundle, struct sail_codec *codec) {
 
-    /* Find the codec in the cache. */
-    struct sail_codec_bundle *found_codec_bundle = NULL;
+#ifdef SAIL_THREAD_SAFE
+    return sail_atomic_compare_exchange_pointer((void **)&codec_bundle->codec, NULL, codec);
+#else
+    struct sail_codec *published_codec = codec_bundle->codec;
 
-    for (struct sail_codec_bundle_node *codec_bundle_node = context->codec_bundle_node; codec_bundle_node != NULL; codec_bundle_node = codec_bundle_node->next) {
-        struct sail_codec_bundle *codec_bundle = codec_bundle_node->codec_bundle;
+    if (published_codec == NULL) {
+        codec_bundle->codec = codec;
+    }
 
-        if (codec_bundle->codec_info == codec_info) {
-            if (codec_bundle->codec != NULL) {
-                *codec = codec_bundle->codec;
-                return SAIL_OK;
-            }
+    return published_codec;
+#endif
+}
 
-            found_codec_bundle = codec_bundle_node->codec_bundle;
-            break;
-        }
-    }
+/*
+ * Wraps an I/O object to track the furthest offset read from it. Codecs that take the whole
+ * stream seek back after reading it, so the final position doesn't tell how many bytes
+ * they needed.
+ */
+struct probe_io_stream {
 
-    /* Something weird. The pointer to the codec info is not found in the cache. */
-    if (found_codec_bundle == NULL) {
-        SAIL_LOG_AND_RETURN(SAIL_ERROR_CODEC_NOT_FOUND);
-    }
+    struct sail_io *io;
+    size_t furthest_offset;
+};
+
+static void update_furthest_offset(struct probe_io_stream *probe_io_stream) {
 
-    if (found_codec_bundle->codec == NULL) {
-        SAIL_TRY(alloc_and_load_codec(found_codec_bundle->codec_info, &found_codec_bundle->codec));
+    size_t offset;
+
+    if (probe_io_stream->io->tell(probe_io_stream->io->stream, &offset) == SAIL_OK
+            && offset > probe_io_stream->furthest_offset) {
+        probe_io_stream->furthest_offset = offset;
     }
+}
+
+static sail_status_t probe_io_tolerant_read(void *stream, void *buf, size_t size_to_read, size_t *read_size) {
+
+    struct probe_io_stream *probe_io_stream = stream;
+
+    const sail_status_t status = probe_io_stream->io->tolerant_read(probe_io_stream->io->stream, buf, size_to_read, read_size);
+    update_furthest_offset(probe_io_stream);
+
+    return status;
+}
+
+static sail_status_t probe_io_strict_read(void *stream, void *buf, size_t size_to_read) {
+
+    struct probe_io_stream *probe_io_stream = stream;
+
+    const sail_status_t status = probe_io_stream->io->strict_read(probe_io_stream->io->stream, buf, size_to_read);
+    update_furthest_offset(probe_io_stream);
+
+    return status;
+}
+
+static sail_status_t probe_io_seek(void *stream, long offset, int whence) {
+
+    struct probe_io_stream *probe_io_stream = stream;
+
+    return probe_io_stream->io->seek(probe_io_stream->io->stream, offset, whence);
+}
+
+static sail_status_t probe_io_tell(void *stream, size_t *offset) {
+
+    struct probe_io_stream *probe_io_stream = stream;
+
+    return probe_io_stream->io->tell(probe_io_stream->io->stream, offset);
+}
+
+static sail_status_t probe_io_close(void *stream) {
+
+    /* The wrapped I/O object is closed by its owner. */
+    (void)stream;
+
+    return SAIL_OK;
+}
+
+static sail_status_t probe_io_eof(void *stream, bool *result) {
+
+    struct probe_io_stream *probe_io_stream = stream;
+
+    return probe_io_stream->io->eof(probe_io_stream->io->stream, result);
+}
+
+static sail_status_t probe_io_direct_buffer(void *stream, const void **buffer, size_t *buffer_length) {
+
+    struct probe_io_stream *probe_io_stream = stream;
+
+    SAIL_TRY(probe_io_stream->io->direct_buffer(probe_io_stream->io->stream, buffer, buffer_length));
 
-    *codec = found_codec_bundle->codec;
+    /* The codec borrows everything up to the end. */
+    if (*buffer_length > probe_io_stream->furthest_offset) {
+        probe_io_stream->furthest_offset = *buffer_length;
+    }
 
     return SAIL_OK;
 }
@@ -83,12 +160,50 @@ sail_status_t load_codec_by_codec_info(const struct sail_codec_info *codec_info,
     SAIL_CHECK_PTR(codec_info);
     SAIL_CHECK_PTR(codec);
 
-    SAIL_TRY(lock_context());
+    /* The codec bundle list is immutable after the context is initialized. */
+    struct sail_context *context;
+    SAIL_TRY(fetch_global_context_guarded(&context));
+
+    /* Find the codec in the cache. */
+    struct sail_codec_bundle *found_codec_bundle = NULL;
+
+    for (struct sail_codec_bundle_node *codec_bundle_node = context->codec_bundle_node; codec_bundle_node != NULL; codec_bundle_node = codec_bundle_node->next) {
+        if (codec_bundle_node->codec_bundle->codec_info == codec_info) {
+            found_codec_bundle = codec_bundle_node->codec_bundle;
+            break;
+        }
+    }
+
+    /* Something weird. The pointer to the codec info is not found in the cache. */
+    if (found_codec_bundle == NULL) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_CODEC_NOT_FOUND);
+    }
+
+    /* Fast path. The codec is already loaded. */
+    struct sail_codec *loaded_codec = load_codec_pointer(found_codec_bundle);
 
-    SAIL_TRY_OR_CLEANUP(load_codec_by_codec_info_unsafe(codec_info, codec),
-                        /* cleanup */ unlock_context());
+    if (loaded_codec != NULL) {
+        *codec = loaded_codec;
+        return SAIL_OK;
+    }
 
-    SAIL_TRY(unlock_context());
+    /*
+     * Slow path. Load the codec and try to publish it. If another thread has won the race,
+     * use its codec and drop ours. Loading the same shared library twice is safe as it's
+     * reference counted.
+     */
+    struct sail_codec *new_codec;
+    SAIL_TRY(alloc_and_load_codec(found_codec_bundle->codec_info, &new_codec));
+
+    struct sail_codec *published_codec = publish_codec_pointer(found_codec_bundle, new_codec);
+
+    if (published_codec == NULL) {
+        *codec = new_codec;
+    } else {
+        SAIL_LOG_DEBUG("%s codec has been loaded by another thread", found_codec_bundle->codec_info->name);
+        destroy_codec(new_codec);
+        *codec = published_codec;
+    }
 
     return SAIL_OK;
 }
@@ -105,6 +220,11 @@ void destroy_hidden_state(struct hidden_state *state) {
 
     sail_destroy_save_options(state->save_options);
 
+    sail_destroy_image(state->rows_image);
+    sail_destroy_image(state->pending_image);
+    sail_free(state->rows_frame);
+    sail_free(state->rows_buffer);
+
     /* This state must be freed and zeroed by codecs. We free it just in case to avoid memory leaks. */
     sail_free(state->state);
 
@@ -130,6 +250,15 @@ sail_status_t stop_saving(void *state, size_t *written) {
         return SAIL_OK;
     }
 
+    /* The frame started by sail_write_next_frame_header() is incomplete. */
+    if (state_of_mind->rows_image != NULL) {
+        SAIL_LOG_ERROR("%u rows of the current frame are not written",
+                        state_of_mind->rows_image->height - state_of_mind->rows_processed);
+        state_of_mind->codec->v7->save_finish(&state_of_mind->state, state_of_mind->io);
+        destroy_hidden_state(state_of_mind);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_CONFLICTING_OPERATION);
+    }
+
     SAIL_TRY_OR_CLEANUP(state_of_mind->codec->v7->save_finish(&state_of_mind->state, state_of_mind->io),
                         /* cleanup */ destroy_hidden_state(state_of_mind));
 
@@ -145,6 +274,66 @@ sail_status_t stop_saving(void *state, size_t *written) {
     return SAIL_OK;
 }
 
+sail_status_t check_frame_conversion(const struct sail_image *image, enum SailPixelFormat output_pixel_format,
+                                     unsigned *output_bytes_per_line) {
+
+    SAIL_CHECK_PTR(image);
+    SAIL_CHECK_PTR(output_bytes_per_line);
+
+    if (!sail_can_convert(image->pixel_format, output_pixel_format)) {
+        SAIL_LOG_ERROR("Cannot load %s pixels as %s", sail_pixel_format_to_string(image->pixel_format),
+                        sail_pixel_format_to_string(output_pixel_format));
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNSUPPORTED_PIXEL_FORMAT);
+    }
+
+    SAIL_TRY(sail_bytes_per_line(image->width, output_pixel_format, output_bytes_per_line));
+
+    return SAIL_OK;
+}
+
+sail_status_t convert_frame_in_place(struct sail_image *image, enum SailPixelFormat output_pixel_format) {
+
+    SAIL_CHECK_PTR(image);
+
+    unsigned output_bytes_per_line;
+    SAIL_TRY(sail_bytes_per_line(image->width, output_pixel_format, &output_bytes_per_line));
+
+    void *scan_line;
+    SAIL_TRY(sail_malloc(image->bytes_per_line, &scan_line));
+
+    /* Shallow copy of the image pointing to a single scan line. */
+    struct sail_image scan_line_image = *image;
+    scan_line_image.pixels = scan_line;
+    scan_line_image.height = 1;
+
+    /*
+     * Output rows never overwrite input rows not converted yet when converting top to bottom
+     * into smaller rows and bottom to top into larger rows. Every input row is copied aside first
+     * as it overlaps its own output row.
+     */
+    const bool grow = output_bytes_per_line > image->bytes_per_line;
+
+    for (unsigned i = 0; i < image->height; i++) {
+        const unsigned row = grow ? image->height - 1 - i : i;
+
+        memcpy(scan_line, (const uint8_t *)image->pixels + (size_t)row * image->bytes_per_line, image->bytes_per_line);
+
+        SAIL_TRY_OR_CLEANUP(sail_convert_image_to_pixels(&scan_line_image,
+                                                         output_pixel_format,
+                                                         NULL /* options */,
+                                                         (uint8_t *)image->pixels + (size_t)row * output_bytes_per_line,
+                                                         output_bytes_per_line),
+                            /* cleanup */ sail_free(scan_line));
+    }
+
+    sail_free(scan_line);
+
+    image->pixel_format   = output_pixel_format;
+    image->bytes_per_line = output_bytes_per_line;
+
+    return SAIL_OK;
+}
+
 sail_status_t allowed_write_output_pixel_format(const struct sail_save_features *save_features, enum SailPixelFormat pixel_format) {
 
     SAIL_CHECK_PTR(save_features);
@@ -158,3 +347,66 @@ sail_status_t allowed_write_output_pixel_format(const struct sail_save_features
     print_unsupported_write_pixel_format(pixel_format);
     SAIL_LOG_AND_RETURN(SAIL_ERROR_UNSUPPORTED_PIXEL_FORMAT);
 }
+
+sail_status_t probe_header(struct sail_io *io, const struct sail_codec_info *codec_info,
+                           struct sail_image **image, size_t *bytes_consumed) {
+
+    SAIL_CHECK_PTR(io);
+    SAIL_CHECK_PTR(codec_info);
+    SAIL_CHECK_PTR(image);
+
+    const struct sail_codec *codec;
+    SAIL_TRY(load_codec_by_codec_info(codec_info, &codec));
+
+    size_t start_offset;
+    SAIL_TRY(io->tell(io->stream, &start_offset));
+
+    struct probe_io_stream probe_io_stream = {
+        .io              = io,
+        .furthest_offset = start_offset,
+    };
+
+    struct sail_io probe_io = {
+        .id             = io->id,
+        .features       = io->features,
+        .stream         = &probe_io_stream,
+        .tolerant_read  = probe_io_tolerant_read,
+        .strict_read    = probe_io_strict_read,
+        .tolerant_write = sail_io_noop_tolerant_write,
+        .strict_write   = sail_io_noop_strict_write,
+        .seek           = probe_io_seek,
+        .tell           = probe_io_tell,
+        .flush          = sail_io_noop_flush,
+        .close          = probe_io_close,
+        .eof            = probe_io_eof,
+        .direct_buffer  = probe_io_direct_buffer,
+    };
+
+    /* No meta data, ICC profiles and such. */
+    struct sail_load_options *load_options;
+    SAIL_TRY(sail_alloc_load_options(&load_options));
+
+    load_options->options = SAIL_OPTION_HEADER_ONLY;
+
+    void *state = NULL;
+    SAIL_TRY_OR_CLEANUP(codec->v7->load_init(&probe_io, load_options, &state),
+                        /* cleanup */ codec->v7->load_finish(&state, &probe_io),
+                                      sail_destroy_load_options(load_options));
+
+    sail_destroy_load_options(load_options);
+
+    struct sail_image *image_local;
+    SAIL_TRY_OR_CLEANUP(codec->v7->load_seek_next_frame(state, &probe_io, &image_local),
+                        /* cleanup */ codec->v7->load_finish(&state, &probe_io));
+
+    SAIL_TRY_OR_CLEANUP(codec->v7->load_finish(&state, &probe_io),
+                        /* cleanup */ sail_destroy_image(image_local));
+
+    if (bytes_consumed != NULL) {
+        *bytes_consumed = probe_io_stream.furthest_offset - start_offset;
+    }
+
+    *image = image_local;
+
+    return SAIL_OK;
+}
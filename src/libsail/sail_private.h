@@ -41,6 +41,7 @@
 
 struct sail_codec_info;
 struct sail_codec;
+struct sail_pixel_allocator;
 struct sail_save_features;
 
 struct hidden_state {
@@ -54,9 +55,37 @@ struct hidden_state {
      */
     struct sail_save_options *save_options;
 
+    /* Load operations allocate pixels with it. NULL means sail_malloc(). */
+    const struct sail_pixel_allocator *pixel_allocator;
+
+    /* Load operations convert frames into it. SAIL_PIXEL_FORMAT_UNKNOWN means the codec pixel format. */
+    enum SailPixelFormat pixel_format;
+
     /* Local state passed to codec loading and saving functions. */
     void *state;
 
+    /*
+     * Frame without pixels being loaded by sail_load_next_rows() or saved by sail_write_next_rows().
+     * NULL if there is no such frame.
+     */
+    struct sail_image *rows_image;
+
+    /* Number of the frame rows loaded or saved so far. */
+    unsigned rows_processed;
+
+    /* Whole frame loaded at once or accumulated for saving when the codec cannot process the frame row by row. */
+    void *rows_frame;
+
+    /* Temporary rows to convert rows loaded by the codec. */
+    void *rows_buffer;
+    size_t rows_buffer_size;
+
+    /*
+     * Frame sought by sail_load_next_frame_into() that didn't fit into the caller pixel buffer.
+     * The next load call continues with it instead of seeking to the next frame. NULL if there is no such frame.
+     */
+    struct sail_image *pending_image;
+
     /* Pointers to internal data structures so no need to free these. */
     const struct sail_codec_info *codec_info;
     const struct sail_codec *codec;
@@ -69,6 +98,26 @@ SAIL_HIDDEN void destroy_hidden_state(struct hidden_state *state);
 
 SAIL_HIDDEN sail_status_t stop_saving(void *state, size_t *written);
 
+/*
+ * Checks if the frame can be converted from the codec pixel format into the output pixel format
+ * after loading. Returns the number of bytes per line in the output pixel format.
+ */
+SAIL_HIDDEN sail_status_t check_frame_conversion(const struct sail_image *image, enum SailPixelFormat output_pixel_format,
+                                                  unsigned *output_bytes_per_line);
+
+/*
+ * Converts the loaded frame into the output pixel format in place. The frame pixels must hold
+ * the frame in both pixel formats.
+ */
+SAIL_HIDDEN sail_status_t convert_frame_in_place(struct sail_image *image, enum SailPixelFormat output_pixel_format);
+
+/*
+ * Loads the first frame header from the I/O source with the specified codec info and
+ * SAIL_OPTION_HEADER_ONLY. Returns the number of bytes consumed from the current I/O position.
+ */
+SAIL_HIDDEN sail_status_t probe_header(struct sail_io *io, const struct sail_codec_info *codec_info,
+                                       struct sail_image **image, size_t *bytes_consumed);
+
 SAIL_HIDDEN sail_status_t allowed_write_output_pixel_format(const struct sail_save_features *save_features, enum SailPixelFormat pixel_format);
 
 #endif
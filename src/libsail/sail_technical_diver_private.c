@@ -72,17 +72,34 @@ sail_status_t start_loading_io_with_options(struct sail_io *io, bool own_io,
 
     *state = NULL;
 
+    /* Codecs skip palettes and such with this option, so frames cannot be loaded. */
+    if (load_options != NULL && (load_options->options & SAIL_OPTION_HEADER_ONLY)) {
+        SAIL_LOG_ERROR("SAIL_OPTION_HEADER_ONLY cannot be used to load frames, use sail_probe_header_*() instead");
+        if (own_io) {
+            sail_destroy_io(io);
+        }
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+
     void *ptr;
     SAIL_TRY_OR_CLEANUP(sail_malloc(sizeof(struct hidden_state), &ptr),
                         /* cleanup */ if (own_io) sail_destroy_io(io));
     struct hidden_state *state_of_mind = ptr;
 
-    state_of_mind->io           = io;
-    state_of_mind->own_io       = own_io;
-    state_of_mind->save_options = NULL;
-    state_of_mind->state        = NULL;
-    state_of_mind->codec_info   = codec_info;
-    state_of_mind->codec        = NULL;
+    state_of_mind->io               = io;
+    state_of_mind->own_io           = own_io;
+    state_of_mind->save_options     = NULL;
+    state_of_mind->pixel_allocator  = NULL;
+    state_of_mind->pixel_format     = SAIL_PIXEL_FORMAT_UNKNOWN;
+    state_of_mind->state            = NULL;
+    state_of_mind->rows_image       = NULL;
+    state_of_mind->rows_processed   = 0;
+    state_of_mind->rows_frame       = NULL;
+    state_of_mind->rows_buffer      = NULL;
+    state_of_mind->rows_buffer_size = 0;
+    state_of_mind->pending_image    = NULL;
+    state_of_mind->codec_info       = codec_info;
+    state_of_mind->codec            = NULL;
 
     SAIL_TRY_OR_CLEANUP(load_codec_by_codec_info(state_of_mind->codec_info, &state_of_mind->codec),
                         /* cleanup */ destroy_hidden_state(state_of_mind));
@@ -101,6 +118,9 @@ sail_status_t start_loading_io_with_options(struct sail_io *io, bool own_io,
         SAIL_TRY_OR_CLEANUP(state_of_mind->codec->v7->load_init(state_of_mind->io, load_options, &state_of_mind->state),
                             /* cleanup */ state_of_mind->codec->v7->load_finish(&state_of_mind->state, state_of_mind->io),
                                           destroy_hidden_state(state_of_mind));
+
+        state_of_mind->pixel_allocator = load_options->pixel_allocator;
+        state_of_mind->pixel_format    = load_options->pixel_format;
     }
 
     *state = state_of_mind;
@@ -131,12 +151,20 @@ sail_status_t start_saving_io_with_options(struct sail_io *io, bool own_io,
                         /* cleanup */ if (own_io) sail_destroy_io(io));
     struct hidden_state *state_of_mind = ptr;
 
-    state_of_mind->io           = io;
-    state_of_mind->own_io       = own_io;
-    state_of_mind->save_options = NULL;
-    state_of_mind->state        = NULL;
-    state_of_mind->codec_info   = codec_info;
-    state_of_mind->codec        = NULL;
+    state_of_mind->io               = io;
+    state_of_mind->own_io           = own_io;
+    state_of_mind->save_options     = NULL;
+    state_of_mind->pixel_allocator  = NULL;
+    state_of_mind->pixel_format     = SAIL_PIXEL_FORMAT_UNKNOWN;
+    state_of_mind->state            = NULL;
+    state_of_mind->rows_image       = NULL;
+    state_of_mind->rows_processed   = 0;
+    state_of_mind->rows_frame       = NULL;
+    state_of_mind->rows_buffer      = NULL;
+    state_of_mind->rows_buffer_size = 0;
+    state_of_mind->pending_image    = NULL;
+    state_of_mind->codec_info       = codec_info;
+    state_of_mind->codec            = NULL;
 
     SAIL_TRY_OR_CLEANUP(load_codec_by_codec_info(state_of_mind->codec_info, &state_of_mind->codec),
                         /* cleanup */ destroy_hidden_state(state_of_mind));
@@ -171,6 +171,17 @@ SAIL_EXPORT sail_status_t sail_codec_load_seek_next_frame_v7_avif(void *state, s
     avifRGBImageSetDefaults(&avif_state->rgb_image, avif_image);
     avif_state->rgb_image.depth = avif_private_round_depth(avif_state->rgb_image.depth);
 
+    /* Output the requested pixel format natively. */
+    if (avif_state->load_options->pixel_format != SAIL_PIXEL_FORMAT_UNKNOWN) {
+        enum avifRGBFormat rgb_pixel_format;
+        uint32_t depth;
+
+        if (avif_private_sail_pixel_format_to_rgb(avif_state->load_options->pixel_format, &rgb_pixel_format, &depth)) {
+            avif_state->rgb_image.format = rgb_pixel_format;
+            avif_state->rgb_image.depth  = depth;
+        }
+    }
+
     image_local->source_image->pixel_format =
         avif_private_sail_pixel_format(avif_image->yuvFormat, avif_image->depth, avif_image->alphaPlane != NULL);
     image_local->source_image->chroma_subsampling = avif_private_sail_chroma_subsampling(avif_image->yuvFormat);
@@ -41,6 +41,8 @@ SAIL_HIDDEN enum SailChromaSubsampling avif_private_sail_chroma_subsampling(enum
 
 SAIL_HIDDEN enum SailPixelFormat avif_private_rgb_sail_pixel_format(enum avifRGBFormat rgb_pixel_format, uint32_t depth);
 
+SAIL_HIDDEN bool avif_private_sail_pixel_format_to_rgb(enum SailPixelFormat pixel_format, enum avifRGBFormat *rgb_pixel_format, uint32_t *depth);
+
 SAIL_HIDDEN uint32_t avif_private_round_depth(uint32_t depth);
 
 SAIL_HIDDEN sail_status_t avif_private_fetch_iccp(const struct avifRWData *avif_iccp, struct sail_iccp **iccp);
@@ -0,0 +1,333 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stdint.h>
+#include <string.h>
+
+#include "sail-common.h"
+
+#include "blend.h"
+
+#if defined __SSE2__
+    #define SAIL_BLEND_HAVE_SSE2
+    #include <emmintrin.h>
+#elif defined __aarch64__ && defined __ARM_NEON
+    #define SAIL_BLEND_HAVE_NEON
+    #include <arm_neon.h>
+#endif
+
+/*
+ * Private functions.
+ */
+
+static inline void blend_over_rgba32_pixel(uint8_t *dst, const uint8_t *src) {
+
+    const unsigned src_a = src[3];
+
+    if (src_a == 255) {
+        memcpy(dst, src, 4);
+        return;
+    }
+
+    if (src_a == 0) {
+        return;
+    }
+
+    /* Weights are scaled by 255 to avoid divisions by 255 before the final one. */
+    const unsigned src_w = src_a * 255;
+    const unsigned dst_w = dst[3] * (255 - src_a);
+    const unsigned out_w = src_w + dst_w;
+
+    for (unsigned i = 0; i < 3; i++) {
+        dst[i] = (uint8_t)((src[i] * src_w + dst[i] * dst_w + out_w / 2) / out_w);
+    }
+
+    dst[3] = (uint8_t)((out_w + 127) / 255);
+}
+
+static inline void blend_over_rgba64_pixel(uint16_t *dst, const uint16_t *src) {
+
+    const uint32_t src_a = src[3];
+
+    if (src_a == 65535) {
+        memcpy(dst, src, 4 * sizeof(uint16_t));
+        return;
+    }
+
+    if (src_a == 0) {
+        return;
+    }
+
+    const uint32_t src_w = src_a * 65535;
+    const uint32_t dst_w = dst[3] * (65535 - src_a);
+    const uint64_t out_w = (uint64_t)src_w + dst_w;
+
+    for (unsigned i = 0; i < 3; i++) {
+        dst[i] = (uint16_t)(((uint64_t)src[i] * src_w + (uint64_t)dst[i] * dst_w + out_w / 2) / out_w);
+    }
+
+    dst[3] = (uint16_t)((out_w + 32767) / 65535);
+}
+
+/*
+ * SIMD kernels return the number of processed pixels. The rest is handled by the scalar code.
+ * Only opaque destination pixels are blended with SIMD as out_a is always 1 for them,
+ * and the division by out_a turns into a division by 255 or 65535:
+ *
+ *     round(x / 255)   = (t + (t >> 8))  >> 8,  t = x + 128
+ *     round(x / 65535) = (t + (t >> 16)) >> 16, t = x + 32768
+ */
+#if defined SAIL_BLEND_HAVE_SSE2
+
+/* Blends 2 pixels from unpacked 16-bit components. */
+static inline __m128i blend_opaque_u16x8_sse2(__m128i src, __m128i dst) {
+
+    const __m128i alpha     = _mm_shufflehi_epi16(_mm_shufflelo_epi16(src, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    const __m128i inv_alpha = _mm_sub_epi16(_mm_set1_epi16(255), alpha);
+
+    const __m128i x = _mm_add_epi16(_mm_mullo_epi16(src, alpha), _mm_mullo_epi16(dst, inv_alpha));
+    const __m128i t = _mm_add_epi16(x, _mm_set1_epi16(128));
+
+    return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+static unsigned blend_over_rgba32_row_simd(uint8_t *dst, const uint8_t *src, unsigned width) {
+
+    const __m128i zero        = _mm_setzero_si128();
+    const __m128i ones        = _mm_set1_epi8((char)0xff);
+    const __m128i alpha_mask  = _mm_set1_epi32((int)0xff000000);
+    const int     alpha_bits  = 0x8888;
+
+    unsigned i = 0;
+
+    for (; i + 4 <= width; i += 4) {
+        const __m128i s = _mm_loadu_si128((const __m128i *)(src + i * 4));
+
+        if ((_mm_movemask_epi8(_mm_cmpeq_epi8(s, ones)) & alpha_bits) == alpha_bits) {
+            _mm_storeu_si128((__m128i *)(dst + i * 4), s);
+            continue;
+        }
+
+        if ((_mm_movemask_epi8(_mm_cmpeq_epi8(s, zero)) & alpha_bits) == alpha_bits) {
+            continue;
+        }
+
+        const __m128i d = _mm_loadu_si128((const __m128i *)(dst + i * 4));
+
+        if ((_mm_movemask_epi8(_mm_cmpeq_epi8(d, ones)) & alpha_bits) != alpha_bits) {
+            for (unsigned k = i; k < i + 4; k++) {
+                blend_over_rgba32_pixel(dst + k * 4, src + k * 4);
+            }
+            continue;
+        }
+
+        const __m128i lo = blend_opaque_u16x8_sse2(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero));
+        const __m128i hi = blend_opaque_u16x8_sse2(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero));
+
+        _mm_storeu_si128((__m128i *)(dst + i * 4), _mm_or_si128(_mm_packus_epi16(lo, hi), alpha_mask));
+    }
+
+    return i;
+}
+
+/* Multiplies unsigned 16-bit components into 32-bit products. */
+static inline void mul_u16_to_u32_sse2(__m128i a, __m128i b, __m128i *lo, __m128i *hi) {
+
+    const __m128i products_lo = _mm_mullo_epi16(a, b);
+    const __m128i products_hi = _mm_mulhi_epu16(a, b);
+
+    *lo = _mm_unpacklo_epi16(products_lo, products_hi);
+    *hi = _mm_unpackhi_epi16(products_lo, products_hi);
+}
+
+static inline __m128i div_65535_sse2(__m128i x) {
+
+    const __m128i t = _mm_add_epi32(x, _mm_set1_epi32(32768));
+    const __m128i r = _mm_srli_epi32(_mm_add_epi32(t, _mm_srli_epi32(t, 16)), 16);
+
+    /* Sign-extend to pack unsigned values with the signed saturation. */
+    return _mm_srai_epi32(_mm_slli_epi32(r, 16), 16);
+}
+
+static unsigned blend_over_rgba64_row_simd(uint16_t *dst, const uint16_t *src, unsigned width) {
+
+    const __m128i alpha_mask = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+
+    unsigned i = 0;
+
+    for (; i + 2 <= width; i += 2) {
+        const uint16_t *src_pixels = src + i * 4;
+        uint16_t *dst_pixels = dst + i * 4;
+
+        if (src_pixels[3] == 65535 && src_pixels[7] == 65535) {
+            memcpy(dst_pixels, src_pixels, 8 * sizeof(uint16_t));
+            continue;
+        }
+
+        if (src_pixels[3] == 0 && src_pixels[7] == 0) {
+            continue;
+        }
+
+        if (dst_pixels[3] != 65535 || dst_pixels[7] != 65535) {
+            blend_over_rgba64_pixel(dst_pixels, src_pixels);
+            blend_over_rgba64_pixel(dst_pixels + 4, src_pixels + 4);
+            continue;
+        }
+
+        const __m128i s         = _mm_loadu_si128((const __m128i *)src_pixels);
+        const __m128i d         = _mm_loadu_si128((const __m128i *)dst_pixels);
+        const __m128i alpha     = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        const __m128i inv_alpha = _mm_xor_si128(alpha, _mm_set1_epi16(-1));
+
+        __m128i src_lo, src_hi, dst_lo, dst_hi;
+        mul_u16_to_u32_sse2(s, alpha, &src_lo, &src_hi);
+        mul_u16_to_u32_sse2(d, inv_alpha, &dst_lo, &dst_hi);
+
+        const __m128i lo = div_65535_sse2(_mm_add_epi32(src_lo, dst_lo));
+        const __m128i hi = div_65535_sse2(_mm_add_epi32(src_hi, dst_hi));
+
+        _mm_storeu_si128((__m128i *)dst_pixels, _mm_or_si128(_mm_packs_epi32(lo, hi), alpha_mask));
+    }
+
+    return i;
+}
+
+#elif defined SAIL_BLEND_HAVE_NEON
+
+static unsigned blend_over_rgba32_row_simd(uint8_t *dst, const uint8_t *src, unsigned width) {
+
+    unsigned i = 0;
+
+    for (; i + 8 <= width; i += 8) {
+        const uint8x8x4_t s = vld4_u8(src + i * 4);
+
+        if (vminv_u8(s.val[3]) == 255) {
+            vst4_u8(dst + i * 4, s);
+            continue;
+        }
+
+        if (vmaxv_u8(s.val[3]) == 0) {
+            continue;
+        }
+
+        uint8x8x4_t d = vld4_u8(dst + i * 4);
+
+        if (vminv_u8(d.val[3]) != 255) {
+            for (unsigned k = i; k < i + 8; k++) {
+                blend_over_rgba32_pixel(dst + k * 4, src + k * 4);
+            }
+            continue;
+        }
+
+        const uint8x8_t inv_alpha = vmvn_u8(s.val[3]);
+
+        for (unsigned c = 0; c < 3; c++) {
+            const uint16x8_t x = vmlal_u8(vmull_u8(s.val[c], s.val[3]), d.val[c], inv_alpha);
+            d.val[c] = vrshrn_n_u16(vrsraq_n_u16(x, x, 8), 8);
+        }
+
+        vst4_u8(dst + i * 4, d);
+    }
+
+    return i;
+}
+
+static unsigned blend_over_rgba64_row_simd(uint16_t *dst, const uint16_t *src, unsigned width) {
+
+    unsigned i = 0;
+
+    for (; i + 4 <= width; i += 4) {
+        const uint16x4x4_t s = vld4_u16(src + i * 4);
+
+        if (vminv_u16(s.val[3]) == 65535) {
+            vst4_u16(dst + i * 4, s);
+            continue;
+        }
+
+        if (vmaxv_u16(s.val[3]) == 0) {
+            continue;
+        }
+
+        uint16x4x4_t d = vld4_u16(dst + i * 4);
+
+        if (vminv_u16(d.val[3]) != 65535) {
+            for (unsigned k = i; k < i + 4; k++) {
+                blend_over_rgba64_pixel(dst + k * 4, src + k * 4);
+            }
+            continue;
+        }
+
+        const uint16x4_t inv_alpha = vmvn_u16(s.val[3]);
+
+        for (unsigned c = 0; c < 3; c++) {
+            const uint32x4_t x = vmlal_u16(vmull_u16(s.val[c], s.val[3]), d.val[c], inv_alpha);
+            d.val[c] = vrshrn_n_u32(vrsraq_n_u32(x, x, 16), 16);
+        }
+
+        vst4_u16(dst + i * 4, d);
+    }
+
+    return i;
+}
+
+#else
+
+static unsigned blend_over_rgba32_row_simd(uint8_t *dst, const uint8_t *src, unsigned width) {
+
+    (void)dst;
+    (void)src;
+    (void)width;
+
+    return 0;
+}
+
+static unsigned blend_over_rgba64_row_simd(uint16_t *dst, const uint16_t *src, unsigned width) {
+
+    (void)dst;
+    (void)src;
+    (void)width;
+
+    return 0;
+}
+
+#endif
+
+/*
+ * Public functions.
+ */
+
+void blend_private_over_rgba32_row(uint8_t *dst, const uint8_t *src, unsigned width) {
+
+    for (unsigned i = blend_over_rgba32_row_simd(dst, src, width); i < width; i++) {
+        blend_over_rgba32_pixel(dst + i * 4, src + i * 4);
+    }
+}
+
+void blend_private_over_rgba64_row(uint16_t *dst, const uint16_t *src, unsigned width) {
+
+    for (unsigned i = blend_over_rgba64_row_simd(dst, src, width); i < width; i++) {
+        blend_over_rgba64_pixel(dst + i * 4, src + i * 4);
+    }
+}
@@ -0,0 +1,51 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SAIL_BLEND_H
+#define SAIL_BLEND_H
+
+#include <stdint.h>
+
+#include "export.h"
+
+/*
+ * Alpha compositing of animation frames shared by codecs. Pixels have 4 components with alpha
+ * being the last one, like RGBA or BGRA. Colors are not premultiplied.
+ *
+ * The "over" operator composites the source pixels over the destination pixels in place
+ * with exact integer arithmetic:
+ *
+ *     out_a = src_a + dst_a * (1 - src_a)
+ *     out_c = (src_c * src_a + dst_c * dst_a * (1 - src_a)) / out_a
+ *
+ * Results are rounded to the nearest integer. SIMD kernels handle common pixel runs
+ * like opaque or fully transparent source pixels and opaque destination pixels,
+ * and produce the same results as the scalar code.
+ */
+SAIL_HIDDEN void blend_private_over_rgba32_row(uint8_t *dst, const uint8_t *src, unsigned width);
+
+SAIL_HIDDEN void blend_private_over_rgba64_row(uint16_t *dst, const uint16_t *src, unsigned width);
+
+#endif
@@ -31,6 +31,8 @@
 
 #include "sail-common.h"
 
+#include "common/reader/reader.h"
+
 #include "bmp.h"
 #include "helpers.h"
 
@@ -385,6 +387,9 @@ sail_status_t bmp_private_read_frame(void *state, struct sail_io *io, struct sai
 
     struct bmp_state *bmp_state = (struct bmp_state *)state;
 
+    struct reader reader;
+    reader_private_init(&reader, io);
+
     /* RLE-encoded images don't need to skip pad bytes. */
     bool skip_pad_bytes = true;
 
@@ -396,11 +401,11 @@ sail_status_t bmp_private_read_frame(void *state, struct sail_io *io, struct sai
                 skip_pad_bytes = false;
 
                 uint8_t marker;
-                SAIL_TRY(io->strict_read(io->stream, &marker, sizeof(marker)));
+                SAIL_TRY(reader_private_read_byte(&reader, &marker));
 
                 if (marker == SAIL_UNENCODED_RUN_MARKER) {
                     uint8_t count_or_marker;
-                    SAIL_TRY(io->strict_read(io->stream, &count_or_marker, sizeof(count_or_marker)));
+                    SAIL_TRY(reader_private_read_byte(&reader, &count_or_marker));
 
                     if (count_or_marker == SAIL_END_OF_SCAN_LINE_MARKER) {
                         /* Jump to the end of scan line. +1 to avoid reading end-of-scan-line marker twice below. */
@@ -418,7 +423,7 @@ sail_status_t bmp_private_read_frame(void *state, struct sail_io *io, struct sai
 
                         for (uint8_t k = 0; k < count_or_marker; k++) {
                             if (read_byte) {
-                                SAIL_TRY(io->strict_read(io->stream, &byte, sizeof(byte)));
+                                SAIL_TRY(reader_private_read_byte(&reader, &byte));
                                 index = (byte >> 4) & 0xf;
                                 read_byte = false;
                             } else {
@@ -432,7 +437,7 @@ sail_status_t bmp_private_read_frame(void *state, struct sail_io *io, struct sai
                         /* Odd number of bytes is accompanied with an additional byte. */
                         uint8_t number_of_unencoded_bytes = (count_or_marker + 1) / 2;
                         if ((number_of_unencoded_bytes % 2) != 0) {
-                            SAIL_TRY(io->seek(io->stream, 1, SEEK_CUR));
+                            SAIL_TRY(reader_private_skip(&reader, 1));
                         }
 
                         pixel_index += count_or_marker;
@@ -443,7 +448,7 @@ sail_status_t bmp_private_read_frame(void *state, struct sail_io *io, struct sai
                     uint8_t index;
 
                     uint8_t byte;
-                    SAIL_TRY(io->strict_read(io->stream, &byte, sizeof(byte)));
+                    SAIL_TRY(reader_private_read_byte(&reader, &byte));
 
                     for (uint8_t k = 0; k < marker; k++) {
                         if (high_4_bits) {
@@ -462,17 +467,17 @@ sail_status_t bmp_private_read_frame(void *state, struct sail_io *io, struct sai
 
                 /* Read a possible end-of-scan-line marker at the end of line. */
                 if (pixel_index == image->width) {
-                    SAIL_TRY(bmp_private_skip_end_of_scan_line(io));
+                    SAIL_TRY(bmp_private_skip_end_of_scan_line(&reader));
                 }
             } else if (bmp_state->version >= SAIL_BMP_V3 && bmp_state->v3.compression == SAIL_BI_RLE8) {
                 skip_pad_bytes = false;
 
                 uint8_t marker;
-                SAIL_TRY(io->strict_read(io->stream, &marker, sizeof(marker)));
+                SAIL_TRY(reader_private_read_byte(&reader, &marker));
 
                 if (marker == SAIL_UNENCODED_RUN_MARKER) {
                     uint8_t count_or_marker;
-                    SAIL_TRY(io->strict_read(io->stream, &count_or_marker, sizeof(count_or_marker)));
+                    SAIL_TRY(reader_private_read_byte(&reader, &count_or_marker));
 
                     if (count_or_marker == SAIL_END_OF_SCAN_LINE_MARKER) {
                         /* Jump to the end of scan line. +1 to avoid reading end-of-scan-line marker twice below. */
@@ -486,14 +491,14 @@ sail_status_t bmp_private_read_frame(void *state, struct sail_io *io, struct sai
                     } else {
                         for (uint8_t k = 0; k < count_or_marker; k++) {
                             uint8_t index;
-                            SAIL_TRY(io->strict_read(io->stream, &index, sizeof(index)));
+                            SAIL_TRY(reader_private_read_byte(&reader, &index));
 
                             *scan++ = index;
                         }
 
                         /* Odd number of pixels is accompanied with an additional byte. */
                         if ((count_or_marker % 2) != 0) {
-                            SAIL_TRY(io->seek(io->stream, 1, SEEK_CUR));
+                            SAIL_TRY(reader_private_skip(&reader, 1));
                         }
 
                         pixel_index += count_or_marker;
@@ -501,7 +506,7 @@ sail_status_t bmp_private_read_frame(void *state, struct sail_io *io, struct sai
                 } else {
                     /* Normal RLE: count + value. */
                     uint8_t index;
-                    SAIL_TRY(io->strict_read(io->stream, &index, sizeof(index)));
+                    SAIL_TRY(reader_private_read_byte(&reader, &index));
 
                     for (uint8_t k = 0; k < marker; k++) {
                         *scan++ = index;
@@ -512,21 +517,24 @@ sail_status_t bmp_private_read_frame(void *state, struct sail_io *io, struct sai
 
                 /* Read a possible end-of-scan-line marker at the end of line. */
                 if (pixel_index == image->width) {
-                    SAIL_TRY(bmp_private_skip_end_of_scan_line(io));
+                    SAIL_TRY(bmp_private_skip_end_of_scan_line(&reader));
                 }
             } else {
                 /* Read a whole scan line. */
-                SAIL_TRY(io->strict_read(io->stream, scan, bmp_state->bytes_in_row));
+                SAIL_TRY(reader_private_read(&reader, scan, bmp_state->bytes_in_row));
                 pixel_index += image->width;
             }
         }
 
         /* Skip pad bytes. */
         if (skip_pad_bytes) {
-            SAIL_TRY(io->seek(io->stream, bmp_state->pad_bytes, SEEK_CUR));
+            SAIL_TRY(reader_private_skip(&reader, bmp_state->pad_bytes));
         }
     }
 
+    /* Leave the I/O position right after the consumed data. */
+    SAIL_TRY(reader_private_sync(&reader));
+
     return SAIL_OK;
 }
 
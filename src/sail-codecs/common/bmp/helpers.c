@@ -27,6 +27,8 @@
 
 #include "sail-common.h"
 
+#include "common/reader/reader.h"
+
 #include "helpers.h"
 
 sail_status_t bmp_private_read_ddb_file_header(struct sail_io *io, struct SailBmpDdbFileHeader *ddb_file_header) {
@@ -146,19 +148,17 @@ sail_status_t bmp_private_fetch_iccp(struct sail_io *io, long offset_of_data, ui
     return SAIL_OK;
 }
 
-sail_status_t bmp_private_skip_end_of_scan_line(struct sail_io *io) {
+sail_status_t bmp_private_skip_end_of_scan_line(struct reader *reader) {
 
     uint8_t marker;
-    SAIL_TRY(io->strict_read(io->stream, &marker, sizeof(marker)));
+    SAIL_TRY(reader_private_peek_byte(reader, 0, &marker));
 
     if (marker == SAIL_UNENCODED_RUN_MARKER) {
-        SAIL_TRY(io->strict_read(io->stream, &marker, sizeof(marker)));
+        SAIL_TRY(reader_private_peek_byte(reader, 1, &marker));
 
-        if (marker != SAIL_END_OF_SCAN_LINE_MARKER) {
-            SAIL_TRY(io->seek(io->stream, -2, SEEK_CUR));
+        if (marker == SAIL_END_OF_SCAN_LINE_MARKER) {
+            SAIL_TRY(reader_private_skip(reader, 2));
         }
-    } else {
-        SAIL_TRY(io->seek(io->stream, -1, SEEK_CUR));
     }
 
     return SAIL_OK;
@@ -0,0 +1,172 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "sail-common.h"
+
+#include "reader.h"
+
+void reader_private_init(struct reader *reader, struct sail_io *io) {
+
+    reader->io     = io;
+    reader->pos    = 0;
+    reader->length = 0;
+}
+
+sail_status_t reader_private_fill(struct reader *reader, size_t size) {
+
+    if (reader->length - reader->pos >= size) {
+        return SAIL_OK;
+    }
+
+    if (size > sizeof(reader->buffer)) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+
+    /* Move the unconsumed bytes to the beginning of the window. */
+    const size_t unconsumed = reader->length - reader->pos;
+    memmove(reader->buffer, reader->buffer + reader->pos, unconsumed);
+
+    reader->pos    = 0;
+    reader->length = unconsumed;
+
+    while (reader->length < size) {
+        size_t read_size;
+        const sail_status_t status = reader->io->tolerant_read(reader->io->stream,
+                                                               reader->buffer + reader->length,
+                                                               sizeof(reader->buffer) - reader->length,
+                                                               &read_size);
+
+        if (status == SAIL_ERROR_EOF || (status == SAIL_OK && read_size == 0)) {
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_READ_IO);
+        }
+
+        SAIL_TRY(status);
+
+        reader->length += read_size;
+    }
+
+    return SAIL_OK;
+}
+
+sail_status_t reader_private_read_slow(struct reader *reader, void *buf, size_t size) {
+
+    unsigned char *buf_ptr = buf;
+
+    /* Drain the window. */
+    const size_t unconsumed = reader->length - reader->pos;
+    memcpy(buf_ptr, reader->buffer + reader->pos, unconsumed);
+
+    buf_ptr += unconsumed;
+    size    -= unconsumed;
+
+    reader->pos    = 0;
+    reader->length = 0;
+
+    if (size >= sizeof(reader->buffer)) {
+        SAIL_TRY(reader->io->strict_read(reader->io->stream, buf_ptr, size));
+    } else {
+        SAIL_TRY(reader_private_fill(reader, size));
+
+        memcpy(buf_ptr, reader->buffer, size);
+        reader->pos = size;
+    }
+
+    return SAIL_OK;
+}
+
+sail_status_t reader_private_skip(struct reader *reader, size_t size) {
+
+    const size_t unconsumed = reader->length - reader->pos;
+
+    if (unconsumed >= size) {
+        reader->pos += size;
+        return SAIL_OK;
+    }
+
+    const size_t size_to_seek = size - unconsumed;
+
+    if (size_to_seek > LONG_MAX) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+
+    reader->pos    = 0;
+    reader->length = 0;
+
+    SAIL_TRY(reader->io->seek(reader->io->stream, (long)size_to_seek, SEEK_CUR));
+
+    return SAIL_OK;
+}
+
+sail_status_t reader_private_sync(struct reader *reader) {
+
+    const size_t unconsumed = reader->length - reader->pos;
+
+    reader->pos    = 0;
+    reader->length = 0;
+
+    if (unconsumed > 0) {
+        SAIL_TRY(reader->io->seek(reader->io->stream, -(long)unconsumed, SEEK_CUR));
+    }
+
+    return SAIL_OK;
+}
+
+sail_status_t reader_private_read_line(struct reader *reader, char *str, size_t str_size) {
+
+    if (str_size < 2) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_INVALID_ARGUMENT);
+    }
+
+    size_t i = 0;
+
+    while (i < str_size - 1) {
+        if (reader->pos == reader->length) {
+            SAIL_TRY(reader_private_fill(reader, 1));
+        }
+
+        /* Copy up to the end of the line, the window, or the string. */
+        const unsigned char *window = reader->buffer + reader->pos;
+        const size_t available = reader->length - reader->pos;
+        const size_t to_scan = available < str_size - 1 - i ? available : str_size - 1 - i;
+        const unsigned char *eol = memchr(window, '\n', to_scan);
+        const size_t to_copy = (eol == NULL) ? to_scan : (size_t)(eol - window) + 1;
+
+        memcpy(str + i, window, to_copy);
+        reader->pos += to_copy;
+        i           += to_copy;
+
+        if (eol != NULL) {
+            str[i] = '\0';
+            return SAIL_OK;
+        }
+    }
+
+    /* String is full and no trailing \n was seen. */
+    SAIL_LOG_AND_RETURN(SAIL_ERROR_READ_IO);
+}
@@ -0,0 +1,138 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#ifndef SAIL_READER_H
+#define SAIL_READER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "sail-common.h"
+
+/* The size of the read-ahead window. */
+#define READER_BUFFER_SIZE 8192
+
+/*
+ * Buffered byte reader over an I/O object for decoders that consume their input in tiny
+ * pieces like RLE markers and literals, or text tokens. Reads the I/O object ahead into a window and serves
+ * small reads from it with inline code. Large reads bypass the window.
+ *
+ * The I/O position runs ahead of the reader position while reading. Call reader_private_sync()
+ * when done to move the I/O position back to the first unconsumed byte.
+ *
+ * The reader is designed to live on the stack of a frame decoding function:
+ *
+ *     struct reader reader;
+ *     reader_private_init(&reader, io);
+ *     ... reader_private_read_byte(&reader, &byte) ...
+ *     SAIL_TRY(reader_private_sync(&reader));
+ */
+struct reader {
+    struct sail_io *io;
+
+    /* The position of the first unconsumed byte in the window. */
+    size_t pos;
+
+    /* The number of valid bytes in the window. */
+    size_t length;
+
+    unsigned char buffer[READER_BUFFER_SIZE];
+};
+
+SAIL_HIDDEN void reader_private_init(struct reader *reader, struct sail_io *io);
+
+/*
+ * Makes sure the window holds at least the specified number of unconsumed bytes. The size must
+ * not exceed READER_BUFFER_SIZE. Returns SAIL_ERROR_READ_IO if the I/O object has less bytes left.
+ */
+SAIL_HIDDEN sail_status_t reader_private_fill(struct reader *reader, size_t size);
+
+/*
+ * The slow path of reader_private_read() for reads crossing the window end.
+ */
+SAIL_HIDDEN sail_status_t reader_private_read_slow(struct reader *reader, void *buf, size_t size);
+
+/*
+ * Skips the specified number of bytes. Seeks the I/O object when the bytes are not in the window.
+ */
+SAIL_HIDDEN sail_status_t reader_private_skip(struct reader *reader, size_t size);
+
+/*
+ * Moves the I/O position back to the first unconsumed byte and empties the window.
+ */
+SAIL_HIDDEN sail_status_t reader_private_sync(struct reader *reader);
+
+/*
+ * Reads a text line including the trailing '\n' and terminates it with zero. Returns SAIL_ERROR_READ_IO
+ * if the line doesn't fit into the string. The text analog of sail_read_string_from_io().
+ */
+SAIL_HIDDEN sail_status_t reader_private_read_line(struct reader *reader, char *str, size_t str_size);
+
+static inline sail_status_t reader_private_read_byte(struct reader *reader, uint8_t *byte) {
+
+    if (reader->pos == reader->length) {
+        SAIL_TRY(reader_private_fill(reader, 1));
+    }
+
+    *byte = reader->buffer[reader->pos++];
+
+    return SAIL_OK;
+}
+
+/*
+ * Returns the unconsumed byte at the specified offset from the reader position without consuming it.
+ */
+static inline sail_status_t reader_private_peek_byte(struct reader *reader, size_t offset, uint8_t *byte) {
+
+    SAIL_TRY(reader_private_fill(reader, offset + 1));
+
+    *byte = reader->buffer[reader->pos + offset];
+
+    return SAIL_OK;
+}
+
+/*
+ * Pushes the last byte read with reader_private_read_byte() back. Only one byte can be pushed back
+ * after every reader_private_read_byte() call.
+ */
+static inline void reader_private_unread_byte(struct reader *reader) {
+
+    reader->pos--;
+}
+
+static inline sail_status_t reader_private_read(struct reader *reader, void *buf, size_t size) {
+
+    if (reader->length - reader->pos >= size) {
+        memcpy(buf, reader->buffer + reader->pos, size);
+        reader->pos += size;
+
+        return SAIL_OK;
+    }
+
+    return reader_private_read_slow(reader, buf, size);
+}
+
+#endif
@@ -33,6 +33,8 @@
 
 #include "sail-common.h"
 
+#include "common/blend/blend.h"
+
 #include "helpers.h"
 #include "io.h"
 
@@ -49,6 +51,7 @@ struct gif_state {
     GifFileType *gif;
     const ColorMapObject *map;
     unsigned char *buf;
+    unsigned char *frame_row;
     int transparency_index;
     int first_frame_height;
     int disposal;
@@ -78,6 +81,7 @@ static sail_status_t alloc_gif_state(struct gif_state **gif_state) {
     (*gif_state)->gif                = NULL;
     (*gif_state)->map                = NULL;
     (*gif_state)->buf                = NULL;
+    (*gif_state)->frame_row          = NULL;
     (*gif_state)->transparency_index = -1;
     (*gif_state)->disposal           = DISPOSAL_UNSPECIFIED;
     (*gif_state)->prev_disposal      = DISPOSAL_UNSPECIFIED;
@@ -105,6 +109,7 @@ static void destroy_gif_state(struct gif_state *gif_state) {
     sail_destroy_save_options(gif_state->save_options);
 
     sail_free(gif_state->buf);
+    sail_free(gif_state->frame_row);
 
     if (gif_state->first_frame != NULL) {
         for(int i = 0; i < gif_state->first_frame_height; i++) {
@@ -161,6 +166,9 @@ SAIL_EXPORT sail_status_t sail_codec_load_init_v7_gif(struct sail_io *io, const
     SAIL_TRY(sail_malloc(gif_state->gif->SWidth * sizeof(GifPixelType), &ptr));
     gif_state->buf = ptr;
 
+    SAIL_TRY(sail_malloc(gif_state->gif->SWidth * 4, &ptr)); /* 4 = RGBA */
+    gif_state->frame_row = ptr;
+
     gif_state->first_frame_height = gif_state->gif->SHeight;
 
     SAIL_TRY(sail_malloc(gif_state->first_frame_height * sizeof(unsigned char *), &ptr));
@@ -410,18 +418,17 @@ SAIL_EXPORT sail_status_t sail_codec_load_frame_v7_gif(void *state, struct sail_
 
                 memcpy(scan, gif_state->first_frame[cc], image->width * 4);
 
+                /* Expand the indexes and blend over the previous frame skipping transparent pixels. */
                 for (unsigned i = 0; i < gif_state->width; i++) {
-                    if (gif_state->buf[i] == gif_state->transparency_index) {
-                        continue;
-                    }
-
-                    unsigned char *pixel = scan + (gif_state->column + i)*4;
+                    unsigned char *pixel = gif_state->frame_row + i*4;
 
                     *(pixel+0) = gif_state->map->Colors[gif_state->buf[i]].Red;
                     *(pixel+1) = gif_state->map->Colors[gif_state->buf[i]].Green;
                     *(pixel+2) = gif_state->map->Colors[gif_state->buf[i]].Blue;
-                    *(pixel+3) = 255;
+                    *(pixel+3) = (gif_state->buf[i] == gif_state->transparency_index) ? 0 : 255;
                 } // for
+
+                blend_private_over_rgba32_row(scan + gif_state->column*4, gif_state->frame_row, gif_state->width);
             }
 
             if (current_pass == last_pass) {
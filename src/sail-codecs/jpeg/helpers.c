@@ -96,6 +96,57 @@ J_COLOR_SPACE jpeg_private_pixel_format_to_color_space(enum SailPixelFormat pixe
     }
 }
 
+bool jpeg_private_output_color_space(J_COLOR_SPACE jpeg_color_space, enum SailPixelFormat pixel_format, J_COLOR_SPACE *out_color_space) {
+
+    const J_COLOR_SPACE color_space = jpeg_private_pixel_format_to_color_space(pixel_format);
+
+    if (color_space == JCS_UNKNOWN) {
+        return false;
+    }
+
+    if (color_space == jpeg_color_space) {
+        *out_color_space = color_space;
+        return true;
+    }
+
+    switch (jpeg_color_space) {
+        case JCS_GRAYSCALE:
+        case JCS_YCbCr:
+        case JCS_RGB: {
+            switch (color_space) {
+                case JCS_GRAYSCALE:
+                case JCS_RGB:
+#ifdef SAIL_HAVE_JPEG_JCS_EXT
+                case JCS_RGB565:
+                case JCS_EXT_BGR:
+                case JCS_EXT_RGBA:
+                case JCS_EXT_BGRA:
+                case JCS_EXT_ABGR:
+                case JCS_EXT_ARGB:
+#endif
+                {
+                    *out_color_space = color_space;
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+        }
+        case JCS_YCCK: {
+            if (color_space == JCS_CMYK) {
+                *out_color_space = color_space;
+                return true;
+            }
+
+            return false;
+        }
+        default: {
+            return false;
+        }
+    }
+}
+
 sail_status_t jpeg_private_fetch_meta_data(struct jpeg_decompress_struct *decompress_context, struct sail_meta_data_node **last_meta_data_node) {
 
     SAIL_CHECK_PTR(last_meta_data_node);
@@ -256,3 +307,52 @@ bool jpeg_private_tuning_key_value_callback(const char *key, const struct sail_v
 
     return true;
 }
+
+bool jpeg_private_load_tuning_key_value_callback(const char *key, const struct sail_variant *value, void *user_data) {
+
+    struct jpeg_decompress_struct *decompress_context = user_data;
+
+    if (strcmp(key, "jpeg-scale-denominator") == 0) {
+        if (value->type == SAIL_VARIANT_TYPE_UNSIGNED_INT) {
+            const unsigned scale_denominator = sail_variant_to_unsigned_int(value);
+
+            /* Scaling in the DCT domain. */
+            if (scale_denominator == 1 || scale_denominator == 2 || scale_denominator == 4 || scale_denominator == 8) {
+                SAIL_LOG_TRACE("JPEG: Scaling the image by 1/%u", scale_denominator);
+                decompress_context->scale_num   = 1;
+                decompress_context->scale_denom = scale_denominator;
+            } else {
+                SAIL_LOG_WARNING("JPEG: Unsupported scale denominator %u. Possible values: 1, 2, 4, 8", scale_denominator);
+            }
+        }
+    }
+
+    return true;
+}
+
+void jpeg_private_read_scanlines(struct jpeg_decompress_struct *decompress_context, void *rows, unsigned bytes_per_line, unsigned rows_count) {
+
+    /* libjpeg never recommends more than 4 scan lines as the maximum vertical sampling factor is 4. */
+    JSAMPROW samprows[4];
+
+    const unsigned max_rows_per_call = (decompress_context->rec_outbuf_height > 0 && decompress_context->rec_outbuf_height <= 4)
+                                        ? (unsigned)decompress_context->rec_outbuf_height : 1;
+
+    for (unsigned row = 0; row < rows_count;) {
+        const unsigned rows_per_call = (rows_count - row < max_rows_per_call) ? rows_count - row : max_rows_per_call;
+
+        for (unsigned i = 0; i < rows_per_call; i++) {
+            samprows[i] = (JSAMPROW)((unsigned char *)rows + (size_t)(row + i) * bytes_per_line);
+        }
+
+        const JDIMENSION rows_read = jpeg_read_scanlines(decompress_context, samprows, rows_per_call);
+
+        /* Suspending data sources are not used, so no rows are read only when the image is over. */
+        if (rows_read == 0) {
+            break;
+        }
+
+        row += rows_read;
+    }
+}
+
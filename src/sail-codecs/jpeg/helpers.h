@@ -51,6 +51,12 @@ SAIL_HIDDEN enum SailPixelFormat jpeg_private_color_space_to_pixel_format(J_COLO
 
 SAIL_HIDDEN J_COLOR_SPACE jpeg_private_pixel_format_to_color_space(enum SailPixelFormat pixel_format);
 
+/*
+ * Returns true if libjpeg can output the pixel format from the JPEG color space natively.
+ * Stores the corresponding output color space.
+ */
+SAIL_HIDDEN bool jpeg_private_output_color_space(J_COLOR_SPACE jpeg_color_space, enum SailPixelFormat pixel_format, J_COLOR_SPACE *out_color_space);
+
 SAIL_HIDDEN sail_status_t jpeg_private_fetch_meta_data(struct jpeg_decompress_struct *decompress_context, struct sail_meta_data_node **last_meta_data_node);
 
 SAIL_HIDDEN sail_status_t jpeg_private_write_meta_data(struct jpeg_compress_struct *compress_context, const struct sail_meta_data_node *meta_data_node);
@@ -65,4 +71,12 @@ SAIL_HIDDEN sail_status_t jpeg_private_write_resolution(struct jpeg_compress_str
 
 SAIL_HIDDEN bool jpeg_private_tuning_key_value_callback(const char *key, const struct sail_variant *value, void *user_data);
 
+SAIL_HIDDEN bool jpeg_private_load_tuning_key_value_callback(const char *key, const struct sail_variant *value, void *user_data);
+
+/*
+ * Reads the next rows_count scan lines into the specified rows. Requests up to rec_outbuf_height
+ * scan lines per call so libjpeg upsamples and converts colors straight into the rows.
+ */
+SAIL_HIDDEN void jpeg_private_read_scanlines(struct jpeg_decompress_struct *decompress_context, void *rows, unsigned bytes_per_line, unsigned rows_count);
+
 #endif
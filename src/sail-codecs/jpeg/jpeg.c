@@ -144,7 +144,14 @@ SAIL_EXPORT sail_status_t sail_codec_load_init_v7_jpeg(struct sail_io *io, const
     jpeg_read_header(jpeg_state->decompress_context, true);
 
     /* Handle the requested color space. */
-    if (jpeg_state->decompress_context->jpeg_color_space == JCS_YCbCr) {
+    J_COLOR_SPACE out_color_space;
+
+    if (jpeg_state->load_options->pixel_format != SAIL_PIXEL_FORMAT_UNKNOWN &&
+            jpeg_private_output_color_space(jpeg_state->decompress_context->jpeg_color_space,
+                                            jpeg_state->load_options->pixel_format,
+                                            &out_color_space)) {
+        jpeg_state->decompress_context->out_color_space = out_color_space;
+    } else if (jpeg_state->decompress_context->jpeg_color_space == JCS_YCbCr) {
         jpeg_state->decompress_context->out_color_space = JCS_RGB;
     } else {
         jpeg_state->decompress_context->out_color_space = jpeg_state->decompress_context->jpeg_color_space;
@@ -153,6 +160,24 @@ SAIL_EXPORT sail_status_t sail_codec_load_init_v7_jpeg(struct sail_io *io, const
     /* We don't want colormapped output. */
     jpeg_state->decompress_context->quantize_colors = false;
 
+    /* Decode no more than the maximum output dimensions need with DCT scaling. */
+    jpeg_state->decompress_context->scale_num   = 1;
+    jpeg_state->decompress_context->scale_denom = sail_scale_denominator_from_load_options(jpeg_state->load_options,
+                                                                                          jpeg_state->decompress_context->image_width,
+                                                                                          jpeg_state->decompress_context->image_height,
+                                                                                          8);
+
+    /* Handle tuning. It overrides the scaling above. The scaled output dimensions are calculated below. */
+    if (jpeg_state->load_options->tuning != NULL) {
+        sail_traverse_hash_map_with_user_data(jpeg_state->load_options->tuning, jpeg_private_load_tuning_key_value_callback, jpeg_state->decompress_context);
+    }
+
+    /* Progressive images are read in full on start. Just calculate the output dimensions. */
+    if (jpeg_state->load_options->options & SAIL_OPTION_HEADER_ONLY) {
+        jpeg_calc_output_dimensions(jpeg_state->decompress_context);
+        return SAIL_OK;
+    }
+
     /* Launch decompression! */
     jpeg_start_decompress(jpeg_state->decompress_context);
 
@@ -234,13 +259,31 @@ SAIL_EXPORT sail_status_t sail_codec_load_frame_v7_jpeg(void *state, struct sail
         SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
     }
 
-    for (unsigned row = 0; row < image->height; row++) {
-        unsigned char *scanline = (unsigned char *)image->pixels + row * image->bytes_per_line;
+    jpeg_private_read_scanlines(jpeg_state->decompress_context, image->pixels, image->bytes_per_line, image->height);
+
+    return SAIL_OK;
+}
+
+SAIL_EXPORT sail_status_t sail_codec_load_frame_rows_v7_jpeg(void *state, struct sail_io *io, struct sail_image *image, unsigned rows_count) {
+
+    SAIL_CHECK_PTR(state);
+    SAIL_TRY(sail_check_io_valid(io));
+    SAIL_TRY(sail_check_image_skeleton_valid(image));
+
+    struct jpeg_state *jpeg_state = (struct jpeg_state *)state;
+
+    if (jpeg_state->libjpeg_error) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+    }
 
-        JSAMPROW samprow = (JSAMPROW)scanline;
-        (void)jpeg_read_scanlines(jpeg_state->decompress_context, &samprow, 1);
+    if (setjmp(jpeg_state->error_context.setjmp_buffer) != 0) {
+        jpeg_state->libjpeg_error = true;
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
     }
 
+    /* libjpeg keeps track of the current scan line. */
+    jpeg_private_read_scanlines(jpeg_state->decompress_context, image->pixels, image->bytes_per_line, rows_count);
+
     return SAIL_OK;
 }
 
@@ -418,6 +461,31 @@ SAIL_EXPORT sail_status_t sail_codec_save_frame_v7_jpeg(void *state, struct sail
     return SAIL_OK;
 }
 
+SAIL_EXPORT sail_status_t sail_codec_save_frame_rows_v7_jpeg(void *state, struct sail_io *io, const struct sail_image *image, unsigned rows_count) {
+
+    SAIL_CHECK_PTR(state);
+    SAIL_TRY(sail_check_io_valid(io));
+    SAIL_TRY(sail_check_image_valid(image));
+
+    struct jpeg_state *jpeg_state = (struct jpeg_state *)state;
+
+    if (jpeg_state->libjpeg_error) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+    }
+
+    if (setjmp(jpeg_state->error_context.setjmp_buffer) != 0) {
+        jpeg_state->libjpeg_error = true;
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+    }
+
+    for (unsigned row = 0; row < rows_count; row++) {
+        JSAMPROW samprow = (JSAMPROW)((const unsigned char *)image->pixels + row * image->bytes_per_line);
+        jpeg_write_scanlines(jpeg_state->compress_context, &samprow, 1);
+    }
+
+    return SAIL_OK;
+}
+
 SAIL_EXPORT sail_status_t sail_codec_save_finish_v7_jpeg(void **state, struct sail_io *io) {
 
     SAIL_CHECK_PTR(state);
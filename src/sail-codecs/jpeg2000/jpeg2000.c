@@ -41,7 +41,7 @@ struct jpeg2000_state {
     struct sail_save_options *save_options;
 
     bool frame_loaded;
-    void *image_data;
+    void *image_data_to_free;
     jas_stream_t *jas_stream;
     jas_image_t *jas_image;
 
@@ -65,11 +65,11 @@ static sail_status_t alloc_jpeg2000_state(struct jpeg2000_state **jpeg2000_state
     (*jpeg2000_state)->load_options = NULL;
     (*jpeg2000_state)->save_options = NULL;
 
-    (*jpeg2000_state)->frame_loaded    = false;
-    (*jpeg2000_state)->image_data      = NULL;
-    (*jpeg2000_state)->jas_stream      = NULL;
-    (*jpeg2000_state)->jas_image       = NULL;
-    (*jpeg2000_state)->number_channels = 0;
+    (*jpeg2000_state)->frame_loaded       = false;
+    (*jpeg2000_state)->image_data_to_free = NULL;
+    (*jpeg2000_state)->jas_stream         = NULL;
+    (*jpeg2000_state)->jas_image          = NULL;
+    (*jpeg2000_state)->number_channels    = 0;
 
     for (int i = 0; i < 4; i++) {
         (*jpeg2000_state)->matrix[i] = NULL;
@@ -105,7 +105,7 @@ static void destroy_jpeg2000_state(struct jpeg2000_state *jpeg2000_state) {
     sail_destroy_load_options(jpeg2000_state->load_options);
     sail_destroy_save_options(jpeg2000_state->save_options);
 
-    sail_free(jpeg2000_state->image_data);
+    sail_free(jpeg2000_state->image_data_to_free);
 
     sail_free(jpeg2000_state);
 }
@@ -130,12 +130,16 @@ SAIL_EXPORT sail_status_t sail_codec_load_init_v7_jpeg2000(struct sail_io *io, c
     /* Deep copy load options. */
     SAIL_TRY(sail_copy_load_options(load_options, &jpeg2000_state->load_options));
 
-    /* Read the entire image to use the JasPer memory API. */
+    /* Read the entire image to use the JasPer memory API. Memory and mapped files are not copied. */
+    const void *image_data;
     size_t image_size;
-    SAIL_TRY(sail_alloc_data_from_io_contents(io, &jpeg2000_state->image_data, &image_size));
+    SAIL_TRY(sail_borrow_data_from_io_contents(io, &image_data, &image_size, &jpeg2000_state->image_data_to_free));
 
-    /* This function may generate a warning on old versions of Jasper: conversion from size_t to int. */
-    jpeg2000_state->jas_stream = jas_stream_memopen(jpeg2000_state->image_data, image_size);
+    /*
+     * This function may generate a warning on old versions of Jasper: conversion from size_t to int.
+     * The stream is only read, so casting const away is safe.
+     */
+    jpeg2000_state->jas_stream = jas_stream_memopen((char *)image_data, image_size);
 
     if (jpeg2000_state->jas_stream == NULL) {
         SAIL_LOG_ERROR("JPEG2000: Failed to open the specified file");
@@ -31,6 +31,8 @@
 
 #include "sail-common.h"
 
+#include "common/reader/reader.h"
+
 #include "helpers.h"
 
 /* PCX signature. */
@@ -160,9 +162,11 @@ SAIL_EXPORT sail_status_t sail_codec_load_seek_next_frame_v7_pcx(void *state, st
                         /* cleanup */ sail_destroy_image(image_local));
     pcx_state->scanline_buffer = ptr;
 
-    /* Build palette if needed. */
-    SAIL_TRY_OR_CLEANUP(pcx_private_build_palette(image_local->pixel_format, io, pcx_state->pcx_header.palette, &image_local->palette),
-                        /* cleanup */ sail_destroy_image(image_local));
+    /* Build palette if needed. 256-color palettes are stored at the end of the file. */
+    if (!(pcx_state->load_options->options & SAIL_OPTION_HEADER_ONLY)) {
+        SAIL_TRY_OR_CLEANUP(pcx_private_build_palette(image_local->pixel_format, io, pcx_state->pcx_header.palette, &image_local->palette),
+                            /* cleanup */ sail_destroy_image(image_local));
+    }
 
     if (pcx_state->pcx_header.hdpi > 0 && pcx_state->pcx_header.vdpi > 0) {
         SAIL_TRY_OR_CLEANUP(sail_alloc_resolution_from_data(SAIL_RESOLUTION_UNIT_INCH,
@@ -188,13 +192,16 @@ SAIL_EXPORT sail_status_t sail_codec_load_frame_v7_pcx(void *state, struct sail_
     if (pcx_state->pcx_header.encoding == SAIL_PCX_NO_ENCODING) {
         SAIL_TRY(pcx_private_read_uncompressed(io, pcx_state->pcx_header.bytes_per_line, pcx_state->pcx_header.planes, pcx_state->scanline_buffer, image));
     } else {
+        struct reader reader;
+        reader_private_init(&reader, io);
+
         for (unsigned row = 0; row < image->height; row++) {
             unsigned buffer_offset = 0;
 
             /* Decode all planes of a single scan line. */
             for (unsigned bytes = 0; bytes < image->bytes_per_line;) {
                 uint8_t marker;
-                SAIL_TRY(io->strict_read(io->stream, &marker, sizeof(marker)));
+                SAIL_TRY(reader_private_read_byte(&reader, &marker));
 
                 uint8_t count;
                 uint8_t value;
@@ -202,7 +209,7 @@ SAIL_EXPORT sail_status_t sail_codec_load_frame_v7_pcx(void *state, struct sail_
                 /* RLE marker set. */
                 if ((marker & SAIL_PCX_RLE_MARKER) == SAIL_PCX_RLE_MARKER) {
                     count = marker & SAIL_PCX_RLE_COUNT_MASK;
-                    SAIL_TRY(io->strict_read(io->stream, &value, sizeof(value)));
+                    SAIL_TRY(reader_private_read_byte(&reader, &value));
                 } else {
                     /* Pixel value. */
                     count = 1;
@@ -226,6 +233,8 @@ SAIL_EXPORT sail_status_t sail_codec_load_frame_v7_pcx(void *state, struct sail_
                 }
             }
         }
+
+        SAIL_TRY(reader_private_sync(&reader));
     }
 
     return SAIL_OK;
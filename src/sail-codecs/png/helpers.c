@@ -30,6 +30,8 @@
 
 #include "sail-common.h"
 
+#include "common/blend/blend.h"
+
 #include "helpers.h"
 
 /*
@@ -189,6 +191,63 @@ enum SailPixelFormat png_private_png_color_type_to_pixel_format(int color_type,
     return SAIL_PIXEL_FORMAT_UNKNOWN;
 }
 
+bool png_private_setup_output_pixel_format(png_structp png_ptr, png_infop info_ptr, int color_type, int bit_depth, enum SailPixelFormat pixel_format) {
+
+    bool output_alpha;
+    bool output_bgr;
+
+    switch (pixel_format) {
+        case SAIL_PIXEL_FORMAT_BPP24_RGB:  output_alpha = false; output_bgr = false; break;
+        case SAIL_PIXEL_FORMAT_BPP24_BGR:  output_alpha = false; output_bgr = true;  break;
+        case SAIL_PIXEL_FORMAT_BPP32_RGBA: output_alpha = true;  output_bgr = false; break;
+        case SAIL_PIXEL_FORMAT_BPP32_BGRA: output_alpha = true;  output_bgr = true;  break;
+
+        default: {
+            return false;
+        }
+    }
+
+    bool input_alpha = (color_type & PNG_COLOR_MASK_ALPHA) != 0;
+
+    if (color_type == PNG_COLOR_TYPE_PALETTE) {
+        png_set_palette_to_rgb(png_ptr);
+
+        /* Palette transparency becomes alpha like in png_private_fetch_palette(). */
+#ifdef PNG_tRNS_SUPPORTED
+        if (output_alpha && png_get_valid(png_ptr, info_ptr, PNG_INFO_tRNS) != 0) {
+            png_set_tRNS_to_alpha(png_ptr);
+            input_alpha = true;
+        }
+#else
+        (void)info_ptr;
+#endif
+    } else if ((color_type & PNG_COLOR_MASK_COLOR) == 0) {
+        if (bit_depth < 8) {
+            png_set_expand_gray_1_2_4_to_8(png_ptr);
+        }
+
+        png_set_gray_to_rgb(png_ptr);
+    }
+
+    if (bit_depth == 16) {
+        png_set_strip_16(png_ptr);
+    }
+
+    if (output_alpha && !input_alpha) {
+        png_set_add_alpha(png_ptr, 0xFF, PNG_FILLER_AFTER);
+    } else if (!output_alpha && input_alpha) {
+        png_set_strip_alpha(png_ptr);
+    }
+
+    if (output_bgr) {
+        png_set_bgr(png_ptr);
+    }
+
+    png_read_update_info(png_ptr, info_ptr);
+
+    return true;
+}
+
 sail_status_t png_private_pixel_format_to_png_color_type(enum SailPixelFormat pixel_format, int *color_type, int *bit_depth) {
 
     SAIL_CHECK_PTR(color_type);
@@ -374,9 +433,9 @@ sail_status_t png_private_write_meta_data(png_structp png_ptr, png_infop info_pt
         png_text *lines = ptr;
 
         /* Indexes in 'lines' that must be freed. 1 = free, 0 = don't free. */
-        SAIL_TRY(sail_malloc(count * sizeof(bool), &ptr));
+        SAIL_TRY(sail_malloc(count * sizeof(int), &ptr));
         int *lines_to_free = ptr;
-        memset(lines_to_free, 0, count);
+        memset(lines_to_free, 0, count * sizeof(int));
 
         unsigned index = 0;
 
@@ -404,7 +463,7 @@ sail_status_t png_private_write_meta_data(png_structp png_ptr, png_infop info_pt
 
                 if (meta_data->key == SAIL_META_DATA_UNKNOWN) {
                     meta_data_key = meta_data->key_unknown;
-                    meta_data_value = (char *)meta_data->value;
+                    meta_data_value = sail_variant_to_string(meta_data->value);
                 } else {
                     if (meta_data->key == SAIL_META_DATA_IPTC) {
                         meta_data_key = "Raw profile type iptc";
@@ -549,31 +608,9 @@ sail_status_t png_private_blend_over(void *dst_raw, unsigned dst_offset, const v
     SAIL_CHECK_PTR(dst_raw);
 
     if (bytes_per_pixel == 4) {
-        const uint8_t *src = src_raw;
-        uint8_t *dst = (uint8_t *)dst_raw + dst_offset * bytes_per_pixel;
-
-        while (width--) {
-            const double src_a = *(src+3) / 255.0;
-            const double dst_a = *(dst+3) / 255.0;
-
-            *dst = (uint8_t)(src_a * (*src) + (1-src_a) * dst_a * (*dst)); src++; dst++;
-            *dst = (uint8_t)(src_a * (*src) + (1-src_a) * dst_a * (*dst)); src++; dst++;
-            *dst = (uint8_t)(src_a * (*src) + (1-src_a) * dst_a * (*dst)); src++; dst++;
-            *dst = (uint8_t)((src_a + (1-src_a) * dst_a) * 255);           src++; dst++;
-        }
+        blend_private_over_rgba32_row((uint8_t *)dst_raw + dst_offset * bytes_per_pixel, src_raw, width);
     } else if (bytes_per_pixel == 8) {
-        const uint16_t *src = src_raw;
-        uint16_t *dst = (uint16_t *)((uint8_t *)dst_raw + dst_offset * bytes_per_pixel);
-
-        while (width--) {
-            const double src_a = *(src+3) / 65535.0;
-            const double dst_a = *(dst+3) / 65535.0;
-
-            *dst = (uint16_t)(src_a * (*src) + (1-src_a) * dst_a * (*dst)); src++; dst++;
-            *dst = (uint16_t)(src_a * (*src) + (1-src_a) * dst_a * (*dst)); src++; dst++;
-            *dst = (uint16_t)(src_a * (*src) + (1-src_a) * dst_a * (*dst)); src++; dst++;
-            *dst = (uint16_t)((src_a + (1-src_a) * dst_a) * 65535);         src++; dst++;
-        }
+        blend_private_over_rgba64_row((uint16_t *)((uint8_t *)dst_raw + dst_offset * bytes_per_pixel), src_raw, width);
     } else {
         SAIL_LOG_AND_RETURN(SAIL_ERROR_UNSUPPORTED_BIT_DEPTH);
     }
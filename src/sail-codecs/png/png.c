@@ -192,6 +192,26 @@ SAIL_EXPORT sail_status_t sail_codec_load_init_v7_png(struct sail_io *io, const
     }
 
     png_set_read_fn(png_state->png_ptr, io, png_private_my_read_fn);
+
+    const bool header_only = png_state->load_options->options & SAIL_OPTION_HEADER_ONLY;
+
+#ifdef PNG_HANDLE_AS_UNKNOWN_SUPPORTED
+    /* Don't decompress and parse the ICC profile and text chunks. */
+    if (header_only) {
+        static const png_byte SKIPPED_CHUNKS[] = {
+            105,  67,  67,  80, '\0', /* iCCP */
+            105,  84,  88, 116, '\0', /* iTXt */
+            116,  69,  88, 116, '\0', /* tEXt */
+            122,  84,  88, 116, '\0', /* zTXt */
+            101,  88,  73, 102, '\0', /* eXIf */
+            115,  80,  76,  84, '\0', /* sPLT */
+        };
+
+        png_set_keep_unknown_chunks(png_state->png_ptr, PNG_HANDLE_CHUNK_NEVER,
+                                    SKIPPED_CHUNKS, (int)(sizeof(SKIPPED_CHUNKS) / 5));
+    }
+#endif
+
     png_read_info(png_state->png_ptr, png_state->info_ptr);
 
     SAIL_TRY(sail_alloc_image(&png_state->first_image));
@@ -215,7 +235,7 @@ SAIL_EXPORT sail_status_t sail_codec_load_init_v7_png(struct sail_io *io, const
                                  &png_state->first_image->bytes_per_line));
 
     /* Fetch palette. */
-    if (png_state->color_type == PNG_COLOR_TYPE_PALETTE) {
+    if (png_state->color_type == PNG_COLOR_TYPE_PALETTE && !header_only) {
         SAIL_TRY(png_private_fetch_palette(png_state->png_ptr, png_state->info_ptr, &png_state->first_image->palette));
     }
 
@@ -238,13 +258,35 @@ SAIL_EXPORT sail_status_t sail_codec_load_init_v7_png(struct sail_io *io, const
         SAIL_LOG_AND_RETURN(SAIL_ERROR_NO_MORE_FRAMES);
     }
 
-    if (png_state->is_apng) {
+    if (png_state->is_apng && !header_only) {
         SAIL_TRY(png_private_alloc_rows(&png_state->prev, png_state->first_image->bytes_per_line, png_state->first_image->height));
     }
 #else
     png_state->frames = 1;
 #endif
 
+    /* Output the requested pixel format natively. APNG frames are composed in the source pixel format. */
+#ifdef PNG_APNG_SUPPORTED
+    const bool is_apng = png_state->is_apng;
+#else
+    const bool is_apng = false;
+#endif
+
+    if (png_state->load_options->pixel_format != SAIL_PIXEL_FORMAT_UNKNOWN && !is_apng &&
+            png_private_setup_output_pixel_format(png_state->png_ptr, png_state->info_ptr,
+                                                  png_state->color_type, png_state->bit_depth,
+                                                  png_state->load_options->pixel_format)) {
+        png_state->first_image->pixel_format = png_state->load_options->pixel_format;
+
+        SAIL_TRY(sail_bytes_per_line(png_state->first_image->width,
+                                     png_state->first_image->pixel_format,
+                                     &png_state->first_image->bytes_per_line));
+
+        /* Palette is expanded by libpng. */
+        sail_destroy_palette(png_state->first_image->palette);
+        png_state->first_image->palette = NULL;
+    }
+
     png_state->first_image->source_image->pixel_format = png_private_png_color_type_to_pixel_format(png_state->color_type, png_state->bit_depth);
     png_state->first_image->source_image->compression = SAIL_COMPRESSION_DEFLATE;
 
@@ -268,7 +310,7 @@ SAIL_EXPORT sail_status_t sail_codec_load_init_v7_png(struct sail_io *io, const
     }
 
 #ifdef PNG_APNG_SUPPORTED
-    if (png_state->is_apng) {
+    if (png_state->is_apng && !header_only) {
         SAIL_TRY(sail_malloc((size_t)png_state->first_image->width * png_state->bytes_per_pixel, &png_state->temp_scanline));
     }
 #endif
@@ -438,6 +480,40 @@ SAIL_EXPORT sail_status_t sail_codec_load_frame_v7_png(void *state, struct sail_
     return SAIL_OK;
 }
 
+SAIL_EXPORT sail_status_t sail_codec_load_frame_rows_v7_png(void *state, struct sail_io *io, struct sail_image *image, unsigned rows_count) {
+
+    SAIL_CHECK_PTR(state);
+    SAIL_TRY(sail_check_io_valid(io));
+    SAIL_TRY(sail_check_image_skeleton_valid(image));
+
+    struct png_state *png_state = (struct png_state *)state;
+
+    if (png_state->libpng_error) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+    }
+
+    /* Interlaced frames and APNG frames blended with previous ones need whole frames. */
+    bool whole_frame_needed = png_state->interlaced_passes > 1;
+#ifdef PNG_APNG_SUPPORTED
+    whole_frame_needed = whole_frame_needed || png_state->is_apng;
+#endif
+
+    if (whole_frame_needed) {
+        return SAIL_ERROR_NOT_IMPLEMENTED;
+    }
+
+    if (setjmp(png_jmpbuf(png_state->png_ptr))) {
+        png_state->libpng_error = true;
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+    }
+
+    for (unsigned row = 0; row < rows_count; row++) {
+        png_read_row(png_state->png_ptr, (unsigned char *)image->pixels + (size_t)row * image->bytes_per_line, NULL);
+    }
+
+    return SAIL_OK;
+}
+
 SAIL_EXPORT sail_status_t sail_codec_load_finish_v7_png(void **state, struct sail_io *io) {
 
     SAIL_CHECK_PTR(state);
@@ -655,6 +731,36 @@ SAIL_EXPORT sail_status_t sail_codec_save_frame_v7_png(void *state, struct sail_
     return SAIL_OK;
 }
 
+SAIL_EXPORT sail_status_t sail_codec_save_frame_rows_v7_png(void *state, struct sail_io *io, const struct sail_image *image, unsigned rows_count) {
+
+    SAIL_CHECK_PTR(state);
+    SAIL_TRY(sail_check_io_valid(io));
+    SAIL_TRY(sail_check_image_valid(image));
+
+    struct png_state *png_state = (struct png_state *)state;
+
+    if (png_state->libpng_error) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+    }
+
+    /* Interlaced images need every row in every pass. */
+    if (png_state->interlaced_passes > 1) {
+        return SAIL_ERROR_NOT_IMPLEMENTED;
+    }
+
+    /* Error handling setup. */
+    if (setjmp(png_jmpbuf(png_state->png_ptr))) {
+        png_state->libpng_error = true;
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+    }
+
+    for (unsigned row = 0; row < rows_count; row++) {
+        png_write_row(png_state->png_ptr, (const unsigned char *)image->pixels + row * image->bytes_per_line);
+    }
+
+    return SAIL_OK;
+}
+
 SAIL_EXPORT sail_status_t sail_codec_save_finish_v7_png(void **state, struct sail_io *io) {
 
     SAIL_CHECK_PTR(state);
@@ -668,6 +774,7 @@ SAIL_EXPORT sail_status_t sail_codec_save_finish_v7_png(void **state, struct sai
     /* Error handling setup. */
     if (png_state->png_ptr != NULL) {
         if (setjmp(png_jmpbuf(png_state->png_ptr))) {
+            png_destroy_write_struct(&png_state->png_ptr, &png_state->info_ptr);
             destroy_png_state(png_state);
             SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
         }
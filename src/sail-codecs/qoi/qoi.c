@@ -43,8 +43,9 @@ struct qoi_state {
     bool frame_loaded;
     bool frame_saved;
 
-    void *image_data;
+    const void *image_data;
     size_t image_data_size;
+    void *image_data_to_free;
     void *pixels;
 
     qoi_desc qoi_desc;
@@ -62,9 +63,10 @@ static sail_status_t alloc_qoi_state(struct qoi_state **qoi_state) {
     (*qoi_state)->frame_loaded = false;
     (*qoi_state)->frame_saved  = false;
 
-    (*qoi_state)->image_data      = NULL;
-    (*qoi_state)->image_data_size = 0;
-    (*qoi_state)->pixels          = NULL;
+    (*qoi_state)->image_data         = NULL;
+    (*qoi_state)->image_data_size    = 0;
+    (*qoi_state)->image_data_to_free = NULL;
+    (*qoi_state)->pixels             = NULL;
 
     return SAIL_OK;
 }
@@ -78,7 +80,7 @@ static void destroy_qoi_state(struct qoi_state *qoi_state) {
     sail_destroy_load_options(qoi_state->load_options);
     sail_destroy_save_options(qoi_state->save_options);
 
-    sail_free(qoi_state->image_data);
+    sail_free(qoi_state->image_data_to_free);
     sail_free(qoi_state->pixels);
 
     sail_free(qoi_state);
@@ -104,8 +106,9 @@ SAIL_EXPORT sail_status_t sail_codec_load_init_v7_qoi(struct sail_io *io, const
     /* Deep copy load options. */
     SAIL_TRY(sail_copy_load_options(load_options, &qoi_state->load_options));
 
-    /* Cache the entire file as the QOI API requires. */
-    SAIL_TRY(sail_alloc_data_from_io_contents(io, &qoi_state->image_data, &qoi_state->image_data_size));
+    /* Cache the entire file as the QOI API requires. Memory and mapped files are not copied. */
+    SAIL_TRY(sail_borrow_data_from_io_contents(io, &qoi_state->image_data, &qoi_state->image_data_size,
+                                               &qoi_state->image_data_to_free));
 
     return SAIL_OK;
 }
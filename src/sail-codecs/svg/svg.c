@@ -39,6 +39,7 @@ struct svg_state {
     struct sail_save_options *save_options;
 
     bool frame_loaded;
+    float zoom;
     resvg_options *resvg_options;
     resvg_render_tree *resvg_tree;
 };
@@ -53,6 +54,7 @@ static sail_status_t alloc_svg_state(struct svg_state **svg_state) {
     (*svg_state)->save_options = NULL;
 
     (*svg_state)->frame_loaded  = false;
+    (*svg_state)->zoom          = 1;
     (*svg_state)->resvg_options = NULL;
     (*svg_state)->resvg_tree    = NULL;
 
@@ -99,15 +101,19 @@ SAIL_EXPORT sail_status_t sail_codec_load_init_v7_svg(struct sail_io *io, const
     /* Deep copy load options. */
     SAIL_TRY(sail_copy_load_options(load_options, &svg_state->load_options));
 
-    /* Read the entire image as the resvg API requires. */
-    void *image_data;
+    /* Read the entire image as the resvg API requires. Memory and mapped files are not copied. */
+    const void *image_data;
     size_t image_size;
-    SAIL_TRY(sail_alloc_data_from_io_contents(io, &image_data, &image_size));
+    void *image_data_to_free;
+    SAIL_TRY(sail_borrow_data_from_io_contents(io, &image_data, &image_size, &image_data_to_free));
 
     svg_state->resvg_options = resvg_options_create();
 
     const int result = resvg_parse_tree_from_data(image_data, image_size, svg_state->resvg_options, &svg_state->resvg_tree);
 
+    /* The tree doesn't reference the data. */
+    sail_free(image_data_to_free);
+
     if (result != RESVG_OK) {
         SAIL_LOG_ERROR("SVG: Failed to load image");
         SAIL_LOG_AND_RETURN(SAIL_ERROR_BROKEN_IMAGE);
@@ -140,8 +146,26 @@ SAIL_EXPORT sail_status_t sail_codec_load_seek_next_frame_v7_svg(void *state, st
     image_local->source_image->pixel_format = SAIL_PIXEL_FORMAT_BPP32_RGBA;
     image_local->source_image->compression = SAIL_COMPRESSION_NONE;
 
-    image_local->width = (unsigned)image_size.width;
-    image_local->height = (unsigned)image_size.height;
+    /* Render images fitted into the maximum output dimensions. */
+    const unsigned max_width  = svg_state->load_options->max_width;
+    const unsigned max_height = svg_state->load_options->max_height;
+
+    if (max_width != 0 && image_size.width > max_width) {
+        svg_state->zoom = (float)max_width / (float)image_size.width;
+    }
+    if (max_height != 0 && image_size.height * svg_state->zoom > max_height) {
+        svg_state->zoom = (float)max_height / (float)image_size.height;
+    }
+
+    image_local->width = (unsigned)(image_size.width * svg_state->zoom);
+    image_local->height = (unsigned)(image_size.height * svg_state->zoom);
+
+    if (image_local->width == 0) {
+        image_local->width = 1;
+    }
+    if (image_local->height == 0) {
+        image_local->height = 1;
+    }
     image_local->pixel_format = SAIL_PIXEL_FORMAT_BPP32_RGBA;
 
     SAIL_TRY_OR_CLEANUP(sail_bytes_per_line(image_local->width, image_local->pixel_format, &image_local->bytes_per_line),
@@ -162,7 +186,9 @@ SAIL_EXPORT sail_status_t sail_codec_load_frame_v7_svg(void *state, struct sail_
 
     memset(image->pixels, 0, (size_t)image->bytes_per_line * image->height);
 
-    const resvg_fit_to resvg_fit_to = { RESVG_FIT_TO_ORIGINAL, 0 };
+    const resvg_fit_to resvg_fit_to = svg_state->zoom < 1
+                                        ? (resvg_fit_to) { RESVG_FIT_TO_ZOOM, svg_state->zoom }
+                                        : (resvg_fit_to) { RESVG_FIT_TO_ORIGINAL, 0 };
 
     resvg_render(svg_state->resvg_tree, resvg_fit_to, image->width, image->height, image->pixels);
 
@@ -30,6 +30,8 @@
 
 #include "sail-common.h"
 
+#include "common/reader/reader.h"
+
 #include "helpers.h"
 
 static const char * const TGA_SIGNATURE   = "TRUEVISION-XFILE.";
@@ -100,12 +102,16 @@ SAIL_EXPORT sail_status_t sail_codec_load_init_v7_tga(struct sail_io *io, const
     /* Deep copy load options. */
     SAIL_TRY(sail_copy_load_options(load_options, &tga_state->load_options));
 
-    /* Read TGA footer. */
-    SAIL_TRY(io->seek(io->stream, -TGA_FOOTER_SIZE, SEEK_END));
-    SAIL_TRY(tga_private_read_file_footer(io, &tga_state->footer));
-    SAIL_TRY(io->seek(io->stream, 0, SEEK_SET));
+    /* Read TGA footer. It only points to meta data, so skip it when loading just the header. */
+    if (tga_state->load_options->options & SAIL_OPTION_HEADER_ONLY) {
+        tga_state->tga2 = false;
+    } else {
+        SAIL_TRY(io->seek(io->stream, -TGA_FOOTER_SIZE, SEEK_END));
+        SAIL_TRY(tga_private_read_file_footer(io, &tga_state->footer));
+        SAIL_TRY(io->seek(io->stream, 0, SEEK_SET));
 
-    tga_state->tga2 = strcmp(TGA_SIGNATURE, (const char *)tga_state->footer.signature) == 0;
+        tga_state->tga2 = strcmp(TGA_SIGNATURE, (const char *)tga_state->footer.signature) == 0;
+    }
 
     return SAIL_OK;
 }
@@ -168,7 +174,7 @@ SAIL_EXPORT sail_status_t sail_codec_load_seek_next_frame_v7_tga(void *state, st
                         /* cleanup */ sail_destroy_image(image_local));
 
     /* Identificator. */
-    if (tga_state->file_header.id_length > 0) {
+    if (tga_state->file_header.id_length > 0 && !(tga_state->load_options->options & SAIL_OPTION_HEADER_ONLY)) {
         SAIL_TRY_OR_CLEANUP(tga_private_fetch_id(io, &tga_state->file_header, &image_local->meta_data_node),
                             /* cleanup */ sail_destroy_image(image_local));
     }
@@ -190,7 +196,8 @@ SAIL_EXPORT sail_status_t sail_codec_load_seek_next_frame_v7_tga(void *state, st
     }
 
     /* Palette. */
-    if (tga_state->file_header.color_map_type == TGA_HAS_COLOR_MAP) {
+    if (tga_state->file_header.color_map_type == TGA_HAS_COLOR_MAP &&
+            !(tga_state->load_options->options & SAIL_OPTION_HEADER_ONLY)) {
         SAIL_TRY_OR_CLEANUP(tga_private_fetch_palette(io, &tga_state->file_header, &image_local->palette),
                             /* cleanup */ sail_destroy_image(image_local));
     }
@@ -223,9 +230,12 @@ SAIL_EXPORT sail_status_t sail_codec_load_frame_v7_tga(void *state, struct sail_
 
             unsigned char *pixels = image->pixels;
 
+            struct reader reader;
+            reader_private_init(&reader, io);
+
             for (unsigned i = 0; i < pixels_num;) {
-                unsigned char marker;
-                SAIL_TRY(io->strict_read(io->stream, &marker, 1));
+                uint8_t marker;
+                SAIL_TRY(reader_private_read_byte(&reader, &marker));
 
                 unsigned count = (marker & 0x7F) + 1;
 
@@ -233,19 +243,21 @@ SAIL_EXPORT sail_status_t sail_codec_load_frame_v7_tga(void *state, struct sail_
                 if (marker & 0x80) {
                     unsigned char pixel[4];
 
-                    SAIL_TRY(io->strict_read(io->stream, pixel, pixel_size));
+                    SAIL_TRY(reader_private_read(&reader, pixel, pixel_size));
 
                     for (unsigned j = 0; j < count; j++, i++) {
                         memcpy(pixels, pixel, pixel_size);
                         pixels += pixel_size;
                     }
                 } else {
-                    for (unsigned j = 0; j < count; j++, i++) {
-                        SAIL_TRY(io->strict_read(io->stream, pixels, pixel_size));
-                        pixels += pixel_size;
-                    }
+                    /* Raw packet: read all the pixels at once. */
+                    SAIL_TRY(reader_private_read(&reader, pixels, (size_t)count * pixel_size));
+                    pixels += (size_t)count * pixel_size;
+                    i += count;
                 }
             }
+
+            SAIL_TRY(reader_private_sync(&reader));
             break;
         }
     }
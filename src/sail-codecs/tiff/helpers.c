@@ -33,6 +33,7 @@
 #include "sail-common.h"
 
 #include "helpers.h"
+#include "io.h"
 
 void tiff_private_my_error_fn(const char *module, const char *format, va_list ap) {
 
@@ -464,3 +465,355 @@ sail_status_t tiff_private_write_resolution(TIFF *tiff, const struct sail_resolu
 
     return SAIL_OK;
 }
+
+enum SailPixelFormat tiff_private_native_pixel_format(TIFF *tiff) {
+
+    uint16_t bits_per_sample;
+    uint16_t samples_per_pixel;
+    uint16_t photometric;
+    uint16_t planar_config;
+    uint16_t sample_format;
+    uint16_t orientation;
+    uint16_t extra_samples_count;
+    uint16_t *extra_samples;
+
+    if (!TIFFGetFieldDefaulted(tiff, TIFFTAG_BITSPERSAMPLE,   &bits_per_sample)                      ||
+        !TIFFGetFieldDefaulted(tiff, TIFFTAG_SAMPLESPERPIXEL, &samples_per_pixel)                    ||
+        !TIFFGetField(tiff,          TIFFTAG_PHOTOMETRIC,     &photometric)                          ||
+        !TIFFGetFieldDefaulted(tiff, TIFFTAG_PLANARCONFIG,    &planar_config)                        ||
+        !TIFFGetFieldDefaulted(tiff, TIFFTAG_SAMPLEFORMAT,    &sample_format)                        ||
+        !TIFFGetFieldDefaulted(tiff, TIFFTAG_ORIENTATION,     &orientation)                          ||
+        !TIFFGetFieldDefaulted(tiff, TIFFTAG_EXTRASAMPLES,    &extra_samples_count, &extra_samples)) {
+        return SAIL_PIXEL_FORMAT_UNKNOWN;
+    }
+
+    if (planar_config != PLANARCONFIG_CONTIG || sample_format != SAMPLEFORMAT_UINT || orientation != ORIENTATION_TOPLEFT) {
+        return SAIL_PIXEL_FORMAT_UNKNOWN;
+    }
+
+    if (bits_per_sample != 8 && bits_per_sample != 16) {
+        return SAIL_PIXEL_FORMAT_UNKNOWN;
+    }
+
+    const bool bpp16 = bits_per_sample == 16;
+
+    /*
+     * SAIL alpha is not premultiplied. Associated (premultiplied) and unspecified extra samples
+     * are left to TIFFRGBAImage which converts them.
+     */
+    const bool unassociated_alpha = extra_samples_count == 1 && extra_samples[0] == EXTRASAMPLE_UNASSALPHA;
+
+    switch (photometric) {
+        case PHOTOMETRIC_MINISBLACK: {
+            if (samples_per_pixel == 1 && extra_samples_count == 0) {
+                return bpp16 ? SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE : SAIL_PIXEL_FORMAT_BPP8_GRAYSCALE;
+            } else if (samples_per_pixel == 2 && unassociated_alpha) {
+                return bpp16 ? SAIL_PIXEL_FORMAT_BPP32_GRAYSCALE_ALPHA : SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE_ALPHA;
+            }
+            break;
+        }
+        case PHOTOMETRIC_RGB: {
+            if (samples_per_pixel == 3 && extra_samples_count == 0) {
+                return bpp16 ? SAIL_PIXEL_FORMAT_BPP48_RGB : SAIL_PIXEL_FORMAT_BPP24_RGB;
+            } else if (samples_per_pixel == 4 && unassociated_alpha) {
+                return bpp16 ? SAIL_PIXEL_FORMAT_BPP64_RGBA : SAIL_PIXEL_FORMAT_BPP32_RGBA;
+            }
+            break;
+        }
+    }
+
+    return SAIL_PIXEL_FORMAT_UNKNOWN;
+}
+
+sail_status_t tiff_private_read_strips(TIFF *tiff, struct sail_image *image) {
+
+    uint32_t rows_per_strip;
+
+    if (!TIFFGetFieldDefaulted(tiff, TIFFTAG_ROWSPERSTRIP, &rows_per_strip)) {
+        SAIL_LOG_ERROR("TIFF: Failed to get the number of rows per strip");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+    }
+
+    if (rows_per_strip > image->height) {
+        rows_per_strip = image->height;
+    }
+
+    const uint32_t strips_count = TIFFNumberOfStrips(tiff);
+
+    /* Strips are whole rows, so decode them straight into the image pixels. */
+    for (uint32_t strip = 0, row = 0; strip < strips_count && row < image->height; strip++, row += rows_per_strip) {
+        const uint32_t strip_rows = (image->height - row < rows_per_strip) ? image->height - row : rows_per_strip;
+
+        if (TIFFReadEncodedStrip(tiff,
+                                 strip,
+                                 (unsigned char *)image->pixels + (size_t)row * image->bytes_per_line,
+                                 (tmsize_t)strip_rows * image->bytes_per_line) < 0) {
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+        }
+    }
+
+    return SAIL_OK;
+}
+
+/* Decodes the tile with the specified number and copies its visible part into the image pixels. */
+static sail_status_t read_tile(TIFF *tiff, struct sail_image *image, uint32_t tile, void *tile_buffer) {
+
+    uint32_t tile_width;
+    uint32_t tile_height;
+
+    TIFFGetField(tiff, TIFFTAG_TILEWIDTH,  &tile_width);
+    TIFFGetField(tiff, TIFFTAG_TILELENGTH, &tile_height);
+
+    const uint32_t tiles_across = (image->width + tile_width - 1) / tile_width;
+    const uint32_t x = (tile % tiles_across) * tile_width;
+    const uint32_t y = (tile / tiles_across) * tile_height;
+
+    if (TIFFReadEncodedTile(tiff, TIFFComputeTile(tiff, x, y, 0, 0), tile_buffer, TIFFTileSize(tiff)) < 0) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+    }
+
+    unsigned bits_per_pixel;
+    SAIL_TRY(sail_bits_per_pixel(image->pixel_format, &bits_per_pixel));
+
+    const tmsize_t tile_row_size = TIFFTileRowSize(tiff);
+    const uint32_t rows          = (image->height - y < tile_height) ? image->height - y : tile_height;
+    const uint32_t columns       = (image->width - x < tile_width) ? image->width - x : tile_width;
+
+    for (uint32_t row = 0; row < rows; row++) {
+        memcpy((unsigned char *)image->pixels + (size_t)(y + row) * image->bytes_per_line + (size_t)x * bits_per_pixel / 8,
+               (const unsigned char *)tile_buffer + (size_t)row * tile_row_size,
+               (size_t)columns * bits_per_pixel / 8);
+    }
+
+    return SAIL_OK;
+}
+
+static sail_status_t read_tiles_sequentially(TIFF *tiff, struct sail_image *image, uint32_t tiles_count) {
+
+    void *tile_buffer;
+    SAIL_TRY(sail_malloc((size_t)TIFFTileSize(tiff), &tile_buffer));
+
+    for (uint32_t tile = 0; tile < tiles_count; tile++) {
+        SAIL_TRY_OR_CLEANUP(read_tile(tiff, image, tile, tile_buffer),
+                            /* cleanup */ sail_free(tile_buffer));
+    }
+
+    sail_free(tile_buffer);
+
+    return SAIL_OK;
+}
+
+#ifdef SAIL_THREAD_SAFE
+
+struct tiles_context {
+    struct sail_io *io;
+    uint16_t directory;
+    struct sail_image *image;
+    uint32_t tiles_count;
+
+    /* Serializes reading from the shared I/O stream. */
+    sail_mutex_t io_mutex;
+
+    /* Guards the fields below. */
+    sail_mutex_t tiles_mutex;
+    uint32_t next_tile;
+    sail_status_t status;
+};
+
+struct tiles_worker {
+    struct tiles_context *context;
+    struct tiff_shared_io shared_io;
+    sail_thread_t thread;
+};
+
+/* Returns false when there are no more tiles or another worker failed. */
+static bool take_next_tile(struct tiles_context *context, uint32_t *tile) {
+
+    bool taken = false;
+
+    sail_lock_mutex(&context->tiles_mutex);
+
+    if (context->status == SAIL_OK && context->next_tile < context->tiles_count) {
+        *tile = context->next_tile++;
+        taken = true;
+    }
+
+    sail_unlock_mutex(&context->tiles_mutex);
+
+    return taken;
+}
+
+static sail_status_t read_next_tiles(TIFF *tiff, struct tiles_context *context) {
+
+    void *tile_buffer;
+    SAIL_TRY(sail_malloc((size_t)TIFFTileSize(tiff), &tile_buffer));
+
+    uint32_t tile;
+
+    while (take_next_tile(context, &tile)) {
+        SAIL_TRY_OR_CLEANUP(read_tile(tiff, context->image, tile, tile_buffer),
+                            /* cleanup */ sail_free(tile_buffer));
+    }
+
+    sail_free(tile_buffer);
+
+    return SAIL_OK;
+}
+
+/* Every worker reads the directory with its own TIFF handle as libtiff handles are not thread-safe. */
+static sail_status_t read_tiles_with_own_handle(struct tiles_worker *worker) {
+
+    struct tiles_context *context = worker->context;
+
+    TIFF *tiff = TIFFClientOpen("sail-codec-tiff",
+                                "rhm",
+                                &worker->shared_io,
+                                tiff_private_my_shared_read_proc,
+                                tiff_private_my_shared_write_proc,
+                                tiff_private_my_shared_seek_proc,
+                                tiff_private_my_dummy_close_proc,
+                                tiff_private_my_dummy_size_proc,
+                                /* map */ NULL,
+                                /* unmap */ NULL);
+
+    if (tiff == NULL) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+    }
+
+    if (!TIFFSetDirectory(tiff, context->directory)) {
+        TIFFCleanup(tiff);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+    }
+
+    SAIL_TRY_OR_CLEANUP(read_next_tiles(tiff, context),
+                        /* cleanup */ TIFFCleanup(tiff));
+
+    TIFFCleanup(tiff);
+
+    return SAIL_OK;
+}
+
+static void tiles_worker_function(void *arg) {
+
+    struct tiles_worker *worker = arg;
+    struct tiles_context *context = worker->context;
+
+    const sail_status_t status = read_tiles_with_own_handle(worker);
+
+    if (status != SAIL_OK) {
+        sail_lock_mutex(&context->tiles_mutex);
+
+        if (context->status == SAIL_OK) {
+            context->status = status;
+        }
+
+        sail_unlock_mutex(&context->tiles_mutex);
+    }
+}
+
+static sail_status_t read_tiles_in_parallel(struct tiles_context *context, unsigned workers_count) {
+
+    void *ptr;
+    SAIL_TRY(sail_malloc(sizeof(struct tiles_worker) * workers_count, &ptr));
+    struct tiles_worker *workers = ptr;
+
+    for (unsigned i = 0; i < workers_count; i++) {
+        workers[i].context          = context;
+        workers[i].shared_io.io     = context->io;
+        workers[i].shared_io.mutex  = &context->io_mutex;
+        workers[i].shared_io.offset = 0;
+    }
+
+    /* The calling thread is the first worker. Run with fewer workers if threads cannot be started. */
+    unsigned threads_started = 0;
+
+    for (unsigned i = 1; i < workers_count; i++) {
+        if (sail_create_thread(&workers[i].thread, tiles_worker_function, &workers[i]) != SAIL_OK) {
+            break;
+        }
+
+        threads_started++;
+    }
+
+    tiles_worker_function(&workers[0]);
+
+    for (unsigned i = 1; i <= threads_started; i++) {
+        sail_join_thread(&workers[i].thread);
+    }
+
+    sail_free(workers);
+
+    return context->status;
+}
+
+static sail_status_t read_tiles_with_workers(struct sail_io *io, uint16_t directory, struct sail_image *image,
+                                             uint32_t tiles_count, unsigned workers_count) {
+
+    struct tiles_context context;
+
+    context.io          = io;
+    context.directory   = directory;
+    context.image       = image;
+    context.tiles_count = tiles_count;
+    context.next_tile   = 0;
+    context.status      = SAIL_OK;
+
+    SAIL_TRY(sail_init_mutex(&context.io_mutex));
+    SAIL_TRY_OR_CLEANUP(sail_init_mutex(&context.tiles_mutex),
+                        /* cleanup */ sail_destroy_mutex(&context.io_mutex));
+
+    const sail_status_t status = read_tiles_in_parallel(&context, workers_count);
+
+    sail_destroy_mutex(&context.tiles_mutex);
+    sail_destroy_mutex(&context.io_mutex);
+
+    return status;
+}
+
+#endif
+
+bool tiff_private_load_tuning_key_value_callback(const char *key, const struct sail_variant *value, void *user_data) {
+
+    unsigned *tile_threads = user_data;
+
+    if (strcmp(key, "tiff-tile-threads") == 0) {
+        if (value->type == SAIL_VARIANT_TYPE_UNSIGNED_INT) {
+            const unsigned threads = sail_variant_to_unsigned_int(value);
+
+            if (threads > 0) {
+                SAIL_LOG_TRACE("TIFF: Reading tiles with up to %u threads", threads);
+                *tile_threads = threads;
+            } else {
+                SAIL_LOG_WARNING("TIFF: The number of tile threads must be greater than zero");
+            }
+        }
+    }
+
+    return true;
+}
+
+sail_status_t tiff_private_read_tiles(TIFF *tiff, struct sail_io *io, uint16_t directory, unsigned max_workers,
+                                      struct sail_image *image) {
+
+    const uint32_t tiles_count = TIFFNumberOfTiles(tiff);
+
+#ifdef SAIL_THREAD_SAFE
+    unsigned workers_count = (max_workers < sail_cpu_count()) ? max_workers : sail_cpu_count();
+    workers_count = (workers_count < tiles_count) ? workers_count : tiles_count;
+
+    if (workers_count > 1) {
+        SAIL_LOG_DEBUG("TIFF: Reading %u tiles with %u workers", tiles_count, workers_count);
+        SAIL_TRY(read_tiles_with_workers(io, directory, image, tiles_count, workers_count));
+        return SAIL_OK;
+    }
+#else
+    (void)io;
+    (void)directory;
+    (void)max_workers;
+#endif
+
+    SAIL_TRY(read_tiles_sequentially(tiff, image, tiles_count));
+
+    return SAIL_OK;
+}
+
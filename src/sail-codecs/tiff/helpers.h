@@ -27,6 +27,8 @@
 #define SAIL_TIFF_HELPERS_H
 
 #include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 
 #include <tiffio.h>
@@ -35,8 +37,11 @@
 #include "error.h"
 #include "export.h"
 
+struct sail_image;
+struct sail_io;
 struct sail_meta_data_node;
 struct sail_resolution;
+struct sail_variant;
 
 SAIL_HIDDEN void tiff_private_my_error_fn(const char *module, const char *format, va_list ap);
 
@@ -60,4 +65,24 @@ SAIL_HIDDEN sail_status_t tiff_private_fetch_resolution(TIFF *tiff, struct sail_
 
 SAIL_HIDDEN sail_status_t tiff_private_write_resolution(TIFF *tiff, const struct sail_resolution *resolution);
 
+/*
+ * Returns the pixel format of pixels read as is with TIFFReadEncodedStrip() and TIFFReadEncodedTile(),
+ * or SAIL_PIXEL_FORMAT_UNKNOWN if the current directory layout needs TIFFRGBAImage to be read.
+ */
+SAIL_HIDDEN enum SailPixelFormat tiff_private_native_pixel_format(TIFF *tiff);
+
+SAIL_HIDDEN sail_status_t tiff_private_read_strips(TIFF *tiff, struct sail_image *image);
+
+SAIL_HIDDEN bool tiff_private_load_tuning_key_value_callback(const char *key, const struct sail_variant *value, void *user_data);
+
+/*
+ * Reads the tiles of the specified directory. When max_workers is greater than 1 and SAIL is built
+ * with SAIL_THREAD_SAFE, decodes independent tiles in parallel with up to max_workers threads,
+ * but no more than the number of CPUs. Every extra thread opens its own TIFF handle over the same
+ * I/O stream and parses the directory again, which costs re-reading the IFD and its tag arrays
+ * like tile offsets. This pays off only for large tiled frames with expensive compressions.
+ */
+SAIL_HIDDEN sail_status_t tiff_private_read_tiles(TIFF *tiff, struct sail_io *io, uint16_t directory, unsigned max_workers,
+                                                  struct sail_image *image);
+
 #endif
@@ -23,6 +23,8 @@
     SOFTWARE.
 */
 
+#include <stdio.h>
+
 #include "sail-common.h"
 
 #include "io.h"
@@ -92,3 +94,84 @@ toff_t tiff_private_my_dummy_size_proc(thandle_t client_data) {
 
     return (toff_t)-1;
 }
+
+#ifdef SAIL_THREAD_SAFE
+
+tmsize_t tiff_private_my_shared_read_proc(thandle_t client_data, void *buffer, tmsize_t buffer_size) {
+
+    struct tiff_shared_io *shared_io = (struct tiff_shared_io *)client_data;
+    struct sail_io *io = shared_io->io;
+    size_t nbytes = 0;
+
+    sail_lock_mutex(shared_io->mutex);
+
+    sail_status_t err = io->seek(io->stream, (long)shared_io->offset, SEEK_SET);
+
+    if (err == SAIL_OK) {
+        err = io->tolerant_read(io->stream, buffer, buffer_size, &nbytes);
+    }
+
+    sail_unlock_mutex(shared_io->mutex);
+
+    if (err != SAIL_OK) {
+        TIFFError(NULL, "Failed to read from the I/O stream: %d", err);
+        return (tmsize_t)-1;
+    }
+
+    shared_io->offset += nbytes;
+
+    return (tmsize_t)nbytes;
+}
+
+tmsize_t tiff_private_my_shared_write_proc(thandle_t client_data, void *buffer, tmsize_t buffer_size) {
+
+    (void)client_data;
+    (void)buffer;
+    (void)buffer_size;
+
+    TIFFError(NULL, "Shared I/O streams are read-only");
+
+    return (tmsize_t)-1;
+}
+
+toff_t tiff_private_my_shared_seek_proc(thandle_t client_data, toff_t offset, int whence) {
+
+    struct tiff_shared_io *shared_io = (struct tiff_shared_io *)client_data;
+    struct sail_io *io = shared_io->io;
+
+    switch (whence) {
+        case SEEK_SET: {
+            shared_io->offset = offset;
+            break;
+        }
+        case SEEK_CUR: {
+            shared_io->offset += offset;
+            break;
+        }
+        default: {
+            size_t new_offset = 0;
+
+            sail_lock_mutex(shared_io->mutex);
+
+            sail_status_t err = io->seek(io->stream, (long)offset, whence);
+
+            if (err == SAIL_OK) {
+                err = io->tell(io->stream, &new_offset);
+            }
+
+            sail_unlock_mutex(shared_io->mutex);
+
+            if (err != SAIL_OK) {
+                TIFFError(NULL, "Failed to seek the I/O stream: %d", err);
+                return (toff_t)-1;
+            }
+
+            shared_io->offset = (toff_t)new_offset;
+            break;
+        }
+    }
+
+    return shared_io->offset;
+}
+
+#endif
@@ -28,8 +28,15 @@
 
 #include <tiffio.h>
 
+#include "config.h"
 #include "export.h"
 
+#ifdef SAIL_THREAD_SAFE
+    #include "threading.h"
+#endif
+
+struct sail_io;
+
 SAIL_HIDDEN tmsize_t tiff_private_my_read_proc(thandle_t client_data, void *buffer, tmsize_t buffer_size);
 
 SAIL_HIDDEN tmsize_t tiff_private_my_write_proc(thandle_t client_data, void *buffer, tmsize_t buffer_size);
@@ -40,4 +47,24 @@ SAIL_HIDDEN int tiff_private_my_dummy_close_proc(thandle_t client_data);
 
 SAIL_HIDDEN toff_t tiff_private_my_dummy_size_proc(thandle_t client_data);
 
+#ifdef SAIL_THREAD_SAFE
+
+/*
+ * I/O shared between several TIFF handles reading the same stream in parallel. Every handle
+ * has its own stream position. Reads are serialized with the mutex.
+ */
+struct tiff_shared_io {
+    struct sail_io *io;
+    sail_mutex_t *mutex;
+    toff_t offset;
+};
+
+SAIL_HIDDEN tmsize_t tiff_private_my_shared_read_proc(thandle_t client_data, void *buffer, tmsize_t buffer_size);
+
+SAIL_HIDDEN tmsize_t tiff_private_my_shared_write_proc(thandle_t client_data, void *buffer, tmsize_t buffer_size);
+
+SAIL_HIDDEN toff_t tiff_private_my_shared_seek_proc(thandle_t client_data, toff_t offset, int whence);
+
+#endif
+
 #endif
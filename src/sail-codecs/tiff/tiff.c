@@ -47,6 +47,12 @@ struct tiff_state {
     int save_compression;
     TIFFRGBAImage image;
     int line;
+
+    /* The current frame is read with TIFFReadEncodedStrip() or TIFFReadEncodedTile() instead of TIFFRGBAImage. */
+    bool native;
+
+    /* The maximum number of threads to read tiles with. Set with the "tiff-tile-threads" tuning. */
+    unsigned tile_threads;
 };
 
 static sail_status_t alloc_tiff_state(struct tiff_state **tiff_state) {
@@ -62,6 +68,8 @@ static sail_status_t alloc_tiff_state(struct tiff_state **tiff_state) {
     (*tiff_state)->save_options     = NULL;
     (*tiff_state)->save_compression = COMPRESSION_NONE;
     (*tiff_state)->line             = 0;
+    (*tiff_state)->native           = false;
+    (*tiff_state)->tile_threads     = 1;
 
     tiff_private_zero_tiff_image(&(*tiff_state)->image);
 
@@ -106,6 +114,11 @@ SAIL_EXPORT sail_status_t sail_codec_load_init_v7_tiff(struct sail_io *io, const
     /* Deep copy load options. */
     SAIL_TRY(sail_copy_load_options(load_options, &tiff_state->load_options));
 
+    /* Handle tuning. */
+    if (tiff_state->load_options->tuning != NULL) {
+        sail_traverse_hash_map_with_user_data(tiff_state->load_options->tuning, tiff_private_load_tuning_key_value_callback, &tiff_state->tile_threads);
+    }
+
     /* Initialize TIFF.
      *
      * 'r': reading operation
@@ -154,16 +167,6 @@ SAIL_EXPORT sail_status_t sail_codec_load_seek_next_frame_v7_tiff(void *state, s
         SAIL_LOG_AND_RETURN(SAIL_ERROR_NO_MORE_FRAMES);
     }
 
-    /* Start reading the next image. */
-    char emsg[1024];
-    if (!TIFFRGBAImageBegin(&tiff_state->image, tiff_state->tiff, /* stop */ 1, emsg)) {
-        SAIL_LOG_ERROR("TIFF: %s", emsg);
-        sail_destroy_image(image_local);
-        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
-    }
-
-    tiff_state->image.req_orientation = ORIENTATION_TOPLEFT;
-
     /* Fill the image properties. */
     if (!TIFFGetField(tiff_state->tiff, TIFFTAG_IMAGEWIDTH,  &image_local->width) || !TIFFGetField(tiff_state->tiff, TIFFTAG_IMAGELENGTH, &image_local->height)) {
         SAIL_LOG_ERROR("TIFF: Failed to get the image dimensions");
@@ -171,6 +174,35 @@ SAIL_EXPORT sail_status_t sail_codec_load_seek_next_frame_v7_tiff(void *state, s
         SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
     }
 
+    /* Read common layouts as is. Fall back to TIFFRGBAImage for exotic ones. */
+    image_local->pixel_format = tiff_private_native_pixel_format(tiff_state->tiff);
+
+    if (image_local->pixel_format != SAIL_PIXEL_FORMAT_UNKNOWN) {
+        SAIL_TRY_OR_CLEANUP(sail_bytes_per_line(image_local->width, image_local->pixel_format, &image_local->bytes_per_line),
+                            /* cleanup */ sail_destroy_image(image_local));
+
+        if (TIFFScanlineSize(tiff_state->tiff) != (tmsize_t)image_local->bytes_per_line) {
+            image_local->pixel_format = SAIL_PIXEL_FORMAT_UNKNOWN;
+        }
+    }
+
+    tiff_state->native = image_local->pixel_format != SAIL_PIXEL_FORMAT_UNKNOWN;
+    tiff_state->line   = 0;
+
+    if (!tiff_state->native) {
+        /* Start reading the next image. */
+        char emsg[1024];
+        if (!TIFFRGBAImageBegin(&tiff_state->image, tiff_state->tiff, /* stop */ 1, emsg)) {
+            SAIL_LOG_ERROR("TIFF: %s", emsg);
+            sail_destroy_image(image_local);
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+        }
+
+        tiff_state->image.req_orientation = ORIENTATION_TOPLEFT;
+
+        image_local->pixel_format = SAIL_PIXEL_FORMAT_BPP32_RGBA;
+    }
+
     /* Fetch meta data. */
     if (tiff_state->load_options->options & SAIL_OPTION_META_DATA) {
         struct sail_meta_data_node **last_meta_data_node = &image_local->meta_data_node;
@@ -189,12 +221,15 @@ SAIL_EXPORT sail_status_t sail_codec_load_seek_next_frame_v7_tiff(void *state, s
     SAIL_TRY_OR_CLEANUP(tiff_private_fetch_resolution(tiff_state->tiff, &image_local->resolution),
                             /* cleanup */ sail_destroy_image(image_local));
 
-    image_local->pixel_format = SAIL_PIXEL_FORMAT_BPP32_RGBA;
-
     SAIL_TRY_OR_CLEANUP(sail_bytes_per_line(image_local->width, image_local->pixel_format, &image_local->bytes_per_line),
                         /* cleanup */ sail_destroy_image(image_local));
 
     /* Fill the source image properties. */
+    uint16_t bits_per_sample = 1;
+    uint16_t samples_per_pixel = 1;
+    TIFFGetFieldDefaulted(tiff_state->tiff, TIFFTAG_BITSPERSAMPLE,   &bits_per_sample);
+    TIFFGetFieldDefaulted(tiff_state->tiff, TIFFTAG_SAMPLESPERPIXEL, &samples_per_pixel);
+
     int compression = COMPRESSION_NONE;
     if (!TIFFGetField(tiff_state->tiff, TIFFTAG_COMPRESSION, &compression)) {
         SAIL_LOG_ERROR("TIFF: Failed to get the image compression type");
@@ -202,7 +237,7 @@ SAIL_EXPORT sail_status_t sail_codec_load_seek_next_frame_v7_tiff(void *state, s
         SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
     }
 
-    image_local->source_image->pixel_format = tiff_private_bpp_to_pixel_format(tiff_state->image.bitspersample * tiff_state->image.samplesperpixel);
+    image_local->source_image->pixel_format = tiff_private_bpp_to_pixel_format(bits_per_sample * samples_per_pixel);
     image_local->source_image->compression = tiff_private_compression_to_sail_compression(compression);
 
     *image = image_local;
@@ -222,6 +257,16 @@ SAIL_EXPORT sail_status_t sail_codec_load_frame_v7_tiff(void *state, struct sail
         SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
     }
 
+    if (tiff_state->native) {
+        if (TIFFIsTiled(tiff_state->tiff)) {
+            SAIL_TRY(tiff_private_read_tiles(tiff_state->tiff, io, tiff_state->current_frame - 1, tiff_state->tile_threads, image));
+        } else {
+            SAIL_TRY(tiff_private_read_strips(tiff_state->tiff, image));
+        }
+
+        return SAIL_OK;
+    }
+
     if (!TIFFRGBAImageGet(&tiff_state->image, image->pixels, image->width, image->height)) {
         SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
     }
@@ -231,6 +276,32 @@ SAIL_EXPORT sail_status_t sail_codec_load_frame_v7_tiff(void *state, struct sail
     return SAIL_OK;
 }
 
+SAIL_EXPORT sail_status_t sail_codec_load_frame_rows_v7_tiff(void *state, struct sail_io *io, struct sail_image *image, unsigned rows_count) {
+
+    SAIL_CHECK_PTR(state);
+    SAIL_TRY(sail_check_io_valid(io));
+    SAIL_TRY(sail_check_image_skeleton_valid(image));
+
+    struct tiff_state *tiff_state = (struct tiff_state *)state;
+
+    if (tiff_state->libtiff_error) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+    }
+
+    /* Tiles and layouts read with TIFFRGBAImage need the whole frame. */
+    if (!tiff_state->native || TIFFIsTiled(tiff_state->tiff)) {
+        return SAIL_ERROR_NOT_IMPLEMENTED;
+    }
+
+    for (unsigned row = 0; row < rows_count; row++) {
+        if (TIFFReadScanline(tiff_state->tiff, (unsigned char *)image->pixels + row * image->bytes_per_line, tiff_state->line++, 0) < 0) {
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+        }
+    }
+
+    return SAIL_OK;
+}
+
 SAIL_EXPORT sail_status_t sail_codec_load_finish_v7_tiff(void **state, struct sail_io *io) {
 
     SAIL_CHECK_PTR(state);
@@ -368,6 +439,34 @@ SAIL_EXPORT sail_status_t sail_codec_save_frame_v7_tiff(void *state, struct sail
     return SAIL_OK;
 }
 
+SAIL_EXPORT sail_status_t sail_codec_save_frame_rows_v7_tiff(void *state, struct sail_io *io, const struct sail_image *image, unsigned rows_count) {
+
+    SAIL_CHECK_PTR(state);
+    SAIL_TRY(sail_check_io_valid(io));
+    SAIL_TRY(sail_check_image_valid(image));
+
+    struct tiff_state *tiff_state = (struct tiff_state *)state;
+
+    if (tiff_state->libtiff_error) {
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+    }
+
+    for (unsigned row = 0; row < rows_count; row++) {
+        if (TIFFWriteScanline(tiff_state->tiff, (unsigned char *)image->pixels + row * image->bytes_per_line, tiff_state->line++, 0) < 0) {
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+        }
+    }
+
+    /* The last rows of the frame. */
+    if ((unsigned)tiff_state->line == image->height) {
+        if (!TIFFWriteDirectory(tiff_state->tiff)) {
+            SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
+        }
+    }
+
+    return SAIL_OK;
+}
+
 SAIL_EXPORT sail_status_t sail_codec_save_finish_v7_tiff(void **state, struct sail_io *io) {
 
     SAIL_CHECK_PTR(state);
@@ -97,8 +97,15 @@ SAIL_EXPORT sail_status_t sail_codec_load_init_v7_wal(struct sail_io *io, const
     /* Read WAL header. */
     SAIL_TRY(wal_private_read_file_header(io, &wal_state->wal_header));
 
-    wal_state->width = wal_state->wal_header.width;
-    wal_state->height = wal_state->wal_header.height;
+    /* Start from the smallest mip level that still covers the maximum output dimensions. */
+    const unsigned scale_denominator = sail_scale_denominator_from_load_options(wal_state->load_options,
+                                                                                wal_state->wal_header.width,
+                                                                                wal_state->wal_header.height,
+                                                                                8);
+
+    while (wal_state->frame_number < 3 && (1U << wal_state->frame_number) < scale_denominator) {
+        wal_state->frame_number++;
+    }
 
     return SAIL_OK;
 }
@@ -115,10 +122,8 @@ SAIL_EXPORT sail_status_t sail_codec_load_seek_next_frame_v7_wal(void *state, st
         SAIL_LOG_AND_RETURN(SAIL_ERROR_NO_MORE_FRAMES);
     }
 
-    if (wal_state->frame_number > 0) {
-        wal_state->width /= 2;
-        wal_state->height /= 2;
-    }
+    wal_state->width = wal_state->wal_header.width >> wal_state->frame_number;
+    wal_state->height = wal_state->wal_header.height >> wal_state->frame_number;
 
     struct sail_image *image_local;
     SAIL_TRY(sail_alloc_image(&image_local));
@@ -27,6 +27,8 @@
 
 #include "sail-common.h"
 
+#include "common/blend/blend.h"
+
 #include "helpers.h"
 
 void webp_private_fill_color(uint8_t *pixels, unsigned bytes_per_line, unsigned bytes_per_pixel,
@@ -47,18 +49,7 @@ sail_status_t webp_private_blend_over(void *dst_raw, unsigned dst_offset, const
     SAIL_CHECK_PTR(dst_raw);
 
     if (bytes_per_pixel == 4) {
-        const uint8_t *src = src_raw;
-        uint8_t *dst = (uint8_t *)dst_raw + dst_offset * bytes_per_pixel;
-
-        while (width--) {
-            const double src_a = *(src+3) / 255.0;
-            const double dst_a = *(dst+3) / 255.0;
-
-            *dst = (uint8_t)(src_a * (*src) + (1-src_a) * dst_a * (*dst)); src++; dst++;
-            *dst = (uint8_t)(src_a * (*src) + (1-src_a) * dst_a * (*dst)); src++; dst++;
-            *dst = (uint8_t)(src_a * (*src) + (1-src_a) * dst_a * (*dst)); src++; dst++;
-            *dst = (uint8_t)((src_a + (1-src_a) * dst_a) * 255);           src++; dst++;
-        }
+        blend_private_over_rgba32_row((uint8_t *)dst_raw + dst_offset * bytes_per_pixel, src_raw, width);
     } else {
         SAIL_LOG_AND_RETURN(SAIL_ERROR_UNSUPPORTED_BIT_DEPTH);
     }
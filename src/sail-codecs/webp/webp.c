@@ -36,6 +36,9 @@
 
 #include "helpers.h"
 
+/* WebPDecodeRGBAInto() and its counterparts for other channel orders. */
+typedef uint8_t* (*webp_decode_into_t)(const uint8_t *data, size_t data_size, uint8_t *output_buffer, size_t output_buffer_size, int output_stride);
+
 /*
  * Codec-specific state.
  */
@@ -50,6 +53,7 @@ struct webp_state {
     uint32_t background_color;
     uint32_t frame_count;
     unsigned bytes_per_pixel;
+    webp_decode_into_t decode_into;
     unsigned frame_x;
     unsigned frame_y;
     unsigned frame_width;
@@ -57,8 +61,9 @@ struct webp_state {
     WebPMuxAnimDispose frame_dispose_method;
     WebPMuxAnimBlend frame_blend_method;
 
-    void *image_data;
+    const void *image_data;
     size_t image_data_size;
+    void *image_data_to_free;
 };
 
 static sail_status_t alloc_webp_state(struct webp_state **webp_state) {
@@ -77,6 +82,7 @@ static sail_status_t alloc_webp_state(struct webp_state **webp_state) {
     (*webp_state)->background_color      = 0;
     (*webp_state)->frame_count           = 0;
     (*webp_state)->bytes_per_pixel       = 0;
+    (*webp_state)->decode_into           = WebPDecodeRGBAInto;
     (*webp_state)->frame_x               = 0;
     (*webp_state)->frame_y               = 0;
     (*webp_state)->frame_width           = 0;
@@ -84,8 +90,9 @@ static sail_status_t alloc_webp_state(struct webp_state **webp_state) {
     (*webp_state)->frame_dispose_method  = WEBP_MUX_DISPOSE_NONE;
     (*webp_state)->frame_blend_method    = WEBP_MUX_NO_BLEND;
 
-    (*webp_state)->image_data      = NULL;
-    (*webp_state)->image_data_size = 0;
+    (*webp_state)->image_data         = NULL;
+    (*webp_state)->image_data_size    = 0;
+    (*webp_state)->image_data_to_free = NULL;
 
     return SAIL_OK;
 }
@@ -101,7 +108,7 @@ static void destroy_webp_state(struct webp_state *webp_state) {
         sail_free(webp_state->webp_iterator);
     }
 
-    sail_free(webp_state->image_data);
+    sail_free(webp_state->image_data_to_free);
 
     WebPDemuxDelete(webp_state->webp_demux);
 
@@ -132,18 +139,25 @@ SAIL_EXPORT sail_status_t sail_codec_load_init_v7_webp(struct sail_io *io, const
     /* Deep copy load options. */
     SAIL_TRY(sail_copy_load_options(load_options, &webp_state->load_options));
 
-    /* Read the entire image. */
+    /* Read the entire image. Memory and mapped files are not copied. */
     SAIL_ALIGNAS(uint32_t) char signature_and_size[8];
     SAIL_TRY(io->strict_read(io->stream, signature_and_size, sizeof(signature_and_size)));
-    webp_state->image_data_size = *(uint32_t *)(signature_and_size + 4) + sizeof(signature_and_size);
+    const size_t riff_size = *(uint32_t *)(signature_and_size + 4) + sizeof(signature_and_size);
 
     SAIL_TRY(io->seek(io->stream, 0, SEEK_SET));
 
-    void *ptr;
-    SAIL_TRY(sail_malloc(webp_state->image_data_size, &ptr));
-    webp_state->image_data = ptr;
+    SAIL_TRY(sail_borrow_data_from_io_contents(io, &webp_state->image_data, &webp_state->image_data_size,
+                                               &webp_state->image_data_to_free));
+
+    if (webp_state->image_data_size < riff_size) {
+        SAIL_LOG_ERROR("WEBP: The image is truncated");
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_READ_IO);
+    }
+
+    /* Ignore trailing data after the RIFF chunk. */
+    webp_state->image_data_size = riff_size;
 
-    SAIL_TRY(io->strict_read(io->stream, webp_state->image_data, webp_state->image_data_size));
+    void *ptr;
 
     /* Construct a WebP demuxer. */
     const WebPData data = { webp_state->image_data, webp_state->image_data_size };
@@ -168,7 +182,15 @@ SAIL_EXPORT sail_status_t sail_codec_load_init_v7_webp(struct sail_io *io, const
 
     image_local->width = WebPDemuxGetI(webp_state->webp_demux, WEBP_FF_CANVAS_WIDTH);
     image_local->height = WebPDemuxGetI(webp_state->webp_demux, WEBP_FF_CANVAS_HEIGHT);
-    image_local->pixel_format = SAIL_PIXEL_FORMAT_BPP32_RGBA;
+
+    /* Output BGRA natively when requested. Blending works with both channel orders. */
+    if (webp_state->load_options->pixel_format == SAIL_PIXEL_FORMAT_BPP32_BGRA) {
+        image_local->pixel_format = SAIL_PIXEL_FORMAT_BPP32_BGRA;
+        webp_state->decode_into   = WebPDecodeBGRAInto;
+    } else {
+        image_local->pixel_format = SAIL_PIXEL_FORMAT_BPP32_RGBA;
+    }
+
     SAIL_TRY_OR_CLEANUP(sail_bytes_per_line(image_local->width, image_local->pixel_format, &image_local->bytes_per_line),
                         /* cleanup */ sail_destroy_image(image_local));
     webp_state->bytes_per_pixel = image_local->bytes_per_line / image_local->width;
@@ -271,23 +293,23 @@ SAIL_EXPORT sail_status_t sail_codec_load_frame_v7_webp(void *state, struct sail
 
     switch (webp_state->frame_blend_method) {
         case WEBP_MUX_NO_BLEND: {
-            if (WebPDecodeRGBAInto(webp_state->webp_iterator->fragment.bytes,
-                                    webp_state->webp_iterator->fragment.size,
-                                    (uint8_t *)webp_state->canvas_image->pixels + webp_state->canvas_image->bytes_per_line * webp_state->frame_y +
-                                        webp_state->frame_x * webp_state->bytes_per_pixel,
-                                    (size_t)webp_state->canvas_image->bytes_per_line * webp_state->canvas_image->height,
-                                    webp_state->canvas_image->bytes_per_line) == NULL) {
+            if (webp_state->decode_into(webp_state->webp_iterator->fragment.bytes,
+                                        webp_state->webp_iterator->fragment.size,
+                                        (uint8_t *)webp_state->canvas_image->pixels + webp_state->canvas_image->bytes_per_line * webp_state->frame_y +
+                                            webp_state->frame_x * webp_state->bytes_per_pixel,
+                                        (size_t)webp_state->canvas_image->bytes_per_line * webp_state->canvas_image->height,
+                                        webp_state->canvas_image->bytes_per_line) == NULL) {
                 SAIL_LOG_ERROR("WEBP: Failed to decode image");
                 SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
             }
             break;
         }
         case WEBP_MUX_BLEND: {
-            if (WebPDecodeRGBAInto(webp_state->webp_iterator->fragment.bytes,
-                                    webp_state->webp_iterator->fragment.size,
-                                    image->pixels,
-                                    (size_t)image->bytes_per_line * image->height,
-                                    webp_state->frame_width * webp_state->bytes_per_pixel) == NULL) {
+            if (webp_state->decode_into(webp_state->webp_iterator->fragment.bytes,
+                                        webp_state->webp_iterator->fragment.size,
+                                        image->pixels,
+                                        (size_t)image->bytes_per_line * image->height,
+                                        webp_state->frame_width * webp_state->bytes_per_pixel) == NULL) {
                 SAIL_LOG_ERROR("WEBP: Failed to decode image");
                 SAIL_LOG_AND_RETURN(SAIL_ERROR_UNDERLYING_CODEC);
             }
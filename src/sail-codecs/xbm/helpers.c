@@ -23,10 +23,35 @@
     SOFTWARE.
 */
 
+#include <stdbool.h>
+#include <stdint.h>
+
 #include "sail-common.h"
 
+#include "common/reader/reader.h"
+
 #include "helpers.h"
 
+/* Values of hexadecimal digits, or -1 for other characters. */
+static const int8_t hex_digit_values[256] = {
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+     0,  1,  2,  3,  4,  5,  6,  7,  8,  9, -1, -1, -1, -1, -1, -1,
+    -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+};
+
 static const unsigned char reverse_lookup_4bits[] = {
     0x0, 0x8, 0x4, 0xc, 0x2, 0xa, 0x6, 0xe,
     0x1, 0x9, 0x5, 0xd, 0x3, 0xb, 0x7, 0xf,
@@ -36,3 +61,95 @@ unsigned char xbm_private_reverse_byte(unsigned char byte) {
 
    return (reverse_lookup_4bits[byte & 0xF] << 4) | reverse_lookup_4bits[byte >> 4];
 }
+
+static inline bool is_separator(uint8_t c) {
+
+    return c == ',' || c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+/*
+ * Parses a literal right in the reader window without per-byte checks. Returns false
+ * if the literal crosses the window end or is broken, and consumes nothing in this case.
+ */
+static inline bool read_hex_literal_from_window(struct reader *reader, unsigned *value) {
+
+    const uint8_t *p   = reader->buffer + reader->pos;
+    const uint8_t *end = reader->buffer + reader->length;
+
+    while (p < end && is_separator(*p)) {
+        p++;
+    }
+
+    if (end - p >= 2 && p[0] == '0' && (p[1] == 'x' || p[1] == 'X')) {
+        p += 2;
+    }
+
+    const uint8_t *digits = p;
+    unsigned result = 0;
+    int digit;
+
+    while (p < end && (digit = hex_digit_values[*p]) >= 0) {
+        result = (result << 4) | (unsigned)digit;
+        p++;
+    }
+
+    /* The literal must have digits and must be followed by a byte in the window. */
+    if (p == digits || p == end) {
+        return false;
+    }
+
+    reader->pos = (size_t)(p - reader->buffer);
+    *value = result;
+
+    return true;
+}
+
+sail_status_t xbm_private_read_hex_literal(struct reader *reader, unsigned *value) {
+
+    if (SAIL_LIKELY(read_hex_literal_from_window(reader, value))) {
+        return SAIL_OK;
+    }
+
+    /* Slow path for literals crossing the window end, and for error reporting. */
+    uint8_t c;
+
+    /* Skip separators. */
+    do {
+        SAIL_TRY(reader_private_read_byte(reader, &c));
+    } while (is_separator(c));
+
+    /* Skip the 0x prefix. */
+    if (c == '0') {
+        SAIL_TRY(reader_private_read_byte(reader, &c));
+
+        if (c == 'x' || c == 'X') {
+            SAIL_TRY(reader_private_read_byte(reader, &c));
+        } else {
+            reader_private_unread_byte(reader);
+            c = '0';
+        }
+    }
+
+    int digit = hex_digit_values[c];
+
+    if (digit < 0) {
+        SAIL_LOG_ERROR("XBM: Expected a hexadecimal literal, but got '%c'", c);
+        SAIL_LOG_AND_RETURN(SAIL_ERROR_BROKEN_IMAGE);
+    }
+
+    unsigned result = 0;
+
+    do {
+        result = (result << 4) | (unsigned)digit;
+
+        SAIL_TRY(reader_private_read_byte(reader, &c));
+        digit = hex_digit_values[c];
+    } while (digit >= 0);
+
+    /* The byte after the literal is a separator or a closing brace. */
+    reader_private_unread_byte(reader);
+
+    *value = result;
+
+    return SAIL_OK;
+}
@@ -26,8 +26,18 @@
 #ifndef SAIL_XBM_HELPERS_H
 #define SAIL_XBM_HELPERS_H
 
+#include "common.h"
+#include "error.h"
 #include "export.h"
 
+struct reader;
+
 SAIL_HIDDEN unsigned char xbm_private_reverse_byte(unsigned char byte);
 
+/*
+ * Reads the next hexadecimal C literal like 0xff or 0x00ff from the data array. Skips
+ * the preceding whitespace and separating commas.
+ */
+SAIL_HIDDEN sail_status_t xbm_private_read_hex_literal(struct reader *reader, unsigned *value);
+
 #endif
@@ -24,12 +24,13 @@
 */
 
 #include <stdbool.h>
-#include <stdio.h>
 #include <stdlib.h> /* atoi() */
 #include <string.h>
 
 #include "sail-common.h"
 
+#include "common/reader/reader.h"
+
 #include "helpers.h"
 
 enum SailXbmVersion {
@@ -47,6 +48,9 @@ struct xbm_state {
     bool frame_loaded;
 
     enum SailXbmVersion version;
+
+    /* Buffered text reader over the I/O object. */
+    struct reader reader;
 };
 
 static sail_status_t alloc_xbm_state(struct xbm_state **xbm_state) {
@@ -95,6 +99,8 @@ SAIL_EXPORT sail_status_t sail_codec_load_init_v7_xbm(struct sail_io *io, const
     /* Deep copy load options. */
     SAIL_TRY(sail_copy_load_options(load_options, &xbm_state->load_options));
 
+    reader_private_init(&xbm_state->reader, io);
+
     return SAIL_OK;
 }
 
@@ -115,7 +121,7 @@ SAIL_EXPORT sail_status_t sail_codec_load_seek_next_frame_v7_xbm(void *state, st
     char buf[512 + 1];
 
     /* Read width. */
-    SAIL_TRY(sail_read_string_from_io(io, buf, sizeof(buf)));
+    SAIL_TRY(reader_private_read_line(&xbm_state->reader, buf, sizeof(buf)));
 
     if (strncmp(buf, "#define ", 8) != 0) {
         SAIL_LOG_AND_RETURN(SAIL_ERROR_BROKEN_IMAGE);
@@ -129,7 +135,7 @@ SAIL_EXPORT sail_status_t sail_codec_load_seek_next_frame_v7_xbm(void *state, st
     unsigned width = atoi(ptr + 6);
 
     /* Read height. */
-    SAIL_TRY(sail_read_string_from_io(io, buf, sizeof(buf)));
+    SAIL_TRY(reader_private_read_line(&xbm_state->reader, buf, sizeof(buf)));
 
     if (strncmp(buf, "#define ", 8) != 0) {
         SAIL_LOG_AND_RETURN(SAIL_ERROR_BROKEN_IMAGE);
@@ -143,7 +149,7 @@ SAIL_EXPORT sail_status_t sail_codec_load_seek_next_frame_v7_xbm(void *state, st
 
     /* Skip other defines. */
     do {
-        SAIL_TRY(sail_read_string_from_io(io, buf, sizeof(buf)));
+        SAIL_TRY(reader_private_read_line(&xbm_state->reader, buf, sizeof(buf)));
     } while(strstr(buf, "#define ") != NULL);
 
     if ((ptr = strchr(buf, '[')) == NULL || strchr(ptr, '{') == NULL) {
@@ -203,47 +209,28 @@ SAIL_EXPORT sail_status_t sail_codec_load_frame_v7_xbm(void *state, struct sail_
     SAIL_TRY(sail_check_io_valid(io));
     SAIL_TRY(sail_check_image_skeleton_valid(image));
 
-    const struct xbm_state *xbm_state = (struct xbm_state *)state;
+    struct xbm_state *xbm_state = (struct xbm_state *)state;
 
-    unsigned literals_to_read;
+    /* X10 bitmaps consist of 16-bit literals, and every row is padded to 16 bits. */
+    const unsigned literal_size = (xbm_state->version == SAIL_XBM_VERSION_11) ? 1 : 2;
 
-    if (SAIL_LIKELY(xbm_state->version == SAIL_XBM_VERSION_11)) {
-        literals_to_read = ((image->width + 7) / 8) * image->height;
-    } else {
-        literals_to_read = (((image->width + 7) / 8 + 1) / 2) * image->height;
-    }
+    for (unsigned row = 0; row < image->height; row++) {
+        unsigned char *scan = (unsigned char *)image->pixels + (size_t)row * image->bytes_per_line;
 
-    SAIL_LOG_TRACE("XBM: Literals to read(%u)", literals_to_read);
+        for (unsigned i = 0; i < image->bytes_per_line; i += literal_size) {
+            unsigned literal;
+            SAIL_TRY(xbm_private_read_hex_literal(&xbm_state->reader, &literal));
 
-    char buf[512 + 1];
-    unsigned char *pixels = image->pixels;
-
-    for (unsigned literals_read = 0; literals_read < literals_to_read; ) {
-        SAIL_TRY(sail_read_string_from_io(io, buf, sizeof(buf)));
-
-        unsigned buf_offset = 0;
-        unsigned holder;
-        char comma;
-        int bytes_consumed;
-
-    #ifdef _MSC_VER
-        while (sscanf_s(buf + buf_offset, "%x %c %n", &holder, &comma, 1, &bytes_consumed) == 2) {
-    #else
-        while (sscanf(buf + buf_offset, "%x %c %n", &holder, &comma, &bytes_consumed) == 2) {
-    #endif
-
-            if (SAIL_LIKELY(xbm_state->version == SAIL_XBM_VERSION_11)) {
-                *pixels++ = xbm_private_reverse_byte((unsigned char)holder);
-            } else {
-                *pixels++ = xbm_private_reverse_byte((unsigned char)(holder & 0xff));
-                *pixels++ = xbm_private_reverse_byte((unsigned char)(holder >> 8));
-            }
+            scan[i] = xbm_private_reverse_byte((unsigned char)(literal & 0xff));
 
-            literals_read++;
-            buf_offset += bytes_consumed;
+            if (literal_size == 2 && i + 1 < image->bytes_per_line) {
+                scan[i + 1] = xbm_private_reverse_byte((unsigned char)((literal >> 8) & 0xff));
+            }
         }
     }
 
+    SAIL_TRY(reader_private_sync(&xbm_state->reader));
+
     return SAIL_OK;
 }
 
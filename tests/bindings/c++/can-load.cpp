@@ -23,6 +23,11 @@
     SOFTWARE.
 */
 
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
 #include "sail-c++.h"
 
 #include "munit.h"
@@ -40,6 +45,119 @@ static MunitResult test_able_to_load(const MunitParameter params[], void *user_d
     return MUNIT_OK;
 }
 
+static MunitResult test_able_to_load_into_caller_buffer(const MunitParameter params[], void *user_data) {
+    (void)user_data;
+
+    const char *path = munit_parameters_get(params, "path");
+
+    const sail::image image(path);
+    munit_assert(image.is_valid());
+
+    const unsigned bytes_per_line = image.bytes_per_line() + 16;
+    std::vector<unsigned char> pixels(static_cast<std::size_t>(bytes_per_line) * image.height());
+
+    sail::image_input image_input;
+    munit_assert(image_input.start(path) == SAIL_OK);
+
+    sail::image image_into;
+    munit_assert(image_input.next_frame(&image_into, pixels.data(), pixels.size(), bytes_per_line) == SAIL_OK);
+    munit_assert(image_input.stop() == SAIL_OK);
+
+    munit_assert(image_into.is_valid());
+    munit_assert_ptr_equal(image_into.pixels(), pixels.data());
+    munit_assert(image_into.bytes_per_line() == bytes_per_line);
+
+    for (unsigned row = 0; row < image.height(); row++) {
+        munit_assert_memory_equal(image.bytes_per_line(), image_into.scan_line(row), image.scan_line(row));
+    }
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_able_to_save_into_growing_memory(const MunitParameter params[], void *user_data) {
+    (void)user_data;
+
+    const char *path = munit_parameters_get(params, "path");
+
+    const sail::image image(path);
+    munit_assert(image.is_valid());
+
+    const sail::codec_info codec_info = sail::codec_info::from_path(path);
+    const std::vector<SailPixelFormat> &pixel_formats = codec_info.save_features().pixel_formats();
+
+    if (std::find(pixel_formats.begin(), pixel_formats.end(), image.pixel_format()) == pixel_formats.end()) {
+        return MUNIT_SKIP;
+    }
+
+    sail::io_memory io_memory;
+
+    {
+        sail::image_output image_output;
+        munit_assert(image_output.start(io_memory, codec_info) == SAIL_OK);
+        munit_assert(image_output.next_frame(image) == SAIL_OK);
+        munit_assert(image_output.stop() == SAIL_OK);
+    }
+
+    munit_assert_not_null(io_memory.buffer());
+    munit_assert(io_memory.buffer_length() > 0);
+
+    sail::image_input image_input;
+    sail::image image_saved;
+    munit_assert(image_input.start(io_memory.buffer(), io_memory.buffer_length(), codec_info) == SAIL_OK);
+    munit_assert(image_input.next_frame(&image_saved) == SAIL_OK);
+    munit_assert(image_input.stop() == SAIL_OK);
+
+    munit_assert(image_saved.width() == image.width());
+    munit_assert(image_saved.height() == image.height());
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_able_to_load_batch(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    std::vector<std::string> paths;
+
+    for (const char * const *path = SAIL_TEST_IMAGES; *path != NULL; path++) {
+        paths.push_back(*path);
+    }
+
+    sail::batch_loader batch_loader;
+    batch_loader.set_threads(3);
+    batch_loader.set_order(SAIL_BATCH_ORDER_INPUT);
+
+    std::size_t next_index = 0;
+
+    munit_assert(batch_loader.load(paths, [&](std::size_t index, sail_status_t status, sail::image &&image) {
+        munit_assert(index == next_index++);
+        munit_assert(status == SAIL_OK);
+        munit_assert(image.is_valid());
+
+        const sail::image expected_image(paths[index]);
+        munit_assert(image.width() == expected_image.width());
+        munit_assert(image.height() == expected_image.height());
+        munit_assert(image.pixel_format() == expected_image.pixel_format());
+    }) == SAIL_OK);
+
+    munit_assert(next_index == paths.size());
+
+    /* Exceptions thrown by the callback are rethrown. */
+    bool thrown = false;
+
+    try {
+        batch_loader.load(paths, [](std::size_t, sail_status_t, sail::image &&) {
+            throw std::runtime_error("stop");
+        });
+    } catch (const std::runtime_error &) {
+        thrown = true;
+    }
+
+    munit_assert(thrown);
+
+    return MUNIT_OK;
+}
+
 static MunitParameterEnum test_params[] = {
     { (char *)"path", (char **)SAIL_TEST_IMAGES },
     { NULL, NULL },
@@ -47,6 +165,9 @@ static MunitParameterEnum test_params[] = {
 
 static MunitTest test_suite_tests[] = {
     { (char *)"/can-load", test_able_to_load, NULL, NULL, MUNIT_TEST_OPTION_NONE, test_params },
+    { (char *)"/can-load-into-caller-buffer", test_able_to_load_into_caller_buffer, NULL, NULL, MUNIT_TEST_OPTION_NONE, test_params },
+    { (char *)"/can-save-into-growing-memory", test_able_to_save_into_growing_memory, NULL, NULL, MUNIT_TEST_OPTION_NONE, test_params },
+    { (char *)"/can-load-batch", test_able_to_load_batch, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
 
     { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
 };
@@ -69,10 +69,15 @@ static MunitResult test_load_options_copy(const MunitParameter params[], void *u
         munit_assert(first_codec.load_features().to_options(&load_options) == SAIL_OK);
         load_options.tuning()["key"] = 10.0;
         munit_assert_double(load_options.tuning()["key"].value<double>(), ==, 10.0);
+        load_options.set_pixel_format(SAIL_PIXEL_FORMAT_BPP32_BGRA);
+        load_options.set_max_size(640, 480);
 
         const sail::load_options load_options2 = load_options;
-        munit_assert(load_options.options() == load_options2.options());
-        munit_assert(load_options.tuning()  == load_options2.tuning());
+        munit_assert(load_options.options()      == load_options2.options());
+        munit_assert(load_options.tuning()       == load_options2.tuning());
+        munit_assert(load_options.pixel_format() == load_options2.pixel_format());
+        munit_assert(load_options2.max_width()   == 640);
+        munit_assert(load_options2.max_height()  == 480);
     }
 
     return MUNIT_OK;
@@ -0,0 +1,185 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2021 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stdint.h>
+#include <string.h>
+
+#include "sail-common.h"
+
+#include "common/blend/blend.h"
+
+#include "munit.h"
+
+/* Longer than a few SIMD vectors, and covers the lengths not divisible by the vector width. */
+#define MAX_WIDTH 67
+
+/*
+ * Reference implementation of the documented "over" operator.
+ */
+static void reference_over_rgba32_pixel(uint8_t *dst, const uint8_t *src) {
+
+    const uint64_t src_a = src[3];
+    const uint64_t dst_a = dst[3];
+
+    if (src_a == 0) {
+        return;
+    }
+
+    /* Alpha is scaled by 255*255. */
+    const uint64_t src_w = src_a * 255;
+    const uint64_t dst_w = dst_a * (255 - src_a);
+    const uint64_t out_w = src_w + dst_w;
+
+    for (unsigned i = 0; i < 3; i++) {
+        dst[i] = (uint8_t)((src[i] * src_w + dst[i] * dst_w + out_w / 2) / out_w);
+    }
+
+    dst[3] = (uint8_t)((out_w + 127) / 255);
+}
+
+static void reference_over_rgba64_pixel(uint16_t *dst, const uint16_t *src) {
+
+    const uint64_t src_a = src[3];
+    const uint64_t dst_a = dst[3];
+
+    if (src_a == 0) {
+        return;
+    }
+
+    /* Alpha is scaled by 65535*65535. */
+    const uint64_t src_w = src_a * 65535;
+    const uint64_t dst_w = dst_a * (65535 - src_a);
+    const uint64_t out_w = src_w + dst_w;
+
+    for (unsigned i = 0; i < 3; i++) {
+        dst[i] = (uint16_t)((src[i] * src_w + dst[i] * dst_w + out_w / 2) / out_w);
+    }
+
+    dst[3] = (uint16_t)((out_w + 32767) / 65535);
+}
+
+/*
+ * Fills pixels with random colors and alpha runs: transparent, opaque, or random alpha.
+ * Runs make whole SIMD vectors hit the fast paths.
+ */
+static void fill_random_pixels(uint16_t *pixels, unsigned width, uint16_t max_value) {
+
+    unsigned i = 0;
+
+    while (i < width) {
+        const int kind = munit_rand_int_range(0, 2);
+        const unsigned run = (unsigned)munit_rand_int_range(1, 9);
+
+        for (unsigned k = 0; k < run && i < width; k++, i++) {
+            for (unsigned c = 0; c < 3; c++) {
+                pixels[i * 4 + c] = (uint16_t)munit_rand_int_range(0, max_value);
+            }
+
+            pixels[i * 4 + 3] = (kind == 0) ? 0 : (kind == 1) ? max_value : (uint16_t)munit_rand_int_range(0, max_value);
+        }
+    }
+}
+
+static MunitResult test_over_rgba32_row(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    uint16_t src_values[MAX_WIDTH * 4];
+    uint16_t dst_values[MAX_WIDTH * 4];
+    uint8_t src[MAX_WIDTH * 4];
+    uint8_t dst[MAX_WIDTH * 4];
+    uint8_t expected[MAX_WIDTH * 4];
+
+    for (unsigned iteration = 0; iteration < 100; iteration++) {
+        for (unsigned width = 0; width <= MAX_WIDTH; width++) {
+            fill_random_pixels(src_values, width, 255);
+            fill_random_pixels(dst_values, width, 255);
+
+            for (unsigned i = 0; i < width * 4; i++) {
+                src[i] = (uint8_t)src_values[i];
+                dst[i] = (uint8_t)dst_values[i];
+            }
+
+            memcpy(expected, dst, width * 4);
+
+            for (unsigned i = 0; i < width; i++) {
+                reference_over_rgba32_pixel(expected + i * 4, src + i * 4);
+            }
+
+            blend_private_over_rgba32_row(dst, src, width);
+
+            munit_assert_memory_equal(width * 4, dst, expected);
+        }
+    }
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_over_rgba64_row(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    uint16_t src[MAX_WIDTH * 4];
+    uint16_t dst[MAX_WIDTH * 4];
+    uint16_t expected[MAX_WIDTH * 4];
+
+    for (unsigned iteration = 0; iteration < 100; iteration++) {
+        for (unsigned width = 0; width <= MAX_WIDTH; width++) {
+            fill_random_pixels(src, width, 65535);
+            fill_random_pixels(dst, width, 65535);
+
+            memcpy(expected, dst, width * 4 * sizeof(uint16_t));
+
+            for (unsigned i = 0; i < width; i++) {
+                reference_over_rgba64_pixel(expected + i * 4, src + i * 4);
+            }
+
+            blend_private_over_rgba64_row(dst, src, width);
+
+            munit_assert_memory_equal(width * 4 * sizeof(uint16_t), dst, expected);
+        }
+    }
+
+    return MUNIT_OK;
+}
+
+static MunitTest test_suite_tests[] = {
+    { (char *)"/over-rgba32-row", test_over_rgba32_row, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/over-rgba64-row", test_over_rgba64_row, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char *)"/blend",
+    test_suite_tests,
+    NULL,
+    1,
+    MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, NULL, argc, argv);
+}
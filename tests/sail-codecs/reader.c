@@ -0,0 +1,249 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2021 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "sail-common.h"
+#include "sail.h"
+
+#include "common/reader/reader.h"
+
+#include "munit.h"
+
+/* A few windows and a partial one. */
+#define DATA_SIZE (READER_BUFFER_SIZE * 3 + 777)
+
+static uint8_t data[DATA_SIZE];
+
+static void *setup(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    for (size_t i = 0; i < DATA_SIZE; i++) {
+        data[i] = (uint8_t)(i * 7 + i / 251);
+    }
+
+    struct sail_io *io;
+    munit_assert(sail_alloc_io_read_memory(data, DATA_SIZE, &io) == SAIL_OK);
+
+    return io;
+}
+
+static void tear_down(void *fixture) {
+
+    sail_destroy_io(fixture);
+}
+
+static size_t io_position(struct sail_io *io) {
+
+    size_t offset;
+    munit_assert(io->tell(io->stream, &offset) == SAIL_OK);
+
+    return offset;
+}
+
+static MunitResult test_read(const MunitParameter params[], void *fixture) {
+    (void)params;
+
+    struct sail_io *io = fixture;
+
+    struct reader reader;
+    reader_private_init(&reader, io);
+
+    /* Small reads crossing the window end, and large reads bypassing the window. */
+    static const size_t sizes[] = { 1, 3, READER_BUFFER_SIZE - 1, 17, READER_BUFFER_SIZE, 1, READER_BUFFER_SIZE + 100, 5 };
+    static uint8_t buf[READER_BUFFER_SIZE + 100];
+
+    size_t offset = 0;
+
+    for (size_t i = 0; offset < DATA_SIZE; i = (i + 1) % (sizeof(sizes) / sizeof(sizes[0]))) {
+        const size_t size = sizes[i] < DATA_SIZE - offset ? sizes[i] : DATA_SIZE - offset;
+
+        if (size == 1) {
+            munit_assert(reader_private_read_byte(&reader, buf) == SAIL_OK);
+        } else {
+            munit_assert(reader_private_read(&reader, buf, size) == SAIL_OK);
+        }
+
+        munit_assert_memory_equal(size, buf, data + offset);
+        offset += size;
+    }
+
+    /* End of data. */
+    uint8_t byte;
+    munit_assert(reader_private_read_byte(&reader, &byte) == SAIL_ERROR_READ_IO);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_read_past_end(const MunitParameter params[], void *fixture) {
+    (void)params;
+
+    struct sail_io *io = fixture;
+
+    struct reader reader;
+    reader_private_init(&reader, io);
+
+    munit_assert(reader_private_skip(&reader, DATA_SIZE - 10) == SAIL_OK);
+
+    uint8_t buf[11];
+    munit_assert(reader_private_read(&reader, buf, sizeof(buf)) != SAIL_OK);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_skip(const MunitParameter params[], void *fixture) {
+    (void)params;
+
+    struct sail_io *io = fixture;
+
+    struct reader reader;
+    reader_private_init(&reader, io);
+
+    uint8_t byte;
+    size_t offset = 0;
+
+    /* Skips inside the window, past the window end, and far away. */
+    static const size_t skips[] = { 0, 10, READER_BUFFER_SIZE - 20, 15, READER_BUFFER_SIZE * 2 };
+
+    for (size_t i = 0; i < sizeof(skips) / sizeof(skips[0]); i++) {
+        munit_assert(reader_private_skip(&reader, skips[i]) == SAIL_OK);
+        offset += skips[i];
+
+        munit_assert(reader_private_read_byte(&reader, &byte) == SAIL_OK);
+        munit_assert_uint8(byte, ==, data[offset]);
+        offset++;
+    }
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_sync(const MunitParameter params[], void *fixture) {
+    (void)params;
+
+    struct sail_io *io = fixture;
+
+    struct reader reader;
+    reader_private_init(&reader, io);
+
+    /* Nothing read. */
+    munit_assert(reader_private_sync(&reader) == SAIL_OK);
+    munit_assert_size(io_position(io), ==, 0);
+
+    /* The I/O position runs ahead of the reader while reading. */
+    uint8_t buf[100];
+    munit_assert(reader_private_read(&reader, buf, sizeof(buf)) == SAIL_OK);
+    munit_assert_size(io_position(io), >, sizeof(buf));
+
+    munit_assert(reader_private_sync(&reader) == SAIL_OK);
+    munit_assert_size(io_position(io), ==, sizeof(buf));
+
+    /* Reading continues from the synced position. */
+    uint8_t byte;
+    munit_assert(reader_private_read_byte(&reader, &byte) == SAIL_OK);
+    munit_assert_uint8(byte, ==, data[sizeof(buf)]);
+
+    munit_assert(reader_private_skip(&reader, READER_BUFFER_SIZE + 50) == SAIL_OK);
+    munit_assert(reader_private_read_byte(&reader, &byte) == SAIL_OK);
+    munit_assert(reader_private_sync(&reader) == SAIL_OK);
+    munit_assert_size(io_position(io), ==, sizeof(buf) + 1 + READER_BUFFER_SIZE + 50 + 1);
+
+    /* Codecs can read the I/O object directly after syncing. */
+    munit_assert(io->strict_read(io->stream, &byte, 1) == SAIL_OK);
+    munit_assert_uint8(byte, ==, data[sizeof(buf) + 1 + READER_BUFFER_SIZE + 50 + 1]);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_peek(const MunitParameter params[], void *fixture) {
+    (void)params;
+
+    struct sail_io *io = fixture;
+
+    struct reader reader;
+    reader_private_init(&reader, io);
+
+    uint8_t byte;
+
+    munit_assert(reader_private_peek_byte(&reader, 0, &byte) == SAIL_OK);
+    munit_assert_uint8(byte, ==, data[0]);
+    munit_assert(reader_private_peek_byte(&reader, 5, &byte) == SAIL_OK);
+    munit_assert_uint8(byte, ==, data[5]);
+
+    /* Peeking doesn't consume. */
+    munit_assert(reader_private_read_byte(&reader, &byte) == SAIL_OK);
+    munit_assert_uint8(byte, ==, data[0]);
+
+    /* Move close to the window end and peek past it. */
+    uint8_t buf[READER_BUFFER_SIZE - 3];
+    munit_assert(reader_private_read(&reader, buf, sizeof(buf)) == SAIL_OK);
+
+    const size_t offset = 1 + sizeof(buf);
+
+    munit_assert(reader_private_peek_byte(&reader, 10, &byte) == SAIL_OK);
+    munit_assert_uint8(byte, ==, data[offset + 10]);
+
+    munit_assert(reader_private_read_byte(&reader, &byte) == SAIL_OK);
+    munit_assert_uint8(byte, ==, data[offset]);
+
+    /* Unread. */
+    reader_private_unread_byte(&reader);
+    munit_assert(reader_private_read_byte(&reader, &byte) == SAIL_OK);
+    munit_assert_uint8(byte, ==, data[offset]);
+
+    /* Offsets must fit into the window. */
+    munit_assert(reader_private_peek_byte(&reader, READER_BUFFER_SIZE, &byte) == SAIL_ERROR_INVALID_ARGUMENT);
+
+    /* Peeking past the end of data. */
+    munit_assert(reader_private_skip(&reader, DATA_SIZE - offset - 1 - 2) == SAIL_OK);
+    munit_assert(reader_private_peek_byte(&reader, 1, &byte) == SAIL_OK);
+    munit_assert_uint8(byte, ==, data[DATA_SIZE - 1]);
+    munit_assert(reader_private_peek_byte(&reader, 2, &byte) == SAIL_ERROR_READ_IO);
+
+    return MUNIT_OK;
+}
+
+static MunitTest test_suite_tests[] = {
+    { (char *)"/read",          test_read,          setup, tear_down, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/read-past-end", test_read_past_end, setup, tear_down, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/skip",          test_skip,          setup, tear_down, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/sync",          test_sync,          setup, tear_down, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/peek",          test_peek,          setup, tear_down, MUNIT_TEST_OPTION_NONE, NULL },
+
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char *)"/reader",
+    test_suite_tests,
+    NULL,
+    1,
+    MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, NULL, argc, argv);
+}
@@ -24,6 +24,7 @@
 */
 
 #include <stddef.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
@@ -181,6 +182,74 @@ static MunitResult test_copy(const MunitParameter params[], void *user_data) {
     return MUNIT_OK;
 }
 
+static MunitResult test_erase_overwrite_copy_many(const MunitParameter params[], void *user_data) {
+
+    (void)params;
+    (void)user_data;
+
+    enum {
+        KEYS_COUNT = 1000
+    };
+
+    struct sail_hash_map *hash_map;
+    munit_assert(sail_alloc_hash_map(&hash_map) == SAIL_OK);
+
+    struct sail_variant *value;
+    munit_assert(sail_alloc_variant(&value) == SAIL_OK);
+
+    char key[32];
+    char string_value[64];
+
+    for (int i = 0; i < KEYS_COUNT; i++) {
+        snprintf(key, sizeof(key), "key-%d", i);
+        munit_assert(sail_set_variant_int(value, i) == SAIL_OK);
+        munit_assert(sail_put_hash_map(hash_map, key, value) == SAIL_OK);
+    }
+
+    /* Erase odd keys and overwrite even keys with larger values. */
+    for (int i = 0; i < KEYS_COUNT; i++) {
+        snprintf(key, sizeof(key), "key-%d", i);
+
+        if (i % 2 != 0) {
+            sail_erase_hash_map_key(hash_map, key);
+        } else {
+            snprintf(string_value, sizeof(string_value), "a rather long string value #%d", i);
+            munit_assert(sail_set_variant_string(value, string_value) == SAIL_OK);
+            munit_assert(sail_put_hash_map(hash_map, key, value) == SAIL_OK);
+        }
+    }
+
+    munit_assert(sail_hash_map_size(hash_map) == KEYS_COUNT / 2);
+
+    struct sail_hash_map *hash_map_copy;
+    munit_assert(sail_copy_hash_map(hash_map, &hash_map_copy) == SAIL_OK);
+    munit_assert(sail_test_compare_hash_maps(hash_map, hash_map_copy) == SAIL_OK);
+
+    /* The copy is independent. */
+    sail_clear_hash_map(hash_map);
+    munit_assert(sail_hash_map_size(hash_map) == 0);
+
+    for (int i = 0; i < KEYS_COUNT; i++) {
+        snprintf(key, sizeof(key), "key-%d", i);
+        const struct sail_variant *value_in_map = sail_hash_map_value(hash_map_copy, key);
+
+        if (i % 2 != 0) {
+            munit_assert_null(value_in_map);
+        } else {
+            snprintf(string_value, sizeof(string_value), "a rather long string value #%d", i);
+            munit_assert_not_null(value_in_map);
+            munit_assert_string_equal(sail_variant_to_string(value_in_map), string_value);
+        }
+    }
+
+    /* Cleanup. */
+    sail_destroy_variant(value);
+    sail_destroy_hash_map(hash_map_copy);
+    sail_destroy_hash_map(hash_map);
+
+    return MUNIT_OK;
+}
+
 static MunitResult test_overwrite(const MunitParameter params[], void *user_data) {
 
     (void)params;
@@ -221,6 +290,95 @@ static MunitResult test_overwrite(const MunitParameter params[], void *user_data
     return MUNIT_OK;
 }
 
+static bool capture_last_key(const char *key, const struct sail_variant *value, void *user_data) {
+
+    (void)value;
+
+    *(const char **)user_data = key;
+
+    return true;
+}
+
+static MunitResult test_put_from_same_map(const MunitParameter params[], void *user_data) {
+
+    (void)params;
+    (void)user_data;
+
+    struct sail_hash_map *hash_map;
+    munit_assert(sail_alloc_hash_map(&hash_map) == SAIL_OK);
+
+    char reference_value[200];
+    memset(reference_value, 'v', sizeof(reference_value) - 1);
+    reference_value[sizeof(reference_value) - 1] = '\0';
+
+    struct sail_variant *value;
+    munit_assert(sail_alloc_variant(&value) == SAIL_OK);
+    munit_assert(sail_set_variant_string(value, reference_value) == SAIL_OK);
+    munit_assert(sail_put_hash_map(hash_map, "k0", value) == SAIL_OK);
+    sail_destroy_variant(value);
+
+    /* New keys with values read from the same map. The arena grows many times. */
+    for (unsigned i = 1; i < 100; i++) {
+        char key[16];
+        char previous_key[16];
+        snprintf(key, sizeof(key), "k%u", i);
+        snprintf(previous_key, sizeof(previous_key), "k%u", i - 1);
+
+        munit_assert(sail_put_hash_map(hash_map, key, sail_hash_map_value(hash_map, previous_key)) == SAIL_OK);
+    }
+
+    munit_assert(sail_hash_map_size(hash_map) == 100);
+
+    for (unsigned i = 0; i < 100; i++) {
+        char key[16];
+        snprintf(key, sizeof(key), "k%u", i);
+
+        munit_assert_string_equal(sail_variant_to_string(sail_hash_map_value(hash_map, key)), reference_value);
+    }
+
+    /* Overwrite a small value with a bigger value read from the same map. */
+    munit_assert(sail_alloc_variant(&value) == SAIL_OK);
+    munit_assert(sail_set_variant_int(value, 5) == SAIL_OK);
+    munit_assert(sail_put_hash_map(hash_map, "small", value) == SAIL_OK);
+    sail_destroy_variant(value);
+
+    for (unsigned i = 0; i < 100; i++) {
+        munit_assert(sail_put_hash_map(hash_map, "small", sail_hash_map_value(hash_map, "k0")) == SAIL_OK);
+
+        /* Grow the data with another value, so the next overwrite reallocates again. */
+        char key[16];
+        snprintf(key, sizeof(key), "small%u", i);
+        munit_assert(sail_put_hash_map(hash_map, key, sail_hash_map_value(hash_map, "small")) == SAIL_OK);
+
+        munit_assert(sail_alloc_variant(&value) == SAIL_OK);
+        munit_assert(sail_set_variant_int(value, (int)i) == SAIL_OK);
+        munit_assert(sail_put_hash_map(hash_map, "small", value) == SAIL_OK);
+        sail_destroy_variant(value);
+    }
+
+    munit_assert_string_equal(sail_variant_to_string(sail_hash_map_value(hash_map, "small99")), reference_value);
+
+    /* New keys pointing into the map: suffixes of the last key. */
+    munit_assert(sail_put_hash_map(hash_map, "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789", sail_hash_map_value(hash_map, "k0")) == SAIL_OK);
+
+    for (unsigned i = 0; i < 60; i++) {
+        const char *last_key = NULL;
+        sail_traverse_hash_map_with_user_data(hash_map, capture_last_key, &last_key);
+        munit_assert_not_null(last_key);
+
+        char expected_key[64];
+        snprintf(expected_key, sizeof(expected_key), "%s", last_key + 1);
+
+        munit_assert(sail_put_hash_map(hash_map, last_key + 1, sail_hash_map_value(hash_map, "k0")) == SAIL_OK);
+        munit_assert(sail_hash_map_has_key(hash_map, expected_key));
+    }
+
+    /* Cleanup. */
+    sail_destroy_hash_map(hash_map);
+
+    return MUNIT_OK;
+}
+
 static MunitResult test_erase(const MunitParameter params[], void *user_data) {
 
     (void)params;
@@ -296,12 +454,14 @@ static MunitResult test_clear(const MunitParameter params[], void *user_data) {
 }
 
 static MunitTest test_suite_tests[] = {
-    { (char *)"/put",            test_put,            NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
-    { (char *)"/put-erase-many", test_put_erase_many, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
-    { (char *)"/copy",           test_copy,           NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
-    { (char *)"/overwrite",      test_overwrite,      NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
-    { (char *)"/erase",          test_erase,          NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
-    { (char *)"/clear",          test_clear,          NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/put",                       test_put,                       NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/put-erase-many",            test_put_erase_many,            NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/copy",                      test_copy,                      NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/overwrite",                 test_overwrite,                 NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/put-from-same-map",         test_put_from_same_map,         NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/erase",                     test_erase,                     NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/erase-overwrite-copy-many", test_erase_overwrite_copy_many, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/clear",                     test_clear,                     NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
 
     { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
 };
@@ -550,6 +550,8 @@ static MunitResult test_codec_feature_to_string(const MunitParameter params[], v
     munit_assert_string_equal(sail_codec_feature_to_string(SAIL_CODEC_FEATURE_META_DATA),   "META-DATA");
     munit_assert_string_equal(sail_codec_feature_to_string(SAIL_CODEC_FEATURE_INTERLACED),  "INTERLACED");
     munit_assert_string_equal(sail_codec_feature_to_string(SAIL_CODEC_FEATURE_ICCP),        "ICCP");
+    munit_assert_string_equal(sail_codec_feature_to_string(SAIL_CODEC_FEATURE_CUSTOM_BYTES_PER_LINE), "CUSTOM-BYTES-PER-LINE");
+    munit_assert_string_equal(sail_codec_feature_to_string(SAIL_CODEC_FEATURE_ROWS),        "ROWS");
 
     return MUNIT_OK;
 }
@@ -568,6 +570,8 @@ static MunitResult test_codec_feature_from_string(const MunitParameter params[],
     munit_assert(sail_codec_feature_from_string("META-DATA")   == SAIL_CODEC_FEATURE_META_DATA);
     munit_assert(sail_codec_feature_from_string("INTERLACED")  == SAIL_CODEC_FEATURE_INTERLACED);
     munit_assert(sail_codec_feature_from_string("ICCP")        == SAIL_CODEC_FEATURE_ICCP);
+    munit_assert(sail_codec_feature_from_string("CUSTOM-BYTES-PER-LINE") == SAIL_CODEC_FEATURE_CUSTOM_BYTES_PER_LINE);
+    munit_assert(sail_codec_feature_from_string("ROWS")        == SAIL_CODEC_FEATURE_ROWS);
 
     return MUNIT_OK;
 }
@@ -36,6 +36,10 @@ static MunitResult test_alloc_options(const MunitParameter params[], void *user_
     munit_assert_not_null(load_options);
     munit_assert(load_options->options == 0);
     munit_assert_null(load_options->tuning);
+    munit_assert_null(load_options->pixel_allocator);
+    munit_assert(load_options->pixel_format == SAIL_PIXEL_FORMAT_UNKNOWN);
+    munit_assert(load_options->max_width == 0);
+    munit_assert(load_options->max_height == 0);
 
     sail_destroy_load_options(load_options);
 
@@ -51,15 +55,27 @@ static MunitResult test_copy_options(const MunitParameter params[], void *user_d
 
     load_options->options = SAIL_OPTION_ICCP;
 
+    struct sail_pixel_pool *pixel_pool;
+    munit_assert(sail_alloc_pixel_pool(0, &pixel_pool) == SAIL_OK);
+    load_options->pixel_allocator = sail_pixel_pool_allocator(pixel_pool);
+    load_options->pixel_format    = SAIL_PIXEL_FORMAT_BPP32_BGRA;
+    load_options->max_width       = 640;
+    load_options->max_height      = 480;
+
     struct sail_load_options *load_options_copy = NULL;
     munit_assert(sail_copy_load_options(load_options, &load_options_copy) == SAIL_OK);
     munit_assert_not_null(load_options_copy);
 
     munit_assert(load_options_copy->options == load_options->options);
     munit_assert_null(load_options_copy->tuning);
+    munit_assert_ptr_equal(load_options_copy->pixel_allocator, load_options->pixel_allocator);
+    munit_assert(load_options_copy->pixel_format == load_options->pixel_format);
+    munit_assert(load_options_copy->max_width == load_options->max_width);
+    munit_assert(load_options_copy->max_height == load_options->max_height);
 
     sail_destroy_load_options(load_options_copy);
     sail_destroy_load_options(load_options);
+    sail_destroy_pixel_pool(pixel_pool);
 
     return MUNIT_OK;
 }
@@ -81,10 +97,42 @@ static MunitResult test_options_from_features(const MunitParameter params[], voi
     return MUNIT_OK;
 }
 
+static MunitResult test_scale_denominator(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    struct sail_load_options *load_options = NULL;
+    munit_assert(sail_alloc_load_options(&load_options) == SAIL_OK);
+
+    /* No limit. */
+    munit_assert(sail_scale_denominator_from_load_options(load_options, 4000, 3000, 8) == 1);
+
+    /* Already fits. */
+    load_options->max_width  = 4000;
+    load_options->max_height = 3000;
+    munit_assert(sail_scale_denominator_from_load_options(load_options, 4000, 3000, 8) == 1);
+
+    /* The fitted image is 400x300, so 1/8 gives 500x375. */
+    load_options->max_width  = 400;
+    load_options->max_height = 400;
+    munit_assert(sail_scale_denominator_from_load_options(load_options, 4000, 3000, 8) == 8);
+    munit_assert(sail_scale_denominator_from_load_options(load_options, 4000, 3000, 4) == 4);
+
+    /* The height is the most constraining dimension. */
+    load_options->max_width  = 0;
+    load_options->max_height = 1000;
+    munit_assert(sail_scale_denominator_from_load_options(load_options, 4000, 3000, 8) == 2);
+
+    sail_destroy_load_options(load_options);
+
+    return MUNIT_OK;
+}
+
 static MunitTest test_suite_tests[] = {
     { (char *)"/alloc", test_alloc_options, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
     { (char *)"/copy", test_copy_options, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
     { (char *)"/from-features", test_options_from_features, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/scale-denominator", test_scale_denominator, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
 
     { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
 };
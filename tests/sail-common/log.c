@@ -0,0 +1,144 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2020 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "sail-common.h"
+
+#include "munit.h"
+
+static unsigned logged_count;
+static char logged_text[16][64];
+
+static void test_logger(enum SailLogLevel level, const char *file, int line, const char *format, va_list args) {
+    (void)level;
+    (void)file;
+    (void)line;
+
+    if (logged_count < sizeof(logged_text) / sizeof(logged_text[0])) {
+        vsnprintf(logged_text[logged_count], sizeof(logged_text[0]), format, args);
+    }
+
+    logged_count++;
+}
+
+static MunitResult test_lazy_arguments(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    /* Warnings and errors are compiled out. */
+    if (SAIL_MIN_LOG_LEVEL < SAIL_LOG_LEVEL_WARNING) {
+        return MUNIT_SKIP;
+    }
+
+    logged_count = 0;
+    sail_set_logger(test_logger);
+    sail_set_log_barrier(SAIL_LOG_LEVEL_WARNING);
+
+    int evaluated = 0;
+
+    /* Filtered out messages don't evaluate their arguments. */
+    SAIL_LOG_DEBUG("%d", ++evaluated);
+    munit_assert_int(evaluated, ==, 0);
+    munit_assert_uint(logged_count, ==, 0);
+
+    SAIL_LOG_WARNING("%d", ++evaluated);
+    munit_assert_int(evaluated, ==, 1);
+    munit_assert_uint(logged_count, ==, 1);
+    munit_assert_string_equal(logged_text[0], "1");
+
+    /* Usable in expressions. */
+    evaluated ? SAIL_LOG_ERROR("error") : SAIL_LOG_INFO("info");
+    munit_assert_uint(logged_count, ==, 2);
+    munit_assert_string_equal(logged_text[1], "error");
+
+    sail_set_log_barrier(SAIL_LOG_LEVEL_DEBUG);
+    sail_set_logger(NULL);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_async(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+#ifdef SAIL_THREAD_SAFE
+    /* Errors are compiled out. */
+    if (SAIL_MIN_LOG_LEVEL < SAIL_LOG_LEVEL_ERROR) {
+        return MUNIT_SKIP;
+    }
+
+    logged_count = 0;
+    sail_set_logger(test_logger);
+
+    munit_assert(sail_start_async_logging(0) == SAIL_ERROR_INVALID_ARGUMENT);
+    munit_assert(sail_start_async_logging(32) == SAIL_OK);
+    munit_assert(sail_start_async_logging(32) == SAIL_ERROR_CONFLICTING_OPERATION);
+
+    for (int i = 0; i < 10; i++) {
+        SAIL_LOG_ERROR("message %d", i);
+    }
+
+    /* Stopping writes all the queued messages. */
+    munit_assert(sail_stop_async_logging() == SAIL_OK);
+    munit_assert(sail_stop_async_logging() == SAIL_OK);
+
+    /* The failed starts log two errors each. */
+    munit_assert_uint(logged_count, ==, 14);
+
+    for (int i = 0; i < 10; i++) {
+        char expected[64];
+        snprintf(expected, sizeof(expected), "message %d", i);
+        munit_assert_string_equal(logged_text[i + 4], expected);
+    }
+
+    sail_set_logger(NULL);
+#else
+    munit_assert(sail_start_async_logging(32) == SAIL_ERROR_NOT_IMPLEMENTED);
+#endif
+
+    return MUNIT_OK;
+}
+
+static MunitTest test_suite_tests[] = {
+    { (char *)"/lazy-arguments", test_lazy_arguments, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/async",          test_async,          NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char *)"/log",
+    test_suite_tests,
+    NULL,
+    1,
+    MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, NULL, argc, argv);
+}
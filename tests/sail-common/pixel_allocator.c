@@ -0,0 +1,159 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stdint.h>
+#include <string.h>
+
+#include "sail-common.h"
+
+#include "munit.h"
+
+static MunitResult test_default_allocator(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    void *pixels = NULL;
+    munit_assert(sail_alloc_pixels(NULL, 1000, &pixels) == SAIL_OK);
+    munit_assert_not_null(pixels);
+
+    memset(pixels, 0, 1000);
+    sail_free_pixels(NULL, pixels);
+    sail_free_pixels(NULL, NULL);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_pool_reuse(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    struct sail_pixel_pool *pixel_pool;
+    munit_assert(sail_alloc_pixel_pool(64 * 1024 * 1024, &pixel_pool) == SAIL_OK);
+
+    const struct sail_pixel_allocator *pixel_allocator = sail_pixel_pool_allocator(pixel_pool);
+    munit_assert_not_null(pixel_allocator);
+
+    const size_t sizes[] = { 1, 100, 4096, 4097, 100000, 1000001, 3 * 1024 * 1024 };
+
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        void *pixels1;
+        munit_assert(sail_alloc_pixels(pixel_allocator, sizes[i], &pixels1) == SAIL_OK);
+        munit_assert((uintptr_t)pixels1 % SAIL_PIXEL_POOL_ALIGNMENT == 0);
+        memset(pixels1, 0xFF, sizes[i]);
+
+        /* Another buffer while the first one is in use. */
+        void *pixels2;
+        munit_assert(sail_alloc_pixels(pixel_allocator, sizes[i], &pixels2) == SAIL_OK);
+        munit_assert_ptr_not_equal(pixels1, pixels2);
+
+        sail_free_pixels(pixel_allocator, pixels1);
+
+        /* The freed buffer is reused. */
+        void *pixels3;
+        munit_assert(sail_alloc_pixels(pixel_allocator, sizes[i], &pixels3) == SAIL_OK);
+        munit_assert_ptr_equal(pixels3, pixels1);
+
+        sail_free_pixels(pixel_allocator, pixels2);
+        sail_free_pixels(pixel_allocator, pixels3);
+    }
+
+    /* Smaller buffer of the same size class reuses the freed one. */
+    void *pixels1;
+    munit_assert(sail_alloc_pixels(pixel_allocator, 5000, &pixels1) == SAIL_OK);
+    sail_free_pixels(pixel_allocator, pixels1);
+
+    void *pixels2;
+    munit_assert(sail_alloc_pixels(pixel_allocator, 4700, &pixels2) == SAIL_OK);
+    munit_assert_ptr_equal(pixels2, pixels1);
+    sail_free_pixels(pixel_allocator, pixels2);
+
+    sail_destroy_pixel_pool(pixel_pool);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_pool_cache_limit(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    /* Nothing is cached. */
+    struct sail_pixel_pool *pixel_pool;
+    munit_assert(sail_alloc_pixel_pool(0, &pixel_pool) == SAIL_OK);
+
+    const struct sail_pixel_allocator *pixel_allocator = sail_pixel_pool_allocator(pixel_pool);
+
+    for (int i = 0; i < 10; i++) {
+        void *pixels;
+        munit_assert(sail_alloc_pixels(pixel_allocator, 50000, &pixels) == SAIL_OK);
+        munit_assert((uintptr_t)pixels % SAIL_PIXEL_POOL_ALIGNMENT == 0);
+        sail_free_pixels(pixel_allocator, pixels);
+    }
+
+    sail_destroy_pixel_pool(pixel_pool);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_pool_outlived_by_image(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    struct sail_pixel_pool *pixel_pool;
+    munit_assert(sail_alloc_pixel_pool(1024 * 1024, &pixel_pool) == SAIL_OK);
+
+    struct sail_image *image;
+    munit_assert(sail_alloc_image(&image) == SAIL_OK);
+
+    image->pixel_allocator = sail_pixel_pool_allocator(pixel_pool);
+    munit_assert(sail_alloc_pixels(image->pixel_allocator, 10000, &image->pixels) == SAIL_OK);
+
+    /* The pool is released when the image is destroyed. */
+    sail_destroy_pixel_pool(pixel_pool);
+    memset(image->pixels, 0, 10000);
+    sail_destroy_image(image);
+
+    return MUNIT_OK;
+}
+
+static MunitTest test_suite_tests[] = {
+    { (char *)"/default-allocator",     test_default_allocator,      NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/pool-reuse",            test_pool_reuse,             NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/pool-cache-limit",      test_pool_cache_limit,       NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/pool-outlived-by-image", test_pool_outlived_by_image, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char *)"/pixel-allocator",
+    test_suite_tests,
+    NULL,
+    1,
+    MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, NULL, argc, argv);
+}
@@ -0,0 +1,341 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sail-common.h"
+#include "sail-manip.h"
+
+#include "munit.h"
+
+/*
+ * Reference implementations reproducing the former lookup table conversions.
+ * Every table entry was rounded separately.
+ */
+
+static int round_to_int(double value) {
+
+    return value < 0 ? -(int)(-value + 0.5) : (int)(value + 0.5);
+}
+
+static uint8_t clamp_to_uint8(int value) {
+
+    return (uint8_t)(value < 0 ? 0 : (value > 255 ? 255 : value));
+}
+
+static void reference_ycbcr_to_rgb(uint8_t y, uint8_t cb, uint8_t cr, uint8_t rgb[3]) {
+
+    rgb[0] = clamp_to_uint8(y                                      + round_to_int(1.40200 * (cr - 128)));
+    rgb[1] = clamp_to_uint8(y - round_to_int(0.34414 * (cb - 128)) - round_to_int(0.71414 * (cr - 128)));
+    rgb[2] = clamp_to_uint8(y + round_to_int(1.77200 * (cb - 128)));
+}
+
+/* The tables overflowed to 0 instead of 256 for the maximum chroma. Clamp here instead. */
+static void reference_rgb_to_ycbcr(uint8_t r, uint8_t g, uint8_t b, uint8_t ycbcr[3]) {
+
+    ycbcr[0] = clamp_to_uint8(        round_to_int(0.299000 * r) + round_to_int(0.587000 * g) + round_to_int(0.114000 * b));
+    ycbcr[1] = clamp_to_uint8(128 -   round_to_int(0.168736 * r) - round_to_int(0.331264 * g) + round_to_int(0.500000 * b));
+    ycbcr[2] = clamp_to_uint8(128 +   round_to_int(0.500000 * r) - round_to_int(0.418688 * g) - round_to_int(0.081312 * b));
+}
+
+static uint8_t reference_cmyk_component(uint8_t c, uint8_t k) {
+
+    return (uint8_t)((double)c * k / 255.0 + 0.5);
+}
+
+static void reference_ycck_to_rgb(uint8_t y, uint8_t cb, uint8_t cr, uint8_t k, uint8_t rgb[3]) {
+
+    const double r = y                             + round_to_int(1.40200 * cr) - 179.45600;
+    const double g = y - round_to_int(0.34414 * cb) - round_to_int(0.71414 * cr) + 135.45984;
+    const double b = y + round_to_int(1.77200 * cb)                              - 226.81600;
+
+    rgb[0] = reference_cmyk_component((uint8_t)(255 - (uint8_t)(r < 0 ? 0 : (r > 255 ? 255 : r))), k);
+    rgb[1] = reference_cmyk_component((uint8_t)(255 - (uint8_t)(g < 0 ? 0 : (g > 255 ? 255 : g))), k);
+    rgb[2] = reference_cmyk_component((uint8_t)(255 - (uint8_t)(b < 0 ? 0 : (b > 255 ? 255 : b))), k);
+}
+
+static struct sail_image* alloc_image(enum SailPixelFormat pixel_format, unsigned width, unsigned height) {
+
+    struct sail_image *image;
+    munit_assert(sail_alloc_image(&image) == SAIL_OK);
+
+    image->width = width;
+    image->height = height;
+    image->pixel_format = pixel_format;
+    munit_assert(sail_bytes_per_line(image->width, image->pixel_format, &image->bytes_per_line) == SAIL_OK);
+    munit_assert(sail_malloc((size_t)image->bytes_per_line * image->height, &image->pixels) == SAIL_OK);
+
+    return image;
+}
+
+static struct sail_image* random_image(enum SailPixelFormat pixel_format, unsigned width, unsigned height) {
+
+    struct sail_image *image = alloc_image(pixel_format, width, height);
+
+    munit_rand_memory((size_t)image->bytes_per_line * image->height, image->pixels);
+
+    return image;
+}
+
+static struct sail_image* convert(const struct sail_image *image, enum SailPixelFormat output_pixel_format) {
+
+    struct sail_image *image_output;
+    munit_assert(sail_convert_image(image, output_pixel_format, &image_output) == SAIL_OK);
+
+    return image_output;
+}
+
+static void assert_close(unsigned actual, unsigned expected, unsigned tolerance) {
+
+    munit_assert_uint(actual + tolerance, >=, expected);
+    munit_assert_uint(actual, <=, expected + tolerance);
+}
+
+/*
+ * Every possible YCbCr value. The rows hold all Cb and Cr pairs for a Y value.
+ */
+static MunitResult test_ycbcr_to_rgb(const MunitParameter params[], void *user_data) {
+
+    (void)params;
+    (void)user_data;
+
+    struct sail_image *image = alloc_image(SAIL_PIXEL_FORMAT_BPP24_YCBCR, 256 * 256, 256);
+
+    for (unsigned y = 0; y < 256; y++) {
+        uint8_t *scan = (uint8_t *)image->pixels + image->bytes_per_line * y;
+
+        for (unsigned cbcr = 0; cbcr < 256 * 256; cbcr++) {
+            *scan++ = (uint8_t)y;
+            *scan++ = (uint8_t)(cbcr >> 8);
+            *scan++ = (uint8_t)(cbcr & 0xFF);
+        }
+    }
+
+    struct sail_image *image_output = convert(image, SAIL_PIXEL_FORMAT_BPP32_RGBA);
+
+    for (unsigned y = 0; y < 256; y++) {
+        const uint8_t *scan_input = (uint8_t *)image->pixels + image->bytes_per_line * y;
+        const uint8_t *scan_output = (uint8_t *)image_output->pixels + image_output->bytes_per_line * y;
+
+        for (unsigned column = 0; column < image->width; column++, scan_input += 3, scan_output += 4) {
+            uint8_t rgb[3];
+            reference_ycbcr_to_rgb(scan_input[0], scan_input[1], scan_input[2], rgb);
+
+            assert_close(scan_output[0], rgb[0], 1);
+            assert_close(scan_output[1], rgb[1], 1);
+            assert_close(scan_output[2], rgb[2], 1);
+            munit_assert_uint8(scan_output[3], ==, 255);
+        }
+    }
+
+    sail_destroy_image(image_output);
+    sail_destroy_image(image);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_rgb_to_ycbcr(const MunitParameter params[], void *user_data) {
+
+    (void)params;
+    (void)user_data;
+
+    /* Every R and G pair with random B values. */
+    struct sail_image *image = random_image(SAIL_PIXEL_FORMAT_BPP32_RGBA, 256, 256);
+
+    for (unsigned row = 0; row < image->height; row++) {
+        uint8_t *scan = (uint8_t *)image->pixels + image->bytes_per_line * row;
+
+        for (unsigned column = 0; column < image->width; column++, scan += 4) {
+            scan[0] = (uint8_t)row;
+            scan[1] = (uint8_t)column;
+        }
+    }
+
+    struct sail_image *image_output = convert(image, SAIL_PIXEL_FORMAT_BPP24_YCBCR);
+
+    for (unsigned row = 0; row < image->height; row++) {
+        const uint8_t *scan_input = (uint8_t *)image->pixels + image->bytes_per_line * row;
+        const uint8_t *scan_output = (uint8_t *)image_output->pixels + image_output->bytes_per_line * row;
+
+        for (unsigned column = 0; column < image->width; column++, scan_input += 4, scan_output += 3) {
+            uint8_t ycbcr[3];
+            reference_rgb_to_ycbcr(scan_input[0], scan_input[1], scan_input[2], ycbcr);
+
+            assert_close(scan_output[0], ycbcr[0], 1);
+            assert_close(scan_output[1], ycbcr[1], 1);
+            assert_close(scan_output[2], ycbcr[2], 1);
+        }
+    }
+
+    sail_destroy_image(image_output);
+    sail_destroy_image(image);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_cmyk_to_rgb(const MunitParameter params[], void *user_data) {
+
+    (void)params;
+    (void)user_data;
+
+    /* Every C and K pair with random M and Y values. */
+    struct sail_image *image = random_image(SAIL_PIXEL_FORMAT_BPP32_CMYK, 256, 256);
+
+    for (unsigned row = 0; row < image->height; row++) {
+        uint8_t *scan = (uint8_t *)image->pixels + image->bytes_per_line * row;
+
+        for (unsigned column = 0; column < image->width; column++, scan += 4) {
+            scan[0] = (uint8_t)column;
+            scan[3] = (uint8_t)row;
+        }
+    }
+
+    struct sail_image *image_output = convert(image, SAIL_PIXEL_FORMAT_BPP32_RGBA);
+
+    for (unsigned row = 0; row < image->height; row++) {
+        const uint8_t *scan_input = (uint8_t *)image->pixels + image->bytes_per_line * row;
+        const uint8_t *scan_output = (uint8_t *)image_output->pixels + image_output->bytes_per_line * row;
+
+        for (unsigned column = 0; column < image->width; column++, scan_input += 4, scan_output += 4) {
+            munit_assert_uint8(scan_output[0], ==, reference_cmyk_component(scan_input[0], scan_input[3]));
+            munit_assert_uint8(scan_output[1], ==, reference_cmyk_component(scan_input[1], scan_input[3]));
+            munit_assert_uint8(scan_output[2], ==, reference_cmyk_component(scan_input[2], scan_input[3]));
+            munit_assert_uint8(scan_output[3], ==, 255);
+        }
+    }
+
+    sail_destroy_image(image_output);
+    sail_destroy_image(image);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_ycck_to_rgb(const MunitParameter params[], void *user_data) {
+
+    (void)params;
+    (void)user_data;
+
+    struct sail_image *image = random_image(SAIL_PIXEL_FORMAT_BPP32_YCCK, 1024, 256);
+    struct sail_image *image_output = convert(image, SAIL_PIXEL_FORMAT_BPP32_RGBA);
+
+    for (unsigned row = 0; row < image->height; row++) {
+        const uint8_t *scan_input = (uint8_t *)image->pixels + image->bytes_per_line * row;
+        const uint8_t *scan_output = (uint8_t *)image_output->pixels + image_output->bytes_per_line * row;
+
+        for (unsigned column = 0; column < image->width; column++, scan_input += 4, scan_output += 4) {
+            uint8_t rgb[3];
+            reference_ycck_to_rgb(scan_input[0], scan_input[1], scan_input[2], scan_input[3], rgb);
+
+            assert_close(scan_output[0], rgb[0], 1);
+            assert_close(scan_output[1], rgb[1], 1);
+            assert_close(scan_output[2], rgb[2], 1);
+            munit_assert_uint8(scan_output[3], ==, 255);
+        }
+    }
+
+    sail_destroy_image(image_output);
+    sail_destroy_image(image);
+
+    return MUNIT_OK;
+}
+
+/*
+ * SIMD converts leading pixels and scalar code converts the rest. Converting every pixel
+ * separately must produce the same result.
+ */
+static MunitResult test_simd_same_as_scalar(const MunitParameter params[], void *user_data) {
+
+    (void)params;
+    (void)user_data;
+
+    const enum SailPixelFormat pairs[][2] = {
+        { SAIL_PIXEL_FORMAT_BPP24_YCBCR, SAIL_PIXEL_FORMAT_BPP32_RGBA },
+        { SAIL_PIXEL_FORMAT_BPP24_YCBCR, SAIL_PIXEL_FORMAT_BPP24_BGR },
+        { SAIL_PIXEL_FORMAT_BPP24_YCBCR, SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE },
+        { SAIL_PIXEL_FORMAT_BPP32_CMYK,  SAIL_PIXEL_FORMAT_BPP32_RGBA },
+        { SAIL_PIXEL_FORMAT_BPP32_CMYK,  SAIL_PIXEL_FORMAT_BPP24_RGB },
+        { SAIL_PIXEL_FORMAT_BPP32_YCCK,  SAIL_PIXEL_FORMAT_BPP32_RGBA },
+        { SAIL_PIXEL_FORMAT_BPP32_YCCK,  SAIL_PIXEL_FORMAT_BPP64_RGBA },
+        { SAIL_PIXEL_FORMAT_BPP32_RGBA,  SAIL_PIXEL_FORMAT_BPP24_YCBCR },
+        { SAIL_PIXEL_FORMAT_BPP24_BGR,   SAIL_PIXEL_FORMAT_BPP24_YCBCR },
+        { SAIL_PIXEL_FORMAT_BPP64_RGBA,  SAIL_PIXEL_FORMAT_BPP24_YCBCR },
+    };
+
+    for (size_t i = 0; i < sizeof(pairs) / sizeof(pairs[0]); i++) {
+        struct sail_image *image = random_image(pairs[i][0], 37, 2);
+        struct sail_image *image_output = convert(image, pairs[i][1]);
+
+        unsigned input_bits_per_pixel;
+        unsigned output_bits_per_pixel;
+        munit_assert(sail_bits_per_pixel(image->pixel_format, &input_bits_per_pixel) == SAIL_OK);
+        munit_assert(sail_bits_per_pixel(image_output->pixel_format, &output_bits_per_pixel) == SAIL_OK);
+
+        struct sail_image *pixel = alloc_image(pairs[i][0], 1, 1);
+
+        for (unsigned row = 0; row < image->height; row++) {
+            for (unsigned column = 0; column < image->width; column++) {
+                memcpy(pixel->pixels, (uint8_t *)image->pixels + image->bytes_per_line * row + column * input_bits_per_pixel / 8, input_bits_per_pixel / 8);
+
+                struct sail_image *pixel_output = convert(pixel, pairs[i][1]);
+
+                munit_assert_memory_equal(output_bits_per_pixel / 8,
+                                            pixel_output->pixels,
+                                            (uint8_t *)image_output->pixels + image_output->bytes_per_line * row + column * output_bits_per_pixel / 8);
+
+                sail_destroy_image(pixel_output);
+            }
+        }
+
+        sail_destroy_image(pixel);
+        sail_destroy_image(image_output);
+        sail_destroy_image(image);
+    }
+
+    return MUNIT_OK;
+}
+
+static MunitTest test_suite_tests[] = {
+    { (char *)"/ycbcr-to-rgb", test_ycbcr_to_rgb, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/rgb-to-ycbcr", test_rgb_to_ycbcr, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/cmyk-to-rgb",  test_cmyk_to_rgb,  NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/ycck-to-rgb",  test_ycck_to_rgb,  NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/simd-same-as-scalar", test_simd_same_as_scalar, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char *)"/color",
+    test_suite_tests,
+    NULL,
+    1,
+    MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, NULL, argc, argv);
+}
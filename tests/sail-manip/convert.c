@@ -0,0 +1,462 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "sail-common.h"
+#include "sail-manip.h"
+
+#include "munit.h"
+
+/* Formats with exact integer conversions between each other. */
+static const enum SailPixelFormat INPUT_PIXEL_FORMATS[] = {
+    SAIL_PIXEL_FORMAT_BPP8_GRAYSCALE,
+    SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE,
+    SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE_ALPHA,
+    SAIL_PIXEL_FORMAT_BPP32_GRAYSCALE_ALPHA,
+    SAIL_PIXEL_FORMAT_BPP24_RGB,
+    SAIL_PIXEL_FORMAT_BPP24_BGR,
+    SAIL_PIXEL_FORMAT_BPP48_RGB,
+    SAIL_PIXEL_FORMAT_BPP48_BGR,
+    SAIL_PIXEL_FORMAT_BPP32_RGBX,
+    SAIL_PIXEL_FORMAT_BPP32_BGRX,
+    SAIL_PIXEL_FORMAT_BPP32_XRGB,
+    SAIL_PIXEL_FORMAT_BPP32_XBGR,
+    SAIL_PIXEL_FORMAT_BPP32_RGBA,
+    SAIL_PIXEL_FORMAT_BPP32_BGRA,
+    SAIL_PIXEL_FORMAT_BPP32_ARGB,
+    SAIL_PIXEL_FORMAT_BPP32_ABGR,
+    SAIL_PIXEL_FORMAT_BPP64_RGBX,
+    SAIL_PIXEL_FORMAT_BPP64_BGRX,
+    SAIL_PIXEL_FORMAT_BPP64_XRGB,
+    SAIL_PIXEL_FORMAT_BPP64_XBGR,
+    SAIL_PIXEL_FORMAT_BPP64_RGBA,
+    SAIL_PIXEL_FORMAT_BPP64_BGRA,
+    SAIL_PIXEL_FORMAT_BPP64_ARGB,
+    SAIL_PIXEL_FORMAT_BPP64_ABGR,
+};
+
+static const enum SailPixelFormat OUTPUT_PIXEL_FORMATS[] = {
+    SAIL_PIXEL_FORMAT_BPP24_RGB,
+    SAIL_PIXEL_FORMAT_BPP24_BGR,
+    SAIL_PIXEL_FORMAT_BPP48_RGB,
+    SAIL_PIXEL_FORMAT_BPP48_BGR,
+    SAIL_PIXEL_FORMAT_BPP32_RGBX,
+    SAIL_PIXEL_FORMAT_BPP32_BGRX,
+    SAIL_PIXEL_FORMAT_BPP32_RGBA,
+    SAIL_PIXEL_FORMAT_BPP32_BGRA,
+    SAIL_PIXEL_FORMAT_BPP32_ARGB,
+    SAIL_PIXEL_FORMAT_BPP32_ABGR,
+    SAIL_PIXEL_FORMAT_BPP64_RGBA,
+    SAIL_PIXEL_FORMAT_BPP64_BGRA,
+    SAIL_PIXEL_FORMAT_BPP64_ARGB,
+    SAIL_PIXEL_FORMAT_BPP64_ABGR,
+};
+
+struct layout {
+    unsigned component_size;
+    unsigned components;
+    int r;
+    int g;
+    int b;
+    int a;
+};
+
+static struct layout pixel_format_layout(enum SailPixelFormat pixel_format) {
+
+    switch (pixel_format) {
+        case SAIL_PIXEL_FORMAT_BPP8_GRAYSCALE:         return (struct layout) { 1, 1, 0, 0, 0, -1 };
+        case SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE:        return (struct layout) { 2, 1, 0, 0, 0, -1 };
+        case SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE_ALPHA:  return (struct layout) { 1, 2, 0, 0, 0,  1 };
+        case SAIL_PIXEL_FORMAT_BPP32_GRAYSCALE_ALPHA:  return (struct layout) { 2, 2, 0, 0, 0,  1 };
+        case SAIL_PIXEL_FORMAT_BPP24_RGB:              return (struct layout) { 1, 3, 0, 1, 2, -1 };
+        case SAIL_PIXEL_FORMAT_BPP24_BGR:              return (struct layout) { 1, 3, 2, 1, 0, -1 };
+        case SAIL_PIXEL_FORMAT_BPP48_RGB:              return (struct layout) { 2, 3, 0, 1, 2, -1 };
+        case SAIL_PIXEL_FORMAT_BPP48_BGR:              return (struct layout) { 2, 3, 2, 1, 0, -1 };
+        case SAIL_PIXEL_FORMAT_BPP32_RGBX:             return (struct layout) { 1, 4, 0, 1, 2, -1 };
+        case SAIL_PIXEL_FORMAT_BPP32_BGRX:             return (struct layout) { 1, 4, 2, 1, 0, -1 };
+        case SAIL_PIXEL_FORMAT_BPP32_XRGB:             return (struct layout) { 1, 4, 1, 2, 3, -1 };
+        case SAIL_PIXEL_FORMAT_BPP32_XBGR:             return (struct layout) { 1, 4, 3, 2, 1, -1 };
+        case SAIL_PIXEL_FORMAT_BPP32_RGBA:             return (struct layout) { 1, 4, 0, 1, 2,  3 };
+        case SAIL_PIXEL_FORMAT_BPP32_BGRA:             return (struct layout) { 1, 4, 2, 1, 0,  3 };
+        case SAIL_PIXEL_FORMAT_BPP32_ARGB:             return (struct layout) { 1, 4, 1, 2, 3,  0 };
+        case SAIL_PIXEL_FORMAT_BPP32_ABGR:             return (struct layout) { 1, 4, 3, 2, 1,  0 };
+        case SAIL_PIXEL_FORMAT_BPP64_RGBX:             return (struct layout) { 2, 4, 0, 1, 2, -1 };
+        case SAIL_PIXEL_FORMAT_BPP64_BGRX:             return (struct layout) { 2, 4, 2, 1, 0, -1 };
+        case SAIL_PIXEL_FORMAT_BPP64_XRGB:             return (struct layout) { 2, 4, 1, 2, 3, -1 };
+        case SAIL_PIXEL_FORMAT_BPP64_XBGR:             return (struct layout) { 2, 4, 3, 2, 1, -1 };
+        case SAIL_PIXEL_FORMAT_BPP64_RGBA:             return (struct layout) { 2, 4, 0, 1, 2,  3 };
+        case SAIL_PIXEL_FORMAT_BPP64_BGRA:             return (struct layout) { 2, 4, 2, 1, 0,  3 };
+        case SAIL_PIXEL_FORMAT_BPP64_ARGB:             return (struct layout) { 2, 4, 1, 2, 3,  0 };
+        case SAIL_PIXEL_FORMAT_BPP64_ABGR:             return (struct layout) { 2, 4, 3, 2, 1,  0 };
+        default:                                       return (struct layout) { 0, 0, 0, 0, 0, -1 };
+    }
+}
+
+/* Returns the component value scaled to 16 bits. */
+static uint16_t read_component(const struct sail_image *image, const struct layout *layout, unsigned row, unsigned column, int index) {
+
+    const uint8_t *scan = (const uint8_t *)image->pixels + image->bytes_per_line * row + column * layout->components * layout->component_size;
+
+    if (index < 0) {
+        return 65535;
+    } else if (layout->component_size == 1) {
+        return (uint16_t)(scan[index] * 257);
+    } else {
+        return ((const uint16_t *)scan)[index];
+    }
+}
+
+static void write_component(const struct sail_image *image, const struct layout *layout, unsigned row, unsigned column, int index, uint16_t value) {
+
+    uint8_t *scan = (uint8_t *)image->pixels + image->bytes_per_line * row + column * layout->components * layout->component_size;
+
+    if (layout->component_size == 1) {
+        scan[index] = (uint8_t)value;
+    } else {
+        ((uint16_t *)scan)[index] = value;
+    }
+}
+
+static struct sail_image* random_image(enum SailPixelFormat pixel_format, unsigned width, unsigned height) {
+
+    struct sail_image *image;
+    munit_assert(sail_alloc_image(&image) == SAIL_OK);
+
+    image->width = width;
+    image->height = height;
+    image->pixel_format = pixel_format;
+    munit_assert(sail_bytes_per_line(image->width, image->pixel_format, &image->bytes_per_line) == SAIL_OK);
+    munit_assert(sail_malloc((size_t)image->bytes_per_line * image->height, &image->pixels) == SAIL_OK);
+
+    const struct layout layout = pixel_format_layout(pixel_format);
+
+    for (unsigned row = 0; row < height; row++) {
+        for (unsigned column = 0; column < width; column++) {
+            for (unsigned component = 0; component < layout.components; component++) {
+                write_component(image, &layout, row, column, component, (uint16_t)munit_rand_int_range(0, layout.component_size == 1 ? 255 : 65535));
+            }
+        }
+    }
+
+    return image;
+}
+
+static void assert_converted_exactly(const struct sail_image *image, const struct sail_image *image_output) {
+
+    const struct layout input_layout = pixel_format_layout(image->pixel_format);
+    const struct layout output_layout = pixel_format_layout(image_output->pixel_format);
+
+    const int input_indexes[4] = { input_layout.r, input_layout.g, input_layout.b, input_layout.a };
+    const int output_indexes[4] = { output_layout.r, output_layout.g, output_layout.b, output_layout.a };
+
+    for (unsigned row = 0; row < image->height; row++) {
+        for (unsigned column = 0; column < image->width; column++) {
+            for (unsigned i = 0; i < 4; i++) {
+                if (output_indexes[i] < 0) {
+                    continue;
+                }
+
+                const uint16_t value = read_component(image, &input_layout, row, column, input_indexes[i]);
+                const uint16_t expected = output_layout.component_size == 1 ? value / 257 * 257 : value;
+
+                munit_assert_uint16(read_component(image_output, &output_layout, row, column, output_indexes[i]), ==, expected);
+            }
+        }
+    }
+}
+
+static MunitResult test_convert_exact(const MunitParameter params[], void *user_data) {
+
+    (void)params;
+    (void)user_data;
+
+    /* Widths shorter and longer than SIMD blocks to catch row tails. */
+    const unsigned widths[] = { 1, 3, 5, 8, 11, 37, 130 };
+
+    for (size_t w = 0; w < sizeof(widths) / sizeof(widths[0]); w++) {
+        for (size_t i = 0; i < sizeof(INPUT_PIXEL_FORMATS) / sizeof(INPUT_PIXEL_FORMATS[0]); i++) {
+            struct sail_image *image = random_image(INPUT_PIXEL_FORMATS[i], widths[w], 3);
+
+            for (size_t k = 0; k < sizeof(OUTPUT_PIXEL_FORMATS) / sizeof(OUTPUT_PIXEL_FORMATS[0]); k++) {
+                munit_assert(sail_can_convert(image->pixel_format, OUTPUT_PIXEL_FORMATS[k]));
+
+                struct sail_image *image_output;
+                munit_assert(sail_convert_image(image, OUTPUT_PIXEL_FORMATS[k], &image_output) == SAIL_OK);
+
+                assert_converted_exactly(image, image_output);
+
+                sail_destroy_image(image_output);
+            }
+
+            sail_destroy_image(image);
+        }
+    }
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_update_same_as_convert(const MunitParameter params[], void *user_data) {
+
+    (void)params;
+    (void)user_data;
+
+    const enum SailPixelFormat pairs[][2] = {
+        { SAIL_PIXEL_FORMAT_BPP32_RGBA, SAIL_PIXEL_FORMAT_BPP24_RGB },
+        { SAIL_PIXEL_FORMAT_BPP32_BGRA, SAIL_PIXEL_FORMAT_BPP24_RGB },
+        { SAIL_PIXEL_FORMAT_BPP32_BGRX, SAIL_PIXEL_FORMAT_BPP24_BGR },
+        { SAIL_PIXEL_FORMAT_BPP32_ARGB, SAIL_PIXEL_FORMAT_BPP32_RGBA },
+        { SAIL_PIXEL_FORMAT_BPP24_RGB,  SAIL_PIXEL_FORMAT_BPP24_BGR },
+        { SAIL_PIXEL_FORMAT_BPP48_RGB,  SAIL_PIXEL_FORMAT_BPP24_RGB },
+        { SAIL_PIXEL_FORMAT_BPP64_RGBA, SAIL_PIXEL_FORMAT_BPP32_RGBA },
+        { SAIL_PIXEL_FORMAT_BPP64_RGBA, SAIL_PIXEL_FORMAT_BPP48_RGB },
+        { SAIL_PIXEL_FORMAT_BPP64_ABGR, SAIL_PIXEL_FORMAT_BPP24_BGR },
+        { SAIL_PIXEL_FORMAT_BPP64_ABGR, SAIL_PIXEL_FORMAT_BPP64_BGRA },
+        { SAIL_PIXEL_FORMAT_BPP64_XRGB, SAIL_PIXEL_FORMAT_BPP48_BGR },
+        { SAIL_PIXEL_FORMAT_BPP32_XBGR, SAIL_PIXEL_FORMAT_BPP32_ARGB },
+    };
+
+    for (size_t i = 0; i < sizeof(pairs) / sizeof(pairs[0]); i++) {
+        struct sail_image *image = random_image(pairs[i][0], 130, 3);
+
+        struct sail_image *image_output;
+        munit_assert(sail_convert_image(image, pairs[i][1], &image_output) == SAIL_OK);
+
+        munit_assert(sail_update_image(image, pairs[i][1]) == SAIL_OK);
+        munit_assert(image->pixel_format == pairs[i][1]);
+
+        for (unsigned row = 0; row < image->height; row++) {
+            munit_assert_memory_equal(image_output->bytes_per_line,
+                                        (const uint8_t *)image->pixels + image->bytes_per_line * row,
+                                        (const uint8_t *)image_output->pixels + image_output->bytes_per_line * row);
+        }
+
+        sail_destroy_image(image_output);
+        sail_destroy_image(image);
+    }
+
+    return MUNIT_OK;
+}
+
+static struct sail_image* random_bytes_image(enum SailPixelFormat pixel_format, unsigned width, unsigned height) {
+
+    struct sail_image *image;
+    munit_assert(sail_alloc_image(&image) == SAIL_OK);
+
+    image->width = width;
+    image->height = height;
+    image->pixel_format = pixel_format;
+    munit_assert(sail_bytes_per_line(image->width, image->pixel_format, &image->bytes_per_line) == SAIL_OK);
+    munit_assert(sail_malloc((size_t)image->bytes_per_line * image->height, &image->pixels) == SAIL_OK);
+
+    munit_rand_memory((size_t)image->bytes_per_line * image->height, image->pixels);
+
+    return image;
+}
+
+static void assert_images_equal(const struct sail_image *image1, const struct sail_image *image2) {
+
+    munit_assert(image1->pixel_format == image2->pixel_format);
+    munit_assert_uint(image1->bytes_per_line, ==, image2->bytes_per_line);
+    munit_assert_uint(image1->height, ==, image2->height);
+
+    munit_assert_memory_equal((size_t)image1->bytes_per_line * image1->height, image1->pixels, image2->pixels);
+}
+
+static MunitResult test_update_row_converters(const MunitParameter params[], void *user_data) {
+
+    (void)params;
+    (void)user_data;
+
+    /* Row converters into RGBA32 with input pixels of the same and smaller sizes. */
+    const enum SailPixelFormat pairs[][2] = {
+        { SAIL_PIXEL_FORMAT_BPP32_CMYK,  SAIL_PIXEL_FORMAT_BPP32_RGBA },
+        { SAIL_PIXEL_FORMAT_BPP32_YCCK,  SAIL_PIXEL_FORMAT_BPP32_RGBA },
+        { SAIL_PIXEL_FORMAT_BPP32_CMYK,  SAIL_PIXEL_FORMAT_BPP24_RGB },
+        { SAIL_PIXEL_FORMAT_BPP24_YCBCR, SAIL_PIXEL_FORMAT_BPP24_RGB },
+        { SAIL_PIXEL_FORMAT_BPP24_YCBCR, SAIL_PIXEL_FORMAT_BPP32_RGBA },
+    };
+
+    for (size_t i = 0; i < sizeof(pairs) / sizeof(pairs[0]); i++) {
+        struct sail_image *image = random_bytes_image(pairs[i][0], 130, 3);
+
+        struct sail_image *image_output;
+        munit_assert(sail_convert_image(image, pairs[i][1], &image_output) == SAIL_OK);
+
+        bool new_image_fits_into_existing;
+        munit_assert(sail_greater_equal_bits_per_pixel(pairs[i][0], pairs[i][1], &new_image_fits_into_existing) == SAIL_OK);
+
+        if (new_image_fits_into_existing) {
+            munit_assert(sail_update_image(image, pairs[i][1]) == SAIL_OK);
+            munit_assert(image->pixel_format == pairs[i][1]);
+
+            for (unsigned row = 0; row < image->height; row++) {
+                munit_assert_memory_equal(image_output->bytes_per_line,
+                                            (const uint8_t *)image->pixels + image->bytes_per_line * row,
+                                            (const uint8_t *)image_output->pixels + image_output->bytes_per_line * row);
+            }
+        } else {
+            /* The output pixel is larger than the input pixel. */
+            munit_assert(sail_update_image(image, pairs[i][1]) == SAIL_ERROR_UNSUPPORTED_PIXEL_FORMAT);
+            munit_assert(image->pixel_format == pairs[i][0]);
+        }
+
+        sail_destroy_image(image_output);
+        sail_destroy_image(image);
+    }
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_parallel_same_as_serial(const MunitParameter params[], void *user_data) {
+
+    (void)params;
+    (void)user_data;
+
+    /* Both row kernels and generic per-pixel conversions. */
+    const enum SailPixelFormat pairs[][2] = {
+        { SAIL_PIXEL_FORMAT_BPP24_BGR,  SAIL_PIXEL_FORMAT_BPP32_RGBA },
+        { SAIL_PIXEL_FORMAT_BPP64_RGBA, SAIL_PIXEL_FORMAT_BPP32_RGBA },
+        { SAIL_PIXEL_FORMAT_BPP32_RGBA, SAIL_PIXEL_FORMAT_BPP24_RGB },
+        { SAIL_PIXEL_FORMAT_BPP32_CMYK, SAIL_PIXEL_FORMAT_BPP32_RGBA },
+        { SAIL_PIXEL_FORMAT_BPP24_YCBCR, SAIL_PIXEL_FORMAT_BPP24_RGB },
+        { SAIL_PIXEL_FORMAT_BPP16_RGB565, SAIL_PIXEL_FORMAT_BPP48_BGR },
+        { SAIL_PIXEL_FORMAT_BPP4_GRAYSCALE, SAIL_PIXEL_FORMAT_BPP32_BGRA },
+    };
+
+    /* Zero means the number of CPUs. */
+    const unsigned threads[] = { 0, 3 };
+
+    const int options_list[] = { SAIL_CONVERSION_OPTION_DROP_ALPHA, SAIL_CONVERSION_OPTION_BLEND_ALPHA };
+
+    struct sail_conversion_options *options;
+    munit_assert(sail_alloc_conversion_options(&options) == SAIL_OK);
+    options->background24 = (sail_rgb24_t) { 10, 20, 30 };
+    options->background48 = (sail_rgb48_t) { 1000, 2000, 3000 };
+
+    for (size_t i = 0; i < sizeof(pairs) / sizeof(pairs[0]); i++) {
+        /* Above the parallel conversion threshold with a height not divisible by the number of bands. */
+        struct sail_image *image = random_bytes_image(pairs[i][0], 1031, 777);
+
+        for (size_t o = 0; o < sizeof(options_list) / sizeof(options_list[0]); o++) {
+            options->options = options_list[o];
+
+            struct sail_image *image_serial;
+            munit_assert(sail_convert_image_with_options(image, pairs[i][1], options, &image_serial) == SAIL_OK);
+
+            for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); t++) {
+                options->options = options_list[o] | SAIL_CONVERSION_OPTION_PARALLEL;
+                options->threads = threads[t];
+
+                struct sail_image *image_parallel;
+                munit_assert(sail_convert_image_with_options(image, pairs[i][1], options, &image_parallel) == SAIL_OK);
+                assert_images_equal(image_serial, image_parallel);
+                sail_destroy_image(image_parallel);
+
+                bool new_image_fits_into_existing;
+                munit_assert(sail_greater_equal_bits_per_pixel(image->pixel_format, pairs[i][1], &new_image_fits_into_existing) == SAIL_OK);
+
+                if (new_image_fits_into_existing) {
+                    struct sail_image *image_updated;
+                    munit_assert(sail_copy_image(image, &image_updated) == SAIL_OK);
+                    munit_assert(sail_update_image_with_options(image_updated, pairs[i][1], options) == SAIL_OK);
+
+                    for (unsigned row = 0; row < image_updated->height; row++) {
+                        munit_assert_memory_equal(image_serial->bytes_per_line,
+                                                    (const uint8_t *)image_updated->pixels + image_updated->bytes_per_line * row,
+                                                    (const uint8_t *)image_serial->pixels + image_serial->bytes_per_line * row);
+                    }
+
+                    sail_destroy_image(image_updated);
+                }
+            }
+
+            sail_destroy_image(image_serial);
+        }
+
+        sail_destroy_image(image);
+    }
+
+    sail_destroy_conversion_options(options);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_parallel_after_stop(const MunitParameter params[], void *user_data) {
+
+    (void)params;
+    (void)user_data;
+
+    struct sail_image *image = random_bytes_image(SAIL_PIXEL_FORMAT_BPP24_BGR, 1031, 777);
+
+    struct sail_conversion_options *options;
+    munit_assert(sail_alloc_conversion_options(&options) == SAIL_OK);
+
+    struct sail_image *image_serial;
+    munit_assert(sail_convert_image_with_options(image, SAIL_PIXEL_FORMAT_BPP32_RGBA, options, &image_serial) == SAIL_OK);
+
+    options->options |= SAIL_CONVERSION_OPTION_PARALLEL;
+
+    /* The worker threads are started again after stopping. */
+    for (unsigned i = 0; i < 3; i++) {
+        struct sail_image *image_parallel;
+        munit_assert(sail_convert_image_with_options(image, SAIL_PIXEL_FORMAT_BPP32_RGBA, options, &image_parallel) == SAIL_OK);
+        assert_images_equal(image_serial, image_parallel);
+        sail_destroy_image(image_parallel);
+
+        sail_stop_conversion_threads();
+        sail_stop_conversion_threads();
+    }
+
+    sail_destroy_conversion_options(options);
+    sail_destroy_image(image_serial);
+    sail_destroy_image(image);
+
+    return MUNIT_OK;
+}
+
+static MunitTest test_suite_tests[] = {
+    { (char *)"/exact", test_convert_exact, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/update-same-as-convert", test_update_same_as_convert, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/parallel-same-as-serial", test_parallel_same_as_serial, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/parallel-after-stop", test_parallel_after_stop, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/update-row-converters", test_update_row_converters, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char *)"/convert",
+    test_suite_tests,
+    NULL,
+    1,
+    MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, NULL, argc, argv);
+}
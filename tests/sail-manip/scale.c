@@ -0,0 +1,265 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stdint.h>
+#include <string.h>
+
+#include "sail-common.h"
+#include "sail-manip.h"
+
+#include "munit.h"
+
+static const enum SailPixelFormat PIXEL_FORMATS[] = {
+    SAIL_PIXEL_FORMAT_BPP8_GRAYSCALE,
+    SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE,
+    SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE_ALPHA,
+    SAIL_PIXEL_FORMAT_BPP32_GRAYSCALE_ALPHA,
+    SAIL_PIXEL_FORMAT_BPP24_RGB,
+    SAIL_PIXEL_FORMAT_BPP48_BGR,
+    SAIL_PIXEL_FORMAT_BPP32_XRGB,
+    SAIL_PIXEL_FORMAT_BPP32_RGBA,
+    SAIL_PIXEL_FORMAT_BPP32_ABGR,
+    SAIL_PIXEL_FORMAT_BPP64_BGRX,
+    SAIL_PIXEL_FORMAT_BPP64_RGBA,
+    SAIL_PIXEL_FORMAT_BPP64_ARGB,
+};
+
+static const enum SailScaling ALGORITHMS[] = {
+    SAIL_SCALING_BOX,
+    SAIL_SCALING_BILINEAR,
+    SAIL_SCALING_MITCHELL,
+    SAIL_SCALING_LANCZOS3,
+};
+
+static struct sail_image* alloc_image(enum SailPixelFormat pixel_format, unsigned width, unsigned height) {
+
+    struct sail_image *image;
+    munit_assert(sail_alloc_image(&image) == SAIL_OK);
+
+    image->width = width;
+    image->height = height;
+    image->pixel_format = pixel_format;
+    munit_assert(sail_bytes_per_line(image->width, image->pixel_format, &image->bytes_per_line) == SAIL_OK);
+    munit_assert(sail_malloc((size_t)image->bytes_per_line * image->height, &image->pixels) == SAIL_OK);
+
+    return image;
+}
+
+static MunitResult test_solid_color_preserved(const MunitParameter params[], void *user_data) {
+
+    (void)params;
+    (void)user_data;
+
+    /* Downscaling, upscaling, and mixed. */
+    const unsigned sizes[][2] = { { 13, 7 }, { 101, 64 }, { 9, 120 } };
+
+    for (size_t f = 0; f < sizeof(PIXEL_FORMATS) / sizeof(PIXEL_FORMATS[0]); f++) {
+        struct sail_image *image = alloc_image(PIXEL_FORMATS[f], 37, 29);
+
+        /* Every byte is the same, so every component is the same too. */
+        memset(image->pixels, 0x5A, (size_t)image->bytes_per_line * image->height);
+
+        for (size_t a = 0; a < sizeof(ALGORITHMS) / sizeof(ALGORITHMS[0]); a++) {
+            for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+                struct sail_image *image_scaled;
+                munit_assert(sail_scale_image(image, sizes[s][0], sizes[s][1], ALGORITHMS[a], &image_scaled) == SAIL_OK);
+
+                munit_assert_uint(image_scaled->width, ==, sizes[s][0]);
+                munit_assert_uint(image_scaled->height, ==, sizes[s][1]);
+                munit_assert(image_scaled->pixel_format == image->pixel_format);
+
+                unsigned natural_bytes_per_line;
+                munit_assert(sail_bytes_per_line(image_scaled->width, image_scaled->pixel_format, &natural_bytes_per_line) == SAIL_OK);
+
+                for (unsigned row = 0; row < image_scaled->height; row++) {
+                    const uint8_t *scan = (const uint8_t *)image_scaled->pixels + (size_t)image_scaled->bytes_per_line * row;
+
+                    for (unsigned i = 0; i < natural_bytes_per_line; i++) {
+                        munit_assert_uint8(scan[i], ==, 0x5A);
+                    }
+                }
+
+                sail_destroy_image(image_scaled);
+            }
+        }
+
+        sail_destroy_image(image);
+    }
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_box_averages(const MunitParameter params[], void *user_data) {
+
+    (void)params;
+    (void)user_data;
+
+    struct sail_image *image = alloc_image(SAIL_PIXEL_FORMAT_BPP8_GRAYSCALE, 8, 6);
+
+    for (unsigned row = 0; row < image->height; row++) {
+        for (unsigned column = 0; column < image->width; column++) {
+            ((uint8_t *)image->pixels)[image->bytes_per_line * row + column] = (uint8_t)(row * 40 + column * 4);
+        }
+    }
+
+    struct sail_image *image_scaled;
+    munit_assert(sail_scale_image(image, 4, 3, SAIL_SCALING_BOX, &image_scaled) == SAIL_OK);
+
+    for (unsigned row = 0; row < image_scaled->height; row++) {
+        for (unsigned column = 0; column < image_scaled->width; column++) {
+            /* The average of the 2x2 block is its center value. */
+            const unsigned expected = (row * 2) * 40 + 20 + (column * 2) * 4 + 2;
+
+            munit_assert_uint8(((const uint8_t *)image_scaled->pixels)[image_scaled->bytes_per_line * row + column], ==, expected);
+        }
+    }
+
+    sail_destroy_image(image_scaled);
+    sail_destroy_image(image);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_transparent_pixels_dont_bleed(const MunitParameter params[], void *user_data) {
+
+    (void)params;
+    (void)user_data;
+
+    /* Transparent red columns interleaved with opaque blue columns. */
+    struct sail_image *image = alloc_image(SAIL_PIXEL_FORMAT_BPP32_RGBA, 16, 4);
+
+    for (unsigned row = 0; row < image->height; row++) {
+        for (unsigned column = 0; column < image->width; column++) {
+            uint8_t *pixel = (uint8_t *)image->pixels + image->bytes_per_line * row + column * 4;
+            const uint8_t red[4]  = { 255, 0, 0, 0 };
+            const uint8_t blue[4] = { 0, 0, 255, 255 };
+
+            memcpy(pixel, column % 2 == 0 ? red : blue, 4);
+        }
+    }
+
+    for (size_t a = 0; a < sizeof(ALGORITHMS) / sizeof(ALGORITHMS[0]); a++) {
+        struct sail_image *image_scaled;
+        munit_assert(sail_scale_image(image, 5, 3, ALGORITHMS[a], &image_scaled) == SAIL_OK);
+
+        for (unsigned row = 0; row < image_scaled->height; row++) {
+            for (unsigned column = 0; column < image_scaled->width; column++) {
+                const uint8_t *pixel = (const uint8_t *)image_scaled->pixels + image_scaled->bytes_per_line * row + column * 4;
+
+                munit_assert_uint8(pixel[0], ==, 0);
+                munit_assert_uint8(pixel[1], ==, 0);
+                munit_assert_uint8(pixel[2], ==, 255);
+            }
+        }
+
+        sail_destroy_image(image_scaled);
+    }
+
+    sail_destroy_image(image);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_parallel_same_as_serial(const MunitParameter params[], void *user_data) {
+
+    (void)params;
+    (void)user_data;
+
+    /* Zero means the number of CPUs. */
+    const unsigned threads[] = { 0, 3 };
+
+    struct sail_conversion_options *options;
+    munit_assert(sail_alloc_conversion_options(&options) == SAIL_OK);
+
+    /* Above the parallel scaling threshold with an output height not divisible by the number of bands. */
+    struct sail_image *image = alloc_image(SAIL_PIXEL_FORMAT_BPP32_RGBA, 1031, 777);
+    munit_rand_memory((size_t)image->bytes_per_line * image->height, image->pixels);
+
+    for (size_t a = 0; a < sizeof(ALGORITHMS) / sizeof(ALGORITHMS[0]); a++) {
+        struct sail_image *image_serial;
+        munit_assert(sail_scale_image(image, 640, 481, ALGORITHMS[a], &image_serial) == SAIL_OK);
+
+        for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); t++) {
+            options->options = SAIL_CONVERSION_OPTION_PARALLEL;
+            options->threads = threads[t];
+
+            struct sail_image *image_parallel;
+            munit_assert(sail_scale_image_with_options(image, 640, 481, ALGORITHMS[a], options, &image_parallel) == SAIL_OK);
+            munit_assert_memory_equal((size_t)image_serial->bytes_per_line * image_serial->height, image_serial->pixels, image_parallel->pixels);
+            sail_destroy_image(image_parallel);
+        }
+
+        sail_destroy_image(image_serial);
+    }
+
+    sail_destroy_image(image);
+    sail_destroy_conversion_options(options);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_invalid_arguments(const MunitParameter params[], void *user_data) {
+
+    (void)params;
+    (void)user_data;
+
+    struct sail_image *image = alloc_image(SAIL_PIXEL_FORMAT_BPP24_RGB, 4, 4);
+    struct sail_image *image_scaled = NULL;
+
+    munit_assert(sail_scale_image(image, 0, 4, SAIL_SCALING_BOX, &image_scaled) == SAIL_ERROR_INVALID_ARGUMENT);
+    munit_assert(sail_scale_image(image, 4, 0, SAIL_SCALING_BOX, &image_scaled) == SAIL_ERROR_INVALID_ARGUMENT);
+    munit_assert_null(image_scaled);
+
+    image->pixel_format = SAIL_PIXEL_FORMAT_BPP8_INDEXED;
+    munit_assert(!sail_can_scale(image->pixel_format));
+    munit_assert(sail_scale_image(image, 2, 2, SAIL_SCALING_BOX, &image_scaled) != SAIL_OK);
+    munit_assert_null(image_scaled);
+
+    sail_destroy_image(image);
+
+    return MUNIT_OK;
+}
+
+static MunitTest test_suite_tests[] = {
+    { (char *)"/solid-color-preserved", test_solid_color_preserved, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/box-averages", test_box_averages, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/transparent-pixels-dont-bleed", test_transparent_pixels_dont_bleed, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/parallel-same-as-serial", test_parallel_same_as_serial, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/invalid-arguments", test_invalid_arguments, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char *)"/scale",
+    test_suite_tests,
+    NULL,
+    1,
+    MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, NULL, argc, argv);
+}
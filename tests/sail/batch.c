@@ -0,0 +1,254 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "sail.h"
+
+#include "sail-comparators.h"
+
+#include "munit.h"
+
+#include "test-images.h"
+
+/* Every test image is repeated to have more sources than threads. */
+#define REPEAT_COUNT 4
+
+/* The index of a non-existing file added to the sources. */
+#define INVALID_SOURCE_INDEX 1
+
+struct batch_context {
+
+    size_t count;
+    enum SailBatchOrder order;
+
+    struct sail_image **expected_images;
+
+    size_t delivered;
+    size_t next_index;
+    bool success;
+};
+
+static void batch_callback(size_t index, sail_status_t status, struct sail_image *image, void *user_data) {
+
+    struct batch_context *context = user_data;
+
+    context->delivered++;
+
+    if (context->order == SAIL_BATCH_ORDER_INPUT && index != context->next_index++) {
+        context->success = false;
+    }
+
+    if (index >= context->count) {
+        context->success = false;
+    } else if (context->expected_images[index] == NULL) {
+        if (status == SAIL_OK || image != NULL) {
+            context->success = false;
+        }
+    } else if (status != SAIL_OK || sail_test_compare_images(context->expected_images[index], image) != SAIL_OK) {
+        context->success = false;
+    }
+
+    sail_destroy_image(image);
+}
+
+static size_t test_images_count(void) {
+
+    size_t count = 0;
+
+    for (const char * const *path = SAIL_TEST_IMAGES; *path != NULL; path++) {
+        count++;
+    }
+
+    return count;
+}
+
+/*
+ * Builds the repeated list of test image paths with a non-existing file,
+ * and loads the expected images sequentially.
+ */
+static void alloc_sources(const char ***paths, struct sail_image ***expected_images, size_t *count) {
+
+    const size_t images_count = test_images_count();
+    *count = images_count * REPEAT_COUNT + 1;
+
+    void *ptr;
+    munit_assert(sail_malloc(sizeof(const char *) * *count, &ptr) == SAIL_OK);
+    *paths = ptr;
+    munit_assert(sail_malloc(sizeof(struct sail_image *) * *count, &ptr) == SAIL_OK);
+    *expected_images = ptr;
+
+    for (size_t i = 0, image = 0; i < *count; i++) {
+        if (i == INVALID_SOURCE_INDEX) {
+            (*paths)[i] = "non-existing-file.png";
+            (*expected_images)[i] = NULL;
+        } else {
+            (*paths)[i] = SAIL_TEST_IMAGES[image++ % images_count];
+            munit_assert(sail_load_from_file((*paths)[i], &(*expected_images)[i]) == SAIL_OK);
+        }
+    }
+}
+
+static void destroy_sources(const char **paths, struct sail_image **expected_images, size_t count) {
+
+    for (size_t i = 0; i < count; i++) {
+        sail_destroy_image(expected_images[i]);
+    }
+
+    sail_free(expected_images);
+    sail_free(paths);
+}
+
+static MunitResult test_load_batch_from_files(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    const char **paths;
+    struct sail_image **expected_images;
+    size_t count;
+    alloc_sources(&paths, &expected_images, &count);
+
+    struct sail_batch_options *batch_options;
+    munit_assert(sail_alloc_batch_options(&batch_options) == SAIL_OK);
+
+    const unsigned threads[] = { 1, 3, 0 };
+    const enum SailBatchOrder orders[] = { SAIL_BATCH_ORDER_COMPLETION, SAIL_BATCH_ORDER_INPUT };
+
+    for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); t++) {
+        for (size_t o = 0; o < sizeof(orders) / sizeof(orders[0]); o++) {
+            batch_options->threads = threads[t];
+            batch_options->order   = orders[o];
+
+            struct batch_context context = { count, orders[o], expected_images, 0, 0, true };
+
+            munit_assert(sail_load_batch_from_files(paths, count, batch_options, batch_callback, &context) == SAIL_OK);
+            munit_assert(context.success);
+            munit_assert(context.delivered == count);
+        }
+    }
+
+    /* Default batch options. */
+    struct batch_context context = { count, SAIL_BATCH_ORDER_COMPLETION, expected_images, 0, 0, true };
+    munit_assert(sail_load_batch_from_files(paths, count, NULL, batch_callback, &context) == SAIL_OK);
+    munit_assert(context.success);
+    munit_assert(context.delivered == count);
+
+    /* Empty batch. */
+    context.delivered = 0;
+    munit_assert(sail_load_batch_from_files(paths, 0, NULL, batch_callback, &context) == SAIL_OK);
+    munit_assert(context.delivered == 0);
+
+    sail_destroy_batch_options(batch_options);
+    destroy_sources(paths, expected_images, count);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_load_batch_from_memory(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    const char **paths;
+    struct sail_image **expected_images;
+    size_t count;
+    alloc_sources(&paths, &expected_images, &count);
+
+    void *ptr;
+    munit_assert(sail_malloc(sizeof(void *) * count, &ptr) == SAIL_OK);
+    void **buffers = ptr;
+    munit_assert(sail_malloc(sizeof(size_t) * count, &ptr) == SAIL_OK);
+    size_t *buffer_lengths = ptr;
+
+    for (size_t i = 0; i < count; i++) {
+        if (expected_images[i] == NULL) {
+            /* Garbage without a known magic number. */
+            munit_assert(sail_malloc(16, &buffers[i]) == SAIL_OK);
+            memset(buffers[i], 0, 16);
+            buffer_lengths[i] = 16;
+        } else {
+            munit_assert(sail_file_contents_to_data(paths[i], &buffers[i], &buffer_lengths[i]) == SAIL_OK);
+
+            /* Formats without magic numbers cannot be detected in memory. */
+            const struct sail_codec_info *codec_info;
+
+            if (sail_codec_info_by_magic_number_from_memory(buffers[i], buffer_lengths[i], &codec_info) != SAIL_OK) {
+                sail_destroy_image(expected_images[i]);
+                expected_images[i] = NULL;
+            }
+        }
+    }
+
+    /* Load with explicit load options matching the codec defaults. */
+    struct sail_load_options *load_options;
+    munit_assert(sail_alloc_load_options(&load_options) == SAIL_OK);
+    load_options->options = SAIL_OPTION_META_DATA | SAIL_OPTION_ICCP;
+
+    struct sail_batch_options *batch_options;
+    munit_assert(sail_alloc_batch_options(&batch_options) == SAIL_OK);
+    batch_options->threads      = 4;
+    batch_options->order        = SAIL_BATCH_ORDER_INPUT;
+    batch_options->load_options = load_options;
+
+    struct batch_context context = { count, SAIL_BATCH_ORDER_INPUT, expected_images, 0, 0, true };
+
+    munit_assert(sail_load_batch_from_memory((const void * const *)buffers, buffer_lengths, count,
+                                             batch_options, batch_callback, &context) == SAIL_OK);
+    munit_assert(context.success);
+    munit_assert(context.delivered == count);
+
+    sail_destroy_batch_options(batch_options);
+    sail_destroy_load_options(load_options);
+
+    for (size_t i = 0; i < count; i++) {
+        sail_free(buffers[i]);
+    }
+
+    sail_free(buffer_lengths);
+    sail_free(buffers);
+    destroy_sources(paths, expected_images, count);
+
+    return MUNIT_OK;
+}
+
+static MunitTest test_suite_tests[] = {
+    { (char *)"/load-batch-from-files",  test_load_batch_from_files,  NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/load-batch-from-memory", test_load_batch_from_memory, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char *)"/batch",
+    test_suite_tests,
+    NULL,
+    1,
+    MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, NULL, argc, argv);
+}
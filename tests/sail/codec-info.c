@@ -0,0 +1,144 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <string.h>
+
+#include "sail.h"
+
+#include "munit.h"
+
+#include "test-images.h"
+
+static MunitResult test_codec_info_magic_number(const MunitParameter params[], void *user_data) {
+    (void)user_data;
+
+    const char *path = munit_parameters_get(params, "path");
+
+    const struct sail_codec_info *codec_info_by_extension;
+    munit_assert(sail_codec_info_from_path(path, &codec_info_by_extension) == SAIL_OK);
+
+    /* Codecs like TGA have no magic numbers. */
+    if (codec_info_by_extension->magic_number_node == NULL) {
+        return MUNIT_SKIP;
+    }
+
+    const struct sail_codec_info *codec_info_by_magic;
+    munit_assert(sail_codec_info_by_magic_number_from_path(path, &codec_info_by_magic) == SAIL_OK);
+    munit_assert_ptr_equal(codec_info_by_magic, codec_info_by_extension);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_codec_info_magic_number_not_found(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    unsigned char buffer[SAIL_MAGIC_BUFFER_SIZE];
+    memset(buffer, 'z', sizeof(buffer));
+
+    const struct sail_codec_info *codec_info = NULL;
+    munit_assert(sail_codec_info_by_magic_number_from_memory(buffer, sizeof(buffer), &codec_info) == SAIL_ERROR_CODEC_NOT_FOUND);
+    munit_assert_null(codec_info);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_codec_info_extension(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    const struct sail_codec_info *codec_info;
+    munit_assert(sail_codec_info_from_extension("png", &codec_info) == SAIL_OK);
+    munit_assert_string_equal(codec_info->name, "PNG");
+
+    /* Case-insensitive. */
+    const struct sail_codec_info *codec_info_upper;
+    munit_assert(sail_codec_info_from_extension("PnG", &codec_info_upper) == SAIL_OK);
+    munit_assert_ptr_equal(codec_info_upper, codec_info);
+
+    /* Every indexed extension leads back to its codec. */
+    for (const struct sail_codec_bundle_node *node = sail_codec_bundle_list(); node != NULL; node = node->next) {
+        for (const struct sail_string_node *extension_node = node->codec_bundle->codec_info->extension_node;
+                extension_node != NULL; extension_node = extension_node->next) {
+            munit_assert(sail_codec_info_from_extension(extension_node->string, &codec_info) == SAIL_OK);
+        }
+    }
+
+    munit_assert(sail_codec_info_from_extension("png1", &codec_info) == SAIL_ERROR_CODEC_NOT_FOUND);
+    munit_assert(sail_codec_info_from_extension("pn", &codec_info) == SAIL_ERROR_CODEC_NOT_FOUND);
+    munit_assert(sail_codec_info_from_extension("", &codec_info) == SAIL_ERROR_CODEC_NOT_FOUND);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_codec_info_mime_type(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    const struct sail_codec_info *codec_info;
+    munit_assert(sail_codec_info_from_mime_type("image/png", &codec_info) == SAIL_OK);
+    munit_assert_string_equal(codec_info->name, "PNG");
+
+    const struct sail_codec_info *codec_info_upper;
+    munit_assert(sail_codec_info_from_mime_type("IMAGE/PNG", &codec_info_upper) == SAIL_OK);
+    munit_assert_ptr_equal(codec_info_upper, codec_info);
+
+    for (const struct sail_codec_bundle_node *node = sail_codec_bundle_list(); node != NULL; node = node->next) {
+        for (const struct sail_string_node *mime_type_node = node->codec_bundle->codec_info->mime_type_node;
+                mime_type_node != NULL; mime_type_node = mime_type_node->next) {
+            munit_assert(sail_codec_info_from_mime_type(mime_type_node->string, &codec_info) == SAIL_OK);
+        }
+    }
+
+    munit_assert(sail_codec_info_from_mime_type("image/unknown", &codec_info) == SAIL_ERROR_CODEC_NOT_FOUND);
+
+    return MUNIT_OK;
+}
+
+static MunitParameterEnum test_params[] = {
+    { (char *)"path", (char **)SAIL_TEST_IMAGES },
+    { NULL, NULL },
+};
+
+static MunitTest test_suite_tests[] = {
+    { (char *)"/extension",              test_codec_info_extension,              NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/mime-type",              test_codec_info_mime_type,              NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/magic-number",           test_codec_info_magic_number,           NULL, NULL, MUNIT_TEST_OPTION_NONE, test_params },
+    { (char *)"/magic-number-not-found", test_codec_info_magic_number_not_found, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char *)"/codec-info",
+    test_suite_tests,
+    NULL,
+    1,
+    MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, NULL, argc, argv);
+}
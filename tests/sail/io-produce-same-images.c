@@ -23,7 +23,9 @@
     SOFTWARE.
 */
 
+#include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "sail.h"
 
@@ -70,6 +72,397 @@ static MunitResult test_io_produce_same_images(const MunitParameter params[], vo
     return MUNIT_OK;
 }
 
+static MunitResult test_mmap_file_io_produces_same_images(const MunitParameter params[], void *user_data) {
+    (void)user_data;
+
+    const char *path = munit_parameters_get(params, "path");
+
+    struct sail_image *image_file = NULL;
+    munit_assert(sail_load_from_file(path, &image_file) == SAIL_OK);
+
+    const struct sail_codec_info *codec_info;
+    munit_assert(sail_codec_info_from_path(path, &codec_info) == SAIL_OK);
+
+    struct sail_io *io;
+    munit_assert(sail_alloc_io_read_mmap_file(path, &io) == SAIL_OK);
+    munit_assert(io->id == SAIL_MMAP_FILE_IO_ID);
+    munit_assert(io->features & SAIL_IO_FEATURE_DIRECT_BUFFER);
+
+    /* The borrowed data matches the file contents. */
+    void *data;
+    size_t data_length;
+    munit_assert(sail_file_contents_to_data(path, &data, &data_length) == SAIL_OK);
+
+    const void *borrowed_data;
+    size_t borrowed_data_length;
+    void *data_to_free;
+    munit_assert(sail_borrow_data_from_io_contents(io, &borrowed_data, &borrowed_data_length, &data_to_free) == SAIL_OK);
+    munit_assert_null(data_to_free);
+    munit_assert(borrowed_data_length == data_length);
+    munit_assert_memory_equal(data_length, borrowed_data, data);
+
+    void *state;
+    munit_assert(sail_start_loading_from_io(io, codec_info, &state) == SAIL_OK);
+
+    struct sail_image *image_mmap = NULL;
+    munit_assert(sail_load_next_frame(state, &image_mmap) == SAIL_OK);
+    munit_assert(sail_stop_loading(state) == SAIL_OK);
+
+    munit_assert(sail_test_compare_images(image_file, image_mmap) == SAIL_OK);
+
+    sail_destroy_io(io);
+    sail_free(data);
+    sail_destroy_image(image_mmap);
+    sail_destroy_image(image_file);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_pixel_pool_produces_same_images(const MunitParameter params[], void *user_data) {
+    (void)user_data;
+
+    const char *path = munit_parameters_get(params, "path");
+
+    struct sail_image *image_default = NULL;
+    munit_assert(sail_load_from_file(path, &image_default) == SAIL_OK);
+
+    const struct sail_codec_info *codec_info;
+    munit_assert(sail_codec_info_from_path(path, &codec_info) == SAIL_OK);
+
+    struct sail_pixel_pool *pixel_pool;
+    munit_assert(sail_alloc_pixel_pool(16 * 1024 * 1024, &pixel_pool) == SAIL_OK);
+
+    struct sail_load_options *load_options;
+    munit_assert(sail_alloc_load_options_from_features(codec_info->load_features, &load_options) == SAIL_OK);
+    load_options->pixel_allocator = sail_pixel_pool_allocator(pixel_pool);
+
+    /* Load twice to reuse the pooled buffer. */
+    for (int i = 0; i < 2; i++) {
+        void *state;
+        munit_assert(sail_start_loading_from_file_with_options(path, codec_info, load_options, &state) == SAIL_OK);
+
+        struct sail_image *image_pooled = NULL;
+        munit_assert(sail_load_next_frame(state, &image_pooled) == SAIL_OK);
+        munit_assert(sail_stop_loading(state) == SAIL_OK);
+
+        munit_assert_ptr_equal(image_pooled->pixel_allocator, load_options->pixel_allocator);
+        munit_assert(sail_test_compare_images(image_default, image_pooled) == SAIL_OK);
+
+        sail_destroy_image(image_pooled);
+    }
+
+    sail_destroy_load_options(load_options);
+    sail_destroy_pixel_pool(pixel_pool);
+    sail_destroy_image(image_default);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_load_into_caller_buffer_produces_same_images(const MunitParameter params[], void *user_data) {
+    (void)user_data;
+
+    const char *path = munit_parameters_get(params, "path");
+
+    struct sail_image *image_default = NULL;
+    munit_assert(sail_load_from_file(path, &image_default) == SAIL_OK);
+
+    /* Tightly packed rows, padded rows. */
+    const unsigned paddings[] = { 0, 61 };
+
+    for (size_t i = 0; i < sizeof(paddings) / sizeof(paddings[0]); i++) {
+        const unsigned bytes_per_line = image_default->bytes_per_line + paddings[i];
+        const size_t pixels_size = (size_t)bytes_per_line * image_default->height;
+
+        void *pixels;
+        munit_assert(sail_malloc(pixels_size, &pixels) == SAIL_OK);
+
+        void *state;
+        munit_assert(sail_start_loading_from_file(path, NULL, &state) == SAIL_OK);
+
+        /* Too small buffer or rows. The frame is kept, so retry with the same state. */
+        struct sail_image *image = NULL;
+        munit_assert(sail_load_next_frame_into(state, pixels, pixels_size - 1, bytes_per_line, &image) == SAIL_ERROR_INVALID_ARGUMENT);
+        munit_assert(sail_load_next_frame_into(state, pixels, pixels_size, image_default->bytes_per_line - 1, &image) == SAIL_ERROR_INCORRECT_BYTES_PER_LINE);
+        munit_assert(sail_load_next_frame_into(state, pixels, pixels_size, paddings[i] == 0 ? 0 : bytes_per_line, &image) == SAIL_OK);
+        munit_assert(sail_stop_loading(state) == SAIL_OK);
+
+        munit_assert_ptr_equal(image->pixels, pixels);
+        munit_assert(image->bytes_per_line == bytes_per_line);
+
+        for (unsigned row = 0; row < image->height; row++) {
+            munit_assert_memory_equal(image_default->bytes_per_line,
+                                      (const char *)image->pixels + (size_t)row * image->bytes_per_line,
+                                      (const char *)image_default->pixels + (size_t)row * image_default->bytes_per_line);
+        }
+
+        /* The caller buffer is not freed. */
+        sail_destroy_image(image);
+        sail_free(pixels);
+    }
+
+    sail_destroy_image(image_default);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_load_rows_produces_same_images(const MunitParameter params[], void *user_data) {
+    (void)user_data;
+
+    const char *path = munit_parameters_get(params, "path");
+
+    struct sail_image *image_default = NULL;
+    munit_assert(sail_load_from_file(path, &image_default) == SAIL_OK);
+
+    /* Load a few padded rows at once. */
+    const unsigned rows_count = 7;
+    const unsigned bytes_per_line = image_default->bytes_per_line + 13;
+
+    void *rows;
+    munit_assert(sail_malloc((size_t)rows_count * bytes_per_line, &rows) == SAIL_OK);
+
+    void *state;
+    munit_assert(sail_start_loading_from_file(path, NULL, &state) == SAIL_OK);
+
+    /* No frame to load rows from. */
+    munit_assert(sail_load_next_rows(state, rows, 1, 0) == SAIL_ERROR_CONFLICTING_OPERATION);
+
+    struct sail_image *image = NULL;
+    munit_assert(sail_seek_next_frame(state, &image) == SAIL_OK);
+    munit_assert_null(image->pixels);
+    munit_assert(image->width == image_default->width);
+    munit_assert(image->height == image_default->height);
+    munit_assert(image->pixel_format == image_default->pixel_format);
+    munit_assert(image->bytes_per_line == image_default->bytes_per_line);
+
+    /* The frame rows are not loaded yet. */
+    struct sail_image *image_next = NULL;
+    munit_assert(sail_load_next_frame(state, &image_next) == SAIL_ERROR_CONFLICTING_OPERATION);
+    munit_assert(sail_load_next_rows(state, rows, 0, 0) == SAIL_ERROR_INVALID_ARGUMENT);
+    munit_assert(sail_load_next_rows(state, rows, image->height + 1, 0) == SAIL_ERROR_INVALID_ARGUMENT);
+
+    /* Rows without the codec padding. */
+    unsigned row_size;
+    munit_assert(sail_bytes_per_line(image->width, image->pixel_format, &row_size) == SAIL_OK);
+    munit_assert(sail_load_next_rows(state, rows, 1, row_size - 1) == SAIL_ERROR_INCORRECT_BYTES_PER_LINE);
+
+    for (unsigned first_row = 0; first_row < image->height; first_row += rows_count) {
+        const unsigned count = (image->height - first_row < rows_count) ? image->height - first_row : rows_count;
+
+        munit_assert(sail_load_next_rows(state, rows, count, bytes_per_line) == SAIL_OK);
+
+        for (unsigned row = 0; row < count; row++) {
+            munit_assert_memory_equal(row_size,
+                                      (const char *)rows + (size_t)row * bytes_per_line,
+                                      (const char *)image_default->pixels + (size_t)(first_row + row) * image_default->bytes_per_line);
+        }
+    }
+
+    /* All the rows are loaded. */
+    munit_assert(sail_load_next_rows(state, rows, 1, 0) == SAIL_ERROR_CONFLICTING_OPERATION);
+
+    munit_assert(sail_stop_loading(state) == SAIL_OK);
+
+    sail_destroy_image(image);
+    sail_free(rows);
+    sail_destroy_image(image_default);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_save_into_growing_memory_produces_same_data(const MunitParameter params[], void *user_data) {
+    (void)user_data;
+
+    const char *path = munit_parameters_get(params, "path");
+
+    struct sail_image *image = NULL;
+    munit_assert(sail_load_from_file(path, &image) == SAIL_OK);
+
+    const struct sail_codec_info *codec_info;
+    munit_assert(sail_codec_info_from_path(path, &codec_info) == SAIL_OK);
+
+    bool can_save = false;
+
+    for (unsigned i = 0; i < codec_info->save_features->pixel_formats_length; i++) {
+        if (codec_info->save_features->pixel_formats[i] == image->pixel_format) {
+            can_save = true;
+            break;
+        }
+    }
+
+    if (!can_save) {
+        sail_destroy_image(image);
+        return MUNIT_SKIP;
+    }
+
+    /* Fixed buffer large enough to hold any test image. */
+    const size_t fixed_buffer_length = (size_t)image->bytes_per_line * image->height * 2 + 64 * 1024;
+    void *fixed_buffer;
+    munit_assert(sail_malloc(fixed_buffer_length, &fixed_buffer) == SAIL_OK);
+
+    void *state;
+    size_t written;
+    munit_assert(sail_start_saving_into_memory(fixed_buffer, fixed_buffer_length, codec_info, &state) == SAIL_OK);
+    munit_assert(sail_write_next_frame(state, image) == SAIL_OK);
+    munit_assert(sail_stop_saving_with_written(state, &written) == SAIL_OK);
+
+    void *buffer;
+    size_t buffer_length;
+    munit_assert(sail_save_into_growing_memory(&buffer, &buffer_length, codec_info, image) == SAIL_OK);
+
+    munit_assert(buffer_length == written);
+    munit_assert_memory_equal(written, buffer, fixed_buffer);
+
+    sail_free(buffer);
+    sail_free(fixed_buffer);
+    sail_destroy_image(image);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_write_rows_produces_same_data(const MunitParameter params[], void *user_data) {
+    (void)user_data;
+
+    const char *path = munit_parameters_get(params, "path");
+
+    struct sail_image *image = NULL;
+    munit_assert(sail_load_from_file(path, &image) == SAIL_OK);
+
+    const struct sail_codec_info *codec_info;
+    munit_assert(sail_codec_info_from_path(path, &codec_info) == SAIL_OK);
+
+    bool can_save = false;
+
+    for (unsigned i = 0; i < codec_info->save_features->pixel_formats_length; i++) {
+        if (codec_info->save_features->pixel_formats[i] == image->pixel_format) {
+            can_save = true;
+            break;
+        }
+    }
+
+    if (!can_save) {
+        sail_destroy_image(image);
+        return MUNIT_SKIP;
+    }
+
+    /* Write a few padded rows at once. */
+    const unsigned rows_count = 7;
+    const unsigned bytes_per_line = image->bytes_per_line + 13;
+
+    void *rows;
+    munit_assert(sail_malloc((size_t)rows_count * bytes_per_line, &rows) == SAIL_OK);
+
+    void *buffer = NULL;
+    size_t buffer_length = 0;
+    void *state;
+    munit_assert(sail_start_saving_into_growing_memory(&buffer, &buffer_length, codec_info, &state) == SAIL_OK);
+
+    /* No frame to write rows into. */
+    munit_assert(sail_write_next_rows(state, rows, 1, 0) == SAIL_ERROR_CONFLICTING_OPERATION);
+
+    munit_assert(sail_write_next_frame_header(state, image) == SAIL_OK);
+
+    /* The frame rows are not written yet. */
+    munit_assert(sail_write_next_frame(state, image) == SAIL_ERROR_CONFLICTING_OPERATION);
+    munit_assert(sail_write_next_rows(state, rows, 0, 0) == SAIL_ERROR_INVALID_ARGUMENT);
+    munit_assert(sail_write_next_rows(state, rows, image->height + 1, 0) == SAIL_ERROR_INVALID_ARGUMENT);
+    munit_assert(sail_write_next_rows(state, rows, 1, image->bytes_per_line - 1) == SAIL_ERROR_INCORRECT_BYTES_PER_LINE);
+
+    for (unsigned first_row = 0; first_row < image->height; first_row += rows_count) {
+        const unsigned count = (image->height - first_row < rows_count) ? image->height - first_row : rows_count;
+
+        for (unsigned row = 0; row < count; row++) {
+            memcpy((char *)rows + (size_t)row * bytes_per_line,
+                   (const char *)image->pixels + (size_t)(first_row + row) * image->bytes_per_line,
+                   image->bytes_per_line);
+        }
+
+        munit_assert(sail_write_next_rows(state, rows, count, bytes_per_line) == SAIL_OK);
+    }
+
+    /* All the rows are written. */
+    munit_assert(sail_write_next_rows(state, rows, 1, 0) == SAIL_ERROR_CONFLICTING_OPERATION);
+
+    munit_assert(sail_stop_saving(state) == SAIL_OK);
+
+    void *buffer_default;
+    size_t buffer_length_default;
+    munit_assert(sail_save_into_growing_memory(&buffer_default, &buffer_length_default, codec_info, image) == SAIL_OK);
+
+    munit_assert(buffer_length == buffer_length_default);
+    munit_assert_memory_equal(buffer_length, buffer, buffer_default);
+
+    sail_free(buffer_default);
+    sail_free(buffer);
+
+    /* Stopping with rows left fails. */
+    munit_assert(sail_start_saving_into_growing_memory(&buffer, &buffer_length, codec_info, &state) == SAIL_OK);
+    munit_assert(sail_write_next_frame_header(state, image) == SAIL_OK);
+    munit_assert(sail_stop_saving(state) == SAIL_ERROR_CONFLICTING_OPERATION);
+
+    sail_free(buffer);
+    sail_free(rows);
+    sail_destroy_image(image);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_growing_memory_io(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    void *buffer;
+    size_t buffer_length;
+    struct sail_io *io;
+    munit_assert(sail_alloc_io_write_growing_memory(&buffer, &buffer_length, &io) == SAIL_OK);
+    munit_assert_null(buffer);
+    munit_assert(buffer_length == 0);
+
+    /* Grow past the initial capacity several times. */
+    unsigned char chunk[1000];
+
+    for (unsigned i = 0; i < 300; i++) {
+        memset(chunk, (int)(i & 0xff), sizeof(chunk));
+        munit_assert(io->strict_write(io->stream, chunk, sizeof(chunk)) == SAIL_OK);
+    }
+
+    munit_assert(buffer_length == 300 * sizeof(chunk));
+
+    /* Overwrite and read back. */
+    const unsigned char marker[4] = { 1, 2, 3, 4 };
+    munit_assert(io->seek(io->stream, 10, SEEK_SET) == SAIL_OK);
+    munit_assert(io->strict_write(io->stream, marker, sizeof(marker)) == SAIL_OK);
+    munit_assert(buffer_length == 300 * sizeof(chunk));
+
+    unsigned char read_marker[4];
+    munit_assert(io->seek(io->stream, 10, SEEK_SET) == SAIL_OK);
+    munit_assert(io->strict_read(io->stream, read_marker, sizeof(read_marker)) == SAIL_OK);
+    munit_assert_memory_equal(sizeof(marker), read_marker, marker);
+
+    /* Gaps after seeking past the end are zeroed. */
+    munit_assert(io->seek(io->stream, 16, SEEK_END) == SAIL_OK);
+    munit_assert(io->strict_write(io->stream, marker, sizeof(marker)) == SAIL_OK);
+    munit_assert(buffer_length == 300 * sizeof(chunk) + 16 + sizeof(marker));
+
+    /* Seeking before the beginning fails. */
+    munit_assert(io->seek(io->stream, -1, SEEK_SET) != SAIL_OK);
+
+    sail_destroy_io(io);
+
+    const unsigned char *data = buffer;
+    munit_assert(data[0] == 0 && data[299 * sizeof(chunk)] == 299 % 256);
+    munit_assert_memory_equal(sizeof(marker), data + 10, marker);
+
+    for (unsigned i = 0; i < 16; i++) {
+        munit_assert(data[300 * sizeof(chunk) + i] == 0);
+    }
+
+    munit_assert_memory_equal(sizeof(marker), data + 300 * sizeof(chunk) + 16, marker);
+
+    sail_free(buffer);
+
+    return MUNIT_OK;
+}
+
 static MunitParameterEnum test_params[] = {
     { (char *)"path", (char **)SAIL_TEST_IMAGES },
     { NULL, NULL },
@@ -77,6 +470,13 @@ static MunitParameterEnum test_params[] = {
 
 static MunitTest test_suite_tests[] = {
     { (char *)"/io-produce-same-images", test_io_produce_same_images, NULL, NULL, MUNIT_TEST_OPTION_NONE, test_params },
+    { (char *)"/load-into-caller-buffer-produces-same-images", test_load_into_caller_buffer_produces_same_images, NULL, NULL, MUNIT_TEST_OPTION_NONE, test_params },
+    { (char *)"/load-rows-produces-same-images", test_load_rows_produces_same_images, NULL, NULL, MUNIT_TEST_OPTION_NONE, test_params },
+    { (char *)"/mmap-file-io-produces-same-images", test_mmap_file_io_produces_same_images, NULL, NULL, MUNIT_TEST_OPTION_NONE, test_params },
+    { (char *)"/pixel-pool-produces-same-images", test_pixel_pool_produces_same_images, NULL, NULL, MUNIT_TEST_OPTION_NONE, test_params },
+    { (char *)"/growing-memory-io", test_growing_memory_io, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/save-into-growing-memory-produces-same-data", test_save_into_growing_memory_produces_same_data, NULL, NULL, MUNIT_TEST_OPTION_NONE, test_params },
+    { (char *)"/write-rows-produces-same-data", test_write_rows_produces_same_data, NULL, NULL, MUNIT_TEST_OPTION_NONE, test_params },
 
     { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
 };
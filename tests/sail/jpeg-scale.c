@@ -0,0 +1,162 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "sail.h"
+
+#include "munit.h"
+
+#include "test-images.h"
+
+/* DCT scaling is not exact averaging, and chroma is subsampled. */
+#define MAX_COMPONENT_DIFFERENCE 8
+
+static struct sail_load_options* load_options_with_scale_denominator(const struct sail_codec_info *codec_info, unsigned scale_denominator) {
+
+    struct sail_load_options *load_options;
+    munit_assert(sail_alloc_load_options_from_features(codec_info->load_features, &load_options) == SAIL_OK);
+    munit_assert(sail_alloc_hash_map(&load_options->tuning) == SAIL_OK);
+
+    struct sail_variant *value;
+    munit_assert(sail_alloc_variant(&value) == SAIL_OK);
+    munit_assert(sail_set_variant_unsigned_int(value, scale_denominator) == SAIL_OK);
+    munit_assert(sail_put_hash_map(load_options->tuning, "jpeg-scale-denominator", value) == SAIL_OK);
+    sail_destroy_variant(value);
+
+    return load_options;
+}
+
+/* Compares the scaled pixels with the averages of the matching full-size pixel boxes. */
+static void assert_box_averages(const struct sail_image *image_full, const struct sail_image *image, unsigned scale_denominator) {
+
+    for (unsigned row = 0; row < image->height; row++) {
+        for (unsigned column = 0; column < image->width; column++) {
+            for (unsigned component = 0; component < 3; component++) {
+                unsigned sum = 0;
+                unsigned count = 0;
+
+                for (unsigned y = row * scale_denominator; y < (row + 1) * scale_denominator && y < image_full->height; y++) {
+                    for (unsigned x = column * scale_denominator; x < (column + 1) * scale_denominator && x < image_full->width; x++) {
+                        sum += ((const uint8_t *)image_full->pixels)[(size_t)y * image_full->bytes_per_line + x * 3 + component];
+                        count++;
+                    }
+                }
+
+                const int expected = (int)((sum + count / 2) / count);
+                const int actual = ((const uint8_t *)image->pixels)[(size_t)row * image->bytes_per_line + column * 3 + component];
+
+                munit_assert_int(abs(actual - expected), <=, MAX_COMPONENT_DIFFERENCE);
+            }
+        }
+    }
+}
+
+static MunitResult test_scale_denominator(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    const char *path = SAIL_TEST_IMAGES_PATH "/jpeg/bpp24-rgb.jpg";
+
+    const struct sail_codec_info *codec_info;
+    munit_assert(sail_codec_info_from_path(path, &codec_info) == SAIL_OK);
+
+    struct sail_image *image_full = NULL;
+    munit_assert(sail_load_from_file(path, &image_full) == SAIL_OK);
+    munit_assert(image_full->pixel_format == SAIL_PIXEL_FORMAT_BPP24_RGB);
+
+    static const unsigned scale_denominators[] = { 2, 4, 8 };
+
+    for (size_t i = 0; i < sizeof(scale_denominators) / sizeof(scale_denominators[0]); i++) {
+        const unsigned scale_denominator = scale_denominators[i];
+        const unsigned expected_width    = (image_full->width + scale_denominator - 1) / scale_denominator;
+        const unsigned expected_height   = (image_full->height + scale_denominator - 1) / scale_denominator;
+
+        struct sail_load_options *load_options = load_options_with_scale_denominator(codec_info, scale_denominator);
+
+        /* The sought frame has the reduced dimensions. */
+        void *state;
+        munit_assert(sail_start_loading_from_file_with_options(path, codec_info, load_options, &state) == SAIL_OK);
+
+        struct sail_image *image = NULL;
+        munit_assert(sail_seek_next_frame(state, &image) == SAIL_OK);
+        munit_assert_uint(image->width, ==, expected_width);
+        munit_assert_uint(image->height, ==, expected_height);
+        munit_assert(image->pixel_format == SAIL_PIXEL_FORMAT_BPP24_RGB);
+
+        void *pixels;
+        munit_assert(sail_malloc((size_t)image->bytes_per_line * image->height, &pixels) == SAIL_OK);
+        munit_assert(sail_load_next_rows(state, pixels, image->height, 0) == SAIL_OK);
+        image->pixels = pixels;
+
+        munit_assert(sail_stop_loading(state) == SAIL_OK);
+
+        assert_box_averages(image_full, image, scale_denominator);
+
+        /* Loading the whole frame gives the same pixels. */
+        munit_assert(sail_start_loading_from_file_with_options(path, codec_info, load_options, &state) == SAIL_OK);
+
+        struct sail_image *image_frame = NULL;
+        munit_assert(sail_load_next_frame(state, &image_frame) == SAIL_OK);
+        munit_assert(sail_stop_loading(state) == SAIL_OK);
+
+        munit_assert_uint(image_frame->width, ==, expected_width);
+        munit_assert_uint(image_frame->height, ==, expected_height);
+
+        for (unsigned row = 0; row < image->height; row++) {
+            munit_assert_memory_equal((size_t)image->width * 3,
+                                      (const uint8_t *)image_frame->pixels + (size_t)row * image_frame->bytes_per_line,
+                                      (const uint8_t *)image->pixels + (size_t)row * image->bytes_per_line);
+        }
+
+        sail_destroy_image(image_frame);
+        sail_destroy_image(image);
+        sail_destroy_load_options(load_options);
+    }
+
+    sail_destroy_image(image_full);
+
+    return MUNIT_OK;
+}
+
+static MunitTest test_suite_tests[] = {
+    { (char *)"/scale-denominator", test_scale_denominator, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char *)"/jpeg-scale",
+    test_suite_tests,
+    NULL,
+    1,
+    MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, NULL, argc, argv);
+}
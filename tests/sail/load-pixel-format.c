@@ -0,0 +1,177 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stdlib.h>
+
+#include "sail.h"
+#include "sail-manip.h"
+
+#include "munit.h"
+
+#include "test-images.h"
+
+static const enum SailPixelFormat PIXEL_FORMATS[] = {
+    SAIL_PIXEL_FORMAT_BPP24_BGR,
+    SAIL_PIXEL_FORMAT_BPP32_RGBA,
+    SAIL_PIXEL_FORMAT_BPP32_BGRA,
+    SAIL_PIXEL_FORMAT_BPP64_RGBA,
+};
+
+/* Codecs may scale 16-bit samples to 8 bits with a different rounding. */
+static void assert_pixels_close(const struct sail_image *image, const struct sail_image *image_reference) {
+
+    munit_assert(image->width == image_reference->width);
+    munit_assert(image->height == image_reference->height);
+    munit_assert(image->pixel_format == image_reference->pixel_format);
+
+    for (unsigned row = 0; row < image->height; row++) {
+        const unsigned char *scan = (const unsigned char *)image->pixels + (size_t)row * image->bytes_per_line;
+        const unsigned char *scan_reference = (const unsigned char *)image_reference->pixels + (size_t)row * image_reference->bytes_per_line;
+
+        for (unsigned i = 0; i < image_reference->bytes_per_line; i++) {
+            munit_assert_int(abs((int)scan[i] - (int)scan_reference[i]), <=, 1);
+        }
+    }
+}
+
+static MunitResult test_load_pixel_format(const MunitParameter params[], void *user_data) {
+    (void)user_data;
+
+    const char *path = munit_parameters_get(params, "path");
+
+    const struct sail_codec_info *codec_info;
+    munit_assert(sail_codec_info_from_path(path, &codec_info) == SAIL_OK);
+
+    struct sail_image *image_default = NULL;
+    munit_assert(sail_load_from_file(path, &image_default) == SAIL_OK);
+
+    for (size_t i = 0; i < sizeof(PIXEL_FORMATS) / sizeof(PIXEL_FORMATS[0]); i++) {
+        struct sail_load_options *load_options;
+        munit_assert(sail_alloc_load_options_from_features(codec_info->load_features, &load_options) == SAIL_OK);
+        load_options->pixel_format = PIXEL_FORMATS[i];
+
+        void *state;
+        munit_assert(sail_start_loading_from_file_with_options(path, codec_info, load_options, &state) == SAIL_OK);
+        sail_destroy_load_options(load_options);
+
+        struct sail_image *image = NULL;
+        const sail_status_t status = sail_load_next_frame(state, &image);
+        munit_assert(sail_stop_loading(state) == SAIL_OK);
+
+        if (!sail_can_convert(image_default->pixel_format, PIXEL_FORMATS[i])) {
+            munit_assert(status == SAIL_ERROR_UNSUPPORTED_PIXEL_FORMAT);
+            continue;
+        }
+
+        munit_assert(status == SAIL_OK);
+        munit_assert(image->pixel_format == PIXEL_FORMATS[i]);
+
+        struct sail_image *image_reference = NULL;
+        munit_assert(sail_convert_image(image_default, PIXEL_FORMATS[i], &image_reference) == SAIL_OK);
+
+        assert_pixels_close(image, image_reference);
+
+        sail_destroy_image(image_reference);
+        sail_destroy_image(image);
+    }
+
+    sail_destroy_image(image_default);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_load_pixel_format_into_caller_buffer(const MunitParameter params[], void *user_data) {
+    (void)user_data;
+
+    const char *path = munit_parameters_get(params, "path");
+
+    const struct sail_codec_info *codec_info;
+    munit_assert(sail_codec_info_from_path(path, &codec_info) == SAIL_OK);
+
+    struct sail_image *image_default = NULL;
+    munit_assert(sail_load_from_file(path, &image_default) == SAIL_OK);
+
+    if (!sail_can_convert(image_default->pixel_format, SAIL_PIXEL_FORMAT_BPP32_BGRA)) {
+        sail_destroy_image(image_default);
+        return MUNIT_SKIP;
+    }
+
+    struct sail_image *image_reference = NULL;
+    munit_assert(sail_convert_image(image_default, SAIL_PIXEL_FORMAT_BPP32_BGRA, &image_reference) == SAIL_OK);
+    sail_destroy_image(image_default);
+
+    const unsigned bytes_per_line = image_reference->bytes_per_line + 8;
+    const size_t pixels_size = (size_t)bytes_per_line * image_reference->height;
+
+    void *pixels;
+    munit_assert(sail_malloc(pixels_size, &pixels) == SAIL_OK);
+
+    struct sail_load_options *load_options;
+    munit_assert(sail_alloc_load_options_from_features(codec_info->load_features, &load_options) == SAIL_OK);
+    load_options->pixel_format = SAIL_PIXEL_FORMAT_BPP32_BGRA;
+
+    void *state;
+    munit_assert(sail_start_loading_from_file_with_options(path, codec_info, load_options, &state) == SAIL_OK);
+    sail_destroy_load_options(load_options);
+
+    struct sail_image *image = NULL;
+    munit_assert(sail_load_next_frame_into(state, pixels, pixels_size, bytes_per_line, &image) == SAIL_OK);
+    munit_assert(sail_stop_loading(state) == SAIL_OK);
+
+    munit_assert_ptr_equal(image->pixels, pixels);
+    munit_assert(image->bytes_per_line == bytes_per_line);
+
+    assert_pixels_close(image, image_reference);
+
+    sail_destroy_image(image);
+    sail_destroy_image(image_reference);
+    sail_free(pixels);
+
+    return MUNIT_OK;
+}
+
+static MunitParameterEnum test_params[] = {
+    { (char *)"path", (char **)SAIL_TEST_IMAGES },
+    { NULL, NULL },
+};
+
+static MunitTest test_suite_tests[] = {
+    { (char *)"/load-pixel-format",                    test_load_pixel_format,                    NULL, NULL, MUNIT_TEST_OPTION_NONE, test_params },
+    { (char *)"/load-pixel-format-into-caller-buffer", test_load_pixel_format_into_caller_buffer, NULL, NULL, MUNIT_TEST_OPTION_NONE, test_params },
+
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char *)"/load-pixel-format",
+    test_suite_tests,
+    NULL,
+    1,
+    MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, NULL, argc, argv);
+}
@@ -0,0 +1,207 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "sail.h"
+
+#include "munit.h"
+
+#include "test-images.h"
+
+/*
+ * Checksums of the pixels of RLE-compressed images. They were computed with the decoders
+ * reading the I/O byte by byte, or from the source pixels for the generated PCX images.
+ * They guard the RLE decoders against regressions.
+ */
+struct image_checksum {
+    const char *path;
+    unsigned width;
+    unsigned height;
+    enum SailPixelFormat pixel_format;
+    uint32_t checksum;
+};
+
+static const struct image_checksum RLE_CHECKSUMS[] = {
+    { "bmp/bpp4-indexed.rle.bmp",             32,  32,  SAIL_PIXEL_FORMAT_BPP8_INDEXED,   0x9662ba45 },
+    { "bmp/bpp4-indexed.rle.not4.bmp",        34,  32,  SAIL_PIXEL_FORMAT_BPP8_INDEXED,   0x92180505 },
+    { "bmp/bpp8-indexed.rle.bmp",             32,  32,  SAIL_PIXEL_FORMAT_BPP8_INDEXED,   0x96197685 },
+    { "bmp/bpp8-indexed.rle.not4.bmp",        35,  32,  SAIL_PIXEL_FORMAT_BPP8_INDEXED,   0xf8c38465 },
+    { "pcx/bpp8-indexed.rle.pcx",             131, 97,  SAIL_PIXEL_FORMAT_BPP8_INDEXED,   0x44cb07b4 },
+    { "pcx/bpp24-rgb.rle.pcx",                97,  71,  SAIL_PIXEL_FORMAT_BPP24_RGB,      0x12965b8d },
+    { "tga/bpp8-grayscale.extension.rle.tga", 128, 128, SAIL_PIXEL_FORMAT_BPP8_GRAYSCALE, 0x6eea2dc5 },
+    { "tga/bpp8-indexed.extension.rle.tga",   128, 128, SAIL_PIXEL_FORMAT_BPP8_INDEXED,   0xdfc6e5c5 },
+    { "tga/bpp24-bgr.extension.rle.tga",      128, 128, SAIL_PIXEL_FORMAT_BPP24_BGR,      0xb78d05c5 },
+};
+
+#ifdef SAIL_TEST_TIFF_IMAGES
+/*
+ * Checksums of the TIFF images computed from their source samples. Striped and tiled images
+ * have the same pixels. Associated and unspecified alpha is read with TIFFRGBAImage.
+ */
+static const struct image_checksum TIFF_CHECKSUMS[] = {
+    { "tiff/bpp8-grayscale.tif",         37, 29, SAIL_PIXEL_FORMAT_BPP8_GRAYSCALE,  0x557261b0 },
+    { "tiff/bpp8-grayscale.tiled.tif",   37, 29, SAIL_PIXEL_FORMAT_BPP8_GRAYSCALE,  0x557261b0 },
+    { "tiff/bpp16-grayscale.tif",        37, 29, SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE, 0x5e0f3b7e },
+    { "tiff/bpp16-grayscale.tiled.tif",  37, 29, SAIL_PIXEL_FORMAT_BPP16_GRAYSCALE, 0x5e0f3b7e },
+    { "tiff/bpp24-rgb.tif",              37, 29, SAIL_PIXEL_FORMAT_BPP24_RGB,       0x0405aa96 },
+    { "tiff/bpp24-rgb.tiled.tif",        37, 29, SAIL_PIXEL_FORMAT_BPP24_RGB,       0x0405aa96 },
+    { "tiff/bpp32-rgba.tif",             37, 29, SAIL_PIXEL_FORMAT_BPP32_RGBA,      0x7c99c1e4 },
+    { "tiff/bpp32-rgba.tiled.tif",       37, 29, SAIL_PIXEL_FORMAT_BPP32_RGBA,      0x7c99c1e4 },
+    { "tiff/bpp32-rgba.associated.tif",  37, 29, SAIL_PIXEL_FORMAT_BPP32_RGBA,      0x3519cd8a },
+    { "tiff/bpp32-rgba.unspecified.tif", 37, 29, SAIL_PIXEL_FORMAT_BPP32_RGBA,      0x2b5dc094 },
+    { "tiff/bpp48-rgb.tif",              37, 29, SAIL_PIXEL_FORMAT_BPP48_RGB,       0x311f7349 },
+    { "tiff/bpp48-rgb.tiled.tif",        37, 29, SAIL_PIXEL_FORMAT_BPP48_RGB,       0x311f7349 },
+    { "tiff/bpp64-rgba.tif",             37, 29, SAIL_PIXEL_FORMAT_BPP64_RGBA,      0xde583bee },
+    { "tiff/bpp64-rgba.tiled.tif",       37, 29, SAIL_PIXEL_FORMAT_BPP64_RGBA,      0xde583bee },
+};
+#endif
+
+/* 32-bit FNV-1a of the pixels without the row padding. */
+static uint32_t pixels_checksum(const struct sail_image *image) {
+
+    unsigned row_size;
+    munit_assert(sail_bytes_per_line(image->width, image->pixel_format, &row_size) == SAIL_OK);
+
+    uint32_t checksum = 0x811c9dc5;
+
+    for (unsigned row = 0; row < image->height; row++) {
+        const uint8_t *scan = (const uint8_t *)image->pixels + (size_t)row * image->bytes_per_line;
+
+        for (unsigned i = 0; i < row_size; i++) {
+            checksum = (checksum ^ scan[i]) * 0x01000193;
+        }
+    }
+
+    return checksum;
+}
+
+static MunitResult test_rle_checksums(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    for (size_t i = 0; i < sizeof(RLE_CHECKSUMS) / sizeof(RLE_CHECKSUMS[0]); i++) {
+        char path[512];
+        munit_assert(snprintf(path, sizeof(path), "%s/%s", SAIL_TEST_IMAGES_PATH, RLE_CHECKSUMS[i].path) < (int)sizeof(path));
+
+        struct sail_image *image = NULL;
+        munit_assert(sail_load_from_file(path, &image) == SAIL_OK);
+
+        munit_assert(image->source_image->compression == SAIL_COMPRESSION_RLE);
+        munit_assert_uint(image->width, ==, RLE_CHECKSUMS[i].width);
+        munit_assert_uint(image->height, ==, RLE_CHECKSUMS[i].height);
+        munit_assert_int(image->pixel_format, ==, RLE_CHECKSUMS[i].pixel_format);
+        munit_assert_uint32(pixels_checksum(image), ==, RLE_CHECKSUMS[i].checksum);
+
+        sail_destroy_image(image);
+    }
+
+    return MUNIT_OK;
+}
+
+#ifdef SAIL_TEST_TIFF_IMAGES
+static MunitResult test_tiff_checksums(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    for (size_t i = 0; i < sizeof(TIFF_CHECKSUMS) / sizeof(TIFF_CHECKSUMS[0]); i++) {
+        char path[512];
+        munit_assert(snprintf(path, sizeof(path), "%s/%s", SAIL_TEST_IMAGES_PATH, TIFF_CHECKSUMS[i].path) < (int)sizeof(path));
+
+        struct sail_image *image = NULL;
+        munit_assert(sail_load_from_file(path, &image) == SAIL_OK);
+
+        munit_assert_uint(image->width, ==, TIFF_CHECKSUMS[i].width);
+        munit_assert_uint(image->height, ==, TIFF_CHECKSUMS[i].height);
+        munit_assert_int(image->pixel_format, ==, TIFF_CHECKSUMS[i].pixel_format);
+        munit_assert_uint32(pixels_checksum(image), ==, TIFF_CHECKSUMS[i].checksum);
+
+        sail_destroy_image(image);
+    }
+
+    return MUNIT_OK;
+}
+
+/* Tiles read in parallel give the same pixels. */
+static MunitResult test_tiff_tile_threads(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    for (size_t i = 0; i < sizeof(TIFF_CHECKSUMS) / sizeof(TIFF_CHECKSUMS[0]); i++) {
+        char path[512];
+        munit_assert(snprintf(path, sizeof(path), "%s/%s", SAIL_TEST_IMAGES_PATH, TIFF_CHECKSUMS[i].path) < (int)sizeof(path));
+
+        const struct sail_codec_info *codec_info;
+        munit_assert(sail_codec_info_from_path(path, &codec_info) == SAIL_OK);
+
+        struct sail_load_options *load_options;
+        munit_assert(sail_alloc_load_options_from_features(codec_info->load_features, &load_options) == SAIL_OK);
+        munit_assert(sail_alloc_hash_map(&load_options->tuning) == SAIL_OK);
+
+        struct sail_variant *value;
+        munit_assert(sail_alloc_variant(&value) == SAIL_OK);
+        munit_assert(sail_set_variant_unsigned_int(value, 4) == SAIL_OK);
+        munit_assert(sail_put_hash_map(load_options->tuning, "tiff-tile-threads", value) == SAIL_OK);
+        sail_destroy_variant(value);
+
+        void *state = NULL;
+        struct sail_image *image = NULL;
+        munit_assert(sail_start_loading_from_file_with_options(path, codec_info, load_options, &state) == SAIL_OK);
+        munit_assert(sail_load_next_frame(state, &image) == SAIL_OK);
+        munit_assert(sail_stop_loading(state) == SAIL_OK);
+
+        munit_assert_uint32(pixels_checksum(image), ==, TIFF_CHECKSUMS[i].checksum);
+
+        sail_destroy_image(image);
+        sail_destroy_load_options(load_options);
+    }
+
+    return MUNIT_OK;
+}
+#endif
+
+static MunitTest test_suite_tests[] = {
+    { (char *)"/rle-checksums", test_rle_checksums, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+#ifdef SAIL_TEST_TIFF_IMAGES
+    { (char *)"/tiff-checksums", test_tiff_checksums, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+    { (char *)"/tiff-tile-threads", test_tiff_tile_threads, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+#endif
+
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char *)"/pixel-checksums",
+    test_suite_tests,
+    NULL,
+    1,
+    MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, NULL, argc, argv);
+}
@@ -0,0 +1,158 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stddef.h>
+
+#include "sail.h"
+
+#include "munit.h"
+
+#include "test-images.h"
+
+static MunitResult test_probe_header(const MunitParameter params[], void *user_data) {
+    (void)user_data;
+
+    const char *path = munit_parameters_get(params, "path");
+
+    struct sail_image *image = NULL;
+    const struct sail_codec_info *codec_info;
+    munit_assert(sail_probe_file(path, &image, &codec_info) == SAIL_OK);
+
+    struct sail_image *image_header = NULL;
+    const struct sail_codec_info *codec_info_header;
+    size_t bytes_consumed = 0;
+    munit_assert(sail_probe_header_file(path, &image_header, &codec_info_header, &bytes_consumed) == SAIL_OK);
+
+    munit_assert_ptr_equal(codec_info_header, codec_info);
+    munit_assert(image_header->width == image->width);
+    munit_assert(image_header->height == image->height);
+    munit_assert(image_header->pixel_format == image->pixel_format);
+    munit_assert_null(image_header->meta_data_node);
+    munit_assert_null(image_header->iccp);
+
+    void *data;
+    size_t data_length;
+    munit_assert(sail_file_contents_to_data(path, &data, &data_length) == SAIL_OK);
+
+    munit_assert(bytes_consumed > 0);
+    munit_assert(bytes_consumed <= data_length);
+
+    /* The consumed bytes are enough to probe the image. Codecs like TGA have no magic numbers. */
+    if (codec_info->magic_number_node != NULL) {
+        struct sail_image *image_prefix = NULL;
+        size_t bytes_consumed_prefix;
+        munit_assert(sail_probe_header_memory(data, bytes_consumed, &image_prefix, NULL, &bytes_consumed_prefix) == SAIL_OK);
+
+        munit_assert(image_prefix->width == image->width);
+        munit_assert(image_prefix->height == image->height);
+        munit_assert(image_prefix->pixel_format == image->pixel_format);
+        munit_assert(bytes_consumed_prefix <= bytes_consumed);
+
+        sail_destroy_image(image_prefix);
+    }
+
+    /* Frames cannot be loaded with the header-only option. */
+    struct sail_load_options *load_options;
+    munit_assert(sail_alloc_load_options_from_features(codec_info->load_features, &load_options) == SAIL_OK);
+    load_options->options |= SAIL_OPTION_HEADER_ONLY;
+
+    void *state = NULL;
+    munit_assert(sail_start_loading_from_file_with_options(path, codec_info, load_options, &state) == SAIL_ERROR_INVALID_ARGUMENT);
+    munit_assert_null(state);
+    munit_assert(sail_start_loading_from_memory_with_options(data, data_length, codec_info, load_options, &state) == SAIL_ERROR_INVALID_ARGUMENT);
+    munit_assert_null(state);
+
+    sail_destroy_load_options(load_options);
+
+    sail_free(data);
+    sail_destroy_image(image_header);
+    sail_destroy_image(image);
+
+    return MUNIT_OK;
+}
+
+static MunitResult test_probe_whole_stream(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    /* QOI reads the whole stream and seeks back, so it consumes everything. */
+    const char *path = SAIL_TEST_IMAGES_PATH "/qoi/bpp24-rgb.qoi";
+
+    void *data;
+    size_t data_length;
+    munit_assert(sail_file_contents_to_data(path, &data, &data_length) == SAIL_OK);
+
+    struct sail_image *image = NULL;
+    size_t bytes_consumed = 0;
+    munit_assert(sail_probe_header_file(path, &image, NULL, &bytes_consumed) == SAIL_OK);
+    munit_assert_size(bytes_consumed, ==, data_length);
+    sail_destroy_image(image);
+
+    image = NULL;
+    bytes_consumed = 0;
+    munit_assert(sail_probe_header_memory(data, data_length, &image, NULL, &bytes_consumed) == SAIL_OK);
+    munit_assert_size(bytes_consumed, ==, data_length);
+    sail_destroy_image(image);
+
+    /* Without the direct buffer, the stream is read into memory. */
+    struct sail_io *io;
+    munit_assert(sail_alloc_io_read_memory(data, data_length, &io) == SAIL_OK);
+    io->features &= ~SAIL_IO_FEATURE_DIRECT_BUFFER;
+
+    image = NULL;
+    bytes_consumed = 0;
+    munit_assert(sail_probe_header_io(io, &image, NULL, &bytes_consumed) == SAIL_OK);
+    munit_assert_size(bytes_consumed, ==, data_length);
+    sail_destroy_image(image);
+
+    sail_destroy_io(io);
+    sail_free(data);
+
+    return MUNIT_OK;
+}
+
+static MunitParameterEnum test_params[] = {
+    { (char *)"path", (char **)SAIL_TEST_IMAGES },
+    { NULL, NULL },
+};
+
+static MunitTest test_suite_tests[] = {
+    { (char *)"/probe-header",       test_probe_header,       NULL, NULL, MUNIT_TEST_OPTION_NONE, test_params },
+    { (char *)"/probe-whole-stream", test_probe_whole_stream, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char *)"/probe-header",
+    test_suite_tests,
+    NULL,
+    1,
+    MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, NULL, argc, argv);
+}
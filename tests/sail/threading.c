@@ -0,0 +1,111 @@
+/*  This file is part of SAIL (https://github.com/smoked-herring/sail)
+
+    Copyright (c) 2022 Dmitry Baryshev
+
+    The MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "sail.h"
+
+#include "munit.h"
+
+#include "test-images.h"
+
+#ifdef SAIL_THREAD_SAFE
+
+#define THREADS_COUNT 8
+
+struct thread_context {
+
+    bool success;
+};
+
+static void load_all_images(void *arg) {
+
+    struct thread_context *context = arg;
+
+    context->success = true;
+
+    for (const char * const *path = SAIL_TEST_IMAGES; *path != NULL; path++) {
+        struct sail_image *image;
+
+        if (sail_load_from_file(*path, &image) != SAIL_OK) {
+            context->success = false;
+            return;
+        }
+
+        sail_destroy_image(image);
+    }
+}
+
+static MunitResult test_load_concurrently(const MunitParameter params[], void *user_data) {
+    (void)params;
+    (void)user_data;
+
+    /* Initialize the context but leave codecs unloaded so threads race to load them. */
+    munit_assert(sail_init() == SAIL_OK);
+    munit_assert(sail_unload_codecs() == SAIL_OK);
+
+    sail_thread_t threads[THREADS_COUNT];
+    struct thread_context contexts[THREADS_COUNT];
+
+    for (unsigned i = 0; i < THREADS_COUNT; i++) {
+        munit_assert(sail_create_thread(&threads[i], load_all_images, &contexts[i]) == SAIL_OK);
+    }
+
+    for (unsigned i = 0; i < THREADS_COUNT; i++) {
+        munit_assert(sail_join_thread(&threads[i]) == SAIL_OK);
+        munit_assert(contexts[i].success);
+    }
+
+    /* The codecs are published. */
+    for (const struct sail_codec_bundle_node *node = sail_codec_bundle_list(); node != NULL; node = node->next) {
+        if (strcmp(node->codec_bundle->codec_info->name, "PNG") == 0) {
+            munit_assert_not_null(node->codec_bundle->codec);
+        }
+    }
+
+    return MUNIT_OK;
+}
+#endif
+
+static MunitTest test_suite_tests[] = {
+#ifdef SAIL_THREAD_SAFE
+    { (char *)"/load-concurrently", test_load_concurrently, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL },
+#endif
+
+    { NULL, NULL, NULL, NULL, MUNIT_TEST_OPTION_NONE, NULL }
+};
+
+static const MunitSuite test_suite = {
+    (char *)"/threading",
+    test_suite_tests,
+    NULL,
+    1,
+    MUNIT_SUITE_OPTION_NONE
+};
+
+int main(int argc, char *argv[MUNIT_ARRAY_PARAM(argc + 1)]) {
+    return munit_suite_main(&test_suite, NULL, argc, argv);
+}